@@ -0,0 +1,90 @@
+/**
+ * @file bench-utils.ts
+ * @brief Shared helpers for mount-based benchmarks
+ *
+ * Benchmarks mount a synthetic filesystem, drive it with ordinary tools and
+ * report wall-clock numbers. They need a built addon and /dev/fuse access.
+ */
+
+import { execFile } from 'node:child_process';
+import fs from 'node:fs';
+import { createRequire } from 'node:module';
+import { promisify } from 'node:util';
+
+import {
+  FuseNative,
+  type FuseOperationHandlers,
+  type FuseSession,
+} from '../ts/index.ts';
+
+const requireCompat = createRequire(import.meta.url);
+
+export const execFileAsync = promisify(execFile);
+
+export function loadBinding(): any {
+  for (const flavour of ['Release', 'Debug']) {
+    try {
+      return requireCompat(`../build/${flavour}/fuse-native.node`);
+    } catch {
+      // try next build flavour
+    }
+  }
+  throw new Error('Native binding not built; run `pnpm run build:native` first');
+}
+
+export interface MountedBench {
+  fuse: FuseNative;
+  session: FuseSession;
+  mountPoint: string;
+  close(): Promise<void>;
+}
+
+export async function mountBench(
+  name: string,
+  operations: FuseOperationHandlers
+): Promise<MountedBench> {
+  const mountPoint = `/tmp/fuse-bench-${name}-${process.pid}`;
+  fs.mkdirSync(mountPoint, { recursive: true });
+
+  const fuse = new FuseNative(loadBinding());
+  const session = await fuse.createSession(mountPoint, operations, {
+    autoUnmount: false,
+  });
+  await session.mount();
+
+  return {
+    fuse,
+    session,
+    mountPoint,
+    async close() {
+      await session.unmount();
+      await fuse.shutdownDispatcher(750);
+      await session.destroy();
+      fs.rmdirSync(mountPoint);
+    },
+  };
+}
+
+/** Run `fn` `iterations` times and return per-iteration milliseconds. */
+export async function timeIt(
+  iterations: number,
+  fn: () => Promise<void>
+): Promise<number[]> {
+  const samples: number[] = [];
+  for (let i = 0; i < iterations; i++) {
+    const start = process.hrtime.bigint();
+    await fn();
+    samples.push(Number(process.hrtime.bigint() - start) / 1e6);
+  }
+  return samples;
+}
+
+export function report(label: string, samples: number[]): void {
+  const sorted = [...samples].sort((a, b) => a - b);
+  const median = sorted[Math.floor(sorted.length / 2)] ?? 0;
+  const min = sorted[0] ?? 0;
+  console.log(
+    `${label.padEnd(32)} median ${median.toFixed(2).padStart(9)} ms  ` +
+      `min ${min.toFixed(2).padStart(9)} ms  (n=${samples.length})`
+  );
+}
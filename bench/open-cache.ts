@@ -0,0 +1,140 @@
+/**
+ * @file open-cache.ts
+ * @brief Effect of the per-open cache flags returned by `open`
+ *
+ * Two scenarios against a synthetic filesystem:
+ *
+ *  - reopen: open + read the whole file repeatedly, with and without
+ *    `keep_cache`. Without it every open drops the page cache and each read
+ *    goes back to the handler.
+ *  - parallel writes: several writers issue direct_io writes to disjoint
+ *    ranges of one file, with and without `parallel_direct_writes`. The write
+ *    handler sleeps per request; serialized writes add the latency up.
+ *
+ * Usage: node --loader ts-node/esm bench/open-cache.ts [MiB] [writers] [latencyMs] [iterations]
+ */
+
+import fs from 'node:fs/promises';
+import { setTimeout as sleep } from 'node:timers/promises';
+
+import {
+  StatUtils,
+  createFd,
+  createFlags,
+  createIno,
+  FuseErrno,
+  type FileInfo,
+  type FuseOperationHandlers,
+} from '../ts/index.ts';
+import { mountBench, report, timeIt } from './bench-utils.ts';
+
+const SIZE_MIB = Number(process.argv[2] ?? 16);
+const WRITERS = Number(process.argv[3] ?? 8);
+const LATENCY_MS = Number(process.argv[4] ?? 2);
+const ITERATIONS = Number(process.argv[5] ?? 5);
+
+const FILE_NAME = 'blob';
+const FILE_INO = createIno(2n);
+const FILE_SIZE = SIZE_MIB * 1024 * 1024;
+const WRITES_PER_WRITER = 32;
+const WRITE_SIZE = 64 * 1024;
+
+const content = Buffer.alloc(FILE_SIZE, 0x61);
+
+let policy: Partial<FileInfo> = {};
+let readCalls = 0;
+let nextFh = 1n;
+
+const operations: FuseOperationHandlers = {
+  lookup: async (_parent, name) => {
+    if (name !== FILE_NAME) {
+      throw new FuseErrno('ENOENT');
+    }
+    return {
+      ino: FILE_INO,
+      generation: 0n,
+      entry_timeout: 60,
+      attr_timeout: 60,
+      attr: StatUtils.createFile(FILE_INO, BigInt(FILE_SIZE)),
+    };
+  },
+  getattr: async (ino) => ({
+    attr:
+      ino === 1n
+        ? StatUtils.createDirectory(ino)
+        : StatUtils.createFile(ino, BigInt(FILE_SIZE)),
+    timeout: 60,
+  }),
+  open: async (_ino, _ctx, options) => ({
+    fh: createFd(nextFh++),
+    flags: options?.flags ?? createFlags(0),
+    ...policy,
+  }),
+  release: async () => undefined,
+  flush: async () => undefined,
+  read: async (_ino, _ctx, { offset, size }) => {
+    readCalls++;
+    const start = Number(offset);
+    return content.subarray(start, Math.min(FILE_SIZE, start + size));
+  },
+  write: async (_ino, data) => {
+    await sleep(LATENCY_MS);
+    return data.byteLength;
+  },
+};
+
+const bench = await mountBench('open-cache', operations);
+const path = `${bench.mountPoint}/${FILE_NAME}`;
+
+async function reopenAndRead(): Promise<void> {
+  await fs.readFile(path);
+}
+
+async function parallelWrites(): Promise<void> {
+  const chunk = Buffer.alloc(WRITE_SIZE, 0x62);
+  await Promise.all(
+    Array.from({ length: WRITERS }, async (_, writer) => {
+      const handle = await fs.open(path, 'r+');
+      try {
+        for (let i = 0; i < WRITES_PER_WRITER; i++) {
+          const position = ((writer * WRITES_PER_WRITER + i) * WRITE_SIZE) % FILE_SIZE;
+          await handle.write(chunk, 0, chunk.length, position);
+        }
+      } finally {
+        await handle.close();
+      }
+    })
+  );
+}
+
+async function run(label: string, next: Partial<FileInfo>, fn: () => Promise<void>): Promise<void> {
+  policy = next;
+  // Aufwärmen: erster Durchlauf füllt ggf. den Page Cache
+  await fn();
+  readCalls = 0;
+  report(label, await timeIt(ITERATIONS, fn));
+  if (fn === reopenAndRead) {
+    console.log(`  read requests per run: ${(readCalls / ITERATIONS).toFixed(0)}`);
+  }
+}
+
+try {
+  await fs.stat(path);
+
+  console.log(`reopen + read of ${SIZE_MIB} MiB, ${ITERATIONS} iterations`);
+  await run('default', {}, reopenAndRead);
+  await run('keep_cache', { keep_cache: true }, reopenAndRead);
+
+  console.log(
+    `${WRITERS} writers x ${WRITES_PER_WRITER} direct writes of ${WRITE_SIZE / 1024} KiB, ` +
+      `${LATENCY_MS} ms backend latency`
+  );
+  await run('direct_io', { direct_io: true }, parallelWrites);
+  await run(
+    'direct_io + parallel_direct_writes',
+    { direct_io: true, parallel_direct_writes: true },
+    parallelWrites
+  );
+} finally {
+  await bench.close();
+}
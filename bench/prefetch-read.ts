@@ -0,0 +1,132 @@
+/**
+ * @file prefetch-read.ts
+ * @brief Sequential read of a slow-backed file: cold vs. prefetched via notify_store
+ *
+ * The read handler sleeps per request to mimic object-storage latency. The
+ * prefetched run pushes the whole file into the page cache with
+ * `session.notifyStore()` first, so reads never reach the bridge.
+ *
+ * Usage: node --loader ts-node/esm bench/prefetch-read.ts [MiB] [latencyMs] [iterations]
+ */
+
+import fs from 'node:fs/promises';
+import { setTimeout as sleep } from 'node:timers/promises';
+
+import {
+  StatUtils,
+  createFd,
+  createFlags,
+  createIno,
+  FuseErrno,
+  type FuseOperationHandlers,
+} from '../ts/index.ts';
+import { mountBench, report, timeIt } from './bench-utils.ts';
+
+const SIZE_MIB = Number(process.argv[2] ?? 64);
+const LATENCY_MS = Number(process.argv[3] ?? 2);
+const ITERATIONS = Number(process.argv[4] ?? 5);
+
+const FILE_NAME = 'blob';
+const FILE_INO = createIno(2n);
+const FILE_SIZE = SIZE_MIB * 1024 * 1024;
+const STORE_CHUNK = 1024 * 1024;
+
+const content = Buffer.alloc(FILE_SIZE);
+for (let i = 0; i < FILE_SIZE; i += 4096) {
+  content.writeUInt32LE(i >>> 12, i);
+}
+
+let readCalls = 0;
+
+const operations: FuseOperationHandlers = {
+  lookup: async (_parent, name) => {
+    if (name !== FILE_NAME) {
+      throw new FuseErrno('ENOENT');
+    }
+    return {
+      ino: FILE_INO,
+      generation: 0n,
+      entry_timeout: 60,
+      attr_timeout: 60,
+      attr: StatUtils.createFile(FILE_INO, BigInt(FILE_SIZE)),
+    };
+  },
+  getattr: async (ino) => ({
+    attr:
+      ino === 1n
+        ? StatUtils.createDirectory(ino)
+        : StatUtils.createFile(ino, BigInt(FILE_SIZE)),
+    timeout: 60,
+  }),
+  // keep_cache: sonst verwirft der Kernel den Page Cache bei jedem open
+  open: async () => ({ fh: createFd(1n), flags: createFlags(0), keep_cache: true }),
+  release: async () => undefined,
+  read: async (_ino, _ctx, { offset, size }) => {
+    readCalls++;
+    await sleep(LATENCY_MS);
+    const start = Number(offset);
+    return content.subarray(start, Math.min(FILE_SIZE, start + size));
+  },
+};
+
+const bench = await mountBench('prefetch', operations);
+const path = `${bench.mountPoint}/${FILE_NAME}`;
+
+async function dropPageCache(): Promise<void> {
+  await bench.session.notifyInvalInode(FILE_INO, 0n, -1n);
+}
+
+async function prefetch(): Promise<void> {
+  for (let off = 0; off < FILE_SIZE; off += STORE_CHUNK) {
+    await bench.session.notifyStore(
+      FILE_INO,
+      BigInt(off),
+      content.subarray(off, Math.min(FILE_SIZE, off + STORE_CHUNK))
+    );
+  }
+}
+
+async function sequentialRead(): Promise<void> {
+  const handle = await fs.open(path, 'r');
+  try {
+    const buf = Buffer.allocUnsafe(128 * 1024);
+    let pos = 0;
+    for (;;) {
+      const { bytesRead } = await handle.read(buf, 0, buf.length, pos);
+      if (bytesRead === 0) break;
+      pos += bytesRead;
+    }
+  } finally {
+    await handle.close();
+  }
+}
+
+try {
+  // lookup einmal auslösen, damit der Kernel das Inode kennt
+  await fs.stat(path);
+  console.log(
+    `sequential read of ${SIZE_MIB} MiB, ${LATENCY_MS} ms backend latency, ${ITERATIONS} iterations`
+  );
+
+  readCalls = 0;
+  const cold = await timeIt(ITERATIONS, async () => {
+    await dropPageCache();
+    await sequentialRead();
+  });
+  report('cold', cold);
+  console.log(`  read requests per run: ${(readCalls / ITERATIONS).toFixed(0)}`);
+
+  const storeSamples: number[] = [];
+  readCalls = 0;
+  const warm: number[] = [];
+  for (let i = 0; i < ITERATIONS; i++) {
+    await dropPageCache();
+    storeSamples.push(...(await timeIt(1, prefetch)));
+    warm.push(...(await timeIt(1, sequentialRead)));
+  }
+  report('notify_store (prefetch)', storeSamples);
+  report('prefetched', warm);
+  console.log(`  read requests per run: ${(readCalls / ITERATIONS).toFixed(0)}`);
+} finally {
+  await bench.close();
+}
@@ -0,0 +1,111 @@
+/**
+ * @file write-behind.ts
+ * @brief Small sequential appends to a slow-backed file: synchronous vs write-behind
+ *
+ * The write handler sleeps per call to mimic a remote API. Without
+ * write-behind every append waits for it; with write-behind appends are
+ * acknowledged once buffered and the handler receives merged extents.
+ *
+ * Usage: node --loader ts-node/esm bench/write-behind.ts [appends] [appendBytes] [latencyMs] [iterations]
+ */
+
+import fs from 'node:fs/promises';
+import { setTimeout as sleep } from 'node:timers/promises';
+
+import {
+  StatUtils,
+  createFd,
+  createFlags,
+  createIno,
+  FuseErrno,
+  type FuseOperationHandlers,
+} from '../ts/index.ts';
+import { mountBench, report, timeIt } from './bench-utils.ts';
+
+const APPENDS = Number(process.argv[2] ?? 2000);
+const APPEND_BYTES = Number(process.argv[3] ?? 256);
+const LATENCY_MS = Number(process.argv[4] ?? 2);
+const ITERATIONS = Number(process.argv[5] ?? 3);
+
+const FILE_NAME = 'journal';
+const FILE_INO = createIno(2n);
+
+let fileSize = 0n;
+let writeCalls = 0;
+
+const operations: FuseOperationHandlers = {
+  lookup: async (_parent, name) => {
+    if (name !== FILE_NAME) {
+      throw new FuseErrno('ENOENT');
+    }
+    return {
+      ino: FILE_INO,
+      generation: 0n,
+      entry_timeout: 60,
+      attr_timeout: 1,
+      attr: StatUtils.createFile(FILE_INO, fileSize),
+    };
+  },
+  getattr: async (ino) => ({
+    attr:
+      ino === 1n
+        ? StatUtils.createDirectory(ino)
+        : StatUtils.createFile(ino, fileSize),
+    timeout: 1,
+  }),
+  open: async () => ({ fh: createFd(1n), flags: createFlags(0) }),
+  flush: async () => 0,
+  fsync: async () => undefined,
+  release: async () => undefined,
+  write: async (_ino, data, _ctx, { offset }) => {
+    writeCalls++;
+    await sleep(LATENCY_MS);
+    const end = offset + BigInt(data.byteLength);
+    if (end > fileSize) {
+      fileSize = end;
+    }
+    return data.byteLength;
+  },
+};
+
+const bench = await mountBench('write-behind', operations);
+const path = `${bench.mountPoint}/${FILE_NAME}`;
+const chunk = Buffer.alloc(APPEND_BYTES, 0x61);
+
+async function appendAll(): Promise<void> {
+  const handle = await fs.open(path, 'r+');
+  try {
+    let pos = Number(fileSize);
+    for (let i = 0; i < APPENDS; i++) {
+      await handle.write(chunk, 0, chunk.length, pos);
+      pos += chunk.length;
+    }
+  } finally {
+    // close → flush wartet auf die Queue des Handles
+    await handle.close();
+  }
+}
+
+try {
+  console.log(
+    `${APPENDS} appends of ${APPEND_BYTES} bytes, ${LATENCY_MS} ms backend latency, ${ITERATIONS} iterations`
+  );
+
+  writeCalls = 0;
+  report('synchronous', await timeIt(ITERATIONS, appendAll));
+  console.log(`  write calls per run: ${(writeCalls / ITERATIONS).toFixed(0)}`);
+
+  await bench.fuse.configureWriteBehind({ enabled: true });
+  writeCalls = 0;
+  report('write-behind', await timeIt(ITERATIONS, appendAll));
+  console.log(`  write calls per run: ${(writeCalls / ITERATIONS).toFixed(0)}`);
+
+  const stats = await bench.fuse.getWriteBehindStats();
+  console.log(
+    `  acknowledged=${stats.acknowledgedWrites} throttled=${stats.throttledWrites} ` +
+      `peakDirty=${stats.peakDirtyBytes} avgFlushLatency=${stats.avgFlushLatencyMs.toFixed(2)}ms`
+  );
+} finally {
+  await bench.fuse.configureWriteBehind({ enabled: false });
+  await bench.close();
+}
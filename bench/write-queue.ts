@@ -0,0 +1,47 @@
+/**
+ * @file write-queue.ts
+ * @brief Enqueue/process/flush throughput of the per-FD write queues
+ *
+ * Spreads small writes over many descriptors, drains them with a trivial
+ * executor and waits for every completion callback. No mount is needed; the
+ * numbers are pure queue and callback overhead.
+ *
+ * Usage: node --loader ts-node/esm bench/write-queue.ts [writes] [fds] [iterations]
+ */
+
+import { loadBinding, report, timeIt } from './bench-utils.ts';
+
+const WRITES = Number(process.argv[2] ?? 100_000);
+const FDS = Number(process.argv[3] ?? 4096);
+const ITERATIONS = Number(process.argv[4] ?? 5);
+
+const binding = loadBinding();
+const payload = new ArrayBuffer(64);
+const size = BigInt(payload.byteLength);
+
+async function round(): Promise<void> {
+  let outstanding = WRITES;
+  let resolveDone!: () => void;
+  const done = new Promise<void>((resolve) => {
+    resolveDone = resolve;
+  });
+  const onComplete = () => {
+    if (--outstanding === 0) {
+      resolveDone();
+    }
+  };
+
+  for (let i = 0; i < WRITES; i++) {
+    const fd = BigInt(1000 + (i % FDS));
+    binding.enqueueWrite(fd, BigInt(i) * size, size, payload, 2, onComplete);
+  }
+  binding.processWriteQueues((op: { size: bigint }) => Number(op.size));
+  binding.flushAllWriteQueues(1000);
+  await done;
+}
+
+console.log(`${WRITES} writes over ${FDS} descriptors, ${ITERATIONS} iterations`);
+const samples = await timeIt(ITERATIONS, round);
+report('enqueue + process + callbacks', samples);
+const best = Math.min(...samples);
+console.log(`  ${((WRITES / best) * 1000).toFixed(0)} writes/s (best run)`);
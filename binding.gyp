@@ -10,8 +10,22 @@
         "src/timespec_codec.cc",
         "src/logging.cc",
         "src/fuse_bridge.cc",
+        "src/dirent_packer.cc",
+        "src/dir_snapshot_cache.cc",
+        "src/attr_cache.cc",
+        "src/dentry_cache.cc",
+        "src/notify_bridge.cc",
+        "src/inode_table.cc",
+        "src/passthrough.cc",
+        "src/native_io.cc",
+        "src/xattr_fd_cache.cc",
+        "src/xattr_cache.cc",
         "src/session_manager.cc",
+        "src/session_handoff.cc",
         "src/buffer_bridge.cc",
+        "src/buffer_pool.cc",
+        "src/file_mapping.cc",
+        "src/content_hash.cc",
         "src/copy_file_range.cc",
         "src/tsfn_dispatcher.cc",
         "src/write_queue.cc",
@@ -1,5 +1,6 @@
 #include "logging.h"
 
+#include <cinttypes>
 #include <cstdlib>
 
 int main() {
@@ -16,6 +17,11 @@ int main() {
   FUSE_LOG_INFO("sample info");
   FUSE_LOG_DEBUG("sample debug %s", "details");
   FUSE_LOG_TRACE("sample trace value=%d", 42);
+  // Integers only; formatted by the writer thread
+  FUSE_LOG_RECORD(FUSE_LOG_LEVEL_DEBUG, "sample record ino=%" PRIu64 " size=%" PRIu64, 1, 4096);
+
+  // Lines are written by a background thread; flush before exiting early
+  fuse_native::log::flush();
 #else
   (void)0;  // logging disabled at compile time
 #endif
@@ -0,0 +1,275 @@
+/**
+ * @file attr_cache.cc
+ * @brief Native per-inode attribute cache answering getattr without JS
+ */
+
+#include "attr_cache.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "logging.h"
+#include "napi_helpers.h"
+
+namespace fuse_native {
+
+AttrCache& AttrCache::Instance() {
+    static AttrCache instance;
+    return instance;
+}
+
+void AttrCache::Configure(double ttl_seconds, size_t max_entries) {
+    const bool enable = ttl_seconds > 0.0;
+    ttl_ns_.store(static_cast<int64_t>(ttl_seconds * 1e9), std::memory_order_relaxed);
+    max_entries_.store(max_entries, std::memory_order_relaxed);
+    shard_capacity_.store(max_entries == 0 ? 0 : (max_entries + kShardCount - 1) / kShardCount,
+                          std::memory_order_relaxed);
+    enabled_.store(enable, std::memory_order_release);
+    if (!enable) {
+        Clear();
+    }
+    FUSE_LOG_DEBUG("attr cache: ttl=%.3fs max_entries=%zu", ttl_seconds, max_entries);
+}
+
+bool AttrCache::Lookup(fuse_ino_t ino, struct stat* attr, double* attr_timeout) {
+    if (!Enabled()) {
+        return false;
+    }
+
+    Shard& shard = ShardFor(ino);
+    const Clock::time_point now = Clock::now();
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.entries.find(ino);
+        if (it != shard.entries.end()) {
+            if (it->second.expires > now) {
+                const double remaining =
+                    std::chrono::duration<double>(it->second.expires - now).count();
+                *attr = it->second.attr;
+                *attr_timeout = std::min(it->second.attr_timeout, remaining);
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+            shard.entries.erase(it);
+            expirations_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool AttrCache::Peek(fuse_ino_t ino, struct stat* attr, double* attr_timeout) const {
+    if (!Enabled()) {
+        return false;
+    }
+
+    const Shard& shard = ShardFor(ino);
+    const Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.entries.find(ino);
+    if (it == shard.entries.end() || it->second.expires <= now) {
+        return false;
+    }
+    *attr = it->second.attr;
+    *attr_timeout = std::min(it->second.attr_timeout,
+                             std::chrono::duration<double>(it->second.expires - now).count());
+    return true;
+}
+
+void AttrCache::Store(fuse_ino_t ino, const struct stat& attr, double attr_timeout, uint64_t epoch) {
+    if (ino == 0 || !Enabled()) {
+        return;
+    }
+
+    const Clock::time_point now = Clock::now();
+    const Clock::time_point expires =
+        now + std::chrono::nanoseconds(ttl_ns_.load(std::memory_order_relaxed));
+    const size_t capacity = shard_capacity_.load(std::memory_order_relaxed);
+
+    Shard& shard = ShardFor(ino);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    // Seit dem Dispatch invalidiert: Antwort kann älter sein als die Änderung
+    if (shard.invalidated[StripeFor(ino)] > epoch) {
+        return;
+    }
+    auto it = shard.entries.find(ino);
+    if (it == shard.entries.end() && capacity != 0 && shard.entries.size() >= capacity) {
+        // Erst abgelaufene Einträge verwerfen, dann notfalls einen beliebigen
+        for (auto cur = shard.entries.begin(); cur != shard.entries.end();) {
+            if (cur->second.expires <= now) {
+                cur = shard.entries.erase(cur);
+                expirations_.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                ++cur;
+            }
+        }
+        if (shard.entries.size() >= capacity) {
+            shard.entries.erase(shard.entries.begin());
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    Entry& entry = shard.entries[ino];
+    entry.attr = attr;
+    entry.attr.st_ino = static_cast<ino_t>(ino);
+    entry.attr_timeout = attr_timeout;
+    entry.expires = expires;
+    inserts_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool AttrCache::Invalidate(fuse_ino_t ino) {
+    Shard& shard = ShardFor(ino);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.invalidated[StripeFor(ino)] = sequence_.fetch_add(1, std::memory_order_acq_rel) + 1;
+    if (shard.entries.erase(ino) == 0) {
+        return false;
+    }
+    invalidations_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void AttrCache::Clear() {
+    for (Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.invalidated.fill(sequence_.fetch_add(1, std::memory_order_acq_rel) + 1);
+        shard.entries.clear();
+    }
+}
+
+AttrCacheStats AttrCache::GetStats() const {
+    AttrCacheStats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.inserts = inserts_.load(std::memory_order_relaxed);
+    stats.invalidations = invalidations_.load(std::memory_order_relaxed);
+    stats.expirations = expirations_.load(std::memory_order_relaxed);
+    stats.evictions = evictions_.load(std::memory_order_relaxed);
+    stats.max_entries = max_entries_.load(std::memory_order_relaxed);
+    stats.ttl = static_cast<double>(ttl_ns_.load(std::memory_order_relaxed)) / 1e9;
+    for (const Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        stats.entries += shard.entries.size();
+    }
+    return stats;
+}
+
+void AttrCache::ResetStats() {
+    hits_.store(0, std::memory_order_relaxed);
+    misses_.store(0, std::memory_order_relaxed);
+    inserts_.store(0, std::memory_order_relaxed);
+    invalidations_.store(0, std::memory_order_relaxed);
+    expirations_.store(0, std::memory_order_relaxed);
+    evictions_.store(0, std::memory_order_relaxed);
+}
+
+Napi::Value ConfigureAttrCache(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        NapiHelpers::ThrowTypeError(env, "Expected configuration object");
+        return env.Undefined();
+    }
+
+    Napi::Object config = info[0].As<Napi::Object>();
+    Napi::Value ttl = config.Get("ttl");
+    if (!ttl.IsNumber() || !std::isfinite(ttl.As<Napi::Number>().DoubleValue()) ||
+        ttl.As<Napi::Number>().DoubleValue() < 0.0) {
+        NapiHelpers::ThrowTypeError(env, "ttl must be a non-negative number of seconds");
+        return env.Undefined();
+    }
+
+    size_t max_entries = 0;
+    Napi::Value max_value = config.Get("maxEntries");
+    if (!max_value.IsUndefined()) {
+        if (!max_value.IsNumber() || max_value.As<Napi::Number>().DoubleValue() < 0) {
+            NapiHelpers::ThrowTypeError(env, "maxEntries must be a non-negative number");
+            return env.Undefined();
+        }
+        max_entries = static_cast<size_t>(max_value.As<Napi::Number>().Int64Value());
+    }
+
+    AttrCache::Instance().Configure(ttl.As<Napi::Number>().DoubleValue(), max_entries);
+    return Napi::Boolean::New(env, true);
+}
+
+Napi::Value UpdateAttrCache(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 2 || !info[0].IsBigInt() || !info[1].IsObject()) {
+        NapiHelpers::ThrowTypeError(env, "Expected (ino: bigint, attr: object, timeout?: number)");
+        return env.Undefined();
+    }
+
+    const uint64_t ino = NapiHelpers::GetBigUint64(env, info[0]);
+    if (env.IsExceptionPending()) {
+        return env.Undefined();
+    }
+
+    struct stat attr{};
+    if (!NapiHelpers::ObjectToStat(info[1].As<Napi::Object>(), &attr)) {
+        NapiHelpers::ThrowTypeError(env, "Invalid attr object");
+        return env.Undefined();
+    }
+
+    double timeout = 1.0;
+    if (info.Length() > 2 && !info[2].IsUndefined()) {
+        if (!info[2].IsNumber() || !std::isfinite(info[2].As<Napi::Number>().DoubleValue()) ||
+            info[2].As<Napi::Number>().DoubleValue() < 0.0) {
+            NapiHelpers::ThrowTypeError(env, "timeout must be a non-negative number");
+            return env.Undefined();
+        }
+        timeout = info[2].As<Napi::Number>().DoubleValue();
+    }
+
+    AttrCache& cache = AttrCache::Instance();
+    if (ino == 0 || !cache.Enabled()) {
+        return Napi::Boolean::New(env, false);
+    }
+    cache.Store(static_cast<fuse_ino_t>(ino), attr, timeout, cache.Epoch());
+    return Napi::Boolean::New(env, true);
+}
+
+Napi::Value InvalidateAttrCache(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsBigInt()) {
+        NapiHelpers::ThrowTypeError(env, "Expected ino as bigint");
+        return env.Undefined();
+    }
+
+    const uint64_t ino = NapiHelpers::GetBigUint64(env, info[0]);
+    if (env.IsExceptionPending()) {
+        return env.Undefined();
+    }
+    return Napi::Boolean::New(env, AttrCache::Instance().Invalidate(static_cast<fuse_ino_t>(ino)));
+}
+
+Napi::Value GetAttrCacheStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    const AttrCacheStats stats = AttrCache::Instance().GetStats();
+    const uint64_t lookups = stats.hits + stats.misses;
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("hits", NapiHelpers::CreateBigUint64(env, stats.hits));
+    result.Set("misses", NapiHelpers::CreateBigUint64(env, stats.misses));
+    result.Set("inserts", NapiHelpers::CreateBigUint64(env, stats.inserts));
+    result.Set("invalidations", NapiHelpers::CreateBigUint64(env, stats.invalidations));
+    result.Set("expirations", NapiHelpers::CreateBigUint64(env, stats.expirations));
+    result.Set("evictions", NapiHelpers::CreateBigUint64(env, stats.evictions));
+    result.Set("hitRate", Napi::Number::New(
+        env, lookups == 0 ? 0.0 : static_cast<double>(stats.hits) / static_cast<double>(lookups)));
+    result.Set("entries", Napi::Number::New(env, static_cast<double>(stats.entries)));
+    result.Set("maxEntries", Napi::Number::New(env, static_cast<double>(stats.max_entries)));
+    result.Set("ttl", Napi::Number::New(env, stats.ttl));
+    result.Set("shards", Napi::Number::New(env, static_cast<double>(AttrCache::kShardCount)));
+    return result;
+}
+
+Napi::Value ClearAttrCache(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    AttrCache::Instance().Clear();
+    AttrCache::Instance().ResetStats();
+    return Napi::Boolean::New(env, true);
+}
+
+} // namespace fuse_native
@@ -0,0 +1,195 @@
+/**
+ * @file attr_cache.h
+ * @brief Native per-inode attribute cache answering getattr without JS
+ *
+ * Kernel attribute timeouts are kept short for coherency, so hot inodes see a
+ * steady stream of getattr requests. The bridge records every attribute it
+ * replies with (getattr, setattr, lookup, create, readdirplus) and answers
+ * getattr from this cache while the entry is younger than the cache TTL,
+ * which is configured independently of the kernel `attr_timeout`. Mutating
+ * requests drop the affected inodes once they are answered.
+ *
+ * A reply that raced an invalidation must not refill the cache: requests
+ * capture Epoch() at dispatch, every invalidation stamps the inode with a
+ * newer sequence number, and Store() drops attributes older than the stamp.
+ * Stamps are kept per inode stripe, so unrelated inodes rarely collide.
+ *
+ * The table is split into shards with their own lock so multi-threaded
+ * session loops do not serialize on a single mutex.
+ */
+
+#ifndef ATTR_CACHE_H
+#define ATTR_CACHE_H
+
+#include <napi.h>
+#include <fuse3/fuse_lowlevel.h>
+#include <sys/stat.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+namespace fuse_native {
+
+/**
+ * Attribute cache statistics
+ */
+struct AttrCacheStats {
+    uint64_t hits = 0;           ///< getattr answered natively
+    uint64_t misses = 0;         ///< getattr forwarded to JS
+    uint64_t inserts = 0;        ///< Attributes stored (new or refreshed)
+    uint64_t invalidations = 0;  ///< Entries dropped by mutations or the JS API
+    uint64_t expirations = 0;    ///< Entries found past their TTL
+    uint64_t evictions = 0;      ///< Entries dropped to honour the capacity
+    size_t entries = 0;
+    size_t max_entries = 0;
+    double ttl = 0.0;            ///< Seconds
+};
+
+/**
+ * Sharded inode -> struct stat cache.
+ */
+class AttrCache {
+public:
+    static constexpr size_t kShardCount = 16;
+
+    static AttrCache& Instance();
+
+    /**
+     * @brief Configure TTL and capacity
+     * @param ttl_seconds Lifetime of an entry; 0 disables the cache and drops all entries
+     * @param max_entries Capacity across all shards (0 = unbounded)
+     */
+    void Configure(double ttl_seconds, size_t max_entries);
+
+    bool Enabled() const { return enabled_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Look up fresh attributes for an inode
+     * @param ino Inode number
+     * @param attr Receives the cached attributes
+     * @param attr_timeout Receives the kernel timeout to reply with (clamped to the remaining TTL)
+     * @return true on a hit
+     */
+    bool Lookup(fuse_ino_t ino, struct stat* attr, double* attr_timeout);
+
+    /**
+     * @brief Like Lookup(), but without counting a hit or miss
+     *
+     * Used to refresh attributes carried by other cached replies.
+     */
+    bool Peek(fuse_ino_t ino, struct stat* attr, double* attr_timeout) const;
+
+    /**
+     * @brief Current invalidation sequence
+     *
+     * Capture before dispatching a request whose reply carries attributes
+     * and pass to Store().
+     */
+    uint64_t Epoch() const { return sequence_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Store or refresh the attributes of an inode
+     * @param ino Inode number (0 is ignored)
+     * @param attr Attributes as replied to the kernel
+     * @param attr_timeout Kernel attribute timeout of the reply
+     * @param epoch Epoch captured at dispatch; attributes of an inode invalidated since are dropped
+     */
+    void Store(fuse_ino_t ino, const struct stat& attr, double attr_timeout, uint64_t epoch);
+
+    /**
+     * @brief Drop the attributes of an inode and stamp it against in-flight replies
+     * @return true if an entry was removed
+     */
+    bool Invalidate(fuse_ino_t ino);
+
+    void Clear();
+
+    AttrCacheStats GetStats() const;
+
+    void ResetStats();
+
+private:
+    AttrCache() = default;
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        struct stat attr;
+        double attr_timeout;
+        Clock::time_point expires;
+    };
+
+    static constexpr size_t kEpochStripes = 256;  ///< Per shard
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<fuse_ino_t, Entry> entries;
+        std::array<uint64_t, kEpochStripes> invalidated{};  ///< Sequence of the last invalidation per stripe
+    };
+
+    Shard& ShardFor(fuse_ino_t ino) { return shards_[ino % kShardCount]; }
+    const Shard& ShardFor(fuse_ino_t ino) const { return shards_[ino % kShardCount]; }
+    static size_t StripeFor(fuse_ino_t ino) { return (ino / kShardCount) % kEpochStripes; }
+
+    std::array<Shard, kShardCount> shards_;
+    std::atomic<uint64_t> sequence_{0};
+    std::atomic<bool> enabled_{false};
+    std::atomic<int64_t> ttl_ns_{0};
+    std::atomic<size_t> shard_capacity_{0};
+    std::atomic<size_t> max_entries_{0};
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> inserts_{0};
+    std::atomic<uint64_t> invalidations_{0};
+    std::atomic<uint64_t> expirations_{0};
+    std::atomic<uint64_t> evictions_{0};
+};
+
+/**
+ * N-API exposed functions
+ */
+
+/**
+ * Configure the attribute cache (N-API exposed function)
+ * @param info N-API callback info containing `{ttl, maxEntries?}`
+ * @return Boolean indicating success
+ */
+Napi::Value ConfigureAttrCache(const Napi::CallbackInfo& info);
+
+/**
+ * Store attributes for an inode (N-API exposed function)
+ * @param info N-API callback info containing ino (bigint), attr object, timeout? (seconds)
+ * @return Boolean indicating whether the entry was stored
+ */
+Napi::Value UpdateAttrCache(const Napi::CallbackInfo& info);
+
+/**
+ * Drop cached attributes for an inode (N-API exposed function)
+ * @param info N-API callback info containing ino (bigint)
+ * @return Boolean indicating whether an entry was removed
+ */
+Napi::Value InvalidateAttrCache(const Napi::CallbackInfo& info);
+
+/**
+ * Get attribute cache statistics (N-API exposed function)
+ * @param info N-API callback info
+ * @return Object containing statistics
+ */
+Napi::Value GetAttrCacheStats(const Napi::CallbackInfo& info);
+
+/**
+ * Drop all cached attributes and reset statistics (N-API exposed function)
+ * @param info N-API callback info
+ * @return Boolean indicating success
+ */
+Napi::Value ClearAttrCache(const Napi::CallbackInfo& info);
+
+} // namespace fuse_native
+
+#endif // ATTR_CACHE_H
@@ -7,6 +7,7 @@
  */
 
 #include "buffer_bridge.h"
+#include "buffer_pool.h"
 #include "errno_mapping.h"
 #include "napi_helpers.h"
 #include <cstring>
@@ -69,26 +70,8 @@ Napi::ArrayBuffer BufferBridge::CreateManagedBuffer(Napi::Env env, size_t length
         return Napi::ArrayBuffer::New(env, 0);
     }
     
-    try {
-        // Allocate aligned memory for better performance
-        void* data = aligned_alloc(4096, (length + 4095) & ~4095);
-        if (!data) {
-            Napi::Error::New(env, "Failed to allocate aligned memory").ThrowAsJavaScriptException();
-            return Napi::ArrayBuffer();
-        }
-        
-        // Create external buffer with free() as finalizer
-        auto finalizer = [](void* data, void* hint) {
-            (void)hint;
-            free(data);
-        };
-        
-        return CreateExternalBuffer(env, data, length, finalizer, nullptr);
-    } catch (const std::exception& e) {
-        Napi::Error::New(env, std::string("Failed to create managed buffer: ") + e.what())
-            .ThrowAsJavaScriptException();
-        return Napi::ArrayBuffer();
-    }
+    // Größenklassen-Pool statt aligned_alloc/free pro Puffer
+    return BufferPool::Instance().CreateBuffer(env, length);
 }
 
 BufferView BufferBridge::CreateBufferView(void* data, size_t length, size_t offset, size_t size) {
@@ -78,7 +78,9 @@ public:
      * @param length - Size of the buffer to allocate
      * @return ArrayBuffer with automatically managed memory
      * 
-     * @note This allocates aligned memory and sets up automatic cleanup
+     * @note The memory is a page-aligned block from the size-classed BufferPool
+     *       and returns to the pool when the buffer is garbage collected; its
+     *       contents are not zeroed
      */
     static Napi::ArrayBuffer CreateManagedBuffer(Napi::Env env, size_t length);
 
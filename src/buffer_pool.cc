@@ -0,0 +1,335 @@
+/**
+ * @file buffer_pool.cc
+ * @brief Size-classed slab pools backing managed ArrayBuffers
+ */
+
+#include "buffer_pool.h"
+
+#include <sys/mman.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+#include "logging.h"
+#include "napi_helpers.h"
+
+namespace FuseNative {
+
+namespace {
+
+constexpr size_t kPageSize = 4096;
+
+size_t RoundUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+BufferPool& BufferPool::Instance() {
+    // Bewusst nie zerstört: Finalizer können noch beim Env-Teardown nach den
+    // statischen Destruktoren laufen
+    static BufferPool* instance = new BufferPool();
+    return *instance;
+}
+
+void BufferPool::Configure(bool enabled, size_t max_cached_bytes, bool huge_pages) {
+    enabled_.store(enabled, std::memory_order_release);
+    max_cached_bytes_.store(max_cached_bytes, std::memory_order_release);
+    huge_pages_.store(huge_pages, std::memory_order_release);
+    // Gecachte Blöcke können mit anderer Huge-Page-Einstellung gemappt sein
+    const size_t freed = Trim();
+    FUSE_LOG_DEBUG("buffer pool: enabled=%d maxCachedBytes=%zu hugePages=%d (trimmed %zu bytes)",
+                   enabled ? 1 : 0, max_cached_bytes, huge_pages ? 1 : 0, freed);
+}
+
+Napi::ArrayBuffer BufferPool::CreateBuffer(Napi::Env env, size_t length) {
+    size_t index = 0;
+    while (index < kClassCount && kClassSizes[index] < length) {
+        index++;
+    }
+
+    void* block = nullptr;
+    size_t block_size = 0;
+    void* hint = nullptr;
+    if (index < kClassCount) {
+        block = Acquire(index);
+        block_size = kClassSizes[index];
+        hint = reinterpret_cast<void*>(static_cast<uintptr_t>(index));
+    } else {
+        // Übergröße: eigenes Mapping, der Hint trägt die Blockgröße
+        block_size = RoundUp(length, kPageSize);
+        block = AllocateBlock(block_size);
+        hint = reinterpret_cast<void*>(static_cast<uintptr_t>(block_size));
+        oversize_allocations_.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (!block) {
+        Napi::Error::New(env, "Failed to allocate pooled buffer").ThrowAsJavaScriptException();
+        return Napi::ArrayBuffer();
+    }
+
+    napi_value value = nullptr;
+    const napi_status status = napi_create_external_arraybuffer(env, block, length, Finalize, hint, &value);
+    if (status != napi_ok) {
+        if (index < kClassCount) {
+            Release(index, block);
+        } else {
+            FreeBlock(block, block_size);
+        }
+        Napi::Error::New(env, "Failed to create external ArrayBuffer").ThrowAsJavaScriptException();
+        return Napi::ArrayBuffer();
+    }
+
+    TrackOutstanding(block_size);
+    return Napi::ArrayBuffer(env, value);
+}
+
+void BufferPool::Finalize(napi_env env, void* data, void* hint) {
+    (void)env;
+    BufferPool& pool = Instance();
+    const size_t tag = static_cast<size_t>(reinterpret_cast<uintptr_t>(hint));
+    const size_t block_size = tag < kClassCount ? kClassSizes[tag] : tag;
+
+    pool.outstanding_bytes_.fetch_sub(block_size, std::memory_order_relaxed);
+    pool.outstanding_buffers_.fetch_sub(1, std::memory_order_relaxed);
+    if (tag < kClassCount) {
+        pool.Release(tag, data);
+    } else {
+        pool.FreeBlock(data, block_size);
+    }
+}
+
+void* BufferPool::Acquire(size_t index) {
+    SizeClass& size_class = classes_[index];
+    const size_t size = kClassSizes[index];
+    {
+        std::lock_guard<std::mutex> lock(size_class.mutex);
+        if (!size_class.free.empty()) {
+            void* block = size_class.free.back();
+            size_class.free.pop_back();
+            cached_bytes_.fetch_sub(size, std::memory_order_relaxed);
+            size_class.hits.fetch_add(1, std::memory_order_relaxed);
+            size_class.outstanding.fetch_add(1, std::memory_order_relaxed);
+            return block;
+        }
+    }
+
+    void* block = AllocateBlock(size);
+    if (block) {
+        size_class.misses.fetch_add(1, std::memory_order_relaxed);
+        size_class.outstanding.fetch_add(1, std::memory_order_relaxed);
+    }
+    return block;
+}
+
+void BufferPool::Release(size_t index, void* block) {
+    SizeClass& size_class = classes_[index];
+    const size_t size = kClassSizes[index];
+    size_class.outstanding.fetch_sub(1, std::memory_order_relaxed);
+
+    if (enabled_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(size_class.mutex);
+        if (cached_bytes_.load(std::memory_order_relaxed) + size <= max_cached_bytes_.load(std::memory_order_relaxed)) {
+            size_class.free.push_back(block);
+            cached_bytes_.fetch_add(size, std::memory_order_relaxed);
+            size_class.releases.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    size_class.dropped.fetch_add(1, std::memory_order_relaxed);
+    FreeBlock(block, size);
+}
+
+void* BufferPool::AllocateBlock(size_t size) {
+    if (!IsMapped(size)) {
+        return aligned_alloc(kPageSize, size);
+    }
+
+    if (!huge_pages_.load(std::memory_order_acquire)) {
+        void* block = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        return block == MAP_FAILED ? nullptr : block;
+    }
+
+    // Auf 2 MiB ausrichten, damit THP die Blöcke vollständig abdecken kann
+    const size_t mapped = size + kHugePageSize;
+    void* raw = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        return nullptr;
+    }
+    const uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+    const uintptr_t aligned = RoundUp(start, kHugePageSize);
+    if (aligned > start) {
+        munmap(raw, aligned - start);
+    }
+    const size_t tail = (start + mapped) - (aligned + size);
+    if (tail > 0) {
+        munmap(reinterpret_cast<void*>(aligned + size), tail);
+    }
+    void* block = reinterpret_cast<void*>(aligned);
+#ifdef MADV_HUGEPAGE
+    if (madvise(block, size, MADV_HUGEPAGE) == 0) {
+        huge_page_allocations_.fetch_add(1, std::memory_order_relaxed);
+    }
+#endif
+    return block;
+}
+
+void BufferPool::FreeBlock(void* block, size_t size) {
+    if (IsMapped(size)) {
+        munmap(block, size);
+    } else {
+        free(block);
+    }
+}
+
+void BufferPool::TrackOutstanding(size_t size) {
+    outstanding_buffers_.fetch_add(1, std::memory_order_relaxed);
+    const size_t current = outstanding_bytes_.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t peak = peak_outstanding_bytes_.load(std::memory_order_relaxed);
+    while (current > peak &&
+           !peak_outstanding_bytes_.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+    }
+}
+
+size_t BufferPool::Trim() {
+    size_t freed = 0;
+    for (size_t index = 0; index < kClassCount; index++) {
+        std::vector<void*> blocks;
+        {
+            std::lock_guard<std::mutex> lock(classes_[index].mutex);
+            blocks.swap(classes_[index].free);
+        }
+        const size_t size = kClassSizes[index];
+        for (void* block : blocks) {
+            FreeBlock(block, size);
+        }
+        cached_bytes_.fetch_sub(blocks.size() * size, std::memory_order_relaxed);
+        freed += blocks.size() * size;
+    }
+    return freed;
+}
+
+BufferPoolStats BufferPool::GetStats() const {
+    BufferPoolStats stats;
+    for (size_t index = 0; index < kClassCount; index++) {
+        const SizeClass& size_class = classes_[index];
+        BufferPoolClassStats class_stats;
+        class_stats.block_size = kClassSizes[index];
+        {
+            std::lock_guard<std::mutex> lock(size_class.mutex);
+            class_stats.cached = size_class.free.size();
+        }
+        class_stats.outstanding = size_class.outstanding.load(std::memory_order_relaxed);
+        class_stats.hits = size_class.hits.load(std::memory_order_relaxed);
+        class_stats.misses = size_class.misses.load(std::memory_order_relaxed);
+        class_stats.releases = size_class.releases.load(std::memory_order_relaxed);
+        class_stats.dropped = size_class.dropped.load(std::memory_order_relaxed);
+        stats.classes.push_back(class_stats);
+    }
+    stats.cached_bytes = cached_bytes_.load(std::memory_order_relaxed);
+    stats.outstanding_bytes = outstanding_bytes_.load(std::memory_order_relaxed);
+    stats.outstanding_buffers = outstanding_buffers_.load(std::memory_order_relaxed);
+    stats.peak_outstanding_bytes = peak_outstanding_bytes_.load(std::memory_order_relaxed);
+    stats.huge_page_allocations = huge_page_allocations_.load(std::memory_order_relaxed);
+    stats.oversize_allocations = oversize_allocations_.load(std::memory_order_relaxed);
+    stats.max_cached_bytes = max_cached_bytes_.load(std::memory_order_relaxed);
+    stats.enabled = enabled_.load(std::memory_order_relaxed);
+    stats.huge_pages = huge_pages_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace FuseNative
+
+namespace fuse_native {
+
+Napi::Value ConfigureBufferPool(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        NapiHelpers::ThrowTypeError(env, "Expected configuration object");
+        return env.Undefined();
+    }
+
+    Napi::Object config = info[0].As<Napi::Object>();
+    auto read_flag = [&config](const char* key, bool fallback, bool* out) {
+        Napi::Value value = config.Get(key);
+        if (value.IsUndefined()) {
+            *out = fallback;
+            return true;
+        }
+        if (!value.IsBoolean()) {
+            return false;
+        }
+        *out = value.As<Napi::Boolean>().Value();
+        return true;
+    };
+
+    bool enabled = true;
+    bool huge_pages = false;
+    if (!read_flag("enabled", true, &enabled) || !read_flag("hugePages", false, &huge_pages)) {
+        NapiHelpers::ThrowTypeError(env, "enabled and hugePages must be booleans");
+        return env.Undefined();
+    }
+
+    size_t max_cached_bytes = FuseNative::BufferPool::kDefaultMaxCachedBytes;
+    Napi::Value max_value = config.Get("maxCachedBytes");
+    if (!max_value.IsUndefined()) {
+        const double max = max_value.IsNumber() ? max_value.As<Napi::Number>().DoubleValue() : -1.0;
+        if (!std::isfinite(max) || max < 0) {
+            NapiHelpers::ThrowTypeError(env, "maxCachedBytes must be a non-negative number");
+            return env.Undefined();
+        }
+        max_cached_bytes = static_cast<size_t>(max);
+    }
+
+    FuseNative::BufferPool::Instance().Configure(enabled, max_cached_bytes, huge_pages);
+    return Napi::Boolean::New(env, true);
+}
+
+Napi::Value GetBufferPoolStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    const FuseNative::BufferPoolStats stats = FuseNative::BufferPool::Instance().GetStats();
+
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    Napi::Array classes = Napi::Array::New(env, stats.classes.size());
+    for (size_t i = 0; i < stats.classes.size(); i++) {
+        const FuseNative::BufferPoolClassStats& class_stats = stats.classes[i];
+        hits += class_stats.hits;
+        misses += class_stats.misses;
+
+        Napi::Object entry = Napi::Object::New(env);
+        entry.Set("blockSize", Napi::Number::New(env, static_cast<double>(class_stats.block_size)));
+        entry.Set("cached", Napi::Number::New(env, static_cast<double>(class_stats.cached)));
+        entry.Set("outstanding", Napi::Number::New(env, static_cast<double>(class_stats.outstanding)));
+        entry.Set("hits", NapiHelpers::CreateBigUint64(env, class_stats.hits));
+        entry.Set("misses", NapiHelpers::CreateBigUint64(env, class_stats.misses));
+        entry.Set("releases", NapiHelpers::CreateBigUint64(env, class_stats.releases));
+        entry.Set("dropped", NapiHelpers::CreateBigUint64(env, class_stats.dropped));
+        classes.Set(static_cast<uint32_t>(i), entry);
+    }
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("enabled", Napi::Boolean::New(env, stats.enabled));
+    result.Set("hugePages", Napi::Boolean::New(env, stats.huge_pages));
+    result.Set("maxCachedBytes", Napi::Number::New(env, static_cast<double>(stats.max_cached_bytes)));
+    result.Set("cachedBytes", Napi::Number::New(env, static_cast<double>(stats.cached_bytes)));
+    result.Set("gcDeferredBytes", Napi::Number::New(env, static_cast<double>(stats.outstanding_bytes)));
+    result.Set("gcDeferredBuffers", Napi::Number::New(env, static_cast<double>(stats.outstanding_buffers)));
+    result.Set("peakGcDeferredBytes", Napi::Number::New(env, static_cast<double>(stats.peak_outstanding_bytes)));
+    result.Set("hugePageAllocations", NapiHelpers::CreateBigUint64(env, stats.huge_page_allocations));
+    result.Set("oversizeAllocations", NapiHelpers::CreateBigUint64(env, stats.oversize_allocations));
+    result.Set("hitRate", Napi::Number::New(
+        env, hits + misses == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(hits + misses)));
+    result.Set("classes", classes);
+    return result;
+}
+
+Napi::Value TrimBufferPool(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    const size_t freed = FuseNative::BufferPool::Instance().Trim();
+    return Napi::Number::New(env, static_cast<double>(freed));
+}
+
+} // namespace fuse_native
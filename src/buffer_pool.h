@@ -0,0 +1,163 @@
+/**
+ * @file buffer_pool.h
+ * @brief Size-classed slab pools backing managed ArrayBuffers
+ *
+ * Streaming workloads create and drop managed buffers at a high rate; with a
+ * fresh aligned_alloc per buffer and free() in the GC finalizer, every chunk
+ * costs a malloc/free pair and the resident set follows the GC schedule.
+ *
+ * The pool keeps freed blocks per size class (4K ... 4M) and hands them out
+ * again. Finalizers return blocks to their class instead of freeing them as
+ * long as the cached bytes stay below the configured cap. Requests above the
+ * largest class are mapped directly and unmapped in the finalizer.
+ *
+ * Blocks of classes from 2 MiB up are mmap'ed; with huge pages enabled they
+ * are aligned to 2 MiB and advised with MADV_HUGEPAGE.
+ *
+ * The finalizer hint carries the class index (or the block size for
+ * oversized blocks), so no per-buffer heap object is allocated.
+ */
+
+#ifndef FUSE_NATIVE_BUFFER_POOL_H
+#define FUSE_NATIVE_BUFFER_POOL_H
+
+#include <napi.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace FuseNative {
+
+/**
+ * Per size class statistics
+ */
+struct BufferPoolClassStats {
+    size_t block_size = 0;
+    size_t cached = 0;            ///< Free blocks held by the pool
+    size_t outstanding = 0;       ///< Blocks referenced by live ArrayBuffers
+    uint64_t hits = 0;            ///< Acquisitions served from the free list
+    uint64_t misses = 0;          ///< Acquisitions that allocated a new block
+    uint64_t releases = 0;        ///< Blocks returned to the free list
+    uint64_t dropped = 0;         ///< Blocks freed because the cap was reached
+};
+
+/**
+ * Buffer pool statistics
+ */
+struct BufferPoolStats {
+    std::vector<BufferPoolClassStats> classes;
+    size_t cached_bytes = 0;
+    size_t outstanding_bytes = 0;       ///< Handed to JS, waiting for GC finalization
+    size_t outstanding_buffers = 0;
+    size_t peak_outstanding_bytes = 0;
+    uint64_t huge_page_allocations = 0; ///< Blocks mapped with MADV_HUGEPAGE
+    uint64_t oversize_allocations = 0;  ///< Requests above the largest class
+    size_t max_cached_bytes = 0;
+    bool enabled = false;
+    bool huge_pages = false;
+};
+
+/**
+ * Size-classed block pool.
+ */
+class BufferPool {
+public:
+    static constexpr size_t kClassCount = 6;
+    static constexpr std::array<size_t, kClassCount> kClassSizes = {
+        4096, 16384, 65536, 262144, 1048576, 4194304,
+    };
+    static constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+    static constexpr size_t kDefaultMaxCachedBytes = 64 * 1024 * 1024;
+
+    static BufferPool& Instance();
+
+    /**
+     * @brief Configure the pool; drops all cached blocks
+     * @param enabled false frees every block on release
+     * @param max_cached_bytes Cap for free blocks across all classes
+     * @param huge_pages Advise blocks of >= 2 MiB with MADV_HUGEPAGE
+     */
+    void Configure(bool enabled, size_t max_cached_bytes, bool huge_pages);
+
+    /**
+     * @brief Create an ArrayBuffer of @p length bytes backed by a pooled block
+     *
+     * The contents are not zeroed. Throws a JS exception and returns an
+     * empty handle on failure.
+     */
+    Napi::ArrayBuffer CreateBuffer(Napi::Env env, size_t length);
+
+    /**
+     * @brief Free all cached blocks
+     * @return Number of freed bytes
+     */
+    size_t Trim();
+
+    BufferPoolStats GetStats() const;
+
+private:
+    BufferPool() = default;
+
+    struct SizeClass {
+        mutable std::mutex mutex;
+        std::vector<void*> free;
+        std::atomic<size_t> outstanding{0};
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+        std::atomic<uint64_t> releases{0};
+        std::atomic<uint64_t> dropped{0};
+    };
+
+    static bool IsMapped(size_t size) { return size >= kHugePageSize; }
+    static void Finalize(napi_env env, void* data, void* hint);
+
+    void* Acquire(size_t index);
+    void Release(size_t index, void* block);
+    void* AllocateBlock(size_t size);
+    void FreeBlock(void* block, size_t size);
+    void TrackOutstanding(size_t size);
+
+    std::array<SizeClass, kClassCount> classes_;
+    std::atomic<bool> enabled_{true};
+    std::atomic<bool> huge_pages_{false};
+    std::atomic<size_t> max_cached_bytes_{kDefaultMaxCachedBytes};
+    std::atomic<size_t> cached_bytes_{0};
+    std::atomic<size_t> outstanding_bytes_{0};
+    std::atomic<size_t> outstanding_buffers_{0};
+    std::atomic<size_t> peak_outstanding_bytes_{0};
+    std::atomic<uint64_t> huge_page_allocations_{0};
+    std::atomic<uint64_t> oversize_allocations_{0};
+};
+
+} // namespace FuseNative
+
+namespace fuse_native {
+
+/**
+ * Configure the buffer pool (N-API exposed function)
+ * @param info N-API callback info containing `{enabled?, maxCachedBytes?, hugePages?}`
+ * @return Boolean indicating success
+ */
+Napi::Value ConfigureBufferPool(const Napi::CallbackInfo& info);
+
+/**
+ * Get buffer pool statistics (N-API exposed function)
+ * @param info N-API callback info
+ * @return Object containing totals and per-class statistics
+ */
+Napi::Value GetBufferPoolStats(const Napi::CallbackInfo& info);
+
+/**
+ * Free all cached blocks (N-API exposed function)
+ * @param info N-API callback info
+ * @return Number of freed bytes
+ */
+Napi::Value TrimBufferPool(const Napi::CallbackInfo& info);
+
+} // namespace fuse_native
+
+#endif // FUSE_NATIVE_BUFFER_POOL_H
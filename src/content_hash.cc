@@ -0,0 +1,884 @@
+/**
+ * @file content_hash.cc
+ * @brief Native content hashing (CRC32C, XXH3-64, BLAKE3) for buffers and write payloads
+ */
+
+#include "content_hash.h"
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#include <nmmintrin.h>
+#define FUSE_NATIVE_HASH_X86 1
+#endif
+
+#if defined(__aarch64__) && defined(__linux__)
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#ifndef HWCAP_CRC32
+#define HWCAP_CRC32 (1 << 7)
+#endif
+#define FUSE_NATIVE_HASH_ARM 1
+#endif
+
+#include "napi_helpers.h"
+
+namespace FuseNative {
+
+namespace {
+
+// Alle Formate sind little-endian definiert
+inline uint32_t Read32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap32(value);
+#endif
+    return value;
+}
+
+inline uint64_t Read64(const uint8_t* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    return value;
+}
+
+inline void Write64(uint8_t* p, uint64_t value) {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    std::memcpy(p, &value, sizeof(value));
+}
+
+inline uint64_t Rotl64(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint32_t Rotr32(uint32_t value, int bits) {
+    return (value >> bits) | (value << (32 - bits));
+}
+
+// ---------------------------------------------------------------------------
+// CRC32C
+// ---------------------------------------------------------------------------
+
+constexpr uint32_t kCrc32cPoly = 0x82F63B78;  // Castagnoli, reflektiert
+
+struct Crc32cTables {
+    uint32_t table[8][256];
+
+    Crc32cTables() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc >> 1) ^ (kCrc32cPoly & (0u - (crc & 1)));
+            }
+            table[0][i] = crc;
+        }
+        for (uint32_t i = 0; i < 256; i++) {
+            for (int k = 1; k < 8; k++) {
+                table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xff];
+            }
+        }
+    }
+};
+
+uint32_t Crc32cSoftware(uint32_t crc, const uint8_t* p, size_t length) {
+    static const Crc32cTables tables;
+    const auto& t = tables.table;
+
+    // Slicing-by-8: acht Tabellenzugriffe pro 64-Bit-Wort
+    while (length >= 8) {
+        const uint64_t word = Read64(p) ^ crc;
+        crc = t[7][word & 0xff] ^ t[6][(word >> 8) & 0xff] ^ t[5][(word >> 16) & 0xff] ^
+              t[4][(word >> 24) & 0xff] ^ t[3][(word >> 32) & 0xff] ^ t[2][(word >> 40) & 0xff] ^
+              t[1][(word >> 48) & 0xff] ^ t[0][word >> 56];
+        p += 8;
+        length -= 8;
+    }
+    while (length--) {
+        crc = t[0][(crc ^ *p++) & 0xff] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+#if defined(FUSE_NATIVE_HASH_X86)
+__attribute__((target("sse4.2")))
+uint32_t Crc32cSse42(uint32_t crc, const uint8_t* p, size_t length) {
+    while (length > 0 && (reinterpret_cast<uintptr_t>(p) & 7) != 0) {
+        crc = _mm_crc32_u8(crc, *p++);
+        length--;
+    }
+    uint64_t crc64 = crc;
+    while (length >= 8) {
+        uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+        p += 8;
+        length -= 8;
+    }
+    crc = static_cast<uint32_t>(crc64);
+    while (length--) {
+        crc = _mm_crc32_u8(crc, *p++);
+    }
+    return crc;
+}
+#endif
+
+#if defined(FUSE_NATIVE_HASH_ARM)
+__attribute__((target("+crc")))
+uint32_t Crc32cArmv8(uint32_t crc, const uint8_t* p, size_t length) {
+    while (length > 0 && (reinterpret_cast<uintptr_t>(p) & 7) != 0) {
+        crc = __crc32cb(crc, *p++);
+        length--;
+    }
+    while (length >= 8) {
+        uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+        crc = __crc32cd(crc, word);
+        p += 8;
+        length -= 8;
+    }
+    while (length--) {
+        crc = __crc32cb(crc, *p++);
+    }
+    return crc;
+}
+#endif
+
+using Crc32cKernel = uint32_t (*)(uint32_t, const uint8_t*, size_t);
+
+struct Crc32cBackend {
+    Crc32cKernel kernel;
+    const char* name;
+};
+
+// Einmalige Auswahl zur Laufzeit; das Addon wird nicht mit -msse4.2 gebaut
+const Crc32cBackend& SelectCrc32c() {
+    static const Crc32cBackend backend = []() -> Crc32cBackend {
+#if defined(FUSE_NATIVE_HASH_X86)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("sse4.2")) {
+            return {Crc32cSse42, "sse4.2"};
+        }
+#endif
+#if defined(FUSE_NATIVE_HASH_ARM)
+        if ((getauxval(AT_HWCAP) & HWCAP_CRC32) != 0) {
+            return {Crc32cArmv8, "armv8-crc"};
+        }
+#endif
+        return {Crc32cSoftware, "slicing-by-8"};
+    }();
+    return backend;
+}
+
+// ---------------------------------------------------------------------------
+// XXH3-64
+// ---------------------------------------------------------------------------
+
+constexpr uint32_t kPrime32_1 = 0x9E3779B1U;
+constexpr uint32_t kPrime32_2 = 0x85EBCA77U;
+constexpr uint32_t kPrime32_3 = 0xC2B2AE3DU;
+constexpr uint64_t kPrime64_1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kPrime64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t kPrime64_3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t kPrime64_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t kPrime64_5 = 0x27D4EB2F165667C5ULL;
+constexpr uint64_t kPrimeMx1 = 0x165667919E3779F9ULL;
+constexpr uint64_t kPrimeMx2 = 0x9FB21C651E98DF25ULL;
+
+constexpr size_t kSecretSize = 192;
+constexpr size_t kStripeLen = 64;
+constexpr size_t kSecretConsumeRate = 8;
+constexpr size_t kStripesPerBlock = (kSecretSize - kStripeLen) / kSecretConsumeRate;
+constexpr size_t kBlockLen = kStripeLen * kStripesPerBlock;
+constexpr size_t kMidSizeMax = 240;
+
+alignas(64) constexpr uint8_t kSecret[kSecretSize] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+inline uint64_t Mul128Fold64(uint64_t lhs, uint64_t rhs) {
+    const __uint128_t product = static_cast<__uint128_t>(lhs) * rhs;
+    return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+}
+
+inline uint64_t Xxh64Avalanche(uint64_t h) {
+    h ^= h >> 33;
+    h *= kPrime64_2;
+    h ^= h >> 29;
+    h *= kPrime64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+inline uint64_t Xxh3Avalanche(uint64_t h) {
+    h ^= h >> 37;
+    h *= kPrimeMx1;
+    h ^= h >> 32;
+    return h;
+}
+
+inline uint64_t Rrmxmx(uint64_t h, uint64_t length) {
+    h ^= Rotl64(h, 49) ^ Rotl64(h, 24);
+    h *= kPrimeMx2;
+    h ^= (h >> 35) + length;
+    h *= kPrimeMx2;
+    return h ^ (h >> 28);
+}
+
+inline uint64_t Mix16B(const uint8_t* input, const uint8_t* secret, uint64_t seed) {
+    return Mul128Fold64(Read64(input) ^ (Read64(secret) + seed), Read64(input + 8) ^ (Read64(secret + 8) - seed));
+}
+
+uint64_t Xxh3Len1To3(const uint8_t* input, size_t length, uint64_t seed) {
+    const uint32_t c1 = input[0];
+    const uint32_t c2 = input[length >> 1];
+    const uint32_t c3 = input[length - 1];
+    const uint32_t combined = (c1 << 16) | (c2 << 24) | c3 | (static_cast<uint32_t>(length) << 8);
+    const uint64_t bitflip = (Read32(kSecret) ^ Read32(kSecret + 4)) + seed;
+    return Xxh64Avalanche(static_cast<uint64_t>(combined) ^ bitflip);
+}
+
+uint64_t Xxh3Len4To8(const uint8_t* input, size_t length, uint64_t seed) {
+    seed ^= static_cast<uint64_t>(__builtin_bswap32(static_cast<uint32_t>(seed))) << 32;
+    const uint32_t input1 = Read32(input);
+    const uint32_t input2 = Read32(input + length - 4);
+    const uint64_t bitflip = (Read64(kSecret + 8) ^ Read64(kSecret + 16)) - seed;
+    const uint64_t input64 = input2 + (static_cast<uint64_t>(input1) << 32);
+    return Rrmxmx(input64 ^ bitflip, length);
+}
+
+uint64_t Xxh3Len9To16(const uint8_t* input, size_t length, uint64_t seed) {
+    const uint64_t bitflip1 = (Read64(kSecret + 24) ^ Read64(kSecret + 32)) + seed;
+    const uint64_t bitflip2 = (Read64(kSecret + 40) ^ Read64(kSecret + 48)) - seed;
+    const uint64_t input_lo = Read64(input) ^ bitflip1;
+    const uint64_t input_hi = Read64(input + length - 8) ^ bitflip2;
+    const uint64_t acc = length + __builtin_bswap64(input_lo) + input_hi + Mul128Fold64(input_lo, input_hi);
+    return Xxh3Avalanche(acc);
+}
+
+uint64_t Xxh3Len17To128(const uint8_t* input, size_t length, uint64_t seed) {
+    uint64_t acc = length * kPrime64_1;
+    if (length > 32) {
+        if (length > 64) {
+            if (length > 96) {
+                acc += Mix16B(input + 48, kSecret + 96, seed);
+                acc += Mix16B(input + length - 64, kSecret + 112, seed);
+            }
+            acc += Mix16B(input + 32, kSecret + 64, seed);
+            acc += Mix16B(input + length - 48, kSecret + 80, seed);
+        }
+        acc += Mix16B(input + 16, kSecret + 32, seed);
+        acc += Mix16B(input + length - 32, kSecret + 48, seed);
+    }
+    acc += Mix16B(input, kSecret, seed);
+    acc += Mix16B(input + length - 16, kSecret + 16, seed);
+    return Xxh3Avalanche(acc);
+}
+
+uint64_t Xxh3Len129To240(const uint8_t* input, size_t length, uint64_t seed) {
+    constexpr size_t kMidSizeStartOffset = 3;
+    constexpr size_t kMidSizeLastOffset = 17;
+    uint64_t acc = length * kPrime64_1;
+    const size_t rounds = length / 16;
+    for (size_t i = 0; i < 8; i++) {
+        acc += Mix16B(input + 16 * i, kSecret + 16 * i, seed);
+    }
+    acc = Xxh3Avalanche(acc);
+    for (size_t i = 8; i < rounds; i++) {
+        acc += Mix16B(input + 16 * i, kSecret + 16 * (i - 8) + kMidSizeStartOffset, seed);
+    }
+    acc += Mix16B(input + length - 16, kSecret + 136 - kMidSizeLastOffset, seed);
+    return Xxh3Avalanche(acc);
+}
+
+// Ein Stripe = 64 Bytes Eingabe gegen 64 Bytes Secret auf acht 64-Bit-Akkumulatoren
+#if defined(FUSE_NATIVE_HASH_X86)
+inline void Xxh3Accumulate512(uint64_t* acc, const uint8_t* input, const uint8_t* secret) {
+    __m128i* xacc = reinterpret_cast<__m128i*>(acc);
+    for (int i = 0; i < 4; i++) {
+        const __m128i data_vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input) + i);
+        const __m128i key_vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i);
+        const __m128i data_key = _mm_xor_si128(data_vec, key_vec);
+        const __m128i data_key_lo = _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1));
+        const __m128i product = _mm_mul_epu32(data_key, data_key_lo);
+        const __m128i data_swap = _mm_shuffle_epi32(data_vec, _MM_SHUFFLE(1, 0, 3, 2));
+        const __m128i sum = _mm_add_epi64(_mm_load_si128(xacc + i), data_swap);
+        _mm_store_si128(xacc + i, _mm_add_epi64(product, sum));
+    }
+}
+
+inline void Xxh3ScrambleAcc(uint64_t* acc, const uint8_t* secret) {
+    __m128i* xacc = reinterpret_cast<__m128i*>(acc);
+    const __m128i prime32 = _mm_set1_epi32(static_cast<int>(kPrime32_1));
+    for (int i = 0; i < 4; i++) {
+        __m128i acc_vec = _mm_load_si128(xacc + i);
+        acc_vec = _mm_xor_si128(acc_vec, _mm_srli_epi64(acc_vec, 47));
+        const __m128i key_vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i);
+        const __m128i data_key = _mm_xor_si128(acc_vec, key_vec);
+        const __m128i data_key_hi = _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1));
+        const __m128i prod_lo = _mm_mul_epu32(data_key, prime32);
+        const __m128i prod_hi = _mm_mul_epu32(data_key_hi, prime32);
+        _mm_store_si128(xacc + i, _mm_add_epi64(prod_lo, _mm_slli_epi64(prod_hi, 32)));
+    }
+}
+
+constexpr const char* kXxh3Backend = "sse2";
+#else
+inline void Xxh3Accumulate512(uint64_t* acc, const uint8_t* input, const uint8_t* secret) {
+    for (size_t i = 0; i < 8; i++) {
+        const uint64_t data_val = Read64(input + 8 * i);
+        const uint64_t data_key = data_val ^ Read64(secret + 8 * i);
+        acc[i ^ 1] += data_val;
+        acc[i] += static_cast<uint32_t>(data_key) * (data_key >> 32);
+    }
+}
+
+inline void Xxh3ScrambleAcc(uint64_t* acc, const uint8_t* secret) {
+    for (size_t i = 0; i < 8; i++) {
+        uint64_t value = acc[i];
+        value ^= value >> 47;
+        value ^= Read64(secret + 8 * i);
+        value *= kPrime32_1;
+        acc[i] = value;
+    }
+}
+
+constexpr const char* kXxh3Backend = "scalar";
+#endif
+
+uint64_t Xxh3HashLong(const uint8_t* input, size_t length, uint64_t seed) {
+    constexpr size_t kLastAccStart = 7;
+    constexpr size_t kMergeAccsStart = 11;
+
+    // Mit Seed wird das Secret abgeleitet, nicht der Seed eingemischt
+    alignas(64) uint8_t custom[kSecretSize];
+    const uint8_t* secret = kSecret;
+    if (seed != 0) {
+        for (size_t i = 0; i < kSecretSize / 16; i++) {
+            Write64(custom + 16 * i, Read64(kSecret + 16 * i) + seed);
+            Write64(custom + 16 * i + 8, Read64(kSecret + 16 * i + 8) - seed);
+        }
+        secret = custom;
+    }
+
+    alignas(16) uint64_t acc[8] = {kPrime32_3, kPrime64_1, kPrime64_2, kPrime64_3,
+                                   kPrime64_4, kPrime32_2, kPrime64_5, kPrime32_1};
+
+    const size_t blocks = (length - 1) / kBlockLen;
+    for (size_t n = 0; n < blocks; n++) {
+        const uint8_t* block = input + n * kBlockLen;
+        for (size_t s = 0; s < kStripesPerBlock; s++) {
+            Xxh3Accumulate512(acc, block + s * kStripeLen, secret + s * kSecretConsumeRate);
+        }
+        Xxh3ScrambleAcc(acc, secret + kSecretSize - kStripeLen);
+    }
+
+    const size_t stripes = ((length - 1) - kBlockLen * blocks) / kStripeLen;
+    const uint8_t* tail = input + blocks * kBlockLen;
+    for (size_t s = 0; s < stripes; s++) {
+        Xxh3Accumulate512(acc, tail + s * kStripeLen, secret + s * kSecretConsumeRate);
+    }
+    Xxh3Accumulate512(acc, input + length - kStripeLen, secret + kSecretSize - kStripeLen - kLastAccStart);
+
+    uint64_t result = length * kPrime64_1;
+    for (size_t i = 0; i < 4; i++) {
+        const uint8_t* key = secret + kMergeAccsStart + 16 * i;
+        result += Mul128Fold64(acc[2 * i] ^ Read64(key), acc[2 * i + 1] ^ Read64(key + 8));
+    }
+    return Xxh3Avalanche(result);
+}
+
+// ---------------------------------------------------------------------------
+// BLAKE3
+// ---------------------------------------------------------------------------
+
+constexpr size_t kBlake3BlockLen = 64;
+constexpr size_t kBlake3ChunkLen = 1024;
+constexpr size_t kBlake3MaxDepth = 54;  // 2^54 Chunks = 2^64 Bytes
+
+constexpr uint32_t kChunkStart = 1 << 0;
+constexpr uint32_t kChunkEnd = 1 << 1;
+constexpr uint32_t kParent = 1 << 2;
+constexpr uint32_t kRoot = 1 << 3;
+
+constexpr uint32_t kBlake3Iv[8] = {0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+                                   0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19};
+
+constexpr uint8_t kMsgSchedule[7][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8},
+    {3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1},
+    {10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6},
+    {12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4},
+    {9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7},
+    {11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13},
+};
+
+inline void Blake3G(uint32_t* state, int a, int b, int c, int d, uint32_t mx, uint32_t my) {
+    state[a] = state[a] + state[b] + mx;
+    state[d] = Rotr32(state[d] ^ state[a], 16);
+    state[c] = state[c] + state[d];
+    state[b] = Rotr32(state[b] ^ state[c], 12);
+    state[a] = state[a] + state[b] + my;
+    state[d] = Rotr32(state[d] ^ state[a], 8);
+    state[c] = state[c] + state[d];
+    state[b] = Rotr32(state[b] ^ state[c], 7);
+}
+
+/**
+ * Compression function; writes the new chaining value (first 8 output words)
+ */
+void Blake3Compress(uint32_t cv[8], const uint8_t block[kBlake3BlockLen], uint8_t block_len,
+                    uint64_t counter, uint32_t flags) {
+    uint32_t m[16];
+    for (size_t i = 0; i < 16; i++) {
+        m[i] = Read32(block + 4 * i);
+    }
+    uint32_t state[16] = {
+        cv[0], cv[1], cv[2], cv[3], cv[4], cv[5], cv[6], cv[7],
+        kBlake3Iv[0], kBlake3Iv[1], kBlake3Iv[2], kBlake3Iv[3],
+        static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32), block_len, flags,
+    };
+    for (const auto& s : kMsgSchedule) {
+        Blake3G(state, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+        Blake3G(state, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+        Blake3G(state, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+        Blake3G(state, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+        Blake3G(state, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+        Blake3G(state, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+        Blake3G(state, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+        Blake3G(state, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+    }
+    for (size_t i = 0; i < 8; i++) {
+        cv[i] = state[i] ^ state[i + 8];
+    }
+}
+
+/**
+ * Last compression of a chunk or parent node, delayed until it is known
+ * whether it is the root
+ */
+struct Blake3Output {
+    uint32_t cv[8];
+    uint8_t block[kBlake3BlockLen];
+    uint8_t block_len;
+    uint64_t counter;
+    uint32_t flags;
+
+    void ChainingValue(uint32_t out[8]) const {
+        std::memcpy(out, cv, sizeof(cv));
+        Blake3Compress(out, block, block_len, counter, flags);
+    }
+};
+
+/**
+ * Hash one chunk (up to 1024 bytes) up to its last block
+ */
+Blake3Output Blake3Chunk(const uint8_t* input, size_t length, uint64_t chunk_counter) {
+    Blake3Output output{};
+    std::memcpy(output.cv, kBlake3Iv, sizeof(kBlake3Iv));
+    output.counter = chunk_counter;
+
+    uint32_t start = kChunkStart;
+    while (length > kBlake3BlockLen) {
+        Blake3Compress(output.cv, input, kBlake3BlockLen, chunk_counter, start);
+        start = 0;
+        input += kBlake3BlockLen;
+        length -= kBlake3BlockLen;
+    }
+    if (length > 0) {
+        std::memcpy(output.block, input, length);
+    }
+    output.block_len = static_cast<uint8_t>(length);
+    output.flags = start | kChunkEnd;
+    return output;
+}
+
+Blake3Output Blake3Parent(const uint32_t left[8], const uint32_t right[8]) {
+    Blake3Output output{};
+    std::memcpy(output.cv, kBlake3Iv, sizeof(kBlake3Iv));
+    for (size_t i = 0; i < 8; i++) {
+        uint32_t word = left[i];
+        std::memcpy(output.block + 4 * i, &word, 4);
+        word = right[i];
+        std::memcpy(output.block + 32 + 4 * i, &word, 4);
+    }
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    for (size_t i = 0; i < 16; i++) {
+        uint32_t word;
+        std::memcpy(&word, output.block + 4 * i, 4);
+        word = __builtin_bswap32(word);
+        std::memcpy(output.block + 4 * i, &word, 4);
+    }
+#endif
+    output.block_len = kBlake3BlockLen;
+    output.counter = 0;
+    output.flags = kParent;
+    return output;
+}
+
+void Blake3Impl(const uint8_t* input, size_t length, uint8_t out[32]) {
+    // Stack der linken Teilbäume; die Anzahl fertiger Chunks bestimmt das Zusammenfassen
+    uint32_t stack[kBlake3MaxDepth][8];
+    size_t depth = 0;
+    uint64_t chunks = 0;
+
+    while (length > kBlake3ChunkLen) {
+        uint32_t cv[8];
+        Blake3Chunk(input, kBlake3ChunkLen, chunks).ChainingValue(cv);
+        input += kBlake3ChunkLen;
+        length -= kBlake3ChunkLen;
+        chunks++;
+        for (uint64_t total = chunks; (total & 1) == 0; total >>= 1) {
+            Blake3Parent(stack[--depth], cv).ChainingValue(cv);
+        }
+        std::memcpy(stack[depth++], cv, sizeof(cv));
+    }
+
+    Blake3Output output = Blake3Chunk(input, length, chunks);
+    while (depth > 0) {
+        uint32_t cv[8];
+        output.ChainingValue(cv);
+        output = Blake3Parent(stack[--depth], cv);
+    }
+
+    uint32_t root[8];
+    std::memcpy(root, output.cv, sizeof(root));
+    Blake3Compress(root, output.block, output.block_len, 0, output.flags | kRoot);
+    for (size_t i = 0; i < 8; i++) {
+        out[4 * i] = static_cast<uint8_t>(root[i]);
+        out[4 * i + 1] = static_cast<uint8_t>(root[i] >> 8);
+        out[4 * i + 2] = static_cast<uint8_t>(root[i] >> 16);
+        out[4 * i + 3] = static_cast<uint8_t>(root[i] >> 24);
+    }
+}
+
+} // namespace
+
+bool ParseHashAlgorithm(const std::string& name, HashAlgorithm* algorithm) {
+    if (name == "crc32c") {
+        *algorithm = HashAlgorithm::CRC32C;
+    } else if (name == "xxh3") {
+        *algorithm = HashAlgorithm::XXH3;
+    } else if (name == "blake3") {
+        *algorithm = HashAlgorithm::BLAKE3;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* HashAlgorithmName(HashAlgorithm algorithm) {
+    switch (algorithm) {
+        case HashAlgorithm::CRC32C:
+            return "crc32c";
+        case HashAlgorithm::XXH3:
+            return "xxh3";
+        case HashAlgorithm::BLAKE3:
+            return "blake3";
+    }
+    return "unknown";
+}
+
+uint32_t Crc32c(const void* data, size_t length, uint32_t crc) {
+    // Vor- und Nachinvertierung, damit Ergebnisse direkt verkettet werden können
+    return ~SelectCrc32c().kernel(~crc, static_cast<const uint8_t*>(data), length);
+}
+
+uint64_t Xxh3_64(const void* data, size_t length, uint64_t seed) {
+    const uint8_t* input = static_cast<const uint8_t*>(data);
+    if (length == 0) {
+        return Xxh64Avalanche(seed ^ (Read64(kSecret + 56) ^ Read64(kSecret + 64)));
+    }
+    if (length <= 3) {
+        return Xxh3Len1To3(input, length, seed);
+    }
+    if (length <= 8) {
+        return Xxh3Len4To8(input, length, seed);
+    }
+    if (length <= 16) {
+        return Xxh3Len9To16(input, length, seed);
+    }
+    if (length <= 128) {
+        return Xxh3Len17To128(input, length, seed);
+    }
+    if (length <= kMidSizeMax) {
+        return Xxh3Len129To240(input, length, seed);
+    }
+    return Xxh3HashLong(input, length, seed);
+}
+
+void Blake3(const void* data, size_t length, uint8_t out[32]) {
+    Blake3Impl(static_cast<const uint8_t*>(data), length, out);
+}
+
+ContentDigest ComputeDigest(HashAlgorithm algorithm, const void* data, size_t length, uint64_t seed) {
+    ContentDigest digest;
+    digest.algorithm = algorithm;
+    switch (algorithm) {
+        case HashAlgorithm::CRC32C:
+            digest.value = Crc32c(data, length, static_cast<uint32_t>(seed));
+            break;
+        case HashAlgorithm::XXH3:
+            digest.value = Xxh3_64(data, length, seed);
+            break;
+        case HashAlgorithm::BLAKE3:
+            Blake3(data, length, digest.bytes.data());
+            break;
+    }
+    return digest;
+}
+
+Napi::Value DigestToJs(Napi::Env env, const ContentDigest& digest) {
+    switch (digest.algorithm) {
+        case HashAlgorithm::CRC32C:
+            return Napi::Number::New(env, static_cast<double>(digest.value));
+        case HashAlgorithm::XXH3:
+            return fuse_native::NapiHelpers::CreateBigUint64(env, digest.value);
+        case HashAlgorithm::BLAKE3:
+            return Napi::Buffer<uint8_t>::Copy(env, digest.bytes.data(), digest.bytes.size());
+    }
+    return env.Undefined();
+}
+
+WriteDigest& WriteDigest::Instance() {
+    static WriteDigest instance;
+    return instance;
+}
+
+void WriteDigest::Configure(bool enabled, HashAlgorithm algorithm) {
+    algorithm_.store(static_cast<int>(algorithm), std::memory_order_relaxed);
+    enabled_.store(enabled, std::memory_order_release);
+}
+
+bool WriteDigest::Compute(const void* data, size_t length, ContentDigest* digest) {
+    if (!enabled_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    *digest = ComputeDigest(static_cast<HashAlgorithm>(algorithm_.load(std::memory_order_relaxed)), data, length);
+    hashed_bytes_.fetch_add(length, std::memory_order_relaxed);
+    return true;
+}
+
+} // namespace FuseNative
+
+namespace fuse_native {
+
+namespace {
+
+bool GetBytes(const Napi::Value& value, const uint8_t** data, size_t* length) {
+    if (value.IsArrayBuffer()) {
+        Napi::ArrayBuffer buffer = value.As<Napi::ArrayBuffer>();
+        *data = static_cast<const uint8_t*>(buffer.Data());
+        *length = buffer.ByteLength();
+        return true;
+    }
+    if (value.IsTypedArray()) {
+        Napi::TypedArray typed = value.As<Napi::TypedArray>();
+        *data = static_cast<const uint8_t*>(typed.ArrayBuffer().Data()) + typed.ByteOffset();
+        *length = typed.ByteLength();
+        return true;
+    }
+    return false;
+}
+
+bool GetAlgorithm(const Napi::Value& value, FuseNative::HashAlgorithm* algorithm) {
+    return value.IsString() && FuseNative::ParseHashAlgorithm(value.As<Napi::String>().Utf8Value(), algorithm);
+}
+
+bool GetSeed(const Napi::CallbackInfo& info, size_t index, uint64_t* seed) {
+    if (info.Length() <= index || info[index].IsUndefined()) {
+        return true;
+    }
+    if (info[index].IsBigInt()) {
+        auto parsed = NapiHelpers::SafeGetBigIntU64(info[index]);
+        if (!parsed) {
+            return false;
+        }
+        *seed = *parsed;
+        return true;
+    }
+    if (info[index].IsNumber()) {
+        const int64_t number = info[index].As<Napi::Number>().Int64Value();
+        if (number < 0) {
+            return false;
+        }
+        *seed = static_cast<uint64_t>(number);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Hashes a batch of buffers on the libuv thread pool
+ *
+ * The input arrays are kept alive through persistent references for the
+ * duration of Execute(); nothing is copied.
+ */
+class HashWorker : public Napi::AsyncWorker {
+public:
+    HashWorker(Napi::Env env, FuseNative::HashAlgorithm algorithm, uint64_t seed, Napi::Array owner)
+        : Napi::AsyncWorker(env, "fuse-native:hash"),
+          deferred_(Napi::Promise::Deferred::New(env)),
+          owner_(Napi::Persistent(owner)),
+          algorithm_(algorithm),
+          seed_(seed) {}
+
+    Napi::Promise Promise() const { return deferred_.Promise(); }
+
+    void Add(const uint8_t* data, size_t length) { inputs_.push_back({data, length}); }
+
+    void Execute() override {
+        digests_.reserve(inputs_.size());
+        for (const auto& input : inputs_) {
+            digests_.push_back(FuseNative::ComputeDigest(algorithm_, input.first, input.second, seed_));
+        }
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        owner_.Reset();
+        Napi::Array result = Napi::Array::New(env, digests_.size());
+        for (size_t i = 0; i < digests_.size(); i++) {
+            result.Set(static_cast<uint32_t>(i), FuseNative::DigestToJs(env, digests_[i]));
+        }
+        deferred_.Resolve(result);
+    }
+
+    void OnError(const Napi::Error& error) override {
+        owner_.Reset();
+        deferred_.Reject(error.Value());
+    }
+
+private:
+    Napi::Promise::Deferred deferred_;
+    Napi::Reference<Napi::Array> owner_;
+    FuseNative::HashAlgorithm algorithm_;
+    uint64_t seed_;
+    std::vector<std::pair<const uint8_t*, size_t>> inputs_;
+    std::vector<FuseNative::ContentDigest> digests_;
+};
+
+constexpr const char* kAlgorithmError = "algorithm must be 'crc32c', 'xxh3' or 'blake3'";
+constexpr const char* kSeedError = "seed must be a non-negative bigint or number";
+
+} // namespace
+
+Napi::Value HashBuffer(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    FuseNative::HashAlgorithm algorithm;
+    if (info.Length() < 1 || !GetAlgorithm(info[0], &algorithm)) {
+        NapiHelpers::ThrowTypeError(env, kAlgorithmError);
+        return env.Undefined();
+    }
+    const uint8_t* data = nullptr;
+    size_t length = 0;
+    if (info.Length() < 2 || !GetBytes(info[1], &data, &length)) {
+        NapiHelpers::ThrowTypeError(env, "data must be an ArrayBuffer or TypedArray");
+        return env.Undefined();
+    }
+    uint64_t seed = 0;
+    if (!GetSeed(info, 2, &seed)) {
+        NapiHelpers::ThrowTypeError(env, kSeedError);
+        return env.Undefined();
+    }
+
+    return FuseNative::DigestToJs(env, FuseNative::ComputeDigest(algorithm, data, length, seed));
+}
+
+Napi::Value HashBuffers(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    FuseNative::HashAlgorithm algorithm;
+    if (info.Length() < 1 || !GetAlgorithm(info[0], &algorithm)) {
+        NapiHelpers::ThrowTypeError(env, kAlgorithmError);
+        return env.Undefined();
+    }
+    if (info.Length() < 2 || !info[1].IsArray()) {
+        NapiHelpers::ThrowTypeError(env, "Expected array of buffers");
+        return env.Undefined();
+    }
+    uint64_t seed = 0;
+    if (!GetSeed(info, 2, &seed)) {
+        NapiHelpers::ThrowTypeError(env, kSeedError);
+        return env.Undefined();
+    }
+
+    // Eigene Kopie des Arrays: der Aufrufer darf seins danach verändern
+    Napi::Array input = info[1].As<Napi::Array>();
+    Napi::Array owner = Napi::Array::New(env, input.Length());
+    auto* worker = new HashWorker(env, algorithm, seed, owner);
+    for (uint32_t i = 0; i < input.Length(); i++) {
+        Napi::Value item = input.Get(i);
+        const uint8_t* data = nullptr;
+        size_t length = 0;
+        if (!GetBytes(item, &data, &length)) {
+            delete worker;
+            NapiHelpers::ThrowTypeError(env, "buffers must contain ArrayBuffers or TypedArrays");
+            return env.Undefined();
+        }
+        owner.Set(i, item);
+        worker->Add(data, length);
+    }
+
+    Napi::Promise promise = worker->Promise();
+    worker->Queue();
+    return promise;
+}
+
+Napi::Value ConfigureWriteDigest(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    bool enabled = false;
+    FuseNative::HashAlgorithm algorithm = FuseNative::HashAlgorithm::CRC32C;
+    if (info.Length() >= 1 && !info[0].IsUndefined()) {
+        if (!info[0].IsObject()) {
+            NapiHelpers::ThrowTypeError(env, "Expected options object");
+            return env.Undefined();
+        }
+        Napi::Value value = info[0].As<Napi::Object>().Get("algorithm");
+        if (!value.IsUndefined()) {
+            if (!GetAlgorithm(value, &algorithm)) {
+                NapiHelpers::ThrowTypeError(env, kAlgorithmError);
+                return env.Undefined();
+            }
+            enabled = true;
+        }
+    }
+
+    FuseNative::WriteDigest::Instance().Configure(enabled, algorithm);
+    return Napi::Boolean::New(env, true);
+}
+
+Napi::Value GetHashImplementations(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("crc32c", Napi::String::New(env, FuseNative::SelectCrc32c().name));
+    result.Set("xxh3", Napi::String::New(env, FuseNative::kXxh3Backend));
+    result.Set("blake3", Napi::String::New(env, "portable"));
+    result.Set("writeDigestBytes", NapiHelpers::CreateBigUint64(env, FuseNative::WriteDigest::Instance().HashedBytes()));
+    return result;
+}
+
+} // namespace fuse_native
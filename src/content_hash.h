@@ -0,0 +1,146 @@
+/**
+ * @file content_hash.h
+ * @brief Native content hashing (CRC32C, XXH3-64, BLAKE3) for buffers and write payloads
+ *
+ * Content-addressed backends hash every block they store. Hashing in JS, or
+ * through `crypto` after copying the payload out of the request, costs more
+ * than the FUSE round trip itself. These kernels run directly on ArrayBuffer
+ * memory, on the libuv pool for batches, or on the FUSE thread for write
+ * payloads before the handler is called.
+ *
+ * - CRC32C uses the SSE4.2 / ARMv8 CRC instructions when the CPU has them
+ *   (checked at runtime) and slicing-by-8 tables otherwise.
+ * - XXH3-64 follows the reference algorithm; the long-input loop uses SSE2
+ *   on x86-64.
+ * - BLAKE3 is the portable implementation (single-threaded, 32-byte output);
+ *   batches hash several buffers in parallel on the libuv pool instead.
+ */
+
+#ifndef FUSE_NATIVE_CONTENT_HASH_H
+#define FUSE_NATIVE_CONTENT_HASH_H
+
+#include <napi.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace FuseNative {
+
+/**
+ * Supported algorithms
+ */
+enum class HashAlgorithm {
+    CRC32C,
+    XXH3,
+    BLAKE3,
+};
+
+/**
+ * Result of one hash computation
+ */
+struct ContentDigest {
+    HashAlgorithm algorithm = HashAlgorithm::CRC32C;
+    uint64_t value = 0;                   ///< CRC32C / XXH3
+    std::array<uint8_t, 32> bytes{};      ///< BLAKE3
+};
+
+/**
+ * @brief Parse "crc32c", "xxh3" or "blake3"
+ */
+bool ParseHashAlgorithm(const std::string& name, HashAlgorithm* algorithm);
+
+const char* HashAlgorithmName(HashAlgorithm algorithm);
+
+/**
+ * @brief CRC32C (Castagnoli); pass the previous result to continue a stream
+ */
+uint32_t Crc32c(const void* data, size_t length, uint32_t crc = 0);
+
+/**
+ * @brief XXH3 64-bit
+ */
+uint64_t Xxh3_64(const void* data, size_t length, uint64_t seed = 0);
+
+/**
+ * @brief BLAKE3 with 32-byte output
+ */
+void Blake3(const void* data, size_t length, uint8_t out[32]);
+
+/**
+ * @brief Hash @p data with @p algorithm (@p seed: initial CRC / XXH3 seed, ignored by BLAKE3)
+ */
+ContentDigest ComputeDigest(HashAlgorithm algorithm, const void* data, size_t length, uint64_t seed = 0);
+
+/**
+ * @brief number (CRC32C), bigint (XXH3) or 32-byte Buffer (BLAKE3)
+ */
+Napi::Value DigestToJs(Napi::Env env, const ContentDigest& digest);
+
+/**
+ * Digest of write payloads computed by the bridge before the handler runs.
+ */
+class WriteDigest {
+public:
+    static WriteDigest& Instance();
+
+    /**
+     * @brief Enable for @p algorithm, or disable with enabled = false
+     */
+    void Configure(bool enabled, HashAlgorithm algorithm);
+
+    /**
+     * @brief Hash a write payload if enabled
+     * @return true if @p digest was filled
+     */
+    bool Compute(const void* data, size_t length, ContentDigest* digest);
+
+    bool Enabled() const { return enabled_.load(std::memory_order_acquire); }
+
+    uint64_t HashedBytes() const { return hashed_bytes_.load(std::memory_order_relaxed); }
+
+private:
+    WriteDigest() = default;
+
+    std::atomic<bool> enabled_{false};
+    std::atomic<int> algorithm_{0};
+    std::atomic<uint64_t> hashed_bytes_{0};
+};
+
+} // namespace FuseNative
+
+namespace fuse_native {
+
+/**
+ * Hash one buffer on the JS thread (N-API exposed function)
+ * @param info N-API callback info containing algorithm, ArrayBuffer or TypedArray and optional seed
+ * @return number (crc32c), bigint (xxh3) or Buffer (blake3)
+ */
+Napi::Value HashBuffer(const Napi::CallbackInfo& info);
+
+/**
+ * Hash several buffers on the libuv pool (N-API exposed function)
+ * @param info N-API callback info containing algorithm, array of buffers and optional seed
+ * @return Promise resolving to the digests in input order
+ */
+Napi::Value HashBuffers(const Napi::CallbackInfo& info);
+
+/**
+ * Configure the digest passed to write handlers (N-API exposed function)
+ * @param info N-API callback info containing `{algorithm?}`; without it the digest is disabled
+ * @return Boolean indicating success
+ */
+Napi::Value ConfigureWriteDigest(const Napi::CallbackInfo& info);
+
+/**
+ * Report the selected kernels (N-API exposed function)
+ * @param info N-API callback info
+ * @return Object `{crc32c, xxh3, blake3, writeDigestBytes}`
+ */
+Napi::Value GetHashImplementations(const Napi::CallbackInfo& info);
+
+} // namespace fuse_native
+
+#endif // FUSE_NATIVE_CONTENT_HASH_H
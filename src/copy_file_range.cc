@@ -12,11 +12,18 @@
 #include "errno_mapping.h"
 #include "napi_helpers.h"
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
 #include <sys/syscall.h>
+#include <linux/falloc.h>
 #include <linux/fs.h>
 #include <errno.h>
 #include <algorithm>
 #include <memory>
+#include <string>
+#include <vector>
 
 // Fallback syscall number for copy_file_range if not defined in headers
 #ifndef __NR_copy_file_range
@@ -40,6 +47,15 @@ static constexpr size_t MAX_CHUNK_SIZE = 8 * 1024 * 1024;
 // Minimum chunk size (64KB)
 static constexpr size_t MIN_CHUNK_SIZE = 64 * 1024;
 
+// Pipe capacity requested for splice copies (1MB)
+static constexpr int SPLICE_PIPE_SIZE = 1024 * 1024;
+
+CopyFileRange& CopyFileRange::Shared() {
+    // Eine Instanz für JS-Thread und Copy-Worker: Chunk-Größe und Statistiken gelten prozessweit
+    static CopyFileRange instance;
+    return instance;
+}
+
 CopyFileRange::CopyFileRange() : chunkSize_(DEFAULT_CHUNK_SIZE), useKernelCopy_(true) {
     // Test if copy_file_range syscall is available
     testKernelSupport();
@@ -54,33 +70,69 @@ void CopyFileRange::testKernelSupport() {
     ssize_t result = syscall(__NR_copy_file_range, -1, nullptr, -1, nullptr, 0, 0);
     
     if (result == -1 && errno == ENOSYS) {
-        useKernelCopy_ = false;
+        useKernelCopy_.store(false, std::memory_order_relaxed);
     }
 }
 
 ssize_t CopyFileRange::copyFileRange(int fdIn, off_t* offsetIn, int fdOut, off_t* offsetOut,
-                                     size_t length, unsigned int flags) {
+                                     size_t length, unsigned int flags,
+                                     const Control* control) {
     if (length == 0) {
         return 0;
     }
 
+    if (control) {
+        // In Scheiben kopieren: zwischen den Scheiben Abbruch prüfen und Fortschritt melden
+        const size_t slice = chunkSize_.load(std::memory_order_relaxed);
+        size_t totalCopied = 0;
+        while (totalCopied < length) {
+            if (control->cancelled && control->cancelled->load(std::memory_order_acquire)) {
+                break;
+            }
+            const ssize_t copied = copyFileRange(fdIn, offsetIn, fdOut, offsetOut,
+                                                 std::min(length - totalCopied, slice), flags);
+            if (copied < 0) {
+                return totalCopied > 0 ? static_cast<ssize_t>(totalCopied) : -1;
+            }
+            if (copied == 0) {
+                break;  // End of file reached
+            }
+            totalCopied += static_cast<size_t>(copied);
+            if (control->progress) {
+                control->progress(totalCopied);
+            }
+        }
+        return static_cast<ssize_t>(totalCopied);
+    }
+
+    // Reflink: Blöcke teilen statt kopieren – nur mit expliziten Offsets
+    if (offsetIn && offsetOut && flags == 0) {
+        ssize_t result = reflinkCopyFileRange(fdIn, offsetIn, fdOut, offsetOut, length);
+        if (result >= 0) {
+            return result;
+        }
+    }
+
     // Try kernel copy_file_range first if available
-    if (useKernelCopy_) {
+    if (useKernelCopy_.load(std::memory_order_relaxed)) {
         ssize_t result = kernelCopyFileRange(fdIn, offsetIn, fdOut, offsetOut, length, flags);
         
         // If kernel copy succeeded or failed with a non-recoverable error, return result
         if (result >= 0 || (errno != ENOSYS && errno != EOPNOTSUPP && errno != EXDEV)) {
+            if (result > 0) {
+                kernelCopyOperations_.fetch_add(1, std::memory_order_relaxed);
+            }
             return result;
         }
         
         // Kernel copy failed with recoverable error, fall back to chunked copy
         if (errno == ENOSYS || errno == EOPNOTSUPP) {
-            useKernelCopy_ = false;  // Disable for future calls
+            useKernelCopy_.store(false, std::memory_order_relaxed);  // Disable for future calls
         }
     }
 
-    // Fallback to chunked read/write
-    return chunkedCopyFileRange(fdIn, offsetIn, fdOut, offsetOut, length);
+    // Fallback: sparse walk, splice/sendfile, chunked read/write
+    return fallbackCopyFileRange(fdIn, offsetIn, fdOut, offsetOut, length);
 }
 
 ssize_t CopyFileRange::kernelCopyFileRange(int fdIn, off_t* offsetIn, int fdOut, off_t* offsetOut,
@@ -94,6 +146,268 @@ ssize_t CopyFileRange::kernelCopyFileRange(int fdIn, off_t* offsetIn, int fdOut,
     return syscall(__NR_copy_file_range, fdIn, offsetIn, fdOut, offsetOut, length, flags);
 }
 
+ssize_t CopyFileRange::reflinkCopyFileRange(int fdIn, off_t* offsetIn, int fdOut, off_t* offsetOut,
+                                            size_t length) {
+#ifdef FICLONERANGE
+    struct stat st{};
+    if (fstat(fdIn, &st) != 0 || !S_ISREG(st.st_mode)) {
+        return -1;
+    }
+    if (*offsetIn >= st.st_size) {
+        return -1;  // EOF – copy_file_range liefert dafür die passende 0
+    }
+    // Über EOF hinaus klont der Kernel nicht; am Dateiende darf die Länge unaligned sein
+    const size_t available = static_cast<size_t>(st.st_size - *offsetIn);
+    const size_t cloneLength = std::min(length, available);
+
+    struct file_clone_range range{};
+    range.src_fd = fdIn;
+    range.src_offset = static_cast<uint64_t>(*offsetIn);
+    range.src_length = static_cast<uint64_t>(cloneLength);
+    range.dest_offset = static_cast<uint64_t>(*offsetOut);
+    if (ioctl(fdOut, FICLONERANGE, &range) != 0) {
+        // EXDEV, EOPNOTSUPP, EINVAL (Alignment) usw.: nächste Strategie
+        return -1;
+    }
+
+    *offsetIn += static_cast<off_t>(cloneLength);
+    *offsetOut += static_cast<off_t>(cloneLength);
+    reflinkOperations_.fetch_add(1, std::memory_order_relaxed);
+    return static_cast<ssize_t>(cloneLength);
+#else
+    (void)fdIn; (void)offsetIn; (void)fdOut; (void)offsetOut; (void)length;
+    errno = EOPNOTSUPP;
+    return -1;
+#endif
+}
+
+ssize_t CopyFileRange::fallbackCopyFileRange(int fdIn, off_t* offsetIn, int fdOut, off_t* offsetOut,
+                                             size_t length) {
+    struct stat st{};
+    const bool regular = fstat(fdIn, &st) == 0 && S_ISREG(st.st_mode);
+    if (!offsetIn || !offsetOut || !regular) {
+        return copyExtent(fdIn, offsetIn, fdOut, offsetOut, length);
+    }
+
+    if (*offsetIn >= st.st_size) {
+        return 0;
+    }
+    const off_t start = *offsetIn;
+    const off_t end = start + static_cast<off_t>(std::min<uint64_t>(length, st.st_size - start));
+
+    // SEEK_DATA/SEEK_HOLE bewegen die Dateiposition, die fdIn mit dup()/fork() teilen kann:
+    // Extents auf einer eigenen Dateibeschreibung suchen, kopiert wird positionsgenau über fdIn
+    const std::string probePath = "/proc/self/fd/" + std::to_string(fdIn);
+    const int probeFd = open(probePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (probeFd < 0) {
+        return copyExtent(fdIn, offsetIn, fdOut, offsetOut, length);
+    }
+    off_t inPos = start;
+    off_t outPos = *offsetOut;
+    size_t totalCopied = 0;
+    bool sparse = false;
+    bool failed = false;
+
+    while (inPos < end) {
+        off_t dataStart = lseek(probeFd, inPos, SEEK_DATA);
+        if (dataStart < 0) {
+            // ENXIO: nur noch Loch bis EOF; sonst kein SEEK_DATA – alles als Daten behandeln
+            dataStart = (errno == ENXIO) ? end : inPos;
+        }
+        dataStart = std::min(dataStart, end);
+
+        if (dataStart > inPos) {
+            const size_t holeLength = static_cast<size_t>(dataStart - inPos);
+            if (fillHole(fdOut, outPos, holeLength) != 0) {
+                failed = true;
+                break;
+            }
+            holeBytes_.fetch_add(holeLength, std::memory_order_relaxed);
+            sparse = true;
+            inPos += static_cast<off_t>(holeLength);
+            outPos += static_cast<off_t>(holeLength);
+            totalCopied += holeLength;
+            continue;
+        }
+
+        off_t dataEnd = lseek(probeFd, inPos, SEEK_HOLE);
+        if (dataEnd < 0 || dataEnd <= inPos) {
+            dataEnd = end;
+        }
+        dataEnd = std::min(dataEnd, end);
+
+        off_t extentIn = inPos;
+        off_t extentOut = outPos;
+        const size_t extentLength = static_cast<size_t>(dataEnd - inPos);
+        const ssize_t copied = copyExtent(fdIn, &extentIn, fdOut, &extentOut, extentLength);
+        if (copied <= 0) {
+            failed = copied < 0;
+            break;
+        }
+        inPos += copied;
+        outPos += copied;
+        totalCopied += static_cast<size_t>(copied);
+        if (static_cast<size_t>(copied) < extentLength) {
+            break;  // Quelle ist geschrumpft
+        }
+    }
+
+    const int savedErrno = errno;
+    close(probeFd);
+    if (sparse) {
+        sparseOperations_.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (failed && totalCopied == 0) {
+        errno = savedErrno;
+        return -1;
+    }
+
+    // Übersprungenes Loch am Ende: Zielgröße trotzdem bis zum Ende der Kopie ziehen
+    struct stat outSt{};
+    if (fstat(fdOut, &outSt) == 0 && S_ISREG(outSt.st_mode) && outSt.st_size < outPos) {
+        if (ftruncate(fdOut, outPos) != 0 && totalCopied == 0) {
+            return -1;
+        }
+    }
+
+    *offsetIn = inPos;
+    *offsetOut = outPos;
+    return static_cast<ssize_t>(totalCopied);
+}
+
+ssize_t CopyFileRange::copyExtent(int fdIn, off_t* offsetIn, int fdOut, off_t* offsetOut,
+                                  size_t length) {
+    ssize_t result = offsetOut ? spliceCopy(fdIn, offsetIn, fdOut, offsetOut, length)
+                               : sendfileCopy(fdIn, offsetIn, fdOut, length);
+    if (result >= 0 || (errno != EINVAL && errno != ENOSYS && errno != EOPNOTSUPP)) {
+        return result;
+    }
+
+    result = chunkedCopyFileRange(fdIn, offsetIn, fdOut, offsetOut, length);
+    if (result > 0) {
+        bufferedOperations_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return result;
+}
+
+ssize_t CopyFileRange::spliceCopy(int fdIn, off_t* offsetIn, int fdOut, off_t* offsetOut,
+                                  size_t length) {
+    int pipeFds[2];
+    if (pipe2(pipeFds, O_CLOEXEC) != 0) {
+        errno = ENOSYS;  // Buffer-Pfad übernimmt
+        return -1;
+    }
+    // Größere Pipe = weniger Syscalls; Fehler (z.B. pipe-max-size) sind egal
+    fcntl(pipeFds[1], F_SETPIPE_SZ, SPLICE_PIPE_SIZE);
+
+    size_t totalCopied = 0;
+    int error = 0;
+    while (totalCopied < length) {
+        const ssize_t filled = splice(fdIn, offsetIn, pipeFds[1], nullptr,
+                                      length - totalCopied, SPLICE_F_MOVE);
+        if (filled < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            error = errno;
+            break;
+        }
+        if (filled == 0) {
+            break;  // End of file reached
+        }
+
+        ssize_t drained = 0;
+        while (drained < filled) {
+            const ssize_t written = splice(pipeFds[0], nullptr, fdOut, offsetOut,
+                                           static_cast<size_t>(filled - drained), SPLICE_F_MOVE);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                error = errno;
+                break;
+            }
+            if (written == 0) {
+                error = ENOSPC;
+                break;
+            }
+            drained += written;
+        }
+        totalCopied += static_cast<size_t>(drained);
+        if (error != 0) {
+            break;
+        }
+    }
+
+    close(pipeFds[0]);
+    close(pipeFds[1]);
+    if (totalCopied > 0) {
+        spliceOperations_.fetch_add(1, std::memory_order_relaxed);
+        return static_cast<ssize_t>(totalCopied);
+    }
+    if (error != 0) {
+        errno = error;
+        return -1;
+    }
+    return 0;
+}
+
+ssize_t CopyFileRange::sendfileCopy(int fdIn, off_t* offsetIn, int fdOut, size_t length) {
+    size_t totalCopied = 0;
+    while (totalCopied < length) {
+        const ssize_t sent = sendfile(fdOut, fdIn, offsetIn, length - totalCopied);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (totalCopied > 0) {
+                break;
+            }
+            return -1;
+        }
+        if (sent == 0) {
+            break;  // End of file reached
+        }
+        totalCopied += static_cast<size_t>(sent);
+    }
+    if (totalCopied > 0) {
+        sendfileOperations_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return static_cast<ssize_t>(totalCopied);
+}
+
+int CopyFileRange::fillHole(int fdOut, off_t offset, size_t length) {
+    struct stat st{};
+    if (fstat(fdOut, &st) != 0) {
+        return -1;
+    }
+    // Jenseits des Zielendes liest sich alles als Nullen: überspringen
+    if (!S_ISREG(st.st_mode) || offset >= st.st_size) {
+        return S_ISREG(st.st_mode) ? 0 : -1;
+    }
+    const size_t inside = std::min(length, static_cast<size_t>(st.st_size - offset));
+    if (fallocate(fdOut, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, offset,
+                  static_cast<off_t>(inside)) == 0) {
+        return 0;
+    }
+
+    // Kein punch hole: vorhandene Daten mit Nullen überschreiben
+    static const std::vector<char> zeros(MIN_CHUNK_SIZE, 0);
+    size_t done = 0;
+    while (done < inside) {
+        const ssize_t written = pwrite(fdOut, zeros.data(), std::min(inside - done, zeros.size()),
+                                       offset + static_cast<off_t>(done));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        done += static_cast<size_t>(written);
+    }
+    return 0;
+}
+
 ssize_t CopyFileRange::chunkedCopyFileRange(int fdIn, off_t* offsetIn, int fdOut, off_t* offsetOut,
                                             size_t length) {
     if (length == 0) {
@@ -101,7 +415,8 @@ ssize_t CopyFileRange::chunkedCopyFileRange(int fdIn, off_t* offsetIn, int fdOut
     }
 
     // Allocate aligned buffer for optimal I/O performance
-    size_t actualChunkSize = std::min(std::max(length, MIN_CHUNK_SIZE), chunkSize_);
+    size_t actualChunkSize = std::min(std::max(length, MIN_CHUNK_SIZE),
+                                      chunkSize_.load(std::memory_order_relaxed));
     
     void* buffer = aligned_alloc(4096, (actualChunkSize + 4095) & ~4095);
     if (!buffer) {
@@ -197,25 +512,150 @@ ssize_t CopyFileRange::chunkedCopyFileRange(int fdIn, off_t* offsetIn, int fdOut
 }
 
 void CopyFileRange::setChunkSize(size_t chunkSize) {
-    chunkSize_ = std::min(std::max(chunkSize, MIN_CHUNK_SIZE), MAX_CHUNK_SIZE);
+    chunkSize_.store(std::min(std::max(chunkSize, MIN_CHUNK_SIZE), MAX_CHUNK_SIZE),
+                     std::memory_order_relaxed);
 }
 
 size_t CopyFileRange::getChunkSize() const {
-    return chunkSize_;
+    return chunkSize_.load(std::memory_order_relaxed);
 }
 
 bool CopyFileRange::isKernelCopySupported() const {
-    return useKernelCopy_;
+    return useKernelCopy_.load(std::memory_order_relaxed);
 }
 
 CopyFileRange::Stats CopyFileRange::getStats() const {
-    return stats_;
+    Stats stats;
+    stats.totalOperations = totalOperations_.load(std::memory_order_relaxed);
+    stats.totalBytesCopied = totalBytesCopied_.load(std::memory_order_relaxed);
+    stats.asyncOperations = asyncOperations_.load(std::memory_order_relaxed);
+    stats.cancelledOperations = cancelledOperations_.load(std::memory_order_relaxed);
+    stats.activeCopies = activeCopies_.load(std::memory_order_relaxed);
+    stats.reflinkOperations = reflinkOperations_.load(std::memory_order_relaxed);
+    stats.kernelCopyOperations = kernelCopyOperations_.load(std::memory_order_relaxed);
+    stats.spliceOperations = spliceOperations_.load(std::memory_order_relaxed);
+    stats.sendfileOperations = sendfileOperations_.load(std::memory_order_relaxed);
+    stats.bufferedOperations = bufferedOperations_.load(std::memory_order_relaxed);
+    stats.sparseOperations = sparseOperations_.load(std::memory_order_relaxed);
+    stats.holeBytes = holeBytes_.load(std::memory_order_relaxed);
+    return stats;
 }
 
 void CopyFileRange::resetStats() {
-    stats_ = Stats{};
+    // activeCopies_ beschreibt laufende Kopien, kein Zähler
+    totalOperations_.store(0, std::memory_order_relaxed);
+    totalBytesCopied_.store(0, std::memory_order_relaxed);
+    asyncOperations_.store(0, std::memory_order_relaxed);
+    cancelledOperations_.store(0, std::memory_order_relaxed);
+    reflinkOperations_.store(0, std::memory_order_relaxed);
+    kernelCopyOperations_.store(0, std::memory_order_relaxed);
+    spliceOperations_.store(0, std::memory_order_relaxed);
+    sendfileOperations_.store(0, std::memory_order_relaxed);
+    bufferedOperations_.store(0, std::memory_order_relaxed);
+    sparseOperations_.store(0, std::memory_order_relaxed);
+    holeBytes_.store(0, std::memory_order_relaxed);
 }
 
+void CopyFileRange::recordCopy(uint64_t bytes) {
+    totalOperations_.fetch_add(1, std::memory_order_relaxed);
+    totalBytesCopied_.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+/**
+ * Runs one copy on the libuv thread pool and reports progress per chunk
+ */
+class CopyWorker : public Napi::AsyncProgressWorker<uint64_t> {
+public:
+    CopyWorker(Napi::Env env, int fdIn, uint64_t offsetIn, int fdOut, uint64_t offsetOut,
+               uint64_t length, unsigned int flags, std::shared_ptr<std::atomic<bool>> cancelled)
+        : Napi::AsyncProgressWorker<uint64_t>(env, "fuse-native:copy-file-range"),
+          deferred_(Napi::Promise::Deferred::New(env)),
+          fdIn_(fdIn),
+          offsetIn_(offsetIn),
+          fdOut_(fdOut),
+          offsetOut_(offsetOut),
+          length_(length),
+          flags_(flags),
+          cancelled_(std::move(cancelled)) {
+        CopyFileRange::Shared().activeCopies_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Napi::Promise Promise() const { return deferred_.Promise(); }
+
+    void SetProgressCallback(Napi::Function callback) {
+        progress_ = Napi::Persistent(callback);
+    }
+
+    void Execute(const ExecutionProgress& progress) override {
+        off_t offsetIn = static_cast<off_t>(offsetIn_);
+        off_t offsetOut = static_cast<off_t>(offsetOut_);
+        off_t* pOffsetIn = (offsetIn_ != UINT64_MAX) ? &offsetIn : nullptr;
+        off_t* pOffsetOut = (offsetOut_ != UINT64_MAX) ? &offsetOut : nullptr;
+
+        CopyFileRange::Control control;
+        control.cancelled = cancelled_.get();
+        if (!progress_.IsEmpty()) {
+            // AsyncProgressWorker liefert nur den jeweils letzten Stand an JS
+            control.progress = [&progress](uint64_t copied) { progress.Send(&copied, 1); };
+        }
+
+        CopyFileRange& copier = CopyFileRange::Shared();
+        result_ = copier.copyFileRange(fdIn_, pOffsetIn, fdOut_, pOffsetOut,
+                                       static_cast<size_t>(length_), flags_, &control);
+        error_ = result_ < 0 ? errno : 0;
+        copier.asyncOperations_.fetch_add(1, std::memory_order_relaxed);
+        // Ein Abbruch nach der letzten Scheibe ändert am Ergebnis nichts mehr
+        if (cancelled_->load(std::memory_order_acquire) && error_ == 0 &&
+            static_cast<uint64_t>(result_) < length_) {
+            copier.cancelledOperations_.fetch_add(1, std::memory_order_relaxed);
+            error_ = ECANCELED;
+        }
+        if (result_ > 0) {
+            copier.recordCopy(static_cast<uint64_t>(result_));
+        }
+        // Vor OnOK: sobald das Promise settled, zählt die Kopie nicht mehr als aktiv
+        copier.activeCopies_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void OnProgress(const uint64_t* data, size_t count) override {
+        if (progress_.IsEmpty() || count == 0) {
+            return;
+        }
+        Napi::Env env = Env();
+        Napi::HandleScope scope(env);
+        progress_.Value().Call({fuse_native::NapiHelpers::CreateBigUint64(env, data[count - 1])});
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        progress_.Reset();
+        if (error_ != 0) {
+            deferred_.Reject(fuse_native::NapiHelpers::CreateErrnoError(
+                env, error_, fuse_native::errno_to_string(error_) + ": copy_file_range failed").Value());
+            return;
+        }
+        deferred_.Resolve(fuse_native::NapiHelpers::CreateBigUint64(env, static_cast<uint64_t>(result_)));
+    }
+
+    void OnError(const Napi::Error& error) override {
+        progress_.Reset();
+        deferred_.Reject(error.Value());
+    }
+
+private:
+    Napi::Promise::Deferred deferred_;
+    Napi::FunctionReference progress_;
+    int fdIn_;
+    uint64_t offsetIn_;
+    int fdOut_;
+    uint64_t offsetOut_;
+    uint64_t length_;
+    unsigned int flags_;
+    std::shared_ptr<std::atomic<bool>> cancelled_;
+    ssize_t result_ = 0;
+    int error_ = 0;
+};
+
 // N-API wrapper functions
 Napi::Value CopyFileRange::CreateCopyFileRange(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
@@ -231,7 +671,7 @@ Napi::Value CopyFileRange::CreateCopyFileRange(const Napi::CallbackInfo& info) {
     int fdOut = fuse_native::NapiHelpers::GetInt32(env, info[2]);
     uint64_t offsetOutValue = fuse_native::NapiHelpers::GetBigUint64(env, info[3]);
     uint64_t length = fuse_native::NapiHelpers::GetBigUint64(env, info[4]);
-    unsigned int flags = info.Length() > 6 ? fuse_native::NapiHelpers::GetUint32(env, info[6]) : 0;
+    unsigned int flags = info.Length() > 5 ? fuse_native::NapiHelpers::GetUint32(env, info[5]) : 0;
 
     // Convert to appropriate types
     off_t offsetIn = static_cast<off_t>(offsetInValue);
@@ -240,7 +680,7 @@ Napi::Value CopyFileRange::CreateCopyFileRange(const Napi::CallbackInfo& info) {
     off_t* pOffsetOut = (offsetOutValue != UINT64_MAX) ? &offsetOut : nullptr;
 
     // Perform the copy operation
-    static thread_local CopyFileRange copier;
+    CopyFileRange& copier = Shared();
     ssize_t result = copier.copyFileRange(fdIn, pOffsetIn, fdOut, pOffsetOut, 
                                          static_cast<size_t>(length), flags);
 
@@ -251,13 +691,48 @@ Napi::Value CopyFileRange::CreateCopyFileRange(const Napi::CallbackInfo& info) {
     }
 
     // Update statistics
-    copier.stats_.totalOperations++;
-    copier.stats_.totalBytesCopied += result;
+    copier.recordCopy(static_cast<uint64_t>(result));
 
     // Return result as BigInt
     return fuse_native::NapiHelpers::CreateBigUint64(env, static_cast<uint64_t>(result));
 }
 
+Napi::Value CopyFileRange::CreateCopyFileRangeAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 5) {
+        Napi::TypeError::New(env, "Expected at least 5 arguments").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    int fdIn = fuse_native::NapiHelpers::GetInt32(env, info[0]);
+    uint64_t offsetIn = fuse_native::NapiHelpers::GetBigUint64(env, info[1]);
+    int fdOut = fuse_native::NapiHelpers::GetInt32(env, info[2]);
+    uint64_t offsetOut = fuse_native::NapiHelpers::GetBigUint64(env, info[3]);
+    uint64_t length = fuse_native::NapiHelpers::GetBigUint64(env, info[4]);
+    unsigned int flags = (info.Length() > 5 && info[5].IsNumber())
+        ? fuse_native::NapiHelpers::GetUint32(env, info[5]) : 0;
+    if (env.IsExceptionPending()) {
+        return env.Undefined();
+    }
+
+    auto cancelled = std::make_shared<std::atomic<bool>>(false);
+    auto* worker = new CopyWorker(env, fdIn, offsetIn, fdOut, offsetOut, length, flags, cancelled);
+    if (info.Length() > 6 && info[6].IsFunction()) {
+        worker->SetProgressCallback(info[6].As<Napi::Function>());
+    }
+
+    Napi::Object handle = Napi::Object::New(env);
+    handle.Set("promise", worker->Promise());
+    // cancel() darf nach Abschluss noch aufgerufen werden – das Flag lebt im shared_ptr
+    handle.Set("cancel", Napi::Function::New(env, [cancelled](const Napi::CallbackInfo& cb) {
+        cancelled->store(true, std::memory_order_release);
+        return cb.Env().Undefined();
+    }, "cancel"));
+    worker->Queue();
+    return handle;
+}
+
 Napi::Value CopyFileRange::SetChunkSize(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
@@ -268,8 +743,7 @@ Napi::Value CopyFileRange::SetChunkSize(const Napi::CallbackInfo& info) {
 
     uint64_t chunkSize = fuse_native::NapiHelpers::GetBigUint64(env, info[0]);
     
-    static thread_local CopyFileRange copier;
-    copier.setChunkSize(static_cast<size_t>(chunkSize));
+    Shared().setChunkSize(static_cast<size_t>(chunkSize));
 
     return env.Undefined();
 }
@@ -277,8 +751,7 @@ Napi::Value CopyFileRange::SetChunkSize(const Napi::CallbackInfo& info) {
 Napi::Value CopyFileRange::GetChunkSize(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
-    static thread_local CopyFileRange copier;
-    size_t chunkSize = copier.getChunkSize();
+    size_t chunkSize = Shared().getChunkSize();
 
     return fuse_native::NapiHelpers::CreateBigUint64(env, static_cast<uint64_t>(chunkSize));
 }
@@ -286,12 +759,24 @@ Napi::Value CopyFileRange::GetChunkSize(const Napi::CallbackInfo& info) {
 Napi::Value CopyFileRange::GetStats(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
-    static thread_local CopyFileRange copier;
+    CopyFileRange& copier = Shared();
     Stats stats = copier.getStats();
 
     Napi::Object result = Napi::Object::New(env);
     result.Set("totalOperations", fuse_native::NapiHelpers::CreateBigUint64(env, stats.totalOperations));
     result.Set("totalBytesCopied", fuse_native::NapiHelpers::CreateBigUint64(env, stats.totalBytesCopied));
+    result.Set("asyncOperations", fuse_native::NapiHelpers::CreateBigUint64(env, stats.asyncOperations));
+    result.Set("cancelledOperations", fuse_native::NapiHelpers::CreateBigUint64(env, stats.cancelledOperations));
+    result.Set("activeCopies", Napi::Number::New(env, static_cast<double>(stats.activeCopies)));
+    Napi::Object strategies = Napi::Object::New(env);
+    strategies.Set("reflink", fuse_native::NapiHelpers::CreateBigUint64(env, stats.reflinkOperations));
+    strategies.Set("copyFileRange", fuse_native::NapiHelpers::CreateBigUint64(env, stats.kernelCopyOperations));
+    strategies.Set("splice", fuse_native::NapiHelpers::CreateBigUint64(env, stats.spliceOperations));
+    strategies.Set("sendfile", fuse_native::NapiHelpers::CreateBigUint64(env, stats.sendfileOperations));
+    strategies.Set("buffered", fuse_native::NapiHelpers::CreateBigUint64(env, stats.bufferedOperations));
+    strategies.Set("sparse", fuse_native::NapiHelpers::CreateBigUint64(env, stats.sparseOperations));
+    result.Set("strategies", strategies);
+    result.Set("holeBytes", fuse_native::NapiHelpers::CreateBigUint64(env, stats.holeBytes));
     result.Set("kernelCopySupported", Napi::Boolean::New(env, copier.isKernelCopySupported()));
 
     return result;
@@ -300,8 +785,7 @@ Napi::Value CopyFileRange::GetStats(const Napi::CallbackInfo& info) {
 Napi::Value CopyFileRange::ResetStats(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
-    static thread_local CopyFileRange copier;
-    copier.resetStats();
+    Shared().resetStats();
 
     return env.Undefined();
 }
@@ -318,6 +802,10 @@ Napi::Value CopyFileRange(const Napi::CallbackInfo& info) {
     return FuseNative::CopyFileRange::CreateCopyFileRange(info);
 }
 
+Napi::Value CopyFileRangeAsync(const Napi::CallbackInfo& info) {
+    return FuseNative::CopyFileRange::CreateCopyFileRangeAsync(info);
+}
+
 Napi::Value SetCopyChunkSize(const Napi::CallbackInfo& info) {
     return FuseNative::CopyFileRange::SetChunkSize(info);
 }
@@ -5,13 +5,25 @@
  * This module provides native copy_file_range implementation that attempts to use
  * the kernel's copy_file_range syscall for optimal performance, with fallback
  * to chunked read/write operations when the syscall is not available or fails.
+ *
+ * Strategy order for one copy:
+ *   1. FICLONERANGE reflink (positional copies on the same CoW filesystem)
+ *   2. copy_file_range(2)
+ *   3. sparse walk of the source with SEEK_DATA/SEEK_HOLE on a private reopen
+ *      (the shared file position of the source fd never moves); holes are punched
+ *      or skipped in the destination, data extents are moved with
+ *      splice (positional destination) or sendfile (destination at its file
+ *      position), and only then with the pread/pwrite buffer loop
  */
 
 #ifndef FUSE_NATIVE_COPY_FILE_RANGE_H
 #define FUSE_NATIVE_COPY_FILE_RANGE_H
 
 #include <napi.h>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <sys/types.h>
 
 namespace FuseNative {
@@ -31,8 +43,36 @@ public:
     struct Stats {
         uint64_t totalOperations = 0;     ///< Total number of copy operations performed
         uint64_t totalBytesCopied = 0;    ///< Total bytes copied across all operations
+        uint64_t asyncOperations = 0;     ///< Copies that ran on a worker thread
+        uint64_t cancelledOperations = 0; ///< Async copies stopped by their AbortSignal
+        uint64_t activeCopies = 0;        ///< Async copies currently running
+
+        // Welcher Pfad die Bytes bewegt hat (ein Aufruf kann mehrere nutzen)
+        uint64_t reflinkOperations = 0;   ///< Ranges cloned with FICLONERANGE
+        uint64_t kernelCopyOperations = 0;///< Ranges copied by copy_file_range(2)
+        uint64_t spliceOperations = 0;    ///< Data extents moved with splice through a pipe
+        uint64_t sendfileOperations = 0;  ///< Data extents moved with sendfile
+        uint64_t bufferedOperations = 0;  ///< Data extents copied with pread/pwrite
+        uint64_t sparseOperations = 0;    ///< Fallback copies that skipped source holes
+        uint64_t holeBytes = 0;           ///< Source hole bytes not written (punched or skipped)
+    };
+
+    /**
+     * Cancellation and progress hooks for a sliced copy
+     *
+     * With a control block the copy runs in slices of the chunk size; the
+     * cancel flag is checked and progress reported between slices.
+     */
+    struct Control {
+        const std::atomic<bool>* cancelled = nullptr;     ///< Stop before the next slice when set
+        std::function<void(uint64_t)> progress;           ///< Bytes copied so far, after each slice
     };
 
+    /**
+     * Process-wide instance shared by all N-API functions and copy workers
+     */
+    static CopyFileRange& Shared();
+
     /**
      * Constructor - initializes and tests kernel support
      */
@@ -52,6 +92,7 @@ public:
      * @param offsetOut - Destination offset (nullptr to use current position)
      * @param length - Number of bytes to copy
      * @param flags - Copy flags (for kernel copy_file_range)
+     * @param control - Optional cancellation/progress hooks (slices the copy)
      * @return Number of bytes copied, or -1 on error (errno set)
      * 
      * @note This function first attempts to use the kernel copy_file_range syscall
@@ -59,7 +100,8 @@ public:
      *       to chunked read/write operations.
      */
     ssize_t copyFileRange(int fdIn, off_t* offsetIn, int fdOut, off_t* offsetOut,
-                          size_t length, unsigned int flags = 0);
+                          size_t length, unsigned int flags = 0,
+                          const Control* control = nullptr);
 
     /**
      * Set the chunk size for fallback operations
@@ -94,6 +136,11 @@ public:
      */
     void resetStats();
 
+    /**
+     * Account a finished copy in the statistics
+     */
+    void recordCopy(uint64_t bytes);
+
     // N-API wrapper functions for JavaScript interface
     
     /**
@@ -104,10 +151,25 @@ public:
      *               offsetOut: bigint, length: bigint, flags?: number): bigint
      * 
      * @param info - N-API callback info with arguments
-     * @return Promise resolving to bytes copied (as BigInt)
+     * @return Bytes copied (as BigInt); blocks the calling thread
      */
     static Napi::Value CreateCopyFileRange(const Napi::CallbackInfo& info);
 
+    /**
+     * N-API wrapper for copy_file_range on a worker thread
+     *
+     * JavaScript signature:
+     * copyFileRangeAsync(fdIn: number, offsetIn: bigint, fdOut: number,
+     *                    offsetOut: bigint, length: bigint, flags?: number,
+     *                    onProgress?: (bytesCopied: bigint) => void):
+     *     { promise: Promise<bigint>, cancel: () => void }
+     *
+     * `cancel()` stops the copy before the next chunk; the promise then
+     * rejects with ECANCELED. The promise settles only after the worker no
+     * longer touches the descriptors.
+     */
+    static Napi::Value CreateCopyFileRangeAsync(const Napi::CallbackInfo& info);
+
     /**
      * N-API wrapper to set chunk size
      * 
@@ -125,7 +187,10 @@ public:
     /**
      * N-API wrapper to get statistics
      * 
-     * JavaScript signature: getStats(): { totalOperations: bigint, totalBytesCopied: bigint, kernelCopySupported: boolean }
+     * JavaScript signature: getStats(): { totalOperations: bigint, totalBytesCopied: bigint,
+     *     asyncOperations: bigint, cancelledOperations: bigint, activeCopies: number,
+     *     strategies: { reflink, copyFileRange, splice, sendfile, buffered, sparse: bigint },
+     *     holeBytes: bigint, kernelCopySupported: boolean }
      */
     static Napi::Value GetStats(const Napi::CallbackInfo& info);
 
@@ -169,9 +234,62 @@ private:
     ssize_t chunkedCopyFileRange(int fdIn, off_t* offsetIn, int fdOut, off_t* offsetOut,
                                  size_t length);
 
-    size_t chunkSize_;        ///< Chunk size for fallback operations
-    bool useKernelCopy_;      ///< Whether kernel copy_file_range is available
-    Stats stats_;             ///< Operation statistics
+    /**
+     * Clone the range with FICLONERANGE (both offsets required)
+     *
+     * @return Bytes cloned, or -1 if the filesystem cannot reflink this range
+     */
+    ssize_t reflinkCopyFileRange(int fdIn, off_t* offsetIn, int fdOut, off_t* offsetOut,
+                                 size_t length);
+
+    /**
+     * Fallback when copy_file_range cannot be used: sparse walk for positional
+     * copies of regular files, otherwise a single data extent
+     */
+    ssize_t fallbackCopyFileRange(int fdIn, off_t* offsetIn, int fdOut, off_t* offsetOut,
+                                  size_t length);
+
+    /**
+     * Copy one data extent: splice/sendfile first, pread/pwrite buffer last
+     */
+    ssize_t copyExtent(int fdIn, off_t* offsetIn, int fdOut, off_t* offsetOut, size_t length);
+
+    /**
+     * Move bytes file -> pipe -> file with splice (positional destination)
+     * @return Bytes moved, or -1 with errno EINVAL/ENOSYS if nothing could be spliced
+     */
+    ssize_t spliceCopy(int fdIn, off_t* offsetIn, int fdOut, off_t* offsetOut, size_t length);
+
+    /**
+     * Move bytes with sendfile (destination at its file position)
+     * @return Bytes moved, or -1 with errno EINVAL/ENOSYS if sendfile is not usable
+     */
+    ssize_t sendfileCopy(int fdIn, off_t* offsetIn, int fdOut, size_t length);
+
+    /**
+     * Make [offset, offset + length) of the destination read as zeros
+     * without writing data where possible (punch inside, skip beyond EOF)
+     * @return 0 or -1 on error
+     */
+    int fillHole(int fdOut, off_t offset, size_t length);
+
+    friend class CopyWorker;
+
+    // Geteilt zwischen JS-Thread und Copy-Workern
+    std::atomic<size_t> chunkSize_;       ///< Chunk size for fallback operations
+    std::atomic<bool> useKernelCopy_;     ///< Whether kernel copy_file_range is available
+    std::atomic<uint64_t> totalOperations_{0};
+    std::atomic<uint64_t> totalBytesCopied_{0};
+    std::atomic<uint64_t> asyncOperations_{0};
+    std::atomic<uint64_t> cancelledOperations_{0};
+    std::atomic<uint64_t> activeCopies_{0};
+    std::atomic<uint64_t> reflinkOperations_{0};
+    std::atomic<uint64_t> kernelCopyOperations_{0};
+    std::atomic<uint64_t> spliceOperations_{0};
+    std::atomic<uint64_t> sendfileOperations_{0};
+    std::atomic<uint64_t> bufferedOperations_{0};
+    std::atomic<uint64_t> sparseOperations_{0};
+    std::atomic<uint64_t> holeBytes_{0};
 };
 
 } // namespace FuseNative
@@ -190,6 +308,13 @@ namespace fuse_native {
  */
 Napi::Value CopyFileRange(const Napi::CallbackInfo& info);
 
+/**
+ * Copy file range on a worker thread (N-API exposed function)
+ * @param info N-API callback info: descriptors, offsets, length, flags, onProgress
+ * @return Object `{ promise, cancel }`
+ */
+Napi::Value CopyFileRangeAsync(const Napi::CallbackInfo& info);
+
 /**
  * Set chunk size (N-API exposed function)
  * @param info N-API callback info containing chunk size
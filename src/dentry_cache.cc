@@ -0,0 +1,330 @@
+/**
+ * @file dentry_cache.cc
+ * @brief Native (parent, name) lookup cache with negative entries
+ */
+
+#include "dentry_cache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "logging.h"
+#include "napi_helpers.h"
+
+namespace fuse_native {
+
+DentryCache& DentryCache::Instance() {
+    static DentryCache instance;
+    return instance;
+}
+
+void DentryCache::Configure(double entry_ttl, double negative_ttl, size_t max_entries) {
+    const bool enable = entry_ttl > 0.0 || negative_ttl > 0.0;
+    entry_ttl_ns_.store(static_cast<int64_t>(entry_ttl * 1e9), std::memory_order_relaxed);
+    negative_ttl_ns_.store(static_cast<int64_t>(negative_ttl * 1e9), std::memory_order_relaxed);
+    max_entries_.store(max_entries, std::memory_order_relaxed);
+    shard_capacity_.store(max_entries == 0 ? 0 : (max_entries + kShardCount - 1) / kShardCount,
+                          std::memory_order_relaxed);
+    enabled_.store(enable, std::memory_order_release);
+    Clear();
+    FUSE_LOG_DEBUG("dentry cache: entry_ttl=%.3fs negative_ttl=%.3fs max_entries=%zu",
+                   entry_ttl, negative_ttl, max_entries);
+}
+
+DentryLookup DentryCache::Lookup(fuse_ino_t parent, const std::string& name,
+                                 fuse_entry_param* entry) {
+    if (!Enabled()) {
+        return DentryLookup::MISS;
+    }
+
+    Key key{parent, name};
+    Shard& shard = ShardFor(key);
+    const Clock::time_point now = Clock::now();
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it != shard.entries.end()) {
+            if (it->second.expires > now) {
+                if (it->second.negative) {
+                    negative_hits_.fetch_add(1, std::memory_order_relaxed);
+                    return DentryLookup::NEGATIVE;
+                }
+                const double remaining =
+                    std::chrono::duration<double>(it->second.expires - now).count();
+                *entry = it->second.entry;
+                entry->entry_timeout = std::min(entry->entry_timeout, remaining);
+                entry->attr_timeout = std::min(entry->attr_timeout, remaining);
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                return DentryLookup::POSITIVE;
+            }
+            shard.entries.erase(it);
+            expirations_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return DentryLookup::MISS;
+}
+
+bool DentryCache::PeekIno(fuse_ino_t parent, const std::string& name, fuse_ino_t* ino) const {
+    Key key{parent, name};
+    const Shard& shard = ShardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.entries.find(key);
+    if (it == shard.entries.end() || it->second.negative) {
+        return false;
+    }
+    *ino = it->second.entry.ino;
+    return true;
+}
+
+uint64_t DentryCache::Epoch(fuse_ino_t parent, const std::string& name) {
+    Key key{parent, name};
+    Shard& shard = ShardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.epoch;
+}
+
+void DentryCache::StoreLocked(Shard& shard, Key key, Entry entry) {
+    const size_t capacity = shard_capacity_.load(std::memory_order_relaxed);
+    auto it = shard.entries.find(key);
+    if (it != shard.entries.end()) {
+        it->second = entry;
+        return;
+    }
+
+    if (capacity != 0 && shard.entries.size() >= capacity) {
+        // Erst abgelaufene Einträge verwerfen, dann notfalls einen beliebigen
+        const Clock::time_point now = Clock::now();
+        for (auto cur = shard.entries.begin(); cur != shard.entries.end();) {
+            if (cur->second.expires <= now) {
+                cur = shard.entries.erase(cur);
+                expirations_.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                ++cur;
+            }
+        }
+        if (shard.entries.size() >= capacity) {
+            shard.entries.erase(shard.entries.begin());
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    shard.entries.emplace(std::move(key), entry);
+}
+
+void DentryCache::StorePositive(fuse_ino_t parent, const std::string& name,
+                                const fuse_entry_param& entry, uint64_t epoch) {
+    const int64_t ttl_ns = entry_ttl_ns_.load(std::memory_order_relaxed);
+    if (!Enabled() || ttl_ns <= 0 || entry.ino == 0) {
+        return;
+    }
+
+    Key key{parent, name};
+    Shard& shard = ShardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.epoch != epoch) {
+        return;
+    }
+    StoreLocked(shard, std::move(key),
+                Entry{false, entry, Clock::now() + std::chrono::nanoseconds(ttl_ns)});
+    inserts_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void DentryCache::StoreNegative(fuse_ino_t parent, const std::string& name, uint64_t epoch) {
+    const int64_t ttl_ns = negative_ttl_ns_.load(std::memory_order_relaxed);
+    if (!Enabled() || ttl_ns <= 0) {
+        return;
+    }
+
+    fuse_entry_param empty;
+    std::memset(&empty, 0, sizeof(empty));
+
+    Key key{parent, name};
+    Shard& shard = ShardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.epoch != epoch) {
+        return;
+    }
+    StoreLocked(shard, std::move(key),
+                Entry{true, empty, Clock::now() + std::chrono::nanoseconds(ttl_ns)});
+    negative_inserts_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool DentryCache::Invalidate(fuse_ino_t parent, const std::string& name) {
+    Key key{parent, name};
+    Shard& shard = ShardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.epoch++;
+    if (shard.entries.erase(key) == 0) {
+        return false;
+    }
+    invalidations_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+size_t DentryCache::InvalidateParent(fuse_ino_t parent) {
+    size_t removed = 0;
+    for (Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.epoch++;
+        for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+            if (it->first.parent == parent) {
+                it = shard.entries.erase(it);
+                removed++;
+            } else {
+                ++it;
+            }
+        }
+    }
+    invalidations_.fetch_add(removed, std::memory_order_relaxed);
+    return removed;
+}
+
+void DentryCache::Clear() {
+    for (Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.epoch++;
+        shard.entries.clear();
+    }
+}
+
+DentryCacheStats DentryCache::GetStats() const {
+    DentryCacheStats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.negative_hits = negative_hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.inserts = inserts_.load(std::memory_order_relaxed);
+    stats.negative_inserts = negative_inserts_.load(std::memory_order_relaxed);
+    stats.invalidations = invalidations_.load(std::memory_order_relaxed);
+    stats.expirations = expirations_.load(std::memory_order_relaxed);
+    stats.evictions = evictions_.load(std::memory_order_relaxed);
+    stats.max_entries = max_entries_.load(std::memory_order_relaxed);
+    stats.entry_ttl = static_cast<double>(entry_ttl_ns_.load(std::memory_order_relaxed)) / 1e9;
+    stats.negative_ttl = static_cast<double>(negative_ttl_ns_.load(std::memory_order_relaxed)) / 1e9;
+    for (const Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        stats.entries += shard.entries.size();
+        for (const auto& kv : shard.entries) {
+            if (kv.second.negative) {
+                stats.negative_entries++;
+            }
+        }
+    }
+    return stats;
+}
+
+void DentryCache::ResetStats() {
+    hits_.store(0, std::memory_order_relaxed);
+    negative_hits_.store(0, std::memory_order_relaxed);
+    misses_.store(0, std::memory_order_relaxed);
+    inserts_.store(0, std::memory_order_relaxed);
+    negative_inserts_.store(0, std::memory_order_relaxed);
+    invalidations_.store(0, std::memory_order_relaxed);
+    expirations_.store(0, std::memory_order_relaxed);
+    evictions_.store(0, std::memory_order_relaxed);
+}
+
+Napi::Value ConfigureDentryCache(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        NapiHelpers::ThrowTypeError(env, "Expected configuration object");
+        return env.Undefined();
+    }
+
+    Napi::Object config = info[0].As<Napi::Object>();
+    auto read_ttl = [&config](const char* key, double* out) {
+        Napi::Value value = config.Get(key);
+        if (value.IsUndefined()) {
+            *out = 0.0;
+            return true;
+        }
+        if (!value.IsNumber()) {
+            return false;
+        }
+        *out = value.As<Napi::Number>().DoubleValue();
+        return std::isfinite(*out) && *out >= 0.0;
+    };
+
+    double entry_ttl = 0.0;
+    double negative_ttl = 0.0;
+    if (!read_ttl("entryTtl", &entry_ttl) || !read_ttl("negativeTtl", &negative_ttl)) {
+        NapiHelpers::ThrowTypeError(env, "entryTtl and negativeTtl must be non-negative numbers of seconds");
+        return env.Undefined();
+    }
+
+    size_t max_entries = 0;
+    Napi::Value max_value = config.Get("maxEntries");
+    if (!max_value.IsUndefined()) {
+        if (!max_value.IsNumber() || max_value.As<Napi::Number>().DoubleValue() < 0) {
+            NapiHelpers::ThrowTypeError(env, "maxEntries must be a non-negative number");
+            return env.Undefined();
+        }
+        max_entries = static_cast<size_t>(max_value.As<Napi::Number>().Int64Value());
+    }
+
+    DentryCache::Instance().Configure(entry_ttl, negative_ttl, max_entries);
+    return Napi::Boolean::New(env, true);
+}
+
+Napi::Value InvalidateDentryCache(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsBigInt()) {
+        NapiHelpers::ThrowTypeError(env, "Expected parent ino as bigint");
+        return env.Undefined();
+    }
+
+    const uint64_t parent = NapiHelpers::GetBigUint64(env, info[0]);
+    if (env.IsExceptionPending()) {
+        return env.Undefined();
+    }
+
+    DentryCache& cache = DentryCache::Instance();
+    if (info.Length() < 2 || info[1].IsUndefined()) {
+        return Napi::Number::New(env, static_cast<double>(
+            cache.InvalidateParent(static_cast<fuse_ino_t>(parent))));
+    }
+    if (!info[1].IsString()) {
+        NapiHelpers::ThrowTypeError(env, "name must be a string");
+        return env.Undefined();
+    }
+    const bool removed = cache.Invalidate(static_cast<fuse_ino_t>(parent),
+                                          info[1].As<Napi::String>().Utf8Value());
+    return Napi::Number::New(env, removed ? 1 : 0);
+}
+
+Napi::Value GetDentryCacheStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    const DentryCacheStats stats = DentryCache::Instance().GetStats();
+    const uint64_t lookups = stats.hits + stats.negative_hits + stats.misses;
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("hits", NapiHelpers::CreateBigUint64(env, stats.hits));
+    result.Set("negativeHits", NapiHelpers::CreateBigUint64(env, stats.negative_hits));
+    result.Set("misses", NapiHelpers::CreateBigUint64(env, stats.misses));
+    result.Set("inserts", NapiHelpers::CreateBigUint64(env, stats.inserts));
+    result.Set("negativeInserts", NapiHelpers::CreateBigUint64(env, stats.negative_inserts));
+    result.Set("invalidations", NapiHelpers::CreateBigUint64(env, stats.invalidations));
+    result.Set("expirations", NapiHelpers::CreateBigUint64(env, stats.expirations));
+    result.Set("evictions", NapiHelpers::CreateBigUint64(env, stats.evictions));
+    result.Set("hitRate", Napi::Number::New(
+        env, lookups == 0 ? 0.0
+                          : static_cast<double>(stats.hits + stats.negative_hits) /
+                                static_cast<double>(lookups)));
+    result.Set("entries", Napi::Number::New(env, static_cast<double>(stats.entries)));
+    result.Set("negativeEntries", Napi::Number::New(env, static_cast<double>(stats.negative_entries)));
+    result.Set("maxEntries", Napi::Number::New(env, static_cast<double>(stats.max_entries)));
+    result.Set("entryTtl", Napi::Number::New(env, stats.entry_ttl));
+    result.Set("negativeTtl", Napi::Number::New(env, stats.negative_ttl));
+    return result;
+}
+
+Napi::Value ClearDentryCache(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    DentryCache::Instance().Clear();
+    DentryCache::Instance().ResetStats();
+    return Napi::Boolean::New(env, true);
+}
+
+} // namespace fuse_native
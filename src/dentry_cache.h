@@ -0,0 +1,227 @@
+/**
+ * @file dentry_cache.h
+ * @brief Native (parent, name) lookup cache with negative entries
+ *
+ * Build tools probe thousands of paths that do not exist (module resolution,
+ * header search paths); without a cache each probe is a lookup round-trip
+ * into JS. The bridge records lookup results, positive and ENOENT, and
+ * answers repeated lookups itself while they are younger than the configured
+ * TTLs. Replies to namespace operations (mknod, mkdir, symlink, link, create,
+ * unlink, rmdir, rename) drop the affected names.
+ *
+ * A lookup that was dispatched before a conflicting invalidation is not
+ * cached: every shard carries an epoch that invalidations advance, and the
+ * reply is only stored if the epoch seen at dispatch is still current.
+ */
+
+#ifndef DENTRY_CACHE_H
+#define DENTRY_CACHE_H
+
+#include <napi.h>
+#include <fuse3/fuse_lowlevel.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace fuse_native {
+
+/**
+ * Dentry cache statistics
+ */
+struct DentryCacheStats {
+    uint64_t hits = 0;            ///< Positive lookups answered natively
+    uint64_t negative_hits = 0;   ///< ENOENT answered natively
+    uint64_t misses = 0;          ///< Lookups forwarded to JS
+    uint64_t inserts = 0;
+    uint64_t negative_inserts = 0;
+    uint64_t invalidations = 0;
+    uint64_t expirations = 0;
+    uint64_t evictions = 0;
+    size_t entries = 0;
+    size_t negative_entries = 0;
+    size_t max_entries = 0;
+    double entry_ttl = 0.0;       ///< Seconds
+    double negative_ttl = 0.0;    ///< Seconds
+};
+
+/**
+ * Result of a dentry cache lookup
+ */
+enum class DentryLookup {
+    MISS,
+    POSITIVE,
+    NEGATIVE,
+};
+
+/**
+ * Sharded (parent ino, name) -> entry cache.
+ */
+class DentryCache {
+public:
+    static constexpr size_t kShardCount = 16;
+
+    static DentryCache& Instance();
+
+    /**
+     * @brief Configure TTLs and capacity
+     * @param entry_ttl Lifetime of positive entries in seconds (0 = not cached)
+     * @param negative_ttl Lifetime of negative entries in seconds (0 = not cached)
+     * @param max_entries Capacity across all shards (0 = unbounded)
+     */
+    void Configure(double entry_ttl, double negative_ttl, size_t max_entries);
+
+    bool Enabled() const { return enabled_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Look up a name
+     * @param parent Parent directory inode
+     * @param name Entry name
+     * @param entry Receives the cached entry on POSITIVE (timeouts clamped to the remaining TTL)
+     */
+    DentryLookup Lookup(fuse_ino_t parent, const std::string& name, fuse_entry_param* entry);
+
+    /**
+     * @brief Inode a name currently resolves to, without counting a hit or miss
+     *
+     * Expired positive entries still answer; used to find the child of an
+     * unlink/rmdir/rename before its name is dropped.
+     * @return false for unknown and negative entries
+     */
+    bool PeekIno(fuse_ino_t parent, const std::string& name, fuse_ino_t* ino) const;
+
+    /**
+     * @brief Current epoch of the shard holding (parent, name)
+     *
+     * Capture before dispatching a lookup and pass to Store*().
+     */
+    uint64_t Epoch(fuse_ino_t parent, const std::string& name);
+
+    /**
+     * @brief Store a positive entry
+     * @param epoch Epoch captured at dispatch; stale replies are dropped
+     */
+    void StorePositive(fuse_ino_t parent, const std::string& name,
+                       const fuse_entry_param& entry, uint64_t epoch);
+
+    /**
+     * @brief Store a negative entry
+     * @param epoch Epoch captured at dispatch; stale replies are dropped
+     */
+    void StoreNegative(fuse_ino_t parent, const std::string& name, uint64_t epoch);
+
+    /**
+     * @brief Drop one name
+     * @return true if an entry was removed
+     */
+    bool Invalidate(fuse_ino_t parent, const std::string& name);
+
+    /**
+     * @brief Drop all names below a directory
+     * @return Number of removed entries
+     */
+    size_t InvalidateParent(fuse_ino_t parent);
+
+    void Clear();
+
+    DentryCacheStats GetStats() const;
+
+    void ResetStats();
+
+private:
+    DentryCache() = default;
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Key {
+        fuse_ino_t parent;
+        std::string name;
+
+        bool operator==(const Key& other) const {
+            return parent == other.parent && name == other.name;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            return std::hash<std::string>()(key.name) ^
+                   (static_cast<size_t>(key.parent) * 0x9E3779B97F4A7C15ULL);
+        }
+    };
+
+    struct Entry {
+        bool negative;
+        fuse_entry_param entry;
+        Clock::time_point expires;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<Key, Entry, KeyHash> entries;
+        uint64_t epoch = 0;
+    };
+
+    Shard& ShardFor(const Key& key) { return shards_[KeyHash()(key) % kShardCount]; }
+    const Shard& ShardFor(const Key& key) const { return shards_[KeyHash()(key) % kShardCount]; }
+
+    void StoreLocked(Shard& shard, Key key, Entry entry);
+
+    std::array<Shard, kShardCount> shards_;
+    std::atomic<bool> enabled_{false};
+    std::atomic<int64_t> entry_ttl_ns_{0};
+    std::atomic<int64_t> negative_ttl_ns_{0};
+    std::atomic<size_t> shard_capacity_{0};
+    std::atomic<size_t> max_entries_{0};
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> negative_hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> inserts_{0};
+    std::atomic<uint64_t> negative_inserts_{0};
+    std::atomic<uint64_t> invalidations_{0};
+    std::atomic<uint64_t> expirations_{0};
+    std::atomic<uint64_t> evictions_{0};
+};
+
+/**
+ * N-API exposed functions
+ */
+
+/**
+ * Configure the dentry cache (N-API exposed function)
+ * @param info N-API callback info containing `{entryTtl, negativeTtl, maxEntries?}`
+ * @return Boolean indicating success
+ */
+Napi::Value ConfigureDentryCache(const Napi::CallbackInfo& info);
+
+/**
+ * Drop cached names (N-API exposed function)
+ * @param info N-API callback info containing parent (bigint) and optional name;
+ *             without a name every entry below the parent is dropped
+ * @return Number of removed entries
+ */
+Napi::Value InvalidateDentryCache(const Napi::CallbackInfo& info);
+
+/**
+ * Get dentry cache statistics (N-API exposed function)
+ * @param info N-API callback info
+ * @return Object containing statistics
+ */
+Napi::Value GetDentryCacheStats(const Napi::CallbackInfo& info);
+
+/**
+ * Drop all cached names and reset statistics (N-API exposed function)
+ * @param info N-API callback info
+ * @return Boolean indicating success
+ */
+Napi::Value ClearDentryCache(const Napi::CallbackInfo& info);
+
+} // namespace fuse_native
+
+#endif // DENTRY_CACHE_H
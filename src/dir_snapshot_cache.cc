@@ -0,0 +1,240 @@
+/**
+ * @file dir_snapshot_cache.cc
+ * @brief Per-handle directory snapshots serving readdir continuations natively
+ */
+
+#include "dir_snapshot_cache.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+
+#include "logging.h"
+#include "napi_helpers.h"
+
+namespace fuse_native {
+
+size_t DirSnapshot::ResumeIndex(uint64_t offset) const {
+    const size_t count = entries->count;
+    if (offset == 0) {
+        return 0;
+    }
+    const uint64_t* begin = entries->offsets;
+    const uint64_t* end = begin + count;
+    if (monotonic_offsets) {
+        return static_cast<size_t>(std::upper_bound(begin, end, offset) - begin);
+    }
+    // Unbekannter Offset (z.B. seekdir aus einem älteren Listing): nicht als EOF melden
+    const uint64_t* hit = std::find(begin, end, offset);
+    return hit == end ? kNotFound : static_cast<size_t>(hit - begin) + 1;
+}
+
+DirSnapshotCache& DirSnapshotCache::Instance() {
+    static DirSnapshotCache instance;
+    return instance;
+}
+
+void DirSnapshotCache::Configure(size_t max_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_bytes_ = max_bytes;
+    while (bytes_ > max_bytes_ && !lru_.empty()) {
+        EvictLocked(lru_.back());
+        stats_.evictions++;
+    }
+}
+
+bool DirSnapshotCache::Enabled() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return max_bytes_ > 0;
+}
+
+void DirSnapshotCache::Open(uint64_t fh, fuse_ino_t ino) {
+    const DirHandleKey key{fh, ino};
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (++opens_[key] > 1 && slots_.count(key) != 0) {
+        EvictLocked(key);
+        stats_.shared++;
+    }
+}
+
+bool DirSnapshotCache::Insert(uint64_t fh, std::shared_ptr<DirSnapshot> snapshot) {
+    if (!snapshot) {
+        return false;
+    }
+    const DirHandleKey key{fh, snapshot->ino};
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (max_bytes_ == 0) {
+        return false;
+    }
+    // Ohne genau ein opendir gäbe es kein releasedir bzw. mehrere Leser
+    auto open = opens_.find(key);
+    if (open == opens_.end() || open->second != 1) {
+        stats_.shared++;
+        return false;
+    }
+    if (snapshot->bytes > max_bytes_) {
+        stats_.rejected++;
+        return false;
+    }
+
+    if (slots_.count(key) != 0) {
+        EvictLocked(key);
+    }
+    while (bytes_ + snapshot->bytes > max_bytes_ && !lru_.empty()) {
+        FUSE_LOG_DEBUG("dir snapshot: evicting fh=%" PRIu64 " ino=%" PRIu64, lru_.back().fh,
+                       static_cast<uint64_t>(lru_.back().ino));
+        EvictLocked(lru_.back());
+        stats_.evictions++;
+    }
+
+    lru_.push_front(key);
+    bytes_ += snapshot->bytes;
+    slots_[key] = Slot{std::move(snapshot), lru_.begin()};
+    stats_.inserts++;
+    return true;
+}
+
+std::shared_ptr<DirSnapshot> DirSnapshotCache::Find(uint64_t fh, fuse_ino_t ino) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (max_bytes_ == 0) {
+        return nullptr;
+    }
+    auto it = slots_.find(DirHandleKey{fh, ino});
+    if (it == slots_.end()) {
+        stats_.misses++;
+        return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second.lru_pos);
+    stats_.hits++;
+    return it->second.snapshot;
+}
+
+void DirSnapshotCache::Release(uint64_t fh, fuse_ino_t ino) {
+    const DirHandleKey key{fh, ino};
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto open = opens_.find(key);
+    if (open != opens_.end() && --open->second == 0) {
+        opens_.erase(open);
+    }
+    if (slots_.count(key) != 0) {
+        EvictLocked(key);
+        stats_.releases++;
+    }
+}
+
+void DirSnapshotCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    slots_.clear();
+    lru_.clear();
+    bytes_ = 0;
+}
+
+DirSnapshotCacheStats DirSnapshotCache::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    DirSnapshotCacheStats stats = stats_;
+    stats.entries = slots_.size();
+    stats.bytes = bytes_;
+    stats.max_bytes = max_bytes_;
+    return stats;
+}
+
+void DirSnapshotCache::ResetStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_ = DirSnapshotCacheStats{};
+}
+
+void DirSnapshotCache::EvictLocked(const DirHandleKey& key) {
+    auto it = slots_.find(key);
+    if (it == slots_.end()) {
+        return;
+    }
+    bytes_ -= it->second.snapshot->bytes;
+    lru_.erase(it->second.lru_pos);
+    slots_.erase(it);
+}
+
+std::shared_ptr<DirSnapshot> DirSnapshotCache::Build(fuse_ino_t ino, const ColumnarDirents& cols,
+                                                     uint64_t base_offset) {
+    auto snapshot = std::make_shared<DirSnapshot>();
+    snapshot->ino = ino;
+    snapshot->entries = CopyColumnarDirents(cols, base_offset);
+    const uint64_t* offsets = snapshot->entries->offsets;
+    snapshot->monotonic_offsets =
+        std::adjacent_find(offsets, offsets + snapshot->entries->count,
+                           [](uint64_t a, uint64_t b) { return a >= b; }) ==
+        offsets + snapshot->entries->count;
+    snapshot->bytes = sizeof(DirSnapshot) + snapshot->entries->MemoryBytes();
+    return snapshot;
+}
+
+int DecodeDirSnapshot(Napi::Env env, const Napi::Object& listing, fuse_ino_t ino,
+                      uint64_t base_offset, std::shared_ptr<DirSnapshot>* out) {
+    if (IsColumnarReaddirResult(listing)) {
+        ColumnarDirents cols;
+        const int err = DecodeColumnarDirents(listing, &cols);
+        if (err != 0) {
+            return err;
+        }
+        *out = DirSnapshotCache::Build(ino, cols, base_offset);
+        return 0;
+    }
+
+    Napi::Value entries = listing.Get("entries");
+    if (!entries.IsArray()) {
+        return EIO;
+    }
+    ColumnarDirents cols;
+    const int err = DecodeDirentEntries(env, entries.As<Napi::Array>(), base_offset, &cols);
+    if (err != 0) {
+        return err;
+    }
+    *out = DirSnapshotCache::Build(ino, cols, base_offset);
+    return 0;
+}
+
+Napi::Value ConfigureDirSnapshotCache(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        NapiHelpers::ThrowTypeError(env, "Expected configuration object");
+        return env.Undefined();
+    }
+
+    Napi::Object config = info[0].As<Napi::Object>();
+    Napi::Value max_bytes = config.Get("maxBytes");
+    if (!max_bytes.IsNumber() || max_bytes.As<Napi::Number>().DoubleValue() < 0) {
+        NapiHelpers::ThrowTypeError(env, "maxBytes must be a non-negative number");
+        return env.Undefined();
+    }
+
+    DirSnapshotCache::Instance().Configure(
+        static_cast<size_t>(max_bytes.As<Napi::Number>().Int64Value()));
+    return Napi::Boolean::New(env, true);
+}
+
+Napi::Value GetDirSnapshotCacheStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    const DirSnapshotCacheStats stats = DirSnapshotCache::Instance().GetStats();
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("hits", NapiHelpers::CreateBigUint64(env, stats.hits));
+    result.Set("misses", NapiHelpers::CreateBigUint64(env, stats.misses));
+    result.Set("inserts", NapiHelpers::CreateBigUint64(env, stats.inserts));
+    result.Set("evictions", NapiHelpers::CreateBigUint64(env, stats.evictions));
+    result.Set("rejected", NapiHelpers::CreateBigUint64(env, stats.rejected));
+    result.Set("releases", NapiHelpers::CreateBigUint64(env, stats.releases));
+    result.Set("shared", NapiHelpers::CreateBigUint64(env, stats.shared));
+    result.Set("entries", Napi::Number::New(env, static_cast<double>(stats.entries)));
+    result.Set("bytes", Napi::Number::New(env, static_cast<double>(stats.bytes)));
+    result.Set("maxBytes", Napi::Number::New(env, static_cast<double>(stats.max_bytes)));
+    return result;
+}
+
+Napi::Value ClearDirSnapshotCache(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    DirSnapshotCache::Instance().Clear();
+    DirSnapshotCache::Instance().ResetStats();
+    return Napi::Boolean::New(env, true);
+}
+
+} // namespace fuse_native
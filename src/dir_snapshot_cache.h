@@ -0,0 +1,206 @@
+/**
+ * @file dir_snapshot_cache.h
+ * @brief Per-handle directory snapshots serving readdir continuations natively
+ *
+ * The kernel reads directories in ~4 KiB chunks, so a large listing costs
+ * hundreds of readdir round-trips into JS. When a handler opts in (full
+ * listing from opendir, or a readdir result flagged `snapshot: true`) the
+ * bridge keeps the packed listing keyed by `fi->fh` and the directory inode
+ * and answers every later offset itself until releasedir. Snapshots are
+ * bounded by a byte budget and evicted least-recently-used first; an evicted
+ * handle simply falls back to the JS readdir handler.
+ *
+ * Opens are counted per (fh, ino). A handle shared by several opendirs of the
+ * same directory never holds a snapshot, since a continuation could not be
+ * attributed to one listing.
+ */
+
+#ifndef DIR_SNAPSHOT_CACHE_H
+#define DIR_SNAPSHOT_CACHE_H
+
+#include <napi.h>
+#include <fuse3/fuse_lowlevel.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "dirent_packer.h"
+
+namespace fuse_native {
+
+/**
+ * Immutable directory listing captured for one open directory handle.
+ */
+struct DirSnapshot {
+    fuse_ino_t ino = 0;
+    std::unique_ptr<ColumnarDirents> entries;  ///< Owned, explicit offsets
+    bool monotonic_offsets = true;             ///< Enables binary search on resume
+    size_t bytes = 0;
+
+    static constexpr size_t kNotFound = SIZE_MAX;
+
+    /**
+     * @brief Index of the first entry to return for a kernel offset
+     * @param offset Offset passed to readdir (0 or a previous entry's offset)
+     * @return Entry index, count if the offset is past the end, or kNotFound
+     *         if the offset does not belong to this listing (non-monotonic
+     *         offsets only); the caller then falls back to JS
+     */
+    size_t ResumeIndex(uint64_t offset) const;
+};
+
+/**
+ * Snapshot cache statistics
+ */
+struct DirSnapshotCacheStats {
+    uint64_t hits = 0;        ///< readdir calls answered from a snapshot
+    uint64_t misses = 0;      ///< readdir calls on handles without a snapshot
+    uint64_t inserts = 0;
+    uint64_t evictions = 0;   ///< Dropped to honour the byte budget
+    uint64_t rejected = 0;    ///< Larger than the budget, never cached
+    uint64_t releases = 0;    ///< Dropped by releasedir
+    uint64_t shared = 0;      ///< Not cached because several opens share the handle
+    size_t entries = 0;       ///< Cached handles
+    size_t bytes = 0;         ///< Cached bytes
+    size_t max_bytes = 0;
+};
+
+/**
+ * Identity of an open directory: handle plus directory inode
+ */
+struct DirHandleKey {
+    uint64_t fh = 0;
+    fuse_ino_t ino = 0;
+
+    bool operator==(const DirHandleKey& other) const { return fh == other.fh && ino == other.ino; }
+};
+
+struct DirHandleKeyHash {
+    size_t operator()(const DirHandleKey& key) const {
+        return std::hash<uint64_t>()(key.fh) ^ (std::hash<uint64_t>()(key.ino) * 0x9e3779b97f4a7c15ULL);
+    }
+};
+
+/**
+ * LRU cache of directory snapshots keyed by directory handle and inode.
+ */
+class DirSnapshotCache {
+public:
+    static DirSnapshotCache& Instance();
+
+    /**
+     * @brief Set the byte budget; 0 disables caching and drops all snapshots
+     */
+    void Configure(size_t max_bytes);
+
+    bool Enabled() const;
+
+    /**
+     * @brief Count an opendir reply for a handle
+     *
+     * A second open of the same (fh, ino) drops its snapshot.
+     */
+    void Open(uint64_t fh, fuse_ino_t ino);
+
+    /**
+     * @brief Store a snapshot for a handle, evicting LRU snapshots as needed
+     * @return false if caching is disabled, the snapshot exceeds the budget or
+     *         the handle is not owned by exactly one open
+     */
+    bool Insert(uint64_t fh, std::shared_ptr<DirSnapshot> snapshot);
+
+    /**
+     * @brief Look up the snapshot of an open directory
+     * @param fh Directory file handle
+     * @param ino Directory inode
+     * @return Snapshot or nullptr
+     */
+    std::shared_ptr<DirSnapshot> Find(uint64_t fh, fuse_ino_t ino);
+
+    /**
+     * @brief Count a releasedir and drop the handle's snapshot
+     */
+    void Release(uint64_t fh, fuse_ino_t ino);
+
+    void Clear();
+
+    DirSnapshotCacheStats GetStats() const;
+
+    void ResetStats();
+
+    /**
+     * @brief Build a snapshot from decoded entries (deep copy)
+     * @param ino Directory inode
+     * @param cols Entries in listing order
+     * @param base_offset Offset used to derive missing entry offsets
+     */
+    static std::shared_ptr<DirSnapshot> Build(fuse_ino_t ino, const ColumnarDirents& cols,
+                                              uint64_t base_offset);
+
+private:
+    DirSnapshotCache() = default;
+
+    struct Slot {
+        std::shared_ptr<DirSnapshot> snapshot;
+        std::list<DirHandleKey>::iterator lru_pos;
+    };
+
+    void EvictLocked(const DirHandleKey& key);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<DirHandleKey, Slot, DirHandleKeyHash> slots_;
+    std::unordered_map<DirHandleKey, uint32_t, DirHandleKeyHash> opens_;  ///< Open count per handle
+    std::list<DirHandleKey> lru_;  ///< Front = most recently used
+    size_t max_bytes_ = 0;
+    size_t bytes_ = 0;
+    DirSnapshotCacheStats stats_;
+};
+
+/**
+ * @brief Decode a snapshot listing from a handler result
+ *
+ * Accepts `{entries: DirentEntry[]}` or the columnar readdir layout.
+ *
+ * @param env N-API environment
+ * @param listing Listing object
+ * @param ino Directory inode
+ * @param base_offset Offset used to derive missing entry offsets
+ * @param out Resulting snapshot
+ * @return 0 on success, positive errno on malformed input
+ */
+int DecodeDirSnapshot(Napi::Env env, const Napi::Object& listing, fuse_ino_t ino,
+                      uint64_t base_offset, std::shared_ptr<DirSnapshot>* out);
+
+/**
+ * N-API exposed functions
+ */
+
+/**
+ * Configure the snapshot cache (N-API exposed function)
+ * @param info N-API callback info containing `{maxBytes}`
+ * @return Boolean indicating success
+ */
+Napi::Value ConfigureDirSnapshotCache(const Napi::CallbackInfo& info);
+
+/**
+ * Get snapshot cache statistics (N-API exposed function)
+ * @param info N-API callback info
+ * @return Object containing statistics
+ */
+Napi::Value GetDirSnapshotCacheStats(const Napi::CallbackInfo& info);
+
+/**
+ * Drop all snapshots (N-API exposed function)
+ * @param info N-API callback info
+ * @return Boolean indicating success
+ */
+Napi::Value ClearDirSnapshotCache(const Napi::CallbackInfo& info);
+
+} // namespace fuse_native
+
+#endif // DIR_SNAPSHOT_CACHE_H
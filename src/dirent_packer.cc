@@ -0,0 +1,349 @@
+/**
+ * @file dirent_packer.cc
+ * @brief Columnar readdir result decoding and native dirent packing
+ */
+
+#include "dirent_packer.h"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+
+namespace fuse_native {
+
+namespace {
+
+constexpr size_t kMaxNameLength = 255;
+
+template <typename T>
+bool GetTypedColumn(const Napi::Object& obj, const char* key, napi_typedarray_type type,
+                    const T** data, size_t* length) {
+    Napi::Value value = obj.Get(key);
+    if (!value.IsTypedArray()) {
+        return false;
+    }
+    Napi::TypedArray array = value.As<Napi::TypedArray>();
+    if (array.TypedArrayType() != type) {
+        return false;
+    }
+    *data = reinterpret_cast<const T*>(
+        static_cast<const uint8_t*>(array.ArrayBuffer().Data()) + array.ByteOffset());
+    *length = array.ElementLength();
+    return true;
+}
+
+int DecodeNameArray(const Napi::Array& names, ColumnarDirents* out) {
+    if (names.Length() < out->count) {
+        return EIO;
+    }
+
+    // Copy all names into one NUL-separated block, then index it; pointers are
+    // taken after the block stops growing.
+    std::vector<size_t> starts;
+    starts.reserve(out->count);
+    out->name_storage.clear();
+    out->name_storage.reserve(out->count * 16);
+    for (size_t i = 0; i < out->count; ++i) {
+        Napi::Value item = names.Get(static_cast<uint32_t>(i));
+        if (!item.IsString()) {
+            return EIO;
+        }
+        std::string name = item.As<Napi::String>().Utf8Value();
+        if (name.empty() || name.size() > kMaxNameLength) {
+            return EIO;
+        }
+        starts.push_back(out->name_storage.size());
+        out->name_storage.append(name);
+        out->name_storage.push_back('\0');
+    }
+
+    out->name_ptrs.resize(out->count);
+    for (size_t i = 0; i < out->count; ++i) {
+        out->name_ptrs[i] = out->name_storage.data() + starts[i];
+    }
+    out->names = out->name_ptrs.data();
+    return 0;
+}
+
+int DecodeNameBlob(const Napi::Object& result, ColumnarDirents* out) {
+    const uint8_t* blob = nullptr;
+    size_t blob_len = 0;
+    if (!GetTypedColumn(result, "names", napi_uint8_array, &blob, &blob_len)) {
+        return EIO;
+    }
+
+    out->name_ptrs.resize(out->count);
+    out->names = out->name_ptrs.data();
+
+    const uint32_t* lengths = nullptr;
+    size_t lengths_len = 0;
+    if (result.Has("nameLengths") && !result.Get("nameLengths").IsUndefined()) {
+        if (!GetTypedColumn(result, "nameLengths", napi_uint32_array, &lengths, &lengths_len) ||
+            lengths_len < out->count) {
+            return EIO;
+        }
+
+        // Packed without terminators: re-emit with NULs for fuse_add_direntry.
+        out->name_storage.resize(blob_len + out->count);
+        size_t src = 0;
+        size_t dst = 0;
+        for (size_t i = 0; i < out->count; ++i) {
+            const size_t len = lengths[i];
+            if (len == 0 || len > kMaxNameLength || len > blob_len - src) {
+                return EIO;
+            }
+            std::memcpy(&out->name_storage[dst], blob + src, len);
+            out->name_storage[dst + len] = '\0';
+            out->name_ptrs[i] = out->name_storage.data() + dst;
+            src += len;
+            dst += len + 1;
+        }
+        return 0;
+    }
+
+    // NUL-separated blob: names point straight into JS memory.
+    size_t pos = 0;
+    for (size_t i = 0; i < out->count; ++i) {
+        const void* nul = pos < blob_len ? std::memchr(blob + pos, 0, blob_len - pos) : nullptr;
+        if (!nul) {
+            return EIO;
+        }
+        const size_t len = static_cast<const uint8_t*>(nul) - (blob + pos);
+        if (len == 0 || len > kMaxNameLength) {
+            return EIO;
+        }
+        out->name_ptrs[i] = reinterpret_cast<const char*>(blob + pos);
+        pos += len + 1;
+    }
+    return 0;
+}
+
+bool ReadOffset(const Napi::Value& value, off_t* out) {
+    if (value.IsBigInt()) {
+        bool lossless = false;
+        *out = static_cast<off_t>(value.As<Napi::BigInt>().Int64Value(&lossless));
+        return lossless && *out >= 0;
+    }
+    if (value.IsNumber()) {
+        *out = static_cast<off_t>(value.As<Napi::Number>().Int64Value());
+        return *out >= 0;
+    }
+    return false;
+}
+
+// Index names once the storage has stopped growing.
+void IndexNames(ColumnarDirents* cols, const std::vector<size_t>& starts) {
+    cols->name_ptrs.resize(starts.size());
+    for (size_t i = 0; i < starts.size(); ++i) {
+        cols->name_ptrs[i] = cols->name_storage.data() + starts[i];
+    }
+    cols->names = cols->name_ptrs.data();
+}
+
+} // namespace
+
+ColumnarDirents ColumnarDirents::Slice(size_t first) const {
+    ColumnarDirents view;
+    first = std::min(first, count);
+    view.count = count - first;
+    view.inos = inos + first;
+    view.offsets = offsets ? offsets + first : nullptr;
+    view.types = types ? types + first : nullptr;
+    view.names = names + first;
+    return view;
+}
+
+size_t ColumnarDirents::MemoryBytes() const {
+    return sizeof(*this) + name_storage.capacity() +
+           name_ptrs.capacity() * sizeof(const char*) +
+           ino_storage.capacity() * sizeof(uint64_t) +
+           offset_storage.capacity() * sizeof(uint64_t) +
+           type_storage.capacity();
+}
+
+std::unique_ptr<ColumnarDirents> CopyColumnarDirents(const ColumnarDirents& src,
+                                                     uint64_t base_offset) {
+    auto out = std::make_unique<ColumnarDirents>();
+    const size_t n = src.count;
+    out->count = n;
+    out->ino_storage.assign(src.inos, src.inos + n);
+    out->offset_storage.resize(n);
+    out->type_storage.resize(n, 0);
+
+    std::vector<size_t> starts(n);
+    size_t total = 0;
+    for (size_t i = 0; i < n; ++i) {
+        total += std::strlen(src.names[i]) + 1;
+    }
+    out->name_storage.reserve(total);
+    for (size_t i = 0; i < n; ++i) {
+        starts[i] = out->name_storage.size();
+        out->name_storage.append(src.names[i]);
+        out->name_storage.push_back('\0');
+        out->offset_storage[i] = src.offsets ? src.offsets[i] : base_offset + i + 1;
+        if (src.types) {
+            out->type_storage[i] = src.types[i];
+        }
+    }
+
+    out->inos = out->ino_storage.data();
+    out->offsets = out->offset_storage.data();
+    out->types = out->type_storage.data();
+    IndexNames(out.get(), starts);
+    return out;
+}
+
+int DecodeDirentEntries(Napi::Env env, const Napi::Array& entries, uint64_t base_offset,
+                        ColumnarDirents* out) {
+    const uint32_t length = entries.Length();
+    std::vector<size_t> starts;
+    starts.reserve(length);
+    out->ino_storage.reserve(length);
+    out->offset_storage.reserve(length);
+    out->type_storage.reserve(length);
+
+    for (uint32_t i = 0; i < length; ++i) {
+        Napi::Value item = entries.Get(i);
+        if (!item.IsObject()) continue;
+        Napi::Object entry = item.As<Napi::Object>();
+
+        Napi::Value name_value = entry.Get("name");
+        if (!name_value.IsString()) {
+            return EIO;
+        }
+        const std::string name = name_value.As<Napi::String>().Utf8Value();
+        if (name.empty() || name.size() > kMaxNameLength) {
+            return EIO;
+        }
+
+        Napi::Value ino_value = entry.Get("ino");
+        if (!ino_value.IsBigInt()) {
+            return EIO;
+        }
+        bool lossless = false;
+        const uint64_t ino = ino_value.As<Napi::BigInt>().Uint64Value(&lossless);
+        if (!lossless) {
+            return EIO;
+        }
+
+        off_t next = static_cast<off_t>(base_offset + i + 1);
+        Napi::Value next_value = entry.Get("nextOffset");
+        if (!next_value.IsUndefined() && !ReadOffset(next_value, &next)) {
+            return EIO;
+        }
+
+        Napi::Value type_value = entry.Get("type");
+        const uint8_t type = type_value.IsNumber()
+                                 ? static_cast<uint8_t>(type_value.As<Napi::Number>().Uint32Value())
+                                 : 0;
+
+        starts.push_back(out->name_storage.size());
+        out->name_storage.append(name);
+        out->name_storage.push_back('\0');
+        out->ino_storage.push_back(ino);
+        out->offset_storage.push_back(static_cast<uint64_t>(next));
+        out->type_storage.push_back(type);
+    }
+
+    out->count = starts.size();
+    out->inos = out->ino_storage.data();
+    out->offsets = out->offset_storage.data();
+    out->types = out->type_storage.data();
+    IndexNames(out, starts);
+    return 0;
+}
+
+bool IsColumnarReaddirResult(const Napi::Object& result) {
+    Napi::Value inos = result.Get("inos");
+    return inos.IsTypedArray() &&
+           inos.As<Napi::TypedArray>().TypedArrayType() == napi_biguint64_array;
+}
+
+int DecodeColumnarDirents(const Napi::Object& result, ColumnarDirents* out) {
+    size_t ino_count = 0;
+    if (!GetTypedColumn(result, "inos", napi_biguint64_array, &out->inos, &ino_count)) {
+        return EIO;
+    }
+    out->count = ino_count;
+
+    size_t len = 0;
+    if (result.Has("offsets") && !result.Get("offsets").IsUndefined()) {
+        if (!GetTypedColumn(result, "offsets", napi_biguint64_array, &out->offsets, &len) ||
+            len < out->count) {
+            return EIO;
+        }
+        constexpr uint64_t kMaxOff = static_cast<uint64_t>(std::numeric_limits<off_t>::max());
+        for (size_t i = 0; i < out->count; ++i) {
+            if (out->offsets[i] > kMaxOff) {
+                return EIO;
+            }
+        }
+    }
+
+    if (result.Has("types") && !result.Get("types").IsUndefined()) {
+        if (!GetTypedColumn(result, "types", napi_uint8_array, &out->types, &len) ||
+            len < out->count) {
+            return EIO;
+        }
+    }
+
+    Napi::Value names = result.Get("names");
+    if (names.IsArray()) {
+        return DecodeNameArray(names.As<Napi::Array>(), out);
+    }
+    return DecodeNameBlob(result, out);
+}
+
+size_t PackDirents(fuse_req_t req, const ColumnarDirents& cols, uint64_t base_offset,
+                   char* buf, size_t max_size) {
+    size_t used = 0;
+    struct stat st{};
+    for (size_t i = 0; i < cols.count; ++i) {
+        st.st_ino = cols.inos[i];
+        st.st_mode = cols.types ? static_cast<mode_t>((cols.types[i] & 0xF) << 12) : 0;
+        const off_t next = static_cast<off_t>(cols.offsets ? cols.offsets[i] : base_offset + i + 1);
+
+        // fuse_add_direntry only writes when the entry fits; it always returns the size.
+        const size_t need = fuse_add_direntry(req, buf + used, max_size - used,
+                                              cols.names[i], &st, next);
+        if (need > max_size - used) {
+            break;
+        }
+        used += need;
+    }
+    return used;
+}
+
+size_t PackDirentsPlus(fuse_req_t req, const ColumnarDirents& cols, uint64_t base_offset,
+                       const std::function<fuse_entry_param(uint64_t, int)>& make_entry,
+                       char* buf, size_t max_size, std::vector<uint64_t>* linked) {
+    size_t used = 0;
+    for (size_t i = 0; i < cols.count; ++i) {
+        const int type = cols.types ? cols.types[i] : 0;
+        fuse_entry_param e = make_entry(cols.inos[i], type);
+        const off_t next = static_cast<off_t>(cols.offsets ? cols.offsets[i] : base_offset + i + 1);
+
+        const size_t need = fuse_add_direntry_plus(req, buf + used, max_size - used,
+                                                   cols.names[i], &e, next);
+        if (need > max_size - used) {
+            break;
+        }
+        used += need;
+        if (linked && CountsAsLookup(cols.names[i], e.ino)) {
+            linked->push_back(e.ino);
+        }
+    }
+    return used;
+}
+
+bool CountsAsLookup(const char* name, uint64_t ino) {
+    if (ino == 0 || name == nullptr) {
+        return false;
+    }
+    return !(name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')));
+}
+
+} // namespace fuse_native
@@ -0,0 +1,140 @@
+/**
+ * @file dirent_packer.h
+ * @brief Columnar readdir result decoding and native dirent packing
+ *
+ * Large directories are expensive to return as arrays of `{name, ino, type,
+ * nextOffset}` objects: every entry costs several property lookups and a
+ * BigInt conversion on the JS thread. The columnar format lets handlers hand
+ * over whole columns (typed arrays plus one names column) which are packed
+ * into the kernel dirent buffer with fuse_add_direntry in a single loop.
+ */
+
+#ifndef DIRENT_PACKER_H
+#define DIRENT_PACKER_H
+
+#include <napi.h>
+#include <fuse3/fuse_lowlevel.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fuse_native {
+
+/**
+ * Columnar directory entries.
+ *
+ * Column pointers either borrow JS-owned memory (decoded results, valid only
+ * inside the resolve callback) or point into the owned storage vectors
+ * (snapshots). Owned instances must not be copied or moved once the column
+ * pointers are set; hold them behind a pointer.
+ */
+struct ColumnarDirents {
+    size_t count = 0;
+    const uint64_t* inos = nullptr;     ///< Inode numbers, required
+    const uint64_t* offsets = nullptr;  ///< Resume offsets, optional (base + i + 1)
+    const uint8_t* types = nullptr;     ///< DT_* values, optional
+    const char* const* names = nullptr; ///< NUL-terminated names, required
+
+    // Backing storage (unused for fully borrowed views)
+    std::vector<const char*> name_ptrs;
+    std::string name_storage;
+    std::vector<uint64_t> ino_storage;
+    std::vector<uint64_t> offset_storage;
+    std::vector<uint8_t> type_storage;
+
+    /**
+     * @brief Borrowed view of the entries starting at @p first
+     * @param first Index of the first entry (clamped to count)
+     * @return View without backing storage; valid while this object lives
+     */
+    ColumnarDirents Slice(size_t first) const;
+
+    /**
+     * @brief Approximate heap footprint in bytes (for cache accounting)
+     */
+    size_t MemoryBytes() const;
+};
+
+/**
+ * @brief Deep-copy entries into a self-contained instance
+ * @param src Source columns (may borrow JS memory)
+ * @param base_offset Used to materialize offsets when @p src has none
+ * @return Owned columns with explicit offsets
+ */
+std::unique_ptr<ColumnarDirents> CopyColumnarDirents(const ColumnarDirents& src,
+                                                     uint64_t base_offset);
+
+/**
+ * @brief Decode an `entries` array of `{name, ino, type, nextOffset}` objects
+ * @param env N-API environment
+ * @param entries Entry objects
+ * @param base_offset Used when an entry lacks `nextOffset`
+ * @param out Destination (owned storage is filled)
+ * @return 0 on success, positive errno (EIO) on malformed input
+ */
+int DecodeDirentEntries(Napi::Env env, const Napi::Array& entries, uint64_t base_offset,
+                        ColumnarDirents* out);
+
+/**
+ * @brief Check whether a readdir result uses the columnar layout
+ * @param result Resolved handler result
+ * @return true if `inos` is a BigUint64Array
+ */
+bool IsColumnarReaddirResult(const Napi::Object& result);
+
+/**
+ * @brief Decode a columnar readdir result into a borrowed view
+ *
+ * Accepted name encodings:
+ * - `names: string[]`
+ * - `names: Uint8Array` with `nameLengths: Uint32Array` (packed UTF-8)
+ * - `names: Uint8Array` without lengths (NUL-separated UTF-8)
+ *
+ * @param result Resolved handler result
+ * @param out Destination; typed columns are borrowed from @p result
+ * @return 0 on success, positive errno (EIO) on malformed input
+ */
+int DecodeColumnarDirents(const Napi::Object& result, ColumnarDirents* out);
+
+/**
+ * @brief Pack columnar entries with fuse_add_direntry
+ * @param req FUSE request (needed by fuse_add_direntry)
+ * @param cols Decoded columns
+ * @param base_offset Request offset used when `offsets` is absent
+ * @param buf Destination buffer
+ * @param max_size Capacity of @p buf
+ * @return Number of bytes written; stops at the first entry that does not fit
+ */
+size_t PackDirents(fuse_req_t req, const ColumnarDirents& cols, uint64_t base_offset,
+                   char* buf, size_t max_size);
+
+/**
+ * @brief Pack columnar entries with fuse_add_direntry_plus
+ * @param req FUSE request
+ * @param cols Decoded columns
+ * @param base_offset Request offset used when `offsets` is absent
+ * @param make_entry Builds the entry param for (ino, d_type)
+ * @param buf Destination buffer
+ * @param max_size Capacity of @p buf
+ * @param linked Optional; receives the inodes whose lookup count the kernel
+ *               increments for the packed entries
+ * @return Number of bytes written
+ */
+size_t PackDirentsPlus(fuse_req_t req, const ColumnarDirents& cols, uint64_t base_offset,
+                       const std::function<fuse_entry_param(uint64_t, int)>& make_entry,
+                       char* buf, size_t max_size, std::vector<uint64_t>* linked = nullptr);
+
+/**
+ * @brief Whether a readdirplus entry takes a kernel lookup reference
+ *
+ * The kernel links every entry with a non-zero inode except "." and "..".
+ */
+bool CountsAsLookup(const char* name, uint64_t ino);
+
+} // namespace fuse_native
+
+#endif // DIRENT_PACKER_H
@@ -59,6 +59,9 @@ static const std::unordered_map<int, std::string> errno_to_string_map = {
     {ELOOP, "ELOOP"},
     {ENOMSG, "ENOMSG"},
     {EIDRM, "EIDRM"},
+#ifdef ENODATA
+    {ENODATA, "ENODATA"},
+#endif
 #ifdef ENOTSUP
     {ENOTSUP, "ENOTSUP"},
 #endif
@@ -111,6 +114,9 @@ static const std::unordered_map<int, std::string> errno_to_message_map = {
     {ELOOP, "Too many levels of symbolic links"},
     {ENOMSG, "No message of desired type"},
     {EIDRM, "Identifier removed"},
+#ifdef ENODATA
+    {ENODATA, "No data available"},
+#endif
 #ifdef ENOTSUP
     {ENOTSUP, "Operation not supported"},
 #endif
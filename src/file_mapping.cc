@@ -0,0 +1,366 @@
+/**
+ * @file file_mapping.cc
+ * @brief mmap-backed file views exposed as external ArrayBuffers
+ */
+
+#include "file_mapping.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "logging.h"
+#include "napi_helpers.h"
+
+namespace FuseNative {
+
+namespace {
+
+size_t PageSize() {
+    static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return page_size;
+}
+
+bool ParseAdvice(const std::string& name, int* advice) {
+    if (name == "normal") {
+        *advice = MADV_NORMAL;
+    } else if (name == "sequential") {
+        *advice = MADV_SEQUENTIAL;
+    } else if (name == "random") {
+        *advice = MADV_RANDOM;
+    } else if (name == "willneed") {
+        *advice = MADV_WILLNEED;
+    } else if (name == "dontneed") {
+        *advice = MADV_DONTNEED;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+FileMapping::FileMapping(void* base, size_t length) : base_(base), length_(length) {}
+
+FileMapping::~FileMapping() {
+    munmap(base_, length_);
+    FileMappingTable::Instance().OnUnmapped(length_);
+}
+
+FileMappingTable& FileMappingTable::Instance() {
+    // Wie der Buffer-Pool nie zerstört: Finalizer können beim Env-Teardown laufen
+    static FileMappingTable* instance = new FileMappingTable();
+    return *instance;
+}
+
+Napi::Value FileMappingTable::Map(Napi::Env env, int fd, const std::string& path,
+                                  const FileMappingOptions& options) {
+    int owned_fd = -1;
+    if (fd < 0) {
+        const int flags = (options.shared && options.writable ? O_RDWR : O_RDONLY) | O_CLOEXEC;
+        owned_fd = open(path.c_str(), flags);
+        if (owned_fd < 0) {
+            const int err = errno;
+            fuse_native::NapiHelpers::CreateErrnoError(env, err, "open " + path + ": " + std::strerror(err))
+                .ThrowAsJavaScriptException();
+            return env.Undefined();
+        }
+        fd = owned_fd;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0) {
+        const int err = errno;
+        if (owned_fd >= 0) close(owned_fd);
+        fuse_native::NapiHelpers::CreateErrnoError(env, err, std::string("fstat: ") + std::strerror(err))
+            .ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    // Nie über das Dateiende hinaus mappen: Zugriffe dort lösen SIGBUS aus
+    const uint64_t file_size = static_cast<uint64_t>(st.st_size);
+    const uint64_t available = options.offset < file_size ? file_size - options.offset : 0;
+    const uint64_t length = options.length == 0 ? available : std::min(options.length, available);
+    if (length == 0) {
+        if (owned_fd >= 0) close(owned_fd);
+        return Napi::ArrayBuffer::New(env, 0);
+    }
+
+    const uint64_t aligned_offset = options.offset & ~static_cast<uint64_t>(PageSize() - 1);
+    const size_t delta = static_cast<size_t>(options.offset - aligned_offset);
+    const size_t map_length = static_cast<size_t>(length) + delta;
+
+    const int prot = PROT_READ | (!options.shared || options.writable ? PROT_WRITE : 0);
+    int flags = options.shared ? MAP_SHARED : MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    if (options.populate) {
+        flags |= MAP_POPULATE;
+    }
+#endif
+    void* base = mmap(nullptr, map_length, prot, flags, fd, static_cast<off_t>(aligned_offset));
+    const int map_errno = errno;
+    if (owned_fd >= 0) {
+        close(owned_fd);
+    }
+    if (base == MAP_FAILED) {
+        fuse_native::NapiHelpers::CreateErrnoError(env, map_errno, std::string("mmap: ") + std::strerror(map_errno))
+            .ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    if (options.advice >= 0 && madvise(base, map_length, options.advice) != 0) {
+        FUSE_LOG_DEBUG("file mapping: madvise(%d) failed: %s", options.advice, std::strerror(errno));
+    }
+
+    auto mapping = std::make_shared<FileMapping>(base, map_length);
+    active_.fetch_add(1, std::memory_order_relaxed);
+    created_.fetch_add(1, std::memory_order_relaxed);
+    const size_t mapped = mapped_bytes_.fetch_add(map_length, std::memory_order_relaxed) + map_length;
+    size_t peak = peak_mapped_bytes_.load(std::memory_order_relaxed);
+    while (mapped > peak &&
+           !peak_mapped_bytes_.compare_exchange_weak(peak, mapped, std::memory_order_relaxed)) {
+    }
+
+    void* view = static_cast<uint8_t*>(base) + delta;
+    auto* hint = new std::shared_ptr<FileMapping>(mapping);
+    napi_value value = nullptr;
+    if (napi_create_external_arraybuffer(env, view, static_cast<size_t>(length), Finalize, hint, &value) != napi_ok) {
+        delete hint;
+        Napi::Error::New(env, "Failed to create external ArrayBuffer").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        views_[reinterpret_cast<uintptr_t>(view)] = View{static_cast<size_t>(length), mapping};
+    }
+    return Napi::ArrayBuffer(env, value);
+}
+
+void FileMappingTable::Finalize(napi_env env, void* data, void* hint) {
+    (void)env;
+    FileMappingTable& table = Instance();
+    {
+        std::lock_guard<std::mutex> lock(table.mutex_);
+        table.views_.erase(reinterpret_cast<uintptr_t>(data));
+    }
+    // Laufende Antworten halten das Mapping selbst
+    delete static_cast<std::shared_ptr<FileMapping>*>(hint);
+}
+
+std::shared_ptr<FileMapping> FileMappingTable::FindLocked(const void* data, size_t length) const {
+    const uintptr_t start = reinterpret_cast<uintptr_t>(data);
+    auto it = views_.upper_bound(start);
+    if (it == views_.begin()) {
+        return nullptr;
+    }
+    --it;
+    if (start + length > it->first + it->second.length) {
+        return nullptr;
+    }
+    return it->second.mapping.lock();
+}
+
+std::shared_ptr<FileMapping> FileMappingTable::Pin(const void* data, size_t length) {
+    if (!data || length == 0) {
+        return nullptr;
+    }
+    std::shared_ptr<FileMapping> mapping;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (views_.empty()) {
+            return nullptr;
+        }
+        mapping = FindLocked(data, length);
+    }
+    if (mapping) {
+        zero_copy_replies_.fetch_add(1, std::memory_order_relaxed);
+        zero_copy_bytes_.fetch_add(length, std::memory_order_relaxed);
+    }
+    return mapping;
+}
+
+int FileMappingTable::Advise(const void* data, size_t length, int advice) {
+    std::shared_ptr<FileMapping> mapping;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        mapping = FindLocked(data, length);
+    }
+    if (!mapping) {
+        return EINVAL;
+    }
+    if (length == 0) {
+        return 0;
+    }
+    // Auf Seitengrenzen erweitern; die Basis des Mappings ist seitenausgerichtet
+    const uintptr_t base = reinterpret_cast<uintptr_t>(mapping->Base());
+    const uintptr_t start = std::max(base, reinterpret_cast<uintptr_t>(data) & ~(PageSize() - 1));
+    const uintptr_t end = reinterpret_cast<uintptr_t>(data) + length;
+    if (madvise(reinterpret_cast<void*>(start), end - start, advice) != 0) {
+        return errno;
+    }
+    return 0;
+}
+
+void FileMappingTable::OnUnmapped(size_t length) {
+    active_.fetch_sub(1, std::memory_order_relaxed);
+    mapped_bytes_.fetch_sub(length, std::memory_order_relaxed);
+    unmapped_.fetch_add(1, std::memory_order_relaxed);
+}
+
+FileMappingStats FileMappingTable::GetStats() const {
+    FileMappingStats stats;
+    stats.active = active_.load(std::memory_order_relaxed);
+    stats.mapped_bytes = mapped_bytes_.load(std::memory_order_relaxed);
+    stats.peak_mapped_bytes = peak_mapped_bytes_.load(std::memory_order_relaxed);
+    stats.created = created_.load(std::memory_order_relaxed);
+    stats.unmapped = unmapped_.load(std::memory_order_relaxed);
+    stats.zero_copy_replies = zero_copy_replies_.load(std::memory_order_relaxed);
+    stats.zero_copy_bytes = zero_copy_bytes_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace FuseNative
+
+namespace fuse_native {
+
+namespace {
+
+bool ReadOptionalU64(const Napi::Object& object, const char* key, uint64_t* out) {
+    Napi::Value value = object.Get(key);
+    if (value.IsUndefined()) {
+        return true;
+    }
+    if (value.IsBigInt()) {
+        auto parsed = NapiHelpers::SafeGetBigIntU64(value);
+        if (!parsed) {
+            return false;
+        }
+        *out = *parsed;
+        return true;
+    }
+    if (value.IsNumber()) {
+        const int64_t number = value.As<Napi::Number>().Int64Value();
+        if (number < 0) {
+            return false;
+        }
+        *out = static_cast<uint64_t>(number);
+        return true;
+    }
+    return false;
+}
+
+bool ReadOptionalFlag(const Napi::Object& object, const char* key, bool* out) {
+    Napi::Value value = object.Get(key);
+    if (value.IsUndefined()) {
+        return true;
+    }
+    if (!value.IsBoolean()) {
+        return false;
+    }
+    *out = value.As<Napi::Boolean>().Value();
+    return true;
+}
+
+} // namespace
+
+Napi::Value MapFile(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    int fd = -1;
+    std::string path;
+    if (info.Length() >= 1 && info[0].IsString()) {
+        path = info[0].As<Napi::String>().Utf8Value();
+    } else if (info.Length() >= 1 && info[0].IsNumber() && info[0].As<Napi::Number>().Int32Value() >= 0) {
+        fd = info[0].As<Napi::Number>().Int32Value();
+    } else {
+        NapiHelpers::ThrowTypeError(env, "Expected path string or file descriptor");
+        return env.Undefined();
+    }
+
+    FuseNative::FileMappingOptions options;
+    if (info.Length() >= 2 && !info[1].IsUndefined()) {
+        if (!info[1].IsObject()) {
+            NapiHelpers::ThrowTypeError(env, "Expected options object");
+            return env.Undefined();
+        }
+        Napi::Object config = info[1].As<Napi::Object>();
+        if (!ReadOptionalU64(config, "offset", &options.offset) ||
+            !ReadOptionalU64(config, "length", &options.length)) {
+            NapiHelpers::ThrowTypeError(env, "offset and length must be non-negative bigints or numbers");
+            return env.Undefined();
+        }
+        if (!ReadOptionalFlag(config, "shared", &options.shared) ||
+            !ReadOptionalFlag(config, "writable", &options.writable) ||
+            !ReadOptionalFlag(config, "populate", &options.populate)) {
+            NapiHelpers::ThrowTypeError(env, "shared, writable and populate must be booleans");
+            return env.Undefined();
+        }
+        Napi::Value advice = config.Get("advice");
+        if (!advice.IsUndefined() &&
+            (!advice.IsString() || !FuseNative::ParseAdvice(advice.As<Napi::String>().Utf8Value(), &options.advice))) {
+            NapiHelpers::ThrowTypeError(env, "advice must be 'normal', 'sequential', 'random', 'willneed' or 'dontneed'");
+            return env.Undefined();
+        }
+    }
+
+    return FuseNative::FileMappingTable::Instance().Map(env, fd, path, options);
+}
+
+Napi::Value AdviseFileMapping(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 2 || !info[1].IsString()) {
+        NapiHelpers::ThrowTypeError(env, "Expected view and advice");
+        return env.Undefined();
+    }
+    const void* data = nullptr;
+    size_t length = 0;
+    if (info[0].IsArrayBuffer()) {
+        Napi::ArrayBuffer buffer = info[0].As<Napi::ArrayBuffer>();
+        data = buffer.Data();
+        length = buffer.ByteLength();
+    } else if (info[0].IsTypedArray()) {
+        Napi::TypedArray typed = info[0].As<Napi::TypedArray>();
+        data = static_cast<const uint8_t*>(typed.ArrayBuffer().Data()) + typed.ByteOffset();
+        length = typed.ByteLength();
+    } else {
+        NapiHelpers::ThrowTypeError(env, "view must be an ArrayBuffer or TypedArray");
+        return env.Undefined();
+    }
+
+    int advice = -1;
+    if (!FuseNative::ParseAdvice(info[1].As<Napi::String>().Utf8Value(), &advice)) {
+        NapiHelpers::ThrowTypeError(env, "advice must be 'normal', 'sequential', 'random', 'willneed' or 'dontneed'");
+        return env.Undefined();
+    }
+
+    const int err = FuseNative::FileMappingTable::Instance().Advise(data, length, advice);
+    if (err != 0) {
+        NapiHelpers::CreateErrnoError(env, err, err == EINVAL ? "view is not a file mapping" : "madvise failed")
+            .ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    return Napi::Boolean::New(env, true);
+}
+
+Napi::Value GetFileMappingStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    const FuseNative::FileMappingStats stats = FuseNative::FileMappingTable::Instance().GetStats();
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("active", Napi::Number::New(env, static_cast<double>(stats.active)));
+    result.Set("mappedBytes", Napi::Number::New(env, static_cast<double>(stats.mapped_bytes)));
+    result.Set("peakMappedBytes", Napi::Number::New(env, static_cast<double>(stats.peak_mapped_bytes)));
+    result.Set("created", NapiHelpers::CreateBigUint64(env, stats.created));
+    result.Set("unmapped", NapiHelpers::CreateBigUint64(env, stats.unmapped));
+    result.Set("zeroCopyReplies", NapiHelpers::CreateBigUint64(env, stats.zero_copy_replies));
+    result.Set("zeroCopyBytes", NapiHelpers::CreateBigUint64(env, stats.zero_copy_bytes));
+    return result;
+}
+
+} // namespace fuse_native
@@ -0,0 +1,167 @@
+/**
+ * @file file_mapping.h
+ * @brief mmap-backed file views exposed as external ArrayBuffers
+ *
+ * Read-only backends that serve data out of large local files (pack files,
+ * archives) would otherwise pread every request into a fresh buffer. A file
+ * view maps a range of the file once; handlers return subarrays of it and
+ * the bridge replies straight from the mapping, so the data only moves from
+ * the page cache into the kernel reply.
+ *
+ * Every view is registered by address. Read and read_buf replies whose
+ * memory lies inside a registered view pin the mapping natively instead of
+ * copying it, so a reply finishing on a worker thread keeps the pages mapped
+ * even if the ArrayBuffer is collected meanwhile. The mapping is unmapped
+ * when the GC finalizer has run and the last in-flight reply is done.
+ *
+ * Truncating the file below a mapped range makes accesses to the missing
+ * pages raise SIGBUS; only map files that are not shrunk while mapped.
+ */
+
+#ifndef FUSE_NATIVE_FILE_MAPPING_H
+#define FUSE_NATIVE_FILE_MAPPING_H
+
+#include <napi.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace FuseNative {
+
+/**
+ * One mmap'ed file range; unmapped by the destructor
+ */
+class FileMapping {
+public:
+    FileMapping(void* base, size_t length);
+    ~FileMapping();
+
+    FileMapping(const FileMapping&) = delete;
+    FileMapping& operator=(const FileMapping&) = delete;
+
+    void* Base() const { return base_; }
+    size_t Length() const { return length_; }
+
+private:
+    void* base_;
+    size_t length_;
+};
+
+/**
+ * Options of a file view
+ */
+struct FileMappingOptions {
+    uint64_t offset = 0;
+    uint64_t length = 0;          ///< 0 = up to the end of the file
+    bool shared = false;          ///< MAP_SHARED instead of MAP_PRIVATE
+    bool writable = false;        ///< Shared views only: PROT_WRITE, writes reach the file
+    bool populate = false;        ///< MAP_POPULATE (prefault the range)
+    int advice = -1;              ///< madvise() advice, -1 = none
+};
+
+/**
+ * File mapping statistics
+ */
+struct FileMappingStats {
+    size_t active = 0;                ///< Mappings not yet unmapped
+    size_t mapped_bytes = 0;
+    size_t peak_mapped_bytes = 0;
+    uint64_t created = 0;
+    uint64_t unmapped = 0;
+    uint64_t zero_copy_replies = 0;   ///< Read replies served straight from a view
+    uint64_t zero_copy_bytes = 0;
+};
+
+/**
+ * Registry of live views.
+ */
+class FileMappingTable {
+public:
+    static FileMappingTable& Instance();
+
+    /**
+     * @brief Map a file range and wrap it in an external ArrayBuffer
+     * @param fd Open descriptor, or -1 to open @p path
+     * @return ArrayBuffer, or an empty handle with a pending JS exception
+     */
+    Napi::Value Map(Napi::Env env, int fd, const std::string& path, const FileMappingOptions& options);
+
+    /**
+     * @brief Mapping containing [data, data + length) of a registered view
+     *
+     * Used by read replies to keep the pages mapped until the reply is sent;
+     * counts the reply as zero-copy.
+     *
+     * @return Mapping, or nullptr if the range is not inside a view
+     */
+    std::shared_ptr<FileMapping> Pin(const void* data, size_t length);
+
+    /**
+     * @brief madvise() the pages covering [data, data + length) of a view
+     * @return 0 or an errno value (EINVAL if the range is not inside a view)
+     */
+    int Advise(const void* data, size_t length, int advice);
+
+    FileMappingStats GetStats() const;
+
+private:
+    friend class FileMapping;
+
+    FileMappingTable() = default;
+
+    struct View {
+        size_t length;
+        std::weak_ptr<FileMapping> mapping;
+    };
+
+    static void Finalize(napi_env env, void* data, void* hint);
+
+    std::shared_ptr<FileMapping> FindLocked(const void* data, size_t length) const;
+    void OnUnmapped(size_t length);
+
+    mutable std::mutex mutex_;
+    std::map<uintptr_t, View> views_;      ///< View start -> view
+
+    std::atomic<size_t> active_{0};
+    std::atomic<size_t> mapped_bytes_{0};
+    std::atomic<size_t> peak_mapped_bytes_{0};
+    std::atomic<uint64_t> created_{0};
+    std::atomic<uint64_t> unmapped_{0};
+    std::atomic<uint64_t> zero_copy_replies_{0};
+    std::atomic<uint64_t> zero_copy_bytes_{0};
+};
+
+} // namespace FuseNative
+
+namespace fuse_native {
+
+/**
+ * Map a file range (N-API exposed function)
+ * @param info N-API callback info containing path or fd and optional
+ *             `{offset, length, shared, writable, populate, advice}`
+ * @return External ArrayBuffer backed by the mapping
+ */
+Napi::Value MapFile(const Napi::CallbackInfo& info);
+
+/**
+ * Apply madvise() to (part of) a file view (N-API exposed function)
+ * @param info N-API callback info containing ArrayBuffer or TypedArray and advice name
+ * @return Boolean indicating success
+ */
+Napi::Value AdviseFileMapping(const Napi::CallbackInfo& info);
+
+/**
+ * Get file mapping statistics (N-API exposed function)
+ * @param info N-API callback info
+ * @return Object containing statistics
+ */
+Napi::Value GetFileMappingStats(const Napi::CallbackInfo& info);
+
+} // namespace fuse_native
+
+#endif // FUSE_NATIVE_FILE_MAPPING_H
@@ -19,10 +19,25 @@
 #include <sys/statvfs.h>
 #include <inttypes.h>
 
+#include "attr_cache.h"
+#include "content_hash.h"
+#include "dentry_cache.h"
+#include "xattr_cache.h"
+#include "xattr_fd_cache.h"
+#include "dir_snapshot_cache.h"
+#include "dirent_packer.h"
 #include "errno_mapping.h"
+#include "file_mapping.h"
+#include "inode_table.h"
+#include "native_io.h"
+#include "notify_bridge.h"
+#include "passthrough.h"
 #include "session_manager.h"
+#include "shutdown.h"
 #include "napi_helpers.h"
+#include "trace_probes.h"
 #include "tsfn_dispatcher.h"
+#include "write_queue.h"
 #include <fuse3/fuse_common.h>
 #include <vector>
 #include <unistd.h>   // pread
@@ -88,6 +103,7 @@ struct BufvecHolder {
     std::shared_ptr<uint8_t[]> storage;
     struct fuse_bufvec* bufvec{nullptr};
     std::vector<std::shared_ptr<std::vector<uint8_t>>> mem_buffers;
+    std::vector<std::shared_ptr<FuseNative::FileMapping>> mappings;  ///< Referenzierte Datei-Views
 
     explicit BufvecHolder(size_t count) {
         size_t total_size = sizeof(struct fuse_bufvec);
@@ -237,6 +253,17 @@ std::shared_ptr<BufvecHolder> ConvertJsFuseBufvec(Napi::Env env, const Napi::Val
                 return nullptr;
             }
 
+            native_buf.fd = -1;
+            native_buf.pos = 0;
+
+            // Datei-View: Mapping festhalten und direkt daraus antworten
+            if (auto mapping = FuseNative::FileMappingTable::Instance().Pin(src_ptr, size)) {
+                holder->mappings.push_back(std::move(mapping));
+                native_buf.mem = const_cast<uint8_t*>(src_ptr);
+                native_buf.mem_size = size;
+                continue;
+            }
+
             auto data_vec = std::make_shared<std::vector<uint8_t>>(size);
             if (size > 0 && src_ptr) {
                 std::memcpy(data_vec->data(), src_ptr, size);
@@ -245,8 +272,6 @@ std::shared_ptr<BufvecHolder> ConvertJsFuseBufvec(Napi::Env env, const Napi::Val
 
             native_buf.mem = data_vec->data();
             native_buf.mem_size = data_vec->size();
-            native_buf.fd = -1;
-            native_buf.pos = 0;
         }
     }
 
@@ -505,6 +530,13 @@ void ReplyWithErrorValue(Napi::Env env,
     context->ReplyError(errno_code);
 }
 
+// js_settle: Handler-Ergebnis liegt vor (sofort oder nach Promise-Auflösung)
+void TraceJsSettle(const FuseRequestContext& context, bool rejected) {
+    FUSE_PROBE(js_settle, FuseOpTypeToString(context.op_type), ToUint64(context.ino),
+               static_cast<int>(rejected), context.request_id,
+               context.js_start_time.time_since_epoch().count() != 0 ? ProbeElapsedNs(context.js_start_time) : 0);
+}
+
 void ResolvePromiseOrValue(Napi::Env env,
                            const std::shared_ptr<FuseRequestContext>& context,
                            Napi::Value result,
@@ -535,6 +567,7 @@ void ResolvePromiseOrValue(Napi::Env env,
             Napi::Function resolve_cb = Napi::Function::New(env, [context, on_resolve](const Napi::CallbackInfo& info) {
                 Napi::Env env_inner = info.Env();
                 Napi::Value value = info.Length() > 0 ? info[0] : env_inner.Undefined();
+                TraceJsSettle(*context, false);
                 try {
                     on_resolve(env_inner, value);
                 } catch (...) {
@@ -546,6 +579,7 @@ void ResolvePromiseOrValue(Napi::Env env,
             Napi::Function reject_cb = Napi::Function::New(env, [context, rejection_handler](const Napi::CallbackInfo& info) {
                 Napi::Env env_inner = info.Env();
                 Napi::Value reason = info.Length() > 0 ? info[0] : env_inner.Undefined();
+                TraceJsSettle(*context, true);
                 rejection_handler(env_inner, reason);
                 return env_inner.Undefined();
             });
@@ -558,6 +592,7 @@ void ResolvePromiseOrValue(Napi::Env env,
         result = promise_obj;
     }
 
+    TraceJsSettle(*context, false);
     try {
         on_resolve(env, result);
     } catch (...) {
@@ -565,13 +600,511 @@ void ResolvePromiseOrValue(Napi::Env env,
     }
 }
 
+// Antwortet ab context->offset aus einem Verzeichnis-Snapshot; false, wenn der Offset nicht dazugehört
+bool ReplyFromDirSnapshot(const std::shared_ptr<FuseRequestContext>& context,
+                          const DirSnapshot& snapshot) {
+    const size_t index = snapshot.ResumeIndex(context->offset);
+    if (index == DirSnapshot::kNotFound) { return false; }
+    const size_t max_size = context->size;
+    if (max_size == 0) { context->ReplyBuf(nullptr, 0); return true; }
+
+    ColumnarDirents view = snapshot.entries->Slice(index);
+    auto buf = std::make_shared<std::vector<char>>(max_size);
+    buf->resize(PackDirents(context->request, view, context->offset, buf->data(), max_size));
+    context->keepalive = buf;
+    context->ReplyBuf(buf->data(), buf->size());
+    return true;
+}
+
+// Snapshot aus einem Handler-Ergebnis übernehmen (nur mit offenem Handle cachebar)
+std::shared_ptr<DirSnapshot> TakeDirSnapshot(Napi::Env env,
+                                             const std::shared_ptr<FuseRequestContext>& context,
+                                             const Napi::Object& listing, int* err) {
+    std::shared_ptr<DirSnapshot> snapshot;
+    *err = DecodeDirSnapshot(env, listing, context->ino, 0, &snapshot);
+    if (*err == 0 && context->has_fi) {
+        DirSnapshotCache::Instance().Insert(context->fi.fh, snapshot);
+    }
+    return snapshot;
+}
+
+// Nach der Antwort auf eine verändernde Operation gecachte Attribute und Namen verwerfen
+void InvalidateCachesOnReply(const FuseRequestContext& context) {
+    AttrCache& attrs = AttrCache::Instance();
+    DentryCache& dentries = DentryCache::Instance();
+    XAttrCache& xattrs = XAttrCache::Instance();
+    const bool attrs_enabled = attrs.Enabled();
+    const bool dentries_enabled = dentries.Enabled();
+    const bool xattrs_enabled = xattrs.Enabled();
+    if (!attrs_enabled && !dentries_enabled && !xattrs_enabled) {
+        return;
+    }
+
+    auto drop_attr = [&](fuse_ino_t ino) {
+        if (attrs_enabled) attrs.Invalidate(ino);
+    };
+    auto drop_name = [&](fuse_ino_t parent, const std::string& name) {
+        if (dentries_enabled) dentries.Invalidate(parent, name);
+    };
+    // Entfernter bzw. überschriebener Eintrag: nlink/ctime des Kinds ändern sich mit
+    auto drop_child = [&](fuse_ino_t parent, const std::string& name) {
+        fuse_ino_t child = 0;
+        if (attrs_enabled && dentries_enabled && dentries.PeekIno(parent, name, &child)) {
+            attrs.Invalidate(child);
+        }
+        drop_name(parent, name);
+    };
+
+    switch (context.op_type) {
+        case FuseOpType::SETATTR:
+        case FuseOpType::TRUNCATE:
+        case FuseOpType::CHMOD:
+        case FuseOpType::CHOWN:
+        case FuseOpType::WRITE:
+        case FuseOpType::WRITE_BUF:
+        case FuseOpType::FALLOCATE:
+            drop_attr(context.ino);
+            // Kann Capabilities entfernen oder ACLs umschreiben
+            if (xattrs_enabled) xattrs.InvalidatePositive(context.ino);
+            break;
+        case FuseOpType::SETXATTR:
+        case FuseOpType::REMOVEXATTR:
+            drop_attr(context.ino);
+            if (xattrs_enabled) xattrs.Invalidate(context.ino, context.name);
+            break;
+        case FuseOpType::COPY_FILE_RANGE:
+            drop_attr(context.new_parent);  // ino_out
+            break;
+        case FuseOpType::MKNOD:
+        case FuseOpType::MKDIR:
+        case FuseOpType::SYMLINK:
+        case FuseOpType::CREATE:
+            drop_attr(context.parent);
+            drop_name(context.parent, context.name);
+            break;
+        case FuseOpType::UNLINK:
+        case FuseOpType::RMDIR:
+            drop_attr(context.parent);
+            drop_child(context.parent, context.name);
+            break;
+        case FuseOpType::LINK:
+            drop_attr(context.ino);
+            drop_attr(context.new_parent);
+            drop_name(context.new_parent, context.new_name);
+            break;
+        case FuseOpType::RENAME:
+            drop_attr(context.parent);
+            drop_attr(context.new_parent);
+            drop_child(context.parent, context.name);
+            drop_child(context.new_parent, context.new_name);
+            break;
+        default:
+            break;
+    }
+}
+
+// Neue Einträge aus Lookup/Create-Antworten im Dentry-Cache ablegen
+void StoreDentryFromReply(const FuseRequestContext& context, const struct fuse_entry_param& entry) {
+    DentryCache& cache = DentryCache::Instance();
+    if (!cache.Enabled()) {
+        return;
+    }
+
+    switch (context.op_type) {
+        case FuseOpType::LOOKUP:
+            if (entry.ino == 0) {
+                cache.StoreNegative(context.parent, context.name, context.dentry_epoch);
+            } else {
+                cache.StorePositive(context.parent, context.name, entry, context.dentry_epoch);
+            }
+            break;
+        case FuseOpType::MKNOD:
+        case FuseOpType::MKDIR:
+        case FuseOpType::SYMLINK:
+        case FuseOpType::CREATE:
+            cache.StorePositive(context.parent, context.name, entry,
+                                cache.Epoch(context.parent, context.name));
+            break;
+        case FuseOpType::LINK:
+            cache.StorePositive(context.new_parent, context.new_name, entry,
+                                cache.Epoch(context.new_parent, context.new_name));
+            break;
+        default:
+            break;
+    }
+}
+
+// Freigegebene Inodes gesammelt an den JS-forget-Handler übergeben
+bool DeliverForgetBatch(std::vector<fuse_ino_t>&& inos) {
+    auto dispatcher = GetGlobalDispatcher();
+    if (!dispatcher || inos.empty()) {
+        return false;
+    }
+
+    auto batch = std::make_shared<std::vector<fuse_ino_t>>(std::move(inos));
+    const uint64_t request_id = dispatcher->DispatchCustom(
+        FuseOpTypeToString(FuseOpType::FORGET),
+        [batch](Napi::Env env, Napi::Function handler) {
+            Napi::HandleScope scope(env);
+            if (!handler.IsFunction()) {
+                return;
+            }
+            Napi::BigUint64Array array = Napi::BigUint64Array::New(env, batch->size());
+            std::copy(batch->begin(), batch->end(), array.Data());
+
+            Napi::Value result = handler.Call({array});
+            if (env.IsExceptionPending()) {
+                env.GetAndClearPendingException();
+                FUSE_LOG_WARN("forget handler threw for a batch of %zu inodes", batch->size());
+                return;
+            }
+            // forget hat keine Antwort – Ablehnungen nur protokollieren
+            if (result.IsPromise()) {
+                Napi::Object promise = result.As<Napi::Object>();
+                Napi::Value catch_fn = promise.Get("catch");
+                if (catch_fn.IsFunction()) {
+                    const size_t count = batch->size();
+                    catch_fn.As<Napi::Function>().Call(promise, {Napi::Function::New(
+                        env, [count](const Napi::CallbackInfo& info) {
+                            FUSE_LOG_WARN("forget handler rejected a batch of %zu inodes", count);
+                            return info.Env().Undefined();
+                        })});
+                }
+            }
+        },
+        CallbackPriority::LOW);
+    return request_id != 0;
+}
+
+// {op:'pread'} eines read-Handlers: pread im Worker-Pool, Antwort direkt von dort
+bool ExecuteNativeRead(const std::shared_ptr<FuseRequestContext>& context, Napi::Value value) {
+    NativeIoDescriptor io;
+    if (!DecodeNativeIoDescriptor(value, NativeIoDescriptor::Op::PREAD, &io)) {
+        return false;
+    }
+    const size_t size = io.size == 0 ? context->size : std::min(io.size, context->size);
+    const bool submitted = NativeIoExecutor::Instance().Submit([context, io, size] {
+        std::vector<char> buffer(size);
+        const int64_t result = PreadFully(io.fd, buffer.data(), size, io.offset);
+        NativeIoExecutor::Instance().RecordRead(result);
+        if (result < 0) {
+            context->ReplyError(static_cast<int>(-result));
+            return;
+        }
+        context->ReplyBuf(buffer.data(), static_cast<size_t>(result));
+    });
+    if (!submitted) {
+        context->ReplyError(EIO);
+    }
+    return true;
+}
+
+// {op:'pwrite'} eines write-Handlers: die Daten liegen noch nativ vor.
+// owner hält die iovec-Puffer bis nach dem pwritev am Leben.
+bool ExecuteNativeWrite(Napi::Value value, std::vector<struct iovec> iov, std::shared_ptr<void> owner,
+                        std::function<void(int64_t)> done) {
+    NativeIoDescriptor io;
+    if (!DecodeNativeIoDescriptor(value, NativeIoDescriptor::Op::PWRITE, &io)) {
+        return false;
+    }
+    const bool submitted = NativeIoExecutor::Instance().Submit(
+        [io, iov = std::move(iov), owner = std::move(owner), done]() mutable {
+            const int64_t result = PwriteFully(io.fd, std::move(iov), io.offset);
+            NativeIoExecutor::Instance().RecordWrite(result);
+            owner.reset();
+            done(result);
+        });
+    if (!submitted) {
+        done(-EIO);
+    }
+    return true;
+}
+
+std::vector<struct iovec> SingleIov(const void* data, size_t size) {
+    return {iovec{const_cast<void*>(data), size}};
+}
+
+// Digest des Write-Payloads, auf dem FUSE-Thread berechnet
+void SetWriteDigest(Napi::Env env, Napi::Object options, const FuseRequestContext& context) {
+    if (context.has_digest) {
+        options.Set("digest", FuseNative::DigestToJs(env, context.digest));
+    }
+}
+
+// Bytes oder negatives errno als write-Antwort
+std::function<void(int64_t)> ReplyWriteResult(const std::shared_ptr<FuseRequestContext>& context) {
+    return [context](int64_t result) {
+        if (result < 0) {
+            context->ReplyError(static_cast<int>(-result));
+            return;
+        }
+        context->ReplyWrite(static_cast<size_t>(result));
+    };
+}
+
+using WriteBatch = std::vector<std::unique_ptr<WriteOperation>>;
+
+// Ergebnis eines write-Handlers: Bytes oder negatives errno
+int64_t WriteResultFromValue(Napi::Value value) {
+    if (value.IsNumber()) {
+        return value.As<Napi::Number>().Int64Value();
+    }
+    if (value.IsBigInt()) {
+        bool lossless = false;
+        const uint64_t written = value.As<Napi::BigInt>().Uint64Value(&lossless);
+        return lossless ? static_cast<int64_t>(written) : -EIO;
+    }
+    if (value.IsObject()) {
+        Napi::Value bytes = value.As<Napi::Object>().Get("bytes");
+        if (bytes.IsNumber()) {
+            return bytes.As<Napi::Number>().Int64Value();
+        }
+    }
+    return -EIO;
+}
+
+// Zusammenhängende Kernel-Writes eines File-Handles als ein JS-write ausführen.
+// Pro Handle ist höchstens ein Batch unterwegs; was währenddessen eintrifft,
+// wird beim nächsten Batch zusammengefasst.
+// finish hält die Queue: ein RELEASE aus CompleteBatch kann sie bereits ausgehängt haben.
+void DispatchNextWriteBatch(const std::shared_ptr<FDWriteQueue>& queue) {
+    const WriteCoalescingConfig config = GetWriteCoalescingConfig();
+    auto batch = std::make_shared<WriteBatch>(
+        queue->TakeBatch(config.max_extent_bytes, config.max_batch_writes));
+    if (batch->empty()) {
+        return;
+    }
+
+    const auto started = std::chrono::steady_clock::now();
+    auto done = std::make_shared<std::atomic<bool>>(false);
+    auto finish = [queue, batch, started, done](int64_t result) {
+        if (done->exchange(true)) {
+            return;
+        }
+        const double latency_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - started).count();
+        queue->CompleteBatch(*batch, result, latency_ms);
+        DispatchNextWriteBatch(queue);
+    };
+
+    auto dispatcher = GetGlobalDispatcher();
+    if (!dispatcher) {
+        finish(-EIO);
+        return;
+    }
+
+    // Digest über den zusammengefassten Payload, wie beim einzelnen write vor dem JS-Thread
+    auto digest = std::make_shared<FuseNative::ContentDigest>();
+    bool has_digest = false;
+    FuseNative::WriteDigest& write_digest = FuseNative::WriteDigest::Instance();
+    if (batch->size() == 1) {
+        const WriteOperation& only = *batch->front();
+        has_digest = write_digest.Compute(only.buffer, static_cast<size_t>(only.size), digest.get());
+    } else if (write_digest.Enabled()) {
+        std::vector<uint8_t> merged;
+        for (const auto& operation : *batch) {
+            const auto* bytes = static_cast<const uint8_t*>(operation->buffer);
+            merged.insert(merged.end(), bytes, bytes + operation->size);
+        }
+        has_digest = write_digest.Compute(merged.data(), merged.size(), digest.get());
+    }
+
+    // Probes des Batches laufen unter der request_id des ersten Writes
+    const uint64_t lead_request_id = std::static_pointer_cast<FuseRequestContext>(batch->front()->owner)->request_id;
+    const uint64_t request_id = dispatcher->DispatchCustom(
+        FuseOpTypeToString(FuseOpType::WRITE),
+        [batch, finish, digest, has_digest](Napi::Env env, Napi::Function handler) {
+            Napi::HandleScope scope(env);
+            if (!handler.IsFunction()) {
+                finish(-EIO);
+                return;
+            }
+
+            auto lead = std::static_pointer_cast<FuseRequestContext>(batch->front()->owner);
+            size_t total = 0;
+            for (const auto& operation : *batch) {
+                total += static_cast<size_t>(operation->size);
+            }
+            Napi::ArrayBuffer data = Napi::ArrayBuffer::New(env, total);
+            auto* dest = static_cast<uint8_t*>(data.Data());
+            for (const auto& operation : *batch) {
+                std::memcpy(dest, operation->buffer, static_cast<size_t>(operation->size));
+                dest += operation->size;
+            }
+
+            Napi::Object options = Napi::Object::New(env);
+            options.Set("offset", NapiHelpers::CreateBigUint64(env, batch->front()->offset));
+            if (lead->has_fi) {
+                options.Set("fi", NapiHelpers::FileInfoToObject(env, lead->fi));
+            }
+            options.Set("coalesced", Napi::Number::New(env, static_cast<double>(batch->size())));
+            if (has_digest) {
+                options.Set("digest", FuseNative::DigestToJs(env, *digest));
+            }
+
+            Napi::Value result = handler.Call({NapiHelpers::CreateBigUint64(env, ToUint64(lead->ino)),
+                                               data, CreateRequestContextObject(env, *lead), options});
+            // pwrite-Deskriptor: die Batch-Puffer direkt im Worker-Pool schreiben
+            auto settle = [batch, finish](Napi::Value value) {
+                std::vector<struct iovec> iov;
+                iov.reserve(batch->size());
+                for (const auto& operation : *batch) {
+                    iov.push_back(iovec{operation->buffer, static_cast<size_t>(operation->size)});
+                }
+                if (!ExecuteNativeWrite(value, std::move(iov), batch, finish)) {
+                    finish(WriteResultFromValue(value));
+                }
+            };
+            if (env.IsExceptionPending()) {
+                Napi::Error error = env.GetAndClearPendingException();
+                finish(-ExtractErrnoFromValue(env, error.Value()));
+                return;
+            }
+
+            if (result.IsPromise()) {
+                Napi::Object promise = result.As<Napi::Object>();
+                Napi::Function then_fn = promise.Get("then").As<Napi::Function>();
+                then_fn.Call(promise, {
+                    Napi::Function::New(env, [settle](const Napi::CallbackInfo& info) {
+                        settle(info.Length() > 0 ? info[0] : info.Env().Undefined());
+                        return info.Env().Undefined();
+                    }),
+                    Napi::Function::New(env, [finish](const Napi::CallbackInfo& info) {
+                        const int err = ExtractErrnoFromValue(
+                            info.Env(), info.Length() > 0 ? info[0] : info.Env().Undefined());
+                        finish(-(err == 0 ? EIO : err));
+                        return info.Env().Undefined();
+                    })});
+                return;
+            }
+            settle(result);
+        },
+        CallbackPriority::NORMAL,
+        [finish](int error_code) {
+            finish(-(error_code == 0 ? EIO : error_code));
+        },
+        lead_request_id);
+
+    if (request_id == 0) {
+        finish(-EAGAIN);
+    }
+}
+
+// Reiht einen Kernel-Write in die Queue seines File-Handles ein.
+// Mit Write-behind wird innerhalb der Dirty-Grenzen sofort bestätigt,
+// darüber erst nach der Ausführung (bremst den Schreiber).
+// false: nicht anwendbar, der Aufrufer verarbeitet den Write selbst.
+bool QueueCoalescedWrite(const std::shared_ptr<FuseRequestContext>& context,
+                         const uint8_t* data, size_t size) {
+    if (!context->has_fi || size == 0 ||
+        !(IsWriteCoalescingEnabled() || IsWriteBehindEnabled()) ||
+        !FuseBridge::HasOperationHandler(FuseOpType::WRITE)) {
+        return false;
+    }
+
+    const uint64_t fh = context->fi.fh;
+    std::shared_ptr<FDWriteQueue> queue = GetKernelWriteQueueManager().GetQueue(fh);
+    if (!queue) {
+        return false;
+    }
+
+    void* copy = std::malloc(size);
+    if (!copy) {
+        return false;
+    }
+    std::memcpy(copy, data, size);
+
+    auto operation = std::make_unique<WriteOperation>(fh, context->offset, size, copy, true);
+    operation->owner = context;
+
+    const bool acknowledged = IsWriteBehindEnabled() && ReserveWriteBehind(*queue, size);
+    if (acknowledged) {
+        const auto queued_at = std::chrono::steady_clock::now();
+        // weak: die Operation liegt in der Queue; wer sie abschließt, hält die Queue
+        std::weak_ptr<FDWriteQueue> weak_queue = queue;
+        operation->completion_callback = [weak_queue, size, queued_at](int result) {
+            const double latency_ms = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - queued_at).count();
+            if (std::shared_ptr<FDWriteQueue> owner = weak_queue.lock()) {
+                CompleteWriteBehind(*owner, size, result, latency_ms);
+            }
+        };
+    } else {
+        operation->completion_callback = [context](int result) {
+            if (result < 0) {
+                context->ReplyError(-result);
+            } else {
+                context->ReplyWrite(static_cast<size_t>(result));
+            }
+        };
+    }
+    // Bis zur Ausführung gilt das Inode als dirty; Attribute erst danach verwerfen
+    const fuse_ino_t ino = context->ino;
+    operation->completion_callback = [complete = std::move(operation->completion_callback), ino](int result) {
+        AttrCache::Instance().Invalidate(ino);
+        complete(result);
+        GetKernelWriteQueueManager().ReleaseInodeWrite(ino);
+    };
+    operation->error_callback = operation->completion_callback;
+
+    GetKernelWriteQueueManager().RetainInodeWrite(ino);
+    if (queue->Enqueue(std::move(operation)) == 0) {
+        if (acknowledged) {
+            ReleaseWriteBehind(*queue, size);
+        }
+        GetKernelWriteQueueManager().ReleaseInodeWrite(ino);
+        return false;
+    }
+    if (acknowledged) {
+        context->ReplyWrite(size);
+    }
+    DispatchNextWriteBatch(queue);
+    return true;
+}
+
+// flush/fsync/release erst nach allen eingereihten Writes des Handles
+bool DeferUntilWritesDrained(const struct fuse_file_info* fi, std::function<void()> resume) {
+    if (!fi) {
+        return false;
+    }
+    std::shared_ptr<FDWriteQueue> queue = GetKernelWriteQueueManager().FindQueue(fi->fh);
+    return queue && queue->DeferUntilIdle(std::move(resume));
+}
+
+// getattr/setattr/read/copy_file_range erst nach allen eingereihten Writes des Inodes,
+// gleich über welchen Handle sie kamen
+bool DeferUntilInodeWritesDrained(fuse_ino_t ino, std::function<void()> resume) {
+    return GetKernelWriteQueueManager().DeferUntilInodeIdle(ino, std::move(resume));
+}
+
+// Fehler eines bereits bestätigten Writes (0 = keiner)
+int TakeDeferredWriteError(const struct fuse_file_info* fi) {
+    if (!fi) {
+        return 0;
+    }
+    std::shared_ptr<FDWriteQueue> queue = GetKernelWriteQueueManager().FindQueue(fi->fh);
+    return queue ? queue->TakeDeferredError() : 0;
+}
+
+// Optionales backingFd aus open/create: Kernel bedient read/write dann selbst
+void AttachBackingFile(const std::shared_ptr<FuseRequestContext>& context, Napi::Object fi_object,
+                       struct fuse_file_info* fi) {
+    Napi::Value fd_value = fi_object.Get("backingFd");
+    if (!fd_value.IsNumber()) {
+        return;
+    }
+    PassthroughRegistry::Instance().Attach(context->request, fd_value.As<Napi::Number>().Int32Value(), fi);
+}
+
+std::atomic<uint64_t> g_next_request_id{1};
+
 } // namespace
 
 FuseRequestContext::FuseRequestContext(FuseOpType op, fuse_req_t req, FuseBridge* bridge_ptr)
     : op_type(op),
       request(req),
       bridge(bridge_ptr),
-      request_id(0),
+      request_id(g_next_request_id.fetch_add(1, std::memory_order_relaxed)),
       priority(CallbackPriority::NORMAL),
       start_time(std::chrono::steady_clock::now()),
       has_caller_ctx(false),
@@ -593,20 +1126,33 @@ FuseRequestContext::FuseRequestContext(FuseOpType op, fuse_req_t req, FuseBridge
       has_lock(false),
       sleep(0),
       replied(false) {
-    FUSE_LOG_TRACE("FuseRequestContext - creating context for op_type %d", static_cast<int>(op));
+    FUSE_LOG_RECORD(FUSE_LOG_LEVEL_TRACE, "FuseRequestContext - creating context for op_type %" PRIu64, static_cast<uint64_t>(op));
     std::memset(&attr, 0, sizeof(attr));
     std::memset(&fi, 0, sizeof(fi));
     std::memset(&fi_out, 0, sizeof(fi_out));
     std::memset(&lock, 0, sizeof(lock));
     std::memset(&caller_ctx, 0, sizeof(caller_ctx));
+    attr_epoch = AttrCache::Instance().Epoch();
     if (req) {
         FUSE_LOG_TRACE("FuseRequestContext - capturing caller context");
         CaptureCallerContext();
+        if (bridge) {
+            unreplied = bridge->UnrepliedCounter();
+            unreplied->fetch_add(1, std::memory_order_relaxed);
+        }
     } else {
         FUSE_LOG_DEBUG("FuseRequestContext - no request provided");
     }
 }
 
+FuseRequestContext::~FuseRequestContext() {
+    // forget/none und direkte fuse_reply_* ohne TryMarkReplied
+    if (unreplied && !replied.load(std::memory_order_acquire) &&
+        unreplied->fetch_sub(1, std::memory_order_release) == 1) {
+        NotifyDrainProgress();
+    }
+}
+
 
 void FuseRequestContext::CaptureCallerContext() {
     const struct fuse_ctx* ctx = fuse_req_ctx(request);
@@ -620,7 +1166,16 @@ void FuseRequestContext::CaptureCallerContext() {
 
 bool FuseRequestContext::TryMarkReplied() {
     bool expected = false;
-    return replied.compare_exchange_strong(expected, true, std::memory_order_acq_rel);
+    if (!replied.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+        return false;
+    }
+    if (unreplied && unreplied->fetch_sub(1, std::memory_order_release) == 1) {
+        NotifyDrainProgress();  // letzte offene Anfrage: wartenden Shutdown wecken
+    }
+    FUSE_PROBE(request_reply, FuseOpTypeToString(op_type), ToUint64(ino), static_cast<uint64_t>(size),
+               request_id, ProbeElapsedNs(start_time));
+    InvalidateCachesOnReply(*this);
+    return true;
 }
 
 void FuseRequestContext::ReplyError(int errno_code) {
@@ -636,9 +1191,17 @@ void FuseRequestContext::ReplyError(int errno_code) {
     if (fuse_errno < 0) {
         fuse_errno = -fuse_errno;
     }
+    FUSE_PROBE(request_error, FuseOpTypeToString(op_type), ToUint64(ino), fuse_errno, request_id,
+               ProbeElapsedNs(start_time));
 
     fuse_reply_err(request, fuse_errno);
     keepalive.reset();
+
+    if (op_type == FuseOpType::LOOKUP && fuse_errno == ENOENT) {
+        DentryCache::Instance().StoreNegative(parent, name, dentry_epoch);
+    } else if (op_type == FuseOpType::GETXATTR && fuse_errno == kXAttrMissingErrno) {
+        XAttrCache::Instance().StoreNegative(ino, name, xattr_epoch);
+    }
 }
 
 void FuseRequestContext::ReplyOk() {
@@ -658,21 +1221,29 @@ void FuseRequestContext::ReplyAttr(const struct stat& attr_value, double attr_ti
         return;
     }
     fuse_reply_attr(request, &attr_value, attr_timeout);
+    AttrCache::Instance().Store(ino, attr_value, attr_timeout, attr_epoch);
 }
 
 void FuseRequestContext::ReplyEntry(const struct fuse_entry_param& entry) {
     if (!TryMarkReplied() || !request) {
         return;
     }
-    fuse_reply_entry(request, const_cast<struct fuse_entry_param*>(&entry));
+    // Referenz vor der Antwort zählen: ein FORGET kann direkt danach eintreffen
+    InodeTable::Instance().AddLookup(entry.ino);
+    if (fuse_reply_entry(request, const_cast<struct fuse_entry_param*>(&entry)) != 0) {
+        InodeTable::Instance().DropLookup(entry.ino);
+    }
+    AttrCache::Instance().Store(entry.ino, entry.attr, entry.attr_timeout, attr_epoch);
+    StoreDentryFromReply(*this, entry);
 }
 
-void FuseRequestContext::ReplyBuf(const void* data_ptr, size_t length) {
+bool FuseRequestContext::ReplyBuf(const void* data_ptr, size_t length) {
     if (!TryMarkReplied() || !request) {
-        return;
+        return false;
     }
-    fuse_reply_buf(request, static_cast<const char*>(data_ptr), length);
+    const int rc = fuse_reply_buf(request, static_cast<const char*>(data_ptr), length);
     keepalive.reset(); // Puffer freigeben
+    return rc == 0;
 }
 
 void FuseRequestContext::ReplyWrite(size_t bytes_written) {
@@ -686,7 +1257,11 @@ void FuseRequestContext::ReplyOpen(const struct fuse_file_info& result_fi) {
     if (!TryMarkReplied() || !request) {
         return;
     }
-    fuse_reply_open(request, const_cast<struct fuse_file_info*>(&result_fi));
+    // Vor der Antwort zählen: das RELEASE kann sofort folgen
+    GetKernelWriteQueueManager().RetainHandle(result_fi.fh);
+    if (fuse_reply_open(request, const_cast<struct fuse_file_info*>(&result_fi)) != 0) {
+        GetKernelWriteQueueManager().ReleaseHandle(result_fi.fh);
+    }
 }
 
 void FuseRequestContext::ReplyOpendir(const struct fuse_file_info& result_fi) {
@@ -701,9 +1276,16 @@ void FuseRequestContext::ReplyCreate(const struct fuse_entry_param& entry,
     if (!TryMarkReplied() || !request) {
         return;
     }
-    fuse_reply_create(request,
-                      const_cast<struct fuse_entry_param*>(&entry),
-                      const_cast<struct fuse_file_info*>(&result_fi));
+    InodeTable::Instance().AddLookup(entry.ino);
+    GetKernelWriteQueueManager().RetainHandle(result_fi.fh);
+    if (fuse_reply_create(request,
+                          const_cast<struct fuse_entry_param*>(&entry),
+                          const_cast<struct fuse_file_info*>(&result_fi)) != 0) {
+        InodeTable::Instance().DropLookup(entry.ino);
+        GetKernelWriteQueueManager().ReleaseHandle(result_fi.fh);
+    }
+    AttrCache::Instance().Store(entry.ino, entry.attr, entry.attr_timeout, attr_epoch);
+    StoreDentryFromReply(*this, entry);
 }
 
 void FuseRequestContext::ReplyStatfs(const struct statvfs& stats) {
@@ -768,7 +1350,8 @@ const char* FuseOpTypeToString(FuseOpType type) {
 }
 
 FuseBridge::FuseBridge(SessionManager* session_mgr)
-    : session_manager_(session_mgr), env_(nullptr), initialized_(false) {
+    : session_manager_(session_mgr), env_(nullptr), initialized_(false),
+      unreplied_requests_(std::make_shared<std::atomic<size_t>>(0)) {
     std::memset(&fuse_ops_, 0, sizeof(fuse_ops_));
 }
 
@@ -830,6 +1413,12 @@ bool FuseBridge::RegisterOperationHandler(Napi::Env env, FuseOpType op_type, Nap
         std::lock_guard<std::mutex> lock(handler_mutex_);
         handler_registry_[op_type] = HandlerRecord{FuseOpTypeToString(op_type)};
     }
+
+    // Mit forget-Handler führt die Bridge die Lookup-Zähler nativ
+    if (op_type == FuseOpType::FORGET) {
+        InodeTable::Instance().SetSink(DeliverForgetBatch);
+        InodeTable::Instance().SetTracking(true);
+    }
     return true;
 }
 
@@ -850,6 +1439,9 @@ bool FuseBridge::RemoveOperationHandler(FuseOpType op_type) {
         std::lock_guard<std::mutex> lock(handler_mutex_);
         handler_registry_.erase(op_type);
     }
+    if (success && op_type == FuseOpType::FORGET) {
+        InodeTable::Instance().SetTracking(false);
+    }
 
     return success;
 }
@@ -887,6 +1479,7 @@ void FuseBridge::InitializeFuseOperations() {
   // --- Inode / Entry mgmt ---
   fuse_ops_.forget        = ForgetCallback;
   fuse_ops_.forget_multi  = ForgetMultiCallback;
+  fuse_ops_.retrieve_reply = RetrieveReplyCallback;
   fuse_ops_.lookup        = LookupCallback;
 
   fuse_ops_.getattr       = GetattrCallback;
@@ -952,6 +1545,8 @@ void FuseBridge::ProcessRequest(std::shared_ptr<FuseRequestContext> context,
   }
 
   const char* op_name_str = FuseOpTypeToString(context->op_type);
+  FUSE_PROBE(request_receive, op_name_str, ToUint64(context->ino), static_cast<uint64_t>(context->size),
+             context->request_id);
 
   if (!HasOperationHandler(context->op_type)) {
     FUSE_LOG_WARN("ProcessRequest - no handler for %s", op_name_str);
@@ -984,6 +1579,12 @@ void FuseBridge::ProcessRequest(std::shared_ptr<FuseRequestContext> context,
             if (shared_context) shared_context->ReplyError(EIO);
             return;
         }
+        if (FUSE_PROBE_ACTIVE(js_settle)) {
+            shared_context->js_start_time = std::chrono::steady_clock::now();
+        }
+        FUSE_PROBE(js_start, FuseOpTypeToString(shared_context->op_type), ToUint64(shared_context->ino),
+                   static_cast<uint64_t>(shared_context->size), shared_context->request_id,
+                   ProbeElapsedNs(shared_context->start_time));
         invoker(env, handler);
     },
     shared_context->priority,
@@ -992,14 +1593,12 @@ void FuseBridge::ProcessRequest(std::shared_ptr<FuseRequestContext> context,
         if (shared_context && !shared_context->replied.load()) {
             shared_context->ReplyError(error_code == 0 ? EIO : error_code);
         }
-    });
+    },
+    shared_context->request_id);
 
     if (request_id == 0) {
         shared_context->ReplyError(EAGAIN);
-        return;
     }
-
-    context->request_id = request_id;
 }
 
 void FuseBridge::DispatchReadBuf(std::shared_ptr<FuseRequestContext> context) {
@@ -1016,6 +1615,9 @@ void FuseBridge::DispatchReadBuf(std::shared_ptr<FuseRequestContext> context) {
         auto result = handler.Call({ino_value, request_ctx, options});
         ResolvePromiseOrValue(env, context, result,
             [context](Napi::Env env_inner, Napi::Value value) {
+                if (ExecuteNativeRead(context, value)) {
+                    return;
+                }
                 std::string error;
                 auto holder = ConvertJsFuseBufvec(env_inner, value, &error);
                 if (!holder) {
@@ -1025,14 +1627,24 @@ void FuseBridge::DispatchReadBuf(std::shared_ptr<FuseRequestContext> context) {
                     context->ReplyError(EINVAL);
                     return;
                 }
-                context->keepalive = holder;
-                int rc = fuse_reply_data(context->request, holder->bufvec, static_cast<enum fuse_buf_copy_flags>(0));
-                if (rc != 0) {
-                    context->ReplyError(-rc);
-                    return;
+                auto reply = [context, holder] {
+                    context->keepalive = holder;
+                    int rc = fuse_reply_data(context->request, holder->bufvec, static_cast<enum fuse_buf_copy_flags>(0));
+                    if (rc != 0) {
+                        context->ReplyError(-rc);
+                        return;
+                    }
+                    context->TryMarkReplied();
+                    context->keepalive.reset();
+                };
+                // fd-Segmente lesen im Worker-Pool statt auf dem JS-Thread
+                bool has_fd = false;
+                for (size_t i = 0; i < holder->bufvec->count; ++i) {
+                    has_fd = has_fd || (holder->bufvec->buf[i].flags & FUSE_BUF_IS_FD);
+                }
+                if (!has_fd || !NativeIoExecutor::Instance().Submit(reply)) {
+                    reply();
                 }
-                context->TryMarkReplied();
-                context->keepalive.reset();
             },
             [context](Napi::Env env_inner, Napi::Value reason) {
                 ReplyWithErrorValue(env_inner, context, reason);
@@ -1160,9 +1772,9 @@ bool FuseBridge::DestroyPollHandle(uint64_t handle_value) {
 }
 
 std::shared_ptr<FuseRequestContext> FuseBridge::CreateContext(FuseOpType op_type, fuse_req_t req) {
-    FUSE_LOG_TRACE("CreateContext - creating context for op_type %d", static_cast<int>(op_type));
+    FUSE_LOG_RECORD(FUSE_LOG_LEVEL_TRACE, "CreateContext - creating context for op_type %" PRIu64, static_cast<uint64_t>(op_type));
     auto context = std::make_shared<FuseRequestContext>(op_type, req, this);
-    FUSE_LOG_TRACE("CreateContext - context created successfully");
+    FUSE_LOG_RECORD(FUSE_LOG_LEVEL_TRACE, "CreateContext - context created successfully");
     return context;
 }
 
@@ -1203,6 +1815,18 @@ void FuseBridge::HandleRmdir(fuse_req_t req, fuse_ino_t parent, const char* name
 }
 
 void FuseBridge::HandleFlush(fuse_req_t req, fuse_ino_t ino, struct fuse_file_info* fi) {
+    if (DeferUntilWritesDrained(fi, [this, req, ino, fi_copy = fi ? *fi : fuse_file_info{}]() mutable {
+            HandleFlush(req, ino, &fi_copy);
+        })) {
+        return;
+    }
+    if (const int deferred = TakeDeferredWriteError(fi)) {
+        auto ctx = CreateContext(FuseOpType::FLUSH, req);
+        ctx->ino = ino;
+        ctx->ReplyError(-deferred);
+        return;
+    }
+
     if (!HasOperationHandler(FuseOpType::FLUSH)) {
        FUSE_LOG_TRACE("No flush handler registered. Reply default 0");
         auto ctx = CreateContext(FuseOpType::FLUSH, req);
@@ -1254,6 +1878,24 @@ void FuseBridge::HandleFlush(fuse_req_t req, fuse_ino_t ino, struct fuse_file_in
 }
 
 void FuseBridge::HandleRelease(fuse_req_t req, fuse_ino_t ino, struct fuse_file_info* fi) {
+    if (DeferUntilWritesDrained(fi, [this, req, ino, fi_copy = fi ? *fi : fuse_file_info{}]() mutable {
+            HandleRelease(req, ino, &fi_copy);
+        })) {
+        return;
+    }
+    // Queue, Dirty-Bytes und Fehler gehören allen Opens mit diesem fh
+    if (fi && GetKernelWriteQueueManager().ReleaseHandle(fi->fh)) {
+        if (const int deferred = TakeDeferredWriteError(fi)) {
+            // release-Antworten wertet der Kernel nicht aus
+            FUSE_LOG_WARN("release: dropping deferred write error %d for fh %llu",
+                          deferred, static_cast<unsigned long long>(fi->fh));
+        }
+        GetKernelWriteQueueManager().RemoveQueue(fi->fh);
+    }
+    if (fi) {
+        PassthroughRegistry::Instance().Release(req, fi->fh);
+    }
+
    auto context = CreateContext(FuseOpType::RELEASE, req);
 
    if (!HasOperationHandler(FuseOpType::FLUSH)) {
@@ -1304,6 +1946,18 @@ void FuseBridge::HandleRelease(fuse_req_t req, fuse_ino_t ino, struct fuse_file_
 }
 
 void FuseBridge::HandleFsync(fuse_req_t req, fuse_ino_t ino, int datasync, struct fuse_file_info* fi) {
+    if (DeferUntilWritesDrained(fi, [this, req, ino, datasync, fi_copy = fi ? *fi : fuse_file_info{}]() mutable {
+            HandleFsync(req, ino, datasync, &fi_copy);
+        })) {
+        return;
+    }
+    if (const int deferred = TakeDeferredWriteError(fi)) {
+        auto ctx = CreateContext(FuseOpType::FSYNC, req);
+        ctx->ino = ino;
+        ctx->ReplyError(-deferred);
+        return;
+    }
+
     auto context = CreateContext(FuseOpType::FSYNC, req);
     context->ino = ino;
     context->datasync = datasync;
@@ -1333,6 +1987,7 @@ void FuseBridge::HandleReleasedir(fuse_req_t req, fuse_ino_t ino, struct fuse_fi
     if (fi) {
         context->fi = *fi;
         context->has_fi = true;
+        DirSnapshotCache::Instance().Release(fi->fh, ino);
     }
 
     ProcessRequest(context, [context](Napi::Env env, Napi::Function handler) {
@@ -1454,6 +2109,37 @@ void FuseBridge::HandleLookup(fuse_req_t req, fuse_ino_t parent, const char* nam
     context->parent = parent;
     context->name = name ? name : "";
 
+    // Fast-Path: bekannte und bekannt fehlende Namen ohne JS-Roundtrip
+    DentryCache& dentries = DentryCache::Instance();
+    if (dentries.Enabled()) {
+        struct fuse_entry_param cached{};
+        switch (dentries.Lookup(parent, context->name, &cached)) {
+            case DentryLookup::NEGATIVE:
+                fuse_reply_err(req, ENOENT);
+                return;
+            case DentryLookup::POSITIVE: {
+                // Nur mit frischen Attributen nativ antworten: der Kernel übernimmt die
+                // Attribute jeder Entry-Antwort, auch mit attr_timeout 0
+                struct stat fresh{};
+                double fresh_timeout = 0.0;
+                if (!AttrCache::Instance().Peek(cached.ino, &fresh, &fresh_timeout)) {
+                    break;
+                }
+                cached.attr = fresh;
+                cached.attr_timeout = fresh_timeout;
+                // Auch ein nativ beantworteter Lookup zählt beim Kernel als Referenz
+                InodeTable::Instance().AddLookup(cached.ino);
+                if (fuse_reply_entry(req, &cached) != 0) {
+                    InodeTable::Instance().DropLookup(cached.ino);
+                }
+                return;
+            }
+            case DentryLookup::MISS:
+                break;
+        }
+        context->dentry_epoch = dentries.Epoch(parent, context->name);
+    }
+
     ProcessRequest(context, [context](Napi::Env env, Napi::Function handler) {
         Napi::Value parent_value = NapiHelpers::CreateBigUint64(env, ToUint64(context->parent));
         Napi::String name_value = Napi::String::New(env, context->name);
@@ -1474,6 +2160,22 @@ void FuseBridge::HandleLookup(fuse_req_t req, fuse_ino_t parent, const char* nam
 }
 
 void FuseBridge::HandleGetattr(fuse_req_t req, fuse_ino_t ino, struct fuse_file_info* fi) {
+    // Größe und mtime erst nach bestätigten, noch ausstehenden Writes
+    if (DeferUntilInodeWritesDrained(ino, [this, req, ino, has_fi = fi != nullptr,
+                                           fi_copy = fi ? *fi : fuse_file_info{}]() mutable {
+            HandleGetattr(req, ino, has_fi ? &fi_copy : nullptr);
+        })) {
+        return;
+    }
+
+    // Fast-Path: frische Attribute ohne JS-Roundtrip beantworten
+    struct stat cached_attr{};
+    double cached_timeout = 0.0;
+    if (AttrCache::Instance().Lookup(ino, &cached_attr, &cached_timeout)) {
+        fuse_reply_attr(req, &cached_attr, cached_timeout);
+        return;
+    }
+
     auto context = CreateContext(FuseOpType::GETATTR, req);
     context->ino = ino;
     if (fi) {
@@ -1536,6 +2238,13 @@ void FuseBridge::HandleGetattr(fuse_req_t req, fuse_ino_t ino, struct fuse_file_
 
 void FuseBridge::HandleSetattr(fuse_req_t req, fuse_ino_t ino, struct stat* attr, int to_set,
                                 struct fuse_file_info* fi) {
+    // Ein truncate darf nicht von einem eingereihten Write überholt werden
+    if (DeferUntilInodeWritesDrained(ino, [this, req, ino, attr_copy = *attr, to_set, has_fi = fi != nullptr,
+                                           fi_copy = fi ? *fi : fuse_file_info{}]() mutable {
+            HandleSetattr(req, ino, &attr_copy, to_set, has_fi ? &fi_copy : nullptr);
+        })) {
+        return;
+    }
     const bool mode_requested = (to_set & FUSE_SET_ATTR_MODE) != 0;
     const bool other_mode_bits = (to_set & ~FUSE_SET_ATTR_MODE) != 0;
     const bool uid_requested = (to_set & FUSE_SET_ATTR_UID) != 0;
@@ -2005,6 +2714,7 @@ void FuseBridge::HandleOpen(fuse_req_t req, fuse_ino_t ino, struct fuse_file_inf
                 auto fi_object = value.As<Napi::Object>();
                 struct fuse_file_info fi_result{};
                 if (NapiHelpers::ObjectToFileInfo(fi_object, &fi_result)) {
+                    AttachBackingFile(context, fi_object, &fi_result);
                     context->ReplyOpen(fi_result);
                     return;
                 }
@@ -2033,6 +2743,22 @@ void FuseBridge::HandleOpendir(fuse_req_t req, fuse_ino_t ino, struct fuse_file_
                 auto fi_object = value.As<Napi::Object>();
                 struct fuse_file_info fi_result{};
                 if (NapiHelpers::ObjectToFileInfo(fi_object, &fi_result)) {
+                    // Opens pro (fh, ino) zählen: geteilte Handles bekommen keinen Snapshot
+                    DirSnapshotCache::Instance().Open(fi_result.fh, context->ino);
+
+                    // Optionales Listing: Snapshot für alle folgenden readdir-Aufrufe
+                    Napi::Value listing = fi_object.Get("snapshot");
+                    if (listing.IsObject() && DirSnapshotCache::Instance().Enabled()) {
+                        std::shared_ptr<DirSnapshot> snapshot;
+                        const int err = DecodeDirSnapshot(env_inner, listing.As<Napi::Object>(),
+                                                          context->ino, 0, &snapshot);
+                        if (err == 0) {
+                            DirSnapshotCache::Instance().Insert(fi_result.fh, snapshot);
+                        } else {
+                            FUSE_LOG_WARN("HandleOpendir - ignoring malformed snapshot for ino=%llu",
+                                          (unsigned long long)context->ino);
+                        }
+                    }
                     context->ReplyOpendir(fi_result);
                     return;
                 }
@@ -2043,7 +2769,14 @@ void FuseBridge::HandleOpendir(fuse_req_t req, fuse_ino_t ino, struct fuse_file_
 }
 void FuseBridge::HandleRead(fuse_req_t req, fuse_ino_t ino, size_t size, off_t off,
                     struct fuse_file_info* fi) {
-    FUSE_LOG_DEBUG("HandleRead - ino=%llu, size=%zu, off=%lld", (unsigned long long)ino, size, (long long)off);
+    // Bestätigte, noch nicht geschriebene Daten zuerst ausführen (auch aus anderen Handles)
+    if (DeferUntilInodeWritesDrained(ino, [this, req, ino, size, off, has_fi = fi != nullptr,
+                                           fi_copy = fi ? *fi : fuse_file_info{}]() mutable {
+            HandleRead(req, ino, size, off, has_fi ? &fi_copy : nullptr);
+        })) {
+        return;
+    }
+    FUSE_LOG_RECORD(FUSE_LOG_LEVEL_DEBUG, "HandleRead - ino=%" PRIu64 ", size=%" PRIu64 ", off=%" PRId64, ino, size, off);
     auto context = CreateContext(FuseOpType::READ, req);
     context->ino = ino;
     context->size = size;
@@ -2079,20 +2812,31 @@ void FuseBridge::HandleRead(fuse_req_t req, fuse_ino_t ino, size_t size, off_t o
 
         auto result = handler.Call({ino_value, request_ctx, options});
         ResolvePromiseOrValue(env, context, result, [context](Napi::Env env_inner, Napi::Value value) {
+            if (ExecuteNativeRead(context, value)) {
+                return;
+            }
+            const uint8_t* data = nullptr;
+            size_t length = 0;
             if (value.IsArrayBuffer()) {
                 Napi::ArrayBuffer buffer = value.As<Napi::ArrayBuffer>();
-                context->keepalive = CreateKeepaliveFromJsValue(value);
-                context->ReplyBuf(buffer.Data(), buffer.ByteLength());
+                data = static_cast<const uint8_t*>(buffer.Data());
+                length = buffer.ByteLength();
+            } else if (value.IsTypedArray()) {
+                Napi::TypedArray typed = value.As<Napi::TypedArray>();
+                data = static_cast<const uint8_t*>(typed.ArrayBuffer().Data()) + typed.ByteOffset();
+                length = typed.ByteLength();
+            } else {
+                context->ReplyUnsupported();
                 return;
             }
-            if (value.IsTypedArray()) {
-                Napi::TypedArray typed = value.As<Napi::TypedArray>();
+            // Der Kernel erwartet höchstens die angefragte Größe
+            length = std::min(length, context->size);
+            if (auto mapping = FuseNative::FileMappingTable::Instance().Pin(data, length)) {
+                context->keepalive = std::move(mapping);
+            } else {
                 context->keepalive = CreateKeepaliveFromJsValue(value);
-                auto* base = static_cast<uint8_t*>(typed.ArrayBuffer().Data());
-                context->ReplyBuf(base + typed.ByteOffset(), typed.ByteLength());
-                return;
             }
-            context->ReplyUnsupported();
+            context->ReplyBuf(data, length);
         });
     });
 }
@@ -2107,10 +2851,16 @@ void FuseBridge::HandleWrite(fuse_req_t req, fuse_ino_t ino, const char* buf, si
         context->fi = *fi;
         context->has_fi = true;
     }
+    // Koaleszierung: die Antwort kommt aus dem Batch des File-Handles
+    if (buf && QueueCoalescedWrite(context, reinterpret_cast<const uint8_t*>(buf), size)) {
+        return;
+    }
     if (buf && size > 0) {
         context->data.assign(reinterpret_cast<const uint8_t*>(buf),
                              reinterpret_cast<const uint8_t*>(buf) + size);
     }
+    context->has_digest = FuseNative::WriteDigest::Instance().Compute(context->data.data(), context->data.size(),
+                                                                      &context->digest);
 
     const bool has_write_buf = HasOperationHandler(FuseOpType::WRITE_BUF);
     const bool has_write = HasOperationHandler(FuseOpType::WRITE);
@@ -2145,12 +2895,17 @@ void FuseBridge::HandleWrite(fuse_req_t req, fuse_ino_t ino, const char* buf, si
             if (context->has_fi) {
                 options.Set("fi", NapiHelpers::FileInfoToObject(env, context->fi));
             }
+            SetWriteDigest(env, options, *context);
 
             Napi::Object request_ctx = CreateRequestContextObject(env, *context);
             Napi::Value result = handler.Call({ino_value, bufvec, request_ctx, options});
 
             ResolvePromiseOrValue(env, context, result,
                 [context](Napi::Env env_inner, Napi::Value value) {
+                    if (ExecuteNativeWrite(value, SingleIov(context->data.data(), context->data.size()),
+                                           context, ReplyWriteResult(context))) {
+                        return;
+                    }
                     if (value.IsNumber()) {
                         size_t written = static_cast<size_t>(value.As<Napi::Number>().Uint32Value());
                         context->ReplyWrite(written);
@@ -2201,10 +2956,15 @@ void FuseBridge::HandleWrite(fuse_req_t req, fuse_ino_t ino, const char* buf, si
         if (context->has_fi) {
             options.Set("fi", NapiHelpers::FileInfoToObject(env, context->fi));
         }
+        SetWriteDigest(env, options, *context);
         Napi::Object request_ctx = CreateRequestContextObject(env, *context);
 
         auto result = handler.Call({ino_value, buffer, request_ctx, options});
         ResolvePromiseOrValue(env, context, result, [context](Napi::Env env_inner, Napi::Value value) {
+            if (ExecuteNativeWrite(value, SingleIov(context->data.data(), context->data.size()),
+                                   context, ReplyWriteResult(context))) {
+                return;
+            }
             if (value.IsNumber()) {
                 size_t written = static_cast<size_t>(value.As<Napi::Number>().Uint32Value());
                 context->ReplyWrite(written);
@@ -2231,6 +2991,15 @@ void FuseBridge::HandleReaddir(fuse_req_t req, fuse_ino_t ino, size_t size, off_
     context->offset = static_cast<uint64_t>(off);
     if (fi) { context->fi = *fi; context->has_fi = true; }
 
+    // Fortsetzung aus dem Snapshot: kein JS-Roundtrip
+    if (fi) {
+        // Unbekannter Offset: weiter an den JS-Handler wie bei verdrängten Snapshots
+        auto snapshot = DirSnapshotCache::Instance().Find(fi->fh, ino);
+        if (snapshot && ReplyFromDirSnapshot(context, *snapshot)) {
+            return;
+        }
+    }
+
     ProcessRequest(context, [context](Napi::Env env, Napi::Function handler) {
         Napi::Value ino_value    = NapiHelpers::CreateBigUint64(env, ToUint64(context->ino));
         Napi::Value offset_value = NapiHelpers::CreateBigUint64(env, context->offset);
@@ -2244,12 +3013,38 @@ void FuseBridge::HandleReaddir(fuse_req_t req, fuse_ino_t ino, size_t size, off_
         ResolvePromiseOrValue(env, context, result, [context](Napi::Env env_inner, Napi::Value value) {
             if (!value.IsObject()) { context->ReplyError(EIO); return; }
             Napi::Object result_obj = value.As<Napi::Object>();
+            const size_t max_size = context->size;
+
+            // Vollständiges Listing: als Snapshot ablegen und ab offset antworten
+            if (result_obj.Get("snapshot").ToBoolean().Value()) {
+                int err = 0;
+                auto snapshot = TakeDirSnapshot(env_inner, context, result_obj, &err);
+                if (err != 0) { context->ReplyError(err); return; }
+                // Der Handler hat zu diesem Offset ein Listing ohne ihn geliefert
+                if (!ReplyFromDirSnapshot(context, *snapshot)) { context->ReplyError(EIO); }
+                return;
+            }
+
+            // Spaltenformat: Typed Arrays direkt packen, ohne Objekt pro Eintrag
+            if (IsColumnarReaddirResult(result_obj)) {
+                ColumnarDirents cols;
+                const int err = DecodeColumnarDirents(result_obj, &cols);
+                if (err != 0) { context->ReplyError(err); return; }
+                if (max_size == 0) { context->ReplyBuf(nullptr, 0); return; }
+
+                auto buf = std::make_shared<std::vector<char>>(max_size);
+                buf->resize(PackDirents(context->request, cols, context->offset,
+                                        buf->data(), max_size));
+                context->keepalive = buf;
+                context->ReplyBuf(buf->data(), buf->size());
+                return;
+            }
+
             if (!result_obj.Has("entries") || !result_obj.Get("entries").IsArray()) {
                 context->ReplyError(EIO); return;
             }
 
             Napi::Array entries = result_obj.Get("entries").As<Napi::Array>();
-            const size_t max_size = context->size;
             if (max_size == 0) { context->ReplyBuf(nullptr, 0); return; }
 
             // Eigentümer-Puffer → Lebensdauer bis nach fuse_reply_buf gesichert
@@ -2344,6 +3139,7 @@ void FuseBridge::HandleReaddirplus(fuse_req_t req, fuse_ino_t ino, size_t size,
         auto buf = std::make_shared<std::vector<char>>();
         buf->resize(max_size);
         size_t buffer_offset = 0;
+        std::vector<fuse_ino_t> linked;
 
         for (uint32_t i = 0; i < entries.Length(); ++i) {
           Napi::Value item = entries.Get(i);
@@ -2392,11 +3188,44 @@ void FuseBridge::HandleReaddirplus(fuse_req_t req, fuse_ino_t ino, size_t size,
                                  max_size - buffer_offset,
                                  name.c_str(), &e, next_offset);
           buffer_offset += need;
+          if (have_full) {
+            AttrCache::Instance().Store(e.ino, e.attr, e.attr_timeout, context->attr_epoch);
+          }
+          if (CountsAsLookup(name.c_str(), e.ino)) {
+            linked.push_back(e.ino);
+          }
         }
 
         buf->resize(buffer_offset);
         context->keepalive = buf;
-        context->ReplyBuf(buf->data(), buf->size());
+        for (fuse_ino_t child : linked) {
+          InodeTable::Instance().AddLookup(child);
+        }
+        if (!context->ReplyBuf(buf->data(), buf->size())) {
+          for (fuse_ino_t child : linked) {
+            InodeTable::Instance().DropLookup(child);
+          }
+        }
+      };
+
+  // Spaltenformat (nur READDIR-Fallback): Minimal-Attr aus d_type
+  auto write_columnar_and_reply =
+      [context, make_min_entry](const ColumnarDirents& cols, size_t max_size) {
+        if (max_size == 0) { context->ReplyBuf(nullptr, 0); return; }
+
+        auto buf = std::make_shared<std::vector<char>>(max_size);
+        std::vector<uint64_t> linked;
+        buf->resize(PackDirentsPlus(context->request, cols, context->offset, make_min_entry,
+                                    buf->data(), max_size, &linked));
+        context->keepalive = buf;
+        for (uint64_t child : linked) {
+          InodeTable::Instance().AddLookup(static_cast<fuse_ino_t>(child));
+        }
+        if (!context->ReplyBuf(buf->data(), buf->size())) {
+          for (uint64_t child : linked) {
+            InodeTable::Instance().DropLookup(static_cast<fuse_ino_t>(child));
+          }
+        }
       };
 
   // 1) Direkter READDIRPLUS-Handler vorhanden
@@ -2428,13 +3257,24 @@ void FuseBridge::HandleReaddirplus(fuse_req_t req, fuse_ino_t ino, size_t size,
   }
 
   // 2) Fallback: READDIR
+  if (fi) {
+    if (auto snapshot = DirSnapshotCache::Instance().Find(fi->fh, ino)) {
+      const size_t index = snapshot->ResumeIndex(context->offset);
+      if (index != DirSnapshot::kNotFound) {
+        write_columnar_and_reply(snapshot->entries->Slice(index), context->size);
+        return;
+      }
+    }
+  }
+
   auto rd_ctx = CreateContext(FuseOpType::READDIR, req);
   rd_ctx->ino    = context->ino;
   rd_ctx->size   = context->size;
   rd_ctx->offset = context->offset;
   if (context->has_fi) { rd_ctx->fi = context->fi; rd_ctx->has_fi = true; }
 
-  ProcessRequest(rd_ctx, [rd_ctx, write_entries_and_reply](Napi::Env env, Napi::Function handler) {
+  ProcessRequest(rd_ctx, [rd_ctx, write_entries_and_reply, write_columnar_and_reply](
+                             Napi::Env env, Napi::Function handler) {
     Napi::Value ino_value    = NapiHelpers::CreateBigUint64(env, ToUint64(rd_ctx->ino));
     Napi::Value offset_value = NapiHelpers::CreateBigUint64(env, rd_ctx->offset);
     Napi::Object request_ctx = CreateRequestContextObject(env, *rd_ctx);
@@ -2444,7 +3284,29 @@ void FuseBridge::HandleReaddirplus(fuse_req_t req, fuse_ino_t ino, size_t size,
 
     auto result = handler.Call({ino_value, offset_value, request_ctx, fi_value, options});
     ResolvePromiseOrValue(env, rd_ctx, result,
-      [rd_ctx, write_entries_and_reply](Napi::Env env_inner, Napi::Value value) {
+      [rd_ctx, write_entries_and_reply, write_columnar_and_reply](Napi::Env env_inner, Napi::Value value) {
+        // Vollständiges Listing aus dem READDIR-Handler: Snapshot ablegen
+        if (value.IsObject() && !value.IsArray() &&
+            value.As<Napi::Object>().Get("snapshot").ToBoolean().Value()) {
+          int err = 0;
+          auto snapshot = TakeDirSnapshot(env_inner, rd_ctx, value.As<Napi::Object>(), &err);
+          if (err != 0) { rd_ctx->ReplyError(err); return; }
+          const size_t index = snapshot->ResumeIndex(rd_ctx->offset);
+          if (index == DirSnapshot::kNotFound) { rd_ctx->ReplyError(EIO); return; }
+          write_columnar_and_reply(snapshot->entries->Slice(index), rd_ctx->size);
+          return;
+        }
+
+        // Spaltenformat aus dem READDIR-Handler mit Minimal-Attr packen
+        if (value.IsObject() && !value.IsArray() &&
+            IsColumnarReaddirResult(value.As<Napi::Object>())) {
+          ColumnarDirents cols;
+          const int err = DecodeColumnarDirents(value.As<Napi::Object>(), &cols);
+          if (err != 0) { rd_ctx->ReplyError(err); return; }
+          write_columnar_and_reply(cols, rd_ctx->size);
+          return;
+        }
+
         // Akzeptiere {entries:[...]} oder direkt Array
         Napi::Array entries;
         if (value.IsArray()) {
@@ -2524,7 +3386,8 @@ void FuseBridge::HandleCreate(fuse_req_t req, fuse_ino_t parent, const char* nam
             }
 
             struct fuse_file_info fi_result{};
-            if (!NapiHelpers::ObjectToFileInfo(result_obj.Get("fi").As<Napi::Object>(), &fi_result)) {
+            Napi::Object fi_object = result_obj.Get("fi").As<Napi::Object>();
+            if (!NapiHelpers::ObjectToFileInfo(fi_object, &fi_result)) {
                 context->ReplyError(EIO);
                 return;
             }
@@ -2600,6 +3463,7 @@ void FuseBridge::HandleCreate(fuse_req_t req, fuse_ino_t parent, const char* nam
               (unsigned long long)fi_result.fh,
               entry.entry_timeout, entry.attr_timeout);
 
+            AttachBackingFile(context, fi_object, &fi_result);
             context->ReplyCreate(entry, fi_result);
         });
     });
@@ -2609,6 +3473,16 @@ void FuseBridge::HandleCopyFileRange(fuse_req_t req, fuse_ino_t ino_in, off_t of
                                      struct fuse_file_info* fi_in, fuse_ino_t ino_out,
                                      off_t off_out, struct fuse_file_info* fi_out,
                                      size_t len, int flags) {
+    // Quelle und Ziel erst nach ihren eingereihten Writes
+    auto resume = [this, req, ino_in, off_in, ino_out, off_out, len, flags,
+                   has_in = fi_in != nullptr, in_copy = fi_in ? *fi_in : fuse_file_info{},
+                   has_out = fi_out != nullptr, out_copy = fi_out ? *fi_out : fuse_file_info{}]() mutable {
+        HandleCopyFileRange(req, ino_in, off_in, has_in ? &in_copy : nullptr, ino_out, off_out,
+                            has_out ? &out_copy : nullptr, len, flags);
+    };
+    if (DeferUntilInodeWritesDrained(ino_in, resume) || DeferUntilInodeWritesDrained(ino_out, resume)) {
+        return;
+    }
     auto context = CreateContext(FuseOpType::COPY_FILE_RANGE, req);
     context->ino = ino_in;
     context->offset = static_cast<uint64_t>(off_in);
@@ -2912,10 +3786,16 @@ void FuseBridge::HandlePoll(fuse_req_t req, fuse_ino_t ino, struct fuse_file_inf
 }
 
 void FuseBridge::HandleInit(fuse_req_t req, struct fuse_conn_info* conn) {
-    auto context = CreateContext(FuseOpType::INIT, req);
     conn->want |= FUSE_CAP_ASYNC_READ | FUSE_CAP_WRITEBACK_CACHE | FUSE_CAP_SPLICE_READ;
     conn->max_write = 4096 * 4;
     conn->max_readahead = 4096 * 4;
+    PassthroughRegistry::Instance().Negotiate(
+        conn, session_manager_ && session_manager_->GetOptions().passthrough);
+    // Übernommene Session: der JS-init lief bereits im Vorgängerprozess
+    if (session_manager_ && session_manager_->IsReplayingInit()) {
+        return;
+    }
+    auto context = CreateContext(FuseOpType::INIT, req);
     ProcessRequest(context, [context, conn](Napi::Env env, Napi::Function handler) {
         Napi::Object conn_info = Napi::Object::New(env);
         conn_info.Set("protoMajor", conn->proto_major);
@@ -2927,8 +3807,21 @@ void FuseBridge::HandleInit(fuse_req_t req, struct fuse_conn_info* conn) {
 }
 
 void FuseBridge::HandleDestroy(fuse_req_t req) {
+  // Verbindung lebt im Nachfolgeprozess weiter: weder Caches noch JS-destroy anfassen
+  if (session_manager_ && session_manager_->IsHandedOff()) {
+    FUSE_LOG_INFO("FuseBridge::HandleDestroy - session handed off, skipping destroy");
+    return;
+  }
+
   auto context = CreateContext(FuseOpType::DESTROY, req);
 
+  // Ausstehende forget-Batches noch vor destroy ausliefern
+  InodeTable::Instance().Reset();
+  PassthroughRegistry::Instance().Reset();
+  GetKernelWriteQueueManager().ResetHandles();
+  XAttrCache::Instance().Clear();
+  XAttrFdCache::Instance().Clear();
+
   {
     std::lock_guard<std::mutex> lock(handler_mutex_);
     handler_registry_.clear();
@@ -2948,10 +3841,32 @@ void FuseBridge::HandleDestroy(fuse_req_t req) {
 }
 
 void FuseBridge::HandleForget(fuse_req_t req, fuse_ino_t ino, uint64_t nlookup) {
+    AttrCache::Instance().Invalidate(ino);
+    XAttrCache::Instance().InvalidateInode(ino);
+    // Die Inode-Nummer darf danach für eine andere Datei vergeben werden
+    XAttrFdCache::Instance().Invalidate(ino);
+    InodeTable::Instance().Forget(ino, nlookup);
     if (req) fuse_reply_none(req);
 }
 
 void FuseBridge::HandleForgetMulti(fuse_req_t req, size_t count, struct fuse_forget_data* forgets) {
+    InodeTable& inodes = InodeTable::Instance();
+    for (size_t i = 0; forgets && i < count; ++i) {
+        AttrCache::Instance().Invalidate(forgets[i].ino);
+        XAttrCache::Instance().InvalidateInode(forgets[i].ino);
+        XAttrFdCache::Instance().Invalidate(forgets[i].ino);
+        inodes.Forget(forgets[i].ino, forgets[i].nlookup);
+    }
+    if (req) fuse_reply_none(req);
+}
+
+void FuseBridge::HandleRetrieveReply(fuse_req_t req, void* cookie, fuse_ino_t ino, off_t offset,
+                                     struct fuse_bufvec* bufv) {
+    // Antwort auf notify_retrieve – geht nie an JS, löst nur das Promise auf
+    if (!CompleteRetrieve(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(cookie)), ino, offset, bufv)) {
+        FUSE_LOG_DEBUG("retrieve_reply: unknown cookie %p for ino=%llu", cookie,
+                       static_cast<unsigned long long>(ino));
+    }
     if (req) fuse_reply_none(req);
 }
 
@@ -2992,6 +3907,30 @@ void FuseBridge::HandleGetxattr(fuse_req_t req, fuse_ino_t ino, const char* name
     context->ino = ino;
     context->name = name ? name : "";
     context->size = size;
+
+    // Fast-Path: bekannte und bekannt fehlende Attribute ohne JS-Roundtrip
+    XAttrCache& xattrs = XAttrCache::Instance();
+    if (xattrs.Enabled()) {
+        XAttrCache::Value cached;
+        switch (xattrs.LookupValue(ino, context->name, &cached)) {
+            case XAttrLookup::NEGATIVE:
+                fuse_reply_err(req, kXAttrMissingErrno);
+                return;
+            case XAttrLookup::POSITIVE:
+                if (size == 0) {
+                    fuse_reply_xattr(req, cached->size());
+                } else if (cached->size() > size) {
+                    fuse_reply_err(req, ERANGE);
+                } else {
+                    fuse_reply_buf(req, reinterpret_cast<const char*>(cached->data()), cached->size());
+                }
+                return;
+            case XAttrLookup::MISS:
+                break;
+        }
+        context->xattr_epoch = xattrs.Epoch(ino);
+    }
+
     ProcessRequest(context, [context](Napi::Env env, Napi::Function handler) {
         Napi::Object opts = Napi::Object::New(env);
         opts.Set("size", Napi::Number::New(env, context->size));
@@ -2999,8 +3938,25 @@ void FuseBridge::HandleGetxattr(fuse_req_t req, fuse_ino_t ino, const char* name
                                     Napi::String::New(env, context->name),
                                     CreateRequestContextObject(env, *context), opts});
         ResolvePromiseOrValue(env, context, result, [context](Napi::Env, Napi::Value value) {
+            // GetxattrHandler-Form { data?, size }
+            if (value.IsObject() && !value.IsBuffer() && !value.IsArray()) {
+                Napi::Object reply = value.As<Napi::Object>();
+                Napi::Value data = reply.Get("data");
+                value = data.IsBuffer() ? data : reply.Get("size");
+                if (value.IsBigInt()) {
+                    bool lossless = false;
+                    value = Napi::Number::New(value.Env(), static_cast<double>(
+                        value.As<Napi::BigInt>().Uint64Value(&lossless)));
+                }
+            }
             if (value.IsBuffer()) {
                 Napi::Buffer<uint8_t> buf = value.As<Napi::Buffer<uint8_t>>();
+                XAttrCache& cache = XAttrCache::Instance();
+                if (cache.Enabled()) {
+                    cache.StoreValue(context->ino, context->name,
+                                     std::make_shared<const std::vector<uint8_t>>(buf.Data(), buf.Data() + buf.Length()),
+                                     context->xattr_epoch);
+                }
                 if (context->size == 0) return (void)fuse_reply_xattr(context->request, buf.Length());
                 if (buf.Length() > context->size) return context->ReplyError(ERANGE);
                 context->keepalive = CreateKeepaliveFromJsValue(value);
@@ -3018,19 +3974,48 @@ void FuseBridge::HandleListxattr(fuse_req_t req, fuse_ino_t ino, size_t size) {
     auto context = CreateContext(FuseOpType::LISTXATTR, req);
     context->ino = ino;
     context->size = size;
+
+    XAttrCache& xattrs = XAttrCache::Instance();
+    if (xattrs.Enabled()) {
+        XAttrCache::List cached;
+        if (xattrs.LookupList(ino, &cached) == XAttrLookup::POSITIVE) {
+            if (size == 0) {
+                fuse_reply_xattr(req, cached->length());
+            } else if (cached->length() > size) {
+                fuse_reply_err(req, ERANGE);
+            } else {
+                fuse_reply_buf(req, cached->data(), cached->length());
+            }
+            return;
+        }
+        context->xattr_epoch = xattrs.Epoch(ino);
+    }
+
     ProcessRequest(context, [context](Napi::Env env, Napi::Function handler) {
         Napi::Object opts = Napi::Object::New(env);
         opts.Set("size", Napi::Number::New(env, context->size));
         auto result = handler.Call(
             {NapiHelpers::CreateBigUint64(env, ToUint64(context->ino)), CreateRequestContextObject(env, *context), opts});
         ResolvePromiseOrValue(env, context, result, [context](Napi::Env, Napi::Value value) {
+            // ListxattrHandler-Form { names?, size }
+            if (value.IsObject() && !value.IsArray() && !value.IsBuffer()) {
+                Napi::Object reply = value.As<Napi::Object>();
+                Napi::Value names = reply.Get("names");
+                value = names.IsArray() ? names : reply.Get("size");
+                if (value.IsBigInt()) {
+                    bool lossless = false;
+                    value = Napi::Number::New(value.Env(), static_cast<double>(
+                        value.As<Napi::BigInt>().Uint64Value(&lossless)));
+                }
+            }
             if (value.IsArray()) {
                 Napi::Array arr = value.As<Napi::Array>();
                 std::string list;
                 for (uint32_t i = 0; i < arr.Length(); ++i) list.append(arr.Get(i).As<Napi::String>().Utf8Value()).push_back('\0');
-                if (context->size == 0) return (void)fuse_reply_xattr(context->request, list.length());
-                if (list.length() > context->size) return context->ReplyError(ERANGE);
                 auto owner = std::make_shared<std::string>(std::move(list));
+                XAttrCache::Instance().StoreList(context->ino, owner, context->xattr_epoch);
+                if (context->size == 0) return (void)fuse_reply_xattr(context->request, owner->length());
+                if (owner->length() > context->size) return context->ReplyError(ERANGE);
                 context->keepalive = owner;
                 context->ReplyBuf(owner->data(), owner->length());
             } else if (value.IsNumber()) {
@@ -3374,6 +4359,17 @@ void FuseBridge::ForgetMultiCallback(fuse_req_t req, size_t count, struct fuse_f
     bridge->HandleForgetMulti(req, count, forgets);
 }
 
+void FuseBridge::RetrieveReplyCallback(fuse_req_t req, void* cookie, fuse_ino_t ino, off_t offset,
+                                       struct fuse_bufvec* bufv) {
+    auto* bridge = GetBridgeFromRequest(req);
+    if (!bridge) {
+        CompleteRetrieve(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(cookie)), ino, offset, bufv);
+        fuse_reply_none(req);
+        return;
+    }
+    bridge->HandleRetrieveReply(req, cookie, ino, offset, bufv);
+}
+
 void FuseBridge::HandleWriteBuf(fuse_req_t req,
                                 fuse_ino_t ino,
                                 struct fuse_bufvec* bufv,
@@ -3404,6 +4400,13 @@ void FuseBridge::HandleWriteBuf(fuse_req_t req,
         }
     }
 
+    // Einzelner Speicherpuffer (Normalfall): direkt einreihen
+    const fuse_buf& first = bufv->buf[0];
+    if (!contains_fd && bufv->count == 1 && bufv->idx == 0 && bufv->off == 0 && first.mem &&
+        QueueCoalescedWrite(context, static_cast<const uint8_t*>(first.mem), first.size)) {
+        return;
+    }
+
     auto handle_write_result = [context](Napi::Env env_inner, Napi::Value value) {
         if (value.IsNumber()) {
             int64_t n = value.As<Napi::Number>().Int64Value();
@@ -3458,9 +4461,16 @@ void FuseBridge::HandleWriteBuf(fuse_req_t req,
             }
         }
 
+        // Digest nur für den zusammenhängenden Normalfall (ein Segment ohne Versatz)
+        if (copies.size() == 1 && bufv->idx == 0 && bufv->off == 0) {
+            context->has_digest = FuseNative::WriteDigest::Instance().Compute(copies[0].data(), copies[0].size(),
+                                                                              &context->digest);
+        }
+
+        auto shared_copies = std::make_shared<std::vector<std::vector<uint8_t>>>(std::move(copies));
         ProcessRequest(context,
             [context,
-             copies = std::move(copies),
+             copies = shared_copies,
              sizes = std::move(sizes),
              flags = std::move(flags),
              idx = bufv->idx,
@@ -3469,19 +4479,19 @@ void FuseBridge::HandleWriteBuf(fuse_req_t req,
                 Napi::Value ino_value = NapiHelpers::CreateBigUint64(env, ToUint64(context->ino));
 
                 Napi::Object bufvec = Napi::Object::New(env);
-                bufvec.Set("count", Napi::Number::New(env, static_cast<double>(copies.size())));
+                bufvec.Set("count", Napi::Number::New(env, static_cast<double>(copies->size())));
                 bufvec.Set("idx", Napi::Number::New(env, static_cast<double>(idx)));
                 bufvec.Set("off", Napi::Number::New(env, static_cast<double>(off_val)));
 
-                Napi::Array buf_array = Napi::Array::New(env, copies.size());
-                for (size_t i = 0; i < copies.size(); ++i) {
+                Napi::Array buf_array = Napi::Array::New(env, copies->size());
+                for (size_t i = 0; i < copies->size(); ++i) {
                     Napi::Object buf_obj = Napi::Object::New(env);
                     buf_obj.Set("size", Napi::Number::New(env, static_cast<double>(sizes[i])));
                     buf_obj.Set("flags", Napi::Number::New(env, static_cast<double>(flags[i])));
 
                     Napi::ArrayBuffer payload = Napi::ArrayBuffer::New(env, sizes[i]);
                     if (sizes[i] > 0) {
-                        std::memcpy(payload.Data(), copies[i].data(), sizes[i]);
+                        std::memcpy(payload.Data(), (*copies)[i].data(), sizes[i]);
                     }
 
                     buf_obj.Set("mem", payload);
@@ -3496,11 +4506,24 @@ void FuseBridge::HandleWriteBuf(fuse_req_t req,
                 if (context->has_fi) {
                     options.Set("fi", NapiHelpers::FileInfoToObject(env, context->fi));
                 }
+                SetWriteDigest(env, options, *context);
 
                 Napi::Object request_ctx = CreateRequestContextObject(env, *context);
                 Napi::Value result = handler.Call({ino_value, bufvec, request_ctx, options});
 
-                ResolvePromiseOrValue(env, context, result, handle_write_result,
+                // pwrite-Deskriptor: Segmente ab idx/off direkt schreiben
+                auto on_result = [context, copies, idx, off_val, handle_write_result](Napi::Env env_inner,
+                                                                                      Napi::Value value) {
+                    std::vector<struct iovec> iov;
+                    for (size_t i = idx; i < copies->size(); ++i) {
+                        const size_t skip = i == idx ? std::min(off_val, (*copies)[i].size()) : 0;
+                        iov.push_back(iovec{(*copies)[i].data() + skip, (*copies)[i].size() - skip});
+                    }
+                    if (!ExecuteNativeWrite(value, std::move(iov), copies, ReplyWriteResult(context))) {
+                        handle_write_result(env_inner, value);
+                    }
+                };
+                ResolvePromiseOrValue(env, context, result, on_result,
                     [context](Napi::Env env_inner, Napi::Value reason) {
                         ReplyWithErrorValue(env_inner, context, reason);
                     });
@@ -3541,12 +4564,19 @@ void FuseBridge::HandleWriteBuf(fuse_req_t req,
         }
     }
 
-    ProcessRequest(context, [context, linear = std::move(linear), handle_write_result](Napi::Env env, Napi::Function handler) {
+    if (QueueCoalescedWrite(context, linear.data(), linear.size())) {
+        return;
+    }
+
+    context->data = std::move(linear);
+    context->has_digest = FuseNative::WriteDigest::Instance().Compute(context->data.data(), context->data.size(),
+                                                                      &context->digest);
+    ProcessRequest(context, [context, handle_write_result](Napi::Env env, Napi::Function handler) {
         Napi::Value ino_value = NapiHelpers::CreateBigUint64(env, ToUint64(context->ino));
 
-        Napi::ArrayBuffer data = Napi::ArrayBuffer::New(env, linear.size());
-        if (!linear.empty()) {
-            std::memcpy(data.Data(), linear.data(), linear.size());
+        Napi::ArrayBuffer data = Napi::ArrayBuffer::New(env, context->data.size());
+        if (!context->data.empty()) {
+            std::memcpy(data.Data(), context->data.data(), context->data.size());
         }
 
         Napi::Object request_ctx = CreateRequestContextObject(env, *context);
@@ -3556,6 +4586,7 @@ void FuseBridge::HandleWriteBuf(fuse_req_t req,
         if (context->has_fi) {
             options.Set("fi", NapiHelpers::FileInfoToObject(env, context->fi));
         }
+        SetWriteDigest(env, options, *context);
 
         Napi::Value result = handler.Call({ino_value, data, request_ctx, options});
 
@@ -3563,7 +4594,12 @@ void FuseBridge::HandleWriteBuf(fuse_req_t req,
             env,
             context,
             result,
-            handle_write_result,
+            [context, handle_write_result](Napi::Env env_inner, Napi::Value value) {
+                if (!ExecuteNativeWrite(value, SingleIov(context->data.data(), context->data.size()),
+                                        context, ReplyWriteResult(context))) {
+                    handle_write_result(env_inner, value);
+                }
+            },
             [context](Napi::Env env_inner, Napi::Value reason) {
                 ReplyWithErrorValue(env_inner, context, reason);
             }
@@ -19,6 +19,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "content_hash.h"
 #include "tsfn_dispatcher.h"
 
 namespace fuse_native {
@@ -91,6 +92,7 @@ const char* FuseOpTypeToString(FuseOpType type);
 
 struct FuseRequestContext : public std::enable_shared_from_this<FuseRequestContext> {
     FuseRequestContext(FuseOpType op_type, fuse_req_t request, FuseBridge* bridge);
+    ~FuseRequestContext();
 
     FuseRequestContext(const FuseRequestContext&) = delete;
     FuseRequestContext& operator=(const FuseRequestContext&) = delete;
@@ -105,7 +107,7 @@ struct FuseRequestContext : public std::enable_shared_from_this<FuseRequestConte
 
     void ReplyAttr(const struct stat& attr_value, double attr_timeout);
     void ReplyEntry(const struct fuse_entry_param& entry);
-    void ReplyBuf(const void* data_ptr, size_t length);
+    bool ReplyBuf(const void* data_ptr, size_t length);
     void ReplyWrite(size_t bytes_written);
     void ReplyOpen(const struct fuse_file_info& result_fi);
     void ReplyOpendir(const struct fuse_file_info& result_fi);
@@ -121,9 +123,10 @@ struct FuseRequestContext : public std::enable_shared_from_this<FuseRequestConte
     FuseOpType op_type;
     fuse_req_t request;
     FuseBridge* bridge;
-    uint64_t request_id{};
+    uint64_t request_id{};  ///< Bridge-wide request sequence (trace probes)
     CallbackPriority priority{};
     std::chrono::steady_clock::time_point start_time{};
+    std::chrono::steady_clock::time_point js_start_time{};  ///< Only set while js_settle is traced
     struct fuse_ctx caller_ctx{};
     bool has_caller_ctx{false};
 
@@ -153,8 +156,14 @@ struct FuseRequestContext : public std::enable_shared_from_this<FuseRequestConte
     struct flock lock{};
     bool has_lock{false};
     int sleep{};
+    uint64_t dentry_epoch{};  ///< DentryCache epoch captured when a lookup is dispatched
+    uint64_t xattr_epoch{};   ///< XAttrCache epoch captured when getxattr/listxattr is dispatched
+    uint64_t attr_epoch{};    ///< AttrCache epoch captured at creation; replies carrying attrs store against it
+    FuseNative::ContentDigest digest{};  ///< Write payload digest (configureWriteDigest)
+    bool has_digest{false};
 
     std::atomic<bool> replied{false};
+    std::shared_ptr<std::atomic<size_t>> unreplied;  ///< Bridge counter, held until replied (session handoff)
 };
 
 /**
@@ -180,10 +189,20 @@ public:
 
     static FuseBridge* GetBridgeFromRequest(fuse_req_t req);
 
+    /**
+     * Requests read from the kernel that have not been answered yet
+     *
+     * Shared with the request contexts, so a context outliving the bridge
+     * still decrements a valid counter.
+     */
+    const std::shared_ptr<std::atomic<size_t>>& UnrepliedCounter() const { return unreplied_requests_; }
+    size_t UnrepliedRequests() const { return unreplied_requests_->load(std::memory_order_acquire); }
+
 private:
     SessionManager* session_manager_;
     napi_env env_;
     bool initialized_;
+    std::shared_ptr<std::atomic<size_t>> unreplied_requests_;
     struct fuse_lowlevel_ops fuse_ops_;
 
     struct HandlerRecord {
@@ -259,6 +278,8 @@ private:
    void HandleDestroy(fuse_req_t req);
    void HandleForget(fuse_req_t req, fuse_ino_t ino, uint64_t nlookup);
    void HandleForgetMulti(fuse_req_t req, size_t count, struct fuse_forget_data* forgets);
+   void HandleRetrieveReply(fuse_req_t req, void* cookie, fuse_ino_t ino, off_t offset,
+                            struct fuse_bufvec* bufv);
    void HandleReadBuf(fuse_req_t req,
                       fuse_ino_t ino,
                       size_t size,
@@ -287,6 +308,8 @@ private:
    static void DestroyCallback(void* userdata);
    static void ForgetCallback(fuse_req_t req, fuse_ino_t ino, uint64_t nlookup);
    static void ForgetMultiCallback(fuse_req_t req, size_t count, struct fuse_forget_data* forgets);
+   static void RetrieveReplyCallback(fuse_req_t req, void* cookie, fuse_ino_t ino, off_t offset,
+                                     struct fuse_bufvec* bufv);
     static void LookupCallback(fuse_req_t req, fuse_ino_t parent, const char* name);
     static void GetattrCallback(fuse_req_t req, fuse_ino_t ino, struct fuse_file_info* fi);
     static void SetattrCallback(fuse_req_t req, fuse_ino_t ino, struct stat* attr, int to_set,
@@ -0,0 +1,321 @@
+/**
+ * @file inode_table.cc
+ * @brief Native inode table tracking kernel lookup counts and batching forgets
+ */
+
+#include "inode_table.h"
+
+#include <algorithm>
+
+#include "logging.h"
+#include "napi_helpers.h"
+
+namespace fuse_native {
+
+namespace {
+
+constexpr fuse_ino_t kRootIno = FUSE_ROOT_ID;
+
+} // namespace
+
+InodeTable& InodeTable::Instance() {
+    static InodeTable instance;
+    return instance;
+}
+
+InodeTable::~InodeTable() {
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        stopping_ = true;
+    }
+    pending_cv_.notify_all();
+    if (flusher_.joinable()) {
+        flusher_.join();
+    }
+}
+
+void InodeTable::SetTracking(bool enabled) {
+    const bool was = tracking_.exchange(enabled, std::memory_order_acq_rel);
+    if (was && !enabled) {
+        ClearCounts();
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        pending_.clear();
+    }
+    FUSE_LOG_DEBUG("inode table: tracking=%d", enabled ? 1 : 0);
+}
+
+void InodeTable::SetSink(Sink sink) {
+    std::lock_guard<std::mutex> lock(sink_mutex_);
+    sink_ = std::move(sink);
+}
+
+void InodeTable::Configure(size_t batch_size, uint32_t flush_interval_ms) {
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        batch_size_ = std::max<size_t>(1, batch_size);
+        flush_interval_ = std::chrono::milliseconds(std::max<uint32_t>(1, flush_interval_ms));
+    }
+    pending_cv_.notify_all();
+    FUSE_LOG_DEBUG("inode table: batch_size=%zu flush_interval=%ums", batch_size, flush_interval_ms);
+}
+
+void InodeTable::AddLookup(fuse_ino_t ino, uint64_t count) {
+    if (ino == 0 || ino == kRootIno || count == 0 || !Tracking()) {
+        return;
+    }
+    Shard& shard = ShardFor(ino);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.nlookup[ino] += count;
+    }
+    lookups_.fetch_add(count, std::memory_order_relaxed);
+}
+
+void InodeTable::DropLookup(fuse_ino_t ino, uint64_t count) {
+    if (ino == 0 || ino == kRootIno || count == 0 || !Tracking()) {
+        return;
+    }
+    lookups_.fetch_sub(count, std::memory_order_relaxed);
+
+    Shard& shard = ShardFor(ino);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.nlookup.find(ino);
+        if (it == shard.nlookup.end()) {
+            return;
+        }
+        if (it->second > count) {
+            it->second -= count;
+            return;
+        }
+        shard.nlookup.erase(it);
+    }
+
+    released_.fetch_add(1, std::memory_order_relaxed);
+    QueueRelease(ino);
+}
+
+bool InodeTable::Forget(fuse_ino_t ino, uint64_t nlookup) {
+    if (ino == 0 || ino == kRootIno || !Tracking()) {
+        return false;
+    }
+    forgets_.fetch_add(nlookup, std::memory_order_relaxed);
+
+    Shard& shard = ShardFor(ino);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.nlookup.find(ino);
+        if (it == shard.nlookup.end()) {
+            unknown_forgets_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (it->second > nlookup) {
+            it->second -= nlookup;
+            return false;
+        }
+        shard.nlookup.erase(it);
+    }
+
+    released_.fetch_add(1, std::memory_order_relaxed);
+    QueueRelease(ino);
+    return true;
+}
+
+uint64_t InodeTable::LookupCount(fuse_ino_t ino) const {
+    const Shard& shard = ShardFor(ino);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.nlookup.find(ino);
+    return it == shard.nlookup.end() ? 0 : it->second;
+}
+
+std::vector<std::pair<fuse_ino_t, uint64_t>> InodeTable::SnapshotCounts() const {
+    std::vector<std::pair<fuse_ino_t, uint64_t>> counts;
+    for (const Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        counts.insert(counts.end(), shard.nlookup.begin(), shard.nlookup.end());
+    }
+    return counts;
+}
+
+void InodeTable::RestoreCounts(const std::vector<std::pair<fuse_ino_t, uint64_t>>& counts) {
+    if (!Tracking()) {
+        return;
+    }
+    for (const auto& entry : counts) {
+        if (entry.first == 0 || entry.first == kRootIno || entry.second == 0) {
+            continue;
+        }
+        Shard& shard = ShardFor(entry.first);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.nlookup[entry.first] = entry.second;
+    }
+}
+
+void InodeTable::QueueRelease(fuse_ino_t ino) {
+    std::vector<fuse_ino_t> full;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        pending_.push_back(ino);
+        if (pending_.size() >= batch_size_) {
+            full.swap(pending_);
+        }
+    }
+    if (!full.empty()) {
+        Deliver(std::move(full));
+        return;
+    }
+    EnsureFlusher();
+    pending_cv_.notify_one();
+}
+
+void InodeTable::EnsureFlusher() {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    if (!flusher_.joinable() && !stopping_) {
+        flusher_ = std::thread([this] { FlusherLoop(); });
+    }
+}
+
+void InodeTable::FlusherLoop() {
+    std::unique_lock<std::mutex> lock(pending_mutex_);
+    while (!stopping_) {
+        pending_cv_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+        if (stopping_) {
+            break;
+        }
+        // Teilbatch nach Ablauf des Intervalls ausliefern
+        pending_cv_.wait_for(lock, flush_interval_, [this] { return stopping_ || pending_.empty(); });
+        if (stopping_ || pending_.empty()) {
+            continue;
+        }
+        std::vector<fuse_ino_t> batch;
+        batch.swap(pending_);
+        lock.unlock();
+        Deliver(std::move(batch));
+        lock.lock();
+    }
+}
+
+void InodeTable::Deliver(std::vector<fuse_ino_t>&& batch) {
+    const size_t count = batch.size();
+    bool delivered = false;
+    {
+        std::lock_guard<std::mutex> lock(sink_mutex_);
+        if (sink_) {
+            delivered = sink_(std::move(batch));
+        }
+    }
+    if (delivered) {
+        batches_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        dropped_.fetch_add(count, std::memory_order_relaxed);
+        FUSE_LOG_DEBUG("inode table: dropped %zu released inodes", count);
+    }
+}
+
+void InodeTable::Flush() {
+    std::vector<fuse_ino_t> batch;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        batch.swap(pending_);
+    }
+    if (!batch.empty()) {
+        Deliver(std::move(batch));
+    }
+}
+
+void InodeTable::Reset() {
+    Flush();
+    ClearCounts();
+}
+
+void InodeTable::ClearCounts() {
+    for (Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.nlookup.clear();
+    }
+}
+
+InodeTableStats InodeTable::GetStats() const {
+    InodeTableStats stats;
+    stats.lookups = lookups_.load(std::memory_order_relaxed);
+    stats.forgets = forgets_.load(std::memory_order_relaxed);
+    stats.released = released_.load(std::memory_order_relaxed);
+    stats.unknown_forgets = unknown_forgets_.load(std::memory_order_relaxed);
+    stats.batches = batches_.load(std::memory_order_relaxed);
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    for (const Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        stats.live_inodes += shard.nlookup.size();
+    }
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    stats.pending = pending_.size();
+    stats.batch_size = batch_size_;
+    stats.flush_interval_ms = static_cast<uint32_t>(flush_interval_.count());
+    return stats;
+}
+
+Napi::Value ConfigureInodeTable(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        NapiHelpers::ThrowTypeError(env, "Expected configuration object");
+        return env.Undefined();
+    }
+
+    Napi::Object config = info[0].As<Napi::Object>();
+    const InodeTableStats current = InodeTable::Instance().GetStats();
+    double values[2] = {static_cast<double>(current.batch_size),
+                        static_cast<double>(current.flush_interval_ms)};
+    const char* keys[2] = {"batchSize", "flushIntervalMs"};
+    for (size_t i = 0; i < 2; ++i) {
+        Napi::Value value = config.Get(keys[i]);
+        if (value.IsUndefined()) {
+            continue;
+        }
+        if (!value.IsNumber() || value.As<Napi::Number>().DoubleValue() < 1 ||
+            value.As<Napi::Number>().DoubleValue() > UINT32_MAX) {
+            NapiHelpers::ThrowTypeError(env, std::string(keys[i]) + " must be a positive number");
+            return env.Undefined();
+        }
+        values[i] = value.As<Napi::Number>().DoubleValue();
+    }
+
+    InodeTable::Instance().Configure(static_cast<size_t>(values[0]), static_cast<uint32_t>(values[1]));
+    return Napi::Boolean::New(env, true);
+}
+
+Napi::Value GetInodeLookupCount(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsBigInt()) {
+        NapiHelpers::ThrowTypeError(env, "Expected ino as bigint");
+        return env.Undefined();
+    }
+
+    const uint64_t ino = NapiHelpers::GetBigUint64(env, info[0]);
+    if (env.IsExceptionPending()) {
+        return env.Undefined();
+    }
+    return NapiHelpers::CreateBigUint64(env, InodeTable::Instance().LookupCount(static_cast<fuse_ino_t>(ino)));
+}
+
+Napi::Value GetInodeTableStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    const InodeTableStats stats = InodeTable::Instance().GetStats();
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("tracking", Napi::Boolean::New(env, InodeTable::Instance().Tracking()));
+    result.Set("lookups", NapiHelpers::CreateBigUint64(env, stats.lookups));
+    result.Set("forgets", NapiHelpers::CreateBigUint64(env, stats.forgets));
+    result.Set("released", NapiHelpers::CreateBigUint64(env, stats.released));
+    result.Set("unknownForgets", NapiHelpers::CreateBigUint64(env, stats.unknown_forgets));
+    result.Set("batches", NapiHelpers::CreateBigUint64(env, stats.batches));
+    result.Set("dropped", NapiHelpers::CreateBigUint64(env, stats.dropped));
+    result.Set("liveInodes", Napi::Number::New(env, static_cast<double>(stats.live_inodes)));
+    result.Set("pending", Napi::Number::New(env, static_cast<double>(stats.pending)));
+    result.Set("batchSize", Napi::Number::New(env, static_cast<double>(stats.batch_size)));
+    result.Set("flushIntervalMs", Napi::Number::New(env, stats.flush_interval_ms));
+    return result;
+}
+
+} // namespace fuse_native
@@ -0,0 +1,208 @@
+/**
+ * @file inode_table.h
+ * @brief Native inode table tracking kernel lookup counts and batching forgets
+ *
+ * Every entry reply (lookup, mknod, mkdir, symlink, link, create and each
+ * readdirplus entry other than "." and "..") gives the kernel one more
+ * reference to an inode; forget returns them. The table keeps that count per
+ * inode so the backend does not have to. When an inode drops to zero it is
+ * queued and handed to the JS `forget` handler in batches, once the batch is
+ * full or the flush interval has passed, instead of one dispatch per forget.
+ *
+ * Tracking is active while a `forget` handler is registered. Inodes looked
+ * up before that are not tracked and never reported. At unmount the kernel
+ * implicitly drops every remaining reference; those inodes are not reported
+ * individually (the `destroy` handler covers them).
+ */
+
+#ifndef INODE_TABLE_H
+#define INODE_TABLE_H
+
+#include <napi.h>
+#include <fuse3/fuse_lowlevel.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fuse_native {
+
+/**
+ * Inode table statistics
+ */
+struct InodeTableStats {
+    uint64_t lookups = 0;          ///< Kernel references handed out
+    uint64_t forgets = 0;          ///< Kernel references returned
+    uint64_t released = 0;         ///< Inodes that reached zero
+    uint64_t unknown_forgets = 0;  ///< Forgets for untracked inodes
+    uint64_t batches = 0;          ///< Batches handed to the sink
+    uint64_t dropped = 0;          ///< Released inodes discarded (no sink or dispatch failed)
+    size_t live_inodes = 0;
+    size_t pending = 0;            ///< Released, not yet delivered
+    size_t batch_size = 0;
+    uint32_t flush_interval_ms = 0;
+};
+
+/**
+ * Sharded inode -> nlookup table with batched release delivery.
+ */
+class InodeTable {
+public:
+    static constexpr size_t kShardCount = 16;
+
+    /** Receives released inodes; called without any table lock held */
+    using Sink = std::function<bool(std::vector<fuse_ino_t>&& inos)>;
+
+    static InodeTable& Instance();
+
+    ~InodeTable();
+
+    /**
+     * @brief Enable or disable tracking
+     *
+     * Disabling drops all counts and pending releases.
+     */
+    void SetTracking(bool enabled);
+
+    bool Tracking() const { return tracking_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Install the receiver for released inodes
+     */
+    void SetSink(Sink sink);
+
+    /**
+     * @brief Configure batching
+     * @param batch_size Deliver as soon as this many inodes are pending (min 1)
+     * @param flush_interval_ms Deliver pending inodes at least this often (min 1)
+     */
+    void Configure(size_t batch_size, uint32_t flush_interval_ms);
+
+    /**
+     * @brief Record kernel references handed out by an entry reply
+     * @param ino Inode number (0 and the root inode are ignored)
+     * @param count Number of references
+     */
+    void AddLookup(fuse_ino_t ino, uint64_t count = 1);
+
+    /**
+     * @brief Take back references whose entry reply never reached the kernel
+     *
+     * Counts are added before the reply is sent so that a racing forget
+     * always finds them; this undoes that when the reply fails. An inode
+     * left without references is released like after a forget.
+     */
+    void DropLookup(fuse_ino_t ino, uint64_t count = 1);
+
+    /**
+     * @brief Record kernel references returned by forget
+     * @return true if the inode reached zero and was queued for delivery
+     */
+    bool Forget(fuse_ino_t ino, uint64_t nlookup);
+
+    /**
+     * @brief Current lookup count of an inode (0 if untracked)
+     */
+    uint64_t LookupCount(fuse_ino_t ino) const;
+
+    /**
+     * @brief Copy of all tracked counts, e.g. to hand them to a successor process
+     */
+    std::vector<std::pair<fuse_ino_t, uint64_t>> SnapshotCounts() const;
+
+    /**
+     * @brief Take over counts from SnapshotCounts() (ignored while not tracking)
+     *
+     * Counts are set, not added: the kernel's references did not change.
+     */
+    void RestoreCounts(const std::vector<std::pair<fuse_ino_t, uint64_t>>& counts);
+
+    /**
+     * @brief Deliver pending releases now
+     */
+    void Flush();
+
+    /**
+     * @brief Session ended: deliver pending releases and drop all counts
+     */
+    void Reset();
+
+    InodeTableStats GetStats() const;
+
+private:
+    InodeTable() = default;
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<fuse_ino_t, uint64_t> nlookup;
+    };
+
+    Shard& ShardFor(fuse_ino_t ino) { return shards_[ino % kShardCount]; }
+    const Shard& ShardFor(fuse_ino_t ino) const { return shards_[ino % kShardCount]; }
+
+    void QueueRelease(fuse_ino_t ino);
+    void EnsureFlusher();
+    void FlusherLoop();
+    void Deliver(std::vector<fuse_ino_t>&& batch);
+    void ClearCounts();
+
+    std::array<Shard, kShardCount> shards_;
+    std::atomic<bool> tracking_{false};
+
+    std::mutex sink_mutex_;
+    Sink sink_;
+
+    // Freigegebene Inodes warten hier auf den nächsten Batch
+    mutable std::mutex pending_mutex_;
+    std::condition_variable pending_cv_;
+    std::vector<fuse_ino_t> pending_;
+    size_t batch_size_ = 1024;
+    std::chrono::milliseconds flush_interval_{50};
+    std::thread flusher_;
+    bool stopping_ = false;
+
+    std::atomic<uint64_t> lookups_{0};
+    std::atomic<uint64_t> forgets_{0};
+    std::atomic<uint64_t> released_{0};
+    std::atomic<uint64_t> unknown_forgets_{0};
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> dropped_{0};
+};
+
+/**
+ * N-API exposed functions
+ */
+
+/**
+ * Configure forget batching (N-API exposed function)
+ * @param info N-API callback info containing `{batchSize?, flushIntervalMs?}`
+ * @return Boolean indicating success
+ */
+Napi::Value ConfigureInodeTable(const Napi::CallbackInfo& info);
+
+/**
+ * Get the tracked lookup count of an inode (N-API exposed function)
+ * @param info N-API callback info containing ino (bigint)
+ * @return BigInt lookup count (0n if untracked)
+ */
+Napi::Value GetInodeLookupCount(const Napi::CallbackInfo& info);
+
+/**
+ * Get inode table statistics (N-API exposed function)
+ * @param info N-API callback info
+ * @return Object containing statistics
+ */
+Napi::Value GetInodeTableStats(const Napi::CallbackInfo& info);
+
+} // namespace fuse_native
+
+#endif // INODE_TABLE_H
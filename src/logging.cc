@@ -5,27 +5,47 @@
 #include <algorithm>
 #include <chrono>
 #include <cctype>
+#include <condition_variable>
 #include <cstdarg>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace fuse_native {
 namespace log {
 
-std::atomic<int> g_runtime_level{FUSE_LOG_DEFAULT_LEVEL};
+// Ohne FUSE_LOG höchstens INFO, auch wenn DEBUG/TRACE einkompiliert sind
+constexpr int kRuntimeDefaultLevel =
+    FUSE_LOG_DEFAULT_LEVEL < FUSE_LOG_LEVEL_INFO ? FUSE_LOG_DEFAULT_LEVEL : FUSE_LOG_LEVEL_INFO;
+
+std::atomic<int> g_runtime_level{-1};
 
 namespace {
 
+constexpr size_t kDefaultRingBytes = 256 * 1024;
+constexpr size_t kMinRingBytes = 16 * 1024;
+constexpr size_t kMaxRingBytes = 16 * 1024 * 1024;
+constexpr size_t kMaxMessage = 1024;
+constexpr auto kFlushInterval = std::chrono::milliseconds(20);
+
 std::once_flag g_init_once;
-std::mutex g_log_mutex;
+std::mutex g_log_mutex;   // Serialisiert nur noch die Ausgabe, nie die loggenden Threads
+
+std::atomic<bool> g_async{true};
+std::atomic<size_t> g_ring_bytes{kDefaultRingBytes};
+std::atomic<uint64_t> g_records{0};
+std::atomic<uint64_t> g_dropped{0};
+std::atomic<uint64_t> g_bytes_written{0};
 
 int parse_level(const char* input) {
   if (!input || !*input) {
-    return FUSE_LOG_DEFAULT_LEVEL;
+    return kRuntimeDefaultLevel;
   }
 
   std::string value(input);
@@ -45,7 +65,7 @@ int parse_level(const char* input) {
   if (value == "INFO")  return FUSE_LOG_LEVEL_INFO;
   if (value == "DEBUG") return FUSE_LOG_LEVEL_DEBUG;
   if (value == "TRACE") return FUSE_LOG_LEVEL_TRACE;
-  return FUSE_LOG_DEFAULT_LEVEL;
+  return kRuntimeDefaultLevel;
 }
 
 const char* level_name(int level) {
@@ -59,11 +79,22 @@ const char* level_name(int level) {
   }
 }
 
-void format_timestamp(char* buffer, size_t buffer_size) {
+size_t normalize_ring_bytes(size_t bytes) {
+  size_t capacity = kMinRingBytes;
+  while (capacity < bytes && capacity < kMaxRingBytes) {
+    capacity <<= 1;
+  }
+  return capacity;
+}
+
+uint64_t now_ns() {
   using namespace std::chrono;
-  const auto now = system_clock::now();
-  const auto millis = duration_cast<milliseconds>(now.time_since_epoch()) % milliseconds(1000);
-  const std::time_t time_now = system_clock::to_time_t(now);
+  return static_cast<uint64_t>(duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count());
+}
+
+void format_timestamp(uint64_t timestamp_ns, char* buffer, size_t buffer_size) {
+  const std::time_t time_now = static_cast<std::time_t>(timestamp_ns / 1000000000ULL);
+  const int millis = static_cast<int>((timestamp_ns / 1000000ULL) % 1000ULL);
   std::tm tm_result;
 #if defined(_WIN32)
   gmtime_s(&tm_result, &time_now);
@@ -79,7 +110,338 @@ void format_timestamp(char* buffer, size_t buffer_size) {
                 tm_result.tm_hour,
                 tm_result.tm_min,
                 tm_result.tm_sec,
-                static_cast<int>(millis.count()));
+                millis);
+}
+
+void format_line(std::string& out, uint64_t timestamp_ns, int level, const char* file, int line,
+                 const char* function, const char* message) {
+  char timestamp[64];
+  format_timestamp(timestamp_ns, timestamp, sizeof(timestamp));
+
+  const char* safe_file = file ? file : "?";
+  const char* safe_function = (function && *function) ? function : nullptr;
+
+  char buffer[kMaxMessage + 512];
+  const int written = std::snprintf(buffer,
+                                    sizeof(buffer),
+                                    "%s [%s] (%s) %s:%d %s%s%s\n",
+                                    timestamp,
+                                    level_name(level),
+                                    FUSE_LOG_TAG,
+                                    safe_file,
+                                    line,
+                                    safe_function ? safe_function : "",
+                                    safe_function ? " - " : "",
+                                    message);
+  if (written > 0) {
+    out.append(buffer, std::min(static_cast<size_t>(written), sizeof(buffer) - 1));
+    if (static_cast<size_t>(written) >= sizeof(buffer)) {
+      out.back() = '\n';
+    }
+  }
+}
+
+void write_out(const std::string& text) {
+  if (text.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(g_log_mutex);
+  std::fwrite(text.data(), 1, text.size(), stderr);
+  std::fflush(stderr);
+  g_bytes_written.fetch_add(text.size(), std::memory_order_relaxed);
+}
+
+// ---------------------------------------------------------------------------
+// Per-thread ring
+// ---------------------------------------------------------------------------
+
+enum RecordKind : uint16_t {
+  kRecordPadding = 0,
+  kRecordText = 1,
+  kRecordBinary = 2,
+};
+
+// size/kind stehen vorn, damit ein Padding-Eintrag in jede 8-Byte-Lücke passt
+struct RecordHeader {
+  uint32_t size;            ///< Whole record incl. header, multiple of 8
+  uint16_t kind;
+  uint16_t level;
+  int32_t line;
+  uint32_t payload;         ///< Text bytes or argument count
+  uint64_t timestamp_ns;
+  const char* file;
+  const char* function;
+  const char* fmt;          ///< Binary records only
+};
+
+static_assert(sizeof(RecordHeader) % 8 == 0, "records must stay 8-byte aligned");
+
+inline size_t align8(size_t value) {
+  return (value + 7) & ~static_cast<size_t>(7);
+}
+
+/**
+ * Single-producer/single-consumer byte ring owned by one logging thread and
+ * drained by the writer thread. head/tail only grow; positions wrap with the
+ * power-of-two mask.
+ */
+class ThreadRing {
+public:
+  explicit ThreadRing(size_t capacity)
+      : capacity_(capacity), mask_(capacity - 1), buffer_(new uint8_t[capacity]) {}
+
+  size_t capacity() const { return capacity_; }
+
+  enum class PushResult { kQueued, kHalfFull, kDropped };
+
+  PushResult push(const RecordHeader& header, const void* payload, size_t payload_size) {
+    const size_t need = align8(sizeof(RecordHeader) + payload_size);
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    const uint64_t tail = tail_.load(std::memory_order_acquire);
+    size_t offset = static_cast<size_t>(head & mask_);
+    const size_t contiguous = capacity_ - offset;
+    const size_t total = need + (contiguous < need ? contiguous : 0);
+    if (capacity_ - static_cast<size_t>(head - tail) < total) {
+      g_dropped.fetch_add(1, std::memory_order_relaxed);
+      return PushResult::kDropped;
+    }
+
+    uint64_t next = head;
+    if (contiguous < need) {
+      const uint32_t pad_size = static_cast<uint32_t>(contiguous);
+      const uint16_t pad_kind = kRecordPadding;
+      std::memcpy(buffer_.get() + offset, &pad_size, sizeof(pad_size));
+      std::memcpy(buffer_.get() + offset + sizeof(pad_size), &pad_kind, sizeof(pad_kind));
+      next += contiguous;
+      offset = 0;
+    }
+    RecordHeader stored = header;
+    stored.size = static_cast<uint32_t>(need);
+    std::memcpy(buffer_.get() + offset, &stored, sizeof(stored));
+    if (payload_size > 0) {
+      std::memcpy(buffer_.get() + offset + sizeof(stored), payload, payload_size);
+    }
+    head_.store(next + need, std::memory_order_release);
+    g_records.fetch_add(1, std::memory_order_relaxed);
+    // Beim Überschreiten der halben Füllung den Writer wecken, nicht erst nach dem Intervall
+    const size_t half = capacity_ / 2;
+    const size_t before = static_cast<size_t>(head - tail);
+    return before < half && before + total >= half ? PushResult::kHalfFull : PushResult::kQueued;
+  }
+
+  // Nur der Writer-Thread (unter g_drain_mutex) ruft drain() auf
+  template <typename Fn>
+  void drain(Fn&& fn) {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    const uint64_t head = head_.load(std::memory_order_acquire);
+    while (tail < head) {
+      const size_t offset = static_cast<size_t>(tail & mask_);
+      uint32_t size;
+      uint16_t kind;
+      std::memcpy(&size, buffer_.get() + offset, sizeof(size));
+      std::memcpy(&kind, buffer_.get() + offset + sizeof(size), sizeof(kind));
+      if (kind != kRecordPadding) {
+        RecordHeader header;
+        std::memcpy(&header, buffer_.get() + offset, sizeof(header));
+        fn(header, buffer_.get() + offset + sizeof(header));
+      }
+      tail += size;
+    }
+    tail_.store(tail, std::memory_order_release);
+  }
+
+  bool empty() const {
+    return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+  }
+
+  std::atomic<bool> closed{false};
+
+private:
+  const size_t capacity_;
+  const size_t mask_;
+  std::unique_ptr<uint8_t[]> buffer_;
+  alignas(64) std::atomic<uint64_t> head_{0};
+  alignas(64) std::atomic<uint64_t> tail_{0};
+};
+
+/**
+ * Registry of rings plus the writer thread. Leaked on purpose: threads may
+ * still log while static destructors run at exit.
+ */
+class AsyncWriter {
+public:
+  static AsyncWriter& instance() {
+    static AsyncWriter* writer = new AsyncWriter();
+    return *writer;
+  }
+
+  std::shared_ptr<ThreadRing> register_ring(size_t capacity) {
+    auto ring = std::make_shared<ThreadRing>(capacity);
+    {
+      std::lock_guard<std::mutex> lock(registry_mutex_);
+      rings_.push_back(ring);
+    }
+    std::call_once(start_once_, [this] {
+      std::thread(&AsyncWriter::run, this).detach();
+      std::atexit([] { AsyncWriter::instance().drain_all(); });
+    });
+    return ring;
+  }
+
+  void wake() { wake_.notify_one(); }
+
+  size_t live_threads() {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    size_t live = 0;
+    for (const auto& ring : rings_) {
+      live += ring->closed.load(std::memory_order_relaxed) ? 0 : 1;
+    }
+    return live;
+  }
+
+  // Alle Ringe leeren, zeitlich sortiert ausgeben, verwaiste Ringe entfernen
+  void drain_all() {
+    std::lock_guard<std::mutex> drain_lock(drain_mutex_);
+
+    std::vector<std::shared_ptr<ThreadRing>> rings;
+    {
+      std::lock_guard<std::mutex> lock(registry_mutex_);
+      rings = rings_;
+    }
+
+    struct Pending {
+      uint64_t timestamp_ns;
+      size_t start;
+      size_t length;
+    };
+    std::vector<Pending> pending;
+    std::string lines;
+
+    for (const auto& ring : rings) {
+      ring->drain([&](const RecordHeader& header, const uint8_t* payload) {
+        char message[kMaxMessage];
+        if (header.kind == kRecordText) {
+          const size_t length = std::min<size_t>(header.payload, sizeof(message) - 1);
+          std::memcpy(message, payload, length);
+          message[length] = '\0';
+        } else {
+          uint64_t args[kMaxRecordArgs] = {};
+          std::memcpy(args, payload, std::min<size_t>(header.payload, kMaxRecordArgs) * sizeof(uint64_t));
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+#pragma GCC diagnostic ignored "-Wformat-security"
+#endif
+          std::snprintf(message, sizeof(message), header.fmt, args[0], args[1], args[2], args[3], args[4], args[5]);
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+        }
+        const size_t start = lines.size();
+        format_line(lines, header.timestamp_ns, header.level, header.file, header.line, header.function, message);
+        pending.push_back({header.timestamp_ns, start, lines.size() - start});
+      });
+    }
+
+    const uint64_t dropped = g_dropped.load(std::memory_order_relaxed);
+    if (dropped != reported_dropped_) {
+      char message[128];
+      std::snprintf(message, sizeof(message), "dropped %llu log records (ring full)",
+                    static_cast<unsigned long long>(dropped - reported_dropped_));
+      reported_dropped_ = dropped;
+      const size_t start = lines.size();
+      format_line(lines, now_ns(), FUSE_LOG_LEVEL_WARN, __FILE__, __LINE__, "logging", message);
+      pending.push_back({now_ns(), start, lines.size() - start});
+    }
+
+    if (!pending.empty()) {
+      std::stable_sort(pending.begin(), pending.end(),
+                       [](const Pending& a, const Pending& b) { return a.timestamp_ns < b.timestamp_ns; });
+      std::string out;
+      out.reserve(lines.size());
+      for (const auto& entry : pending) {
+        out.append(lines, entry.start, entry.length);
+      }
+      write_out(out);
+    }
+
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    rings_.erase(std::remove_if(rings_.begin(), rings_.end(),
+                                [](const std::shared_ptr<ThreadRing>& ring) {
+                                  return ring->closed.load(std::memory_order_acquire) && ring->empty();
+                                }),
+                 rings_.end());
+  }
+
+private:
+  AsyncWriter() = default;
+
+  void run() {
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_.wait_for(lock, kFlushInterval);
+      }
+      drain_all();
+    }
+  }
+
+  std::mutex registry_mutex_;
+  std::vector<std::shared_ptr<ThreadRing>> rings_;
+  std::mutex drain_mutex_;
+  uint64_t reported_dropped_ = 0;
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  std::once_flag start_once_;
+};
+
+// Beim Thread-Ende bleibt der Ring registriert, bis der Writer ihn geleert hat
+struct RingHandle {
+  std::shared_ptr<ThreadRing> ring;
+
+  ~RingHandle() {
+    if (ring) {
+      ring->closed.store(true, std::memory_order_release);
+    }
+  }
+};
+
+thread_local RingHandle t_ring;
+
+ThreadRing& current_ring() {
+  const size_t capacity = g_ring_bytes.load(std::memory_order_relaxed);
+  if (!t_ring.ring || t_ring.ring->capacity() != capacity) {
+    if (t_ring.ring) {
+      t_ring.ring->closed.store(true, std::memory_order_release);
+    }
+    t_ring.ring = AsyncWriter::instance().register_ring(capacity);
+  }
+  return *t_ring.ring;
+}
+
+void enqueue(int level, const char* file, int line, const char* function, const char* fmt, uint16_t kind,
+             uint32_t payload_count, const void* payload, size_t payload_size) {
+  RecordHeader header{};
+  header.kind = kind;
+  header.level = static_cast<uint16_t>(level);
+  header.line = line;
+  header.payload = payload_count;
+  header.timestamp_ns = now_ns();
+  header.file = file;
+  header.function = function;
+  header.fmt = fmt;
+  const ThreadRing::PushResult result = current_ring().push(header, payload, payload_size);
+  // Fehler sofort ausgeben; alles andere sammelt der Writer im Intervall ein
+  if (level <= FUSE_LOG_LEVEL_ERROR || result == ThreadRing::PushResult::kHalfFull) {
+    AsyncWriter::instance().wake();
+  }
+}
+
+void write_sync(int level, const char* file, int line, const char* function, const char* message) {
+  std::string text;
+  format_line(text, now_ns(), level, file, line, function, message);
+  g_records.fetch_add(1, std::memory_order_relaxed);
+  write_out(text);
 }
 
 }  // namespace
@@ -88,6 +450,17 @@ void init_from_env_once() {
   std::call_once(g_init_once, [] {
     const char* env = std::getenv("FUSE_LOG");
     g_runtime_level.store(parse_level(env), std::memory_order_relaxed);
+    const char* sync = std::getenv("FUSE_LOG_SYNC");
+    if (sync && *sync && std::strcmp(sync, "0") != 0) {
+      g_async.store(false, std::memory_order_relaxed);
+    }
+    const char* ring = std::getenv("FUSE_LOG_RING_KB");
+    if (ring && *ring) {
+      const long kib = std::strtol(ring, nullptr, 10);
+      if (kib > 0) {
+        g_ring_bytes.store(normalize_ring_bytes(static_cast<size_t>(kib) * 1024), std::memory_order_relaxed);
+      }
+    }
   });
 }
 
@@ -97,30 +470,80 @@ void log_line(int level, const char* file, int line, const char* function, const
     return;
   }
 
-  char timestamp[64];
-  format_timestamp(timestamp, sizeof(timestamp));
-
-  char message[1024];
+  char message[kMaxMessage];
   va_list args;
   va_start(args, fmt);
-  std::vsnprintf(message, sizeof(message), fmt, args);
+  const int length = std::vsnprintf(message, sizeof(message), fmt, args);
   va_end(args);
 
-  const char* safe_file = file ? file : "?";
-  const char* safe_function = (function && *function) ? function : nullptr;
+  if (!g_async.load(std::memory_order_relaxed)) {
+    write_sync(level, file, line, function, message);
+    return;
+  }
+  const size_t stored = length < 0 ? 0 : std::min(static_cast<size_t>(length), sizeof(message) - 1);
+  enqueue(level, file, line, function, nullptr, kRecordText, static_cast<uint32_t>(stored), message, stored);
+}
 
-  std::lock_guard<std::mutex> lock(g_log_mutex);
-  std::fprintf(stderr,
-               "%s [%s] (%s) %s:%d %s%s%s\n",
-               timestamp,
-               level_name(level),
-               FUSE_LOG_TAG,
-               safe_file,
-               line,
-               safe_function ? safe_function : "",
-               safe_function ? " - " : "",
-               message);
-  std::fflush(stderr);
+void log_record(int level, const char* file, int line, const char* function, const char* fmt,
+                int argc, const uint64_t* args) {
+  init_from_env_once();
+  if (!should_log(level)) {
+    return;
+  }
+  argc = std::max(0, std::min(argc, kMaxRecordArgs));
+
+  if (!g_async.load(std::memory_order_relaxed)) {
+    uint64_t values[kMaxRecordArgs] = {};
+    std::memcpy(values, args, static_cast<size_t>(argc) * sizeof(uint64_t));
+    char message[kMaxMessage];
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+#pragma GCC diagnostic ignored "-Wformat-security"
+#endif
+    std::snprintf(message, sizeof(message), fmt, values[0], values[1], values[2], values[3], values[4], values[5]);
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+    write_sync(level, file, line, function, message);
+    return;
+  }
+  enqueue(level, file, line, function, fmt, kRecordBinary, static_cast<uint32_t>(argc), args,
+          static_cast<size_t>(argc) * sizeof(uint64_t));
+}
+
+void configure(int level, int async, size_t ring_bytes) {
+  init_from_env_once();
+  if (level >= FUSE_LOG_LEVEL_OFF) {
+    g_runtime_level.store(std::min(level, static_cast<int>(FUSE_LOG_LEVEL_TRACE)), std::memory_order_relaxed);
+  }
+  if (async >= 0) {
+    if (async == 0) {
+      // Was noch in den Ringen liegt, vor den ersten synchronen Zeilen ausgeben
+      flush();
+    }
+    g_async.store(async != 0, std::memory_order_relaxed);
+  }
+  if (ring_bytes > 0) {
+    g_ring_bytes.store(normalize_ring_bytes(ring_bytes), std::memory_order_relaxed);
+  }
+}
+
+void flush() {
+  AsyncWriter::instance().drain_all();
+}
+
+LogStats get_stats() {
+  init_from_env_once();
+  LogStats stats;
+  stats.level = g_runtime_level.load(std::memory_order_relaxed);
+  stats.async = g_async.load(std::memory_order_relaxed);
+  stats.ring_bytes = g_ring_bytes.load(std::memory_order_relaxed);
+  stats.threads = AsyncWriter::instance().live_threads();
+  stats.records = g_records.load(std::memory_order_relaxed);
+  stats.dropped = g_dropped.load(std::memory_order_relaxed);
+  stats.bytes_written = g_bytes_written.load(std::memory_order_relaxed);
+  return stats;
 }
 
 }  // namespace log
@@ -1,6 +1,10 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <type_traits>
 
 #ifndef FUSE_LOG_ENABLED
 #define FUSE_LOG_ENABLED 1
@@ -28,33 +32,83 @@ namespace log {
 
 #if FUSE_LOG_ENABLED
 
-extern std::atomic<int> g_runtime_level;
+extern std::atomic<int> g_runtime_level;   ///< -1 until FUSE_LOG has been read
+
+void init_from_env_once();
 
 inline bool should_log(int level) {
-  constexpr int kMinCompiledLevel = FUSE_LOG_DEFAULT_LEVEL;
+  // FUSE_LOG_DEFAULT_LEVEL is the most verbose level compiled in
+  constexpr int kMaxCompiledLevel = FUSE_LOG_DEFAULT_LEVEL;
   if (level <= FUSE_LOG_LEVEL_OFF) {
     return false;
   }
   if (level > FUSE_LOG_LEVEL_TRACE) {
     return false;
   }
-  if (level < kMinCompiledLevel) {
+  if (level > kMaxCompiledLevel) {
     return false;
   }
   int runtime_level = g_runtime_level.load(std::memory_order_relaxed);
+  if (runtime_level < 0) {
+    init_from_env_once();
+    runtime_level = g_runtime_level.load(std::memory_order_relaxed);
+  }
   if (runtime_level == FUSE_LOG_LEVEL_OFF) {
     return false;
   }
   return level <= runtime_level;
 }
 
-void init_from_env_once();
+// Log lines are queued in a per-thread ring buffer and written to stderr by a
+// background thread, so logging threads never wait for each other or for
+// stderr. A full ring drops the record and counts it. FUSE_LOG_SYNC=1 (or
+// configure(..., async = 0, ...)) restores the synchronous writer.
 
 #if defined(__GNUC__) || defined(__clang__)
 __attribute__((format(printf, 5, 6)))
 #endif
 void log_line(int level, const char* file, int line, const char* function, const char* fmt, ...);
 
+constexpr int kMaxRecordArgs = 6;
+
+// Binary record: only fmt (a string literal) and up to six integers are
+// stored; the writer thread formats them. All conversions in fmt must take a
+// 64-bit integer (PRIu64, PRId64, PRIx64).
+void log_record(int level, const char* file, int line, const char* function, const char* fmt,
+                int argc, const uint64_t* args);
+
+template <typename... Args>
+inline void log_record_args(int level, const char* file, int line, const char* function, const char* fmt,
+                            Args... args) {
+  static_assert(sizeof...(Args) <= kMaxRecordArgs, "FUSE_LOG_RECORD takes at most six arguments");
+  static_assert(((std::is_integral<Args>::value || std::is_enum<Args>::value) && ...),
+                "FUSE_LOG_RECORD arguments must be integers");
+  const uint64_t values[sizeof...(Args) + 1] = {static_cast<uint64_t>(args)..., 0};
+  log_record(level, file, line, function, fmt, static_cast<int>(sizeof...(Args)), values);
+}
+
+struct LogStats {
+  int level = 0;
+  bool async = false;
+  size_t ring_bytes = 0;      ///< Capacity of each thread's ring
+  size_t threads = 0;         ///< Threads with a live ring
+  uint64_t records = 0;       ///< Records queued (async) or written (sync)
+  uint64_t dropped = 0;       ///< Records lost to full rings
+  uint64_t bytes_written = 0;
+};
+
+/**
+ * Change the runtime configuration; negative / zero values keep the current
+ * setting. ring_bytes is rounded up to a power of two (16 KiB .. 16 MiB) and
+ * applies to each thread's next record.
+ */
+void configure(int level, int async, size_t ring_bytes);
+
+/** Write everything queued so far (blocks until done). */
+void flush();
+
+LogStats get_stats();
+
 #else  // FUSE_LOG_ENABLED == 0
 
 inline bool should_log(int) {
@@ -65,6 +119,27 @@ inline void init_from_env_once() {}
 
 inline void log_line(int, const char*, int, const char*, const char*, ...) {}
 
+template <typename... Args>
+inline void log_record_args(int, const char*, int, const char*, const char*, Args...) {}
+
+struct LogStats {
+  int level = 0;
+  bool async = false;
+  size_t ring_bytes = 0;
+  size_t threads = 0;
+  uint64_t records = 0;
+  uint64_t dropped = 0;
+  uint64_t bytes_written = 0;
+};
+
+inline void configure(int, int, size_t) {}
+
+inline void flush() {}
+
+inline LogStats get_stats() {
+  return {};
+}
+
 #endif  // FUSE_LOG_ENABLED
 
 }  // namespace log
@@ -82,6 +157,19 @@ inline void log_line(int, const char*, int, const char*, const char*, ...) {}
 
 #define FUSE_LOG(level, fmt, ...) FUSE_LOG_IMPL((level), (fmt), ##__VA_ARGS__)
 
+// Hot paths: integers only, formatted lazily by the writer thread. The printf
+// is never called; it lets -Wformat check fmt against the arguments while fmt
+// is still a literal.
+#define FUSE_LOG_RECORD(level, fmt, ...)                                                            \
+  do {                                                                                             \
+    if (false) {                                                                                   \
+      std::printf((fmt), ##__VA_ARGS__);                                                           \
+    }                                                                                              \
+    if (FUSE_LOG_LEVEL_ENABLED(level)) {                                                           \
+      fuse_native::log::log_record_args((level), __FILE__, __LINE__, __func__, (fmt), ##__VA_ARGS__); \
+    }                                                                                              \
+  } while (0)
+
 #if FUSE_LOG_DEFAULT_LEVEL >= FUSE_LOG_LEVEL_ERROR
 #define FUSE_LOG_ERROR(fmt, ...) FUSE_LOG_IMPL(FUSE_LOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
 #else
@@ -115,6 +203,7 @@ inline void log_line(int, const char*, int, const char*, const char*, ...) {}
 #else  // FUSE_LOG_ENABLED == 0
 
 #define FUSE_LOG(level, fmt, ...) do { (void)sizeof(level); } while (0)
+#define FUSE_LOG_RECORD(level, fmt, ...) do { (void)sizeof(level); } while (0)
 #define FUSE_LOG_ERROR(fmt, ...)  do { (void)sizeof(fmt); } while (0)
 #define FUSE_LOG_WARN(fmt, ...)   do { (void)sizeof(fmt); } while (0)
 #define FUSE_LOG_INFO(fmt, ...)   do { (void)sizeof(fmt); } while (0)
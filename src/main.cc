@@ -12,17 +12,34 @@
 #include <fuse3/fuse_lowlevel.h>
 #include <sys/xattr.h>
 
+#include <algorithm>
+#include <iterator>
+
 #include "fuse_bridge.h"
 #include "napi_helpers.h"
 #include "session_manager.h"
+#include "session_handoff.h"
 #include "errno_mapping.h"
 #include "buffer_bridge.h"
+#include "buffer_pool.h"
+#include "file_mapping.h"
+#include "content_hash.h"
 #include "copy_file_range.h"
 #include "tsfn_dispatcher.h"
 #include "write_queue.h"
 #include "shutdown.h"
 #include "xattr_bridge.h"
+#include "xattr_fd_cache.h"
+#include "xattr_cache.h"
 #include "init_bridge.h"
+#include "dir_snapshot_cache.h"
+#include "attr_cache.h"
+#include "dentry_cache.h"
+#include "inode_table.h"
+#include "notify_bridge.h"
+#include "passthrough.h"
+#include "native_io.h"
+#include "logging.h"
 
 namespace fuse_native {
 
@@ -101,6 +118,92 @@ Napi::Value GetVersion(const Napi::CallbackInfo& info) {
     return version;
 }
 
+namespace {
+
+constexpr const char* kLogLevelNames[] = {"off", "error", "warn", "info", "debug", "trace"};
+
+} // namespace
+
+/**
+ * Configure the native logger
+ * @param info N-API callback info containing `{level?, async?, ringBytes?}`
+ * @return Boolean indicating success
+ */
+Napi::Value ConfigureLogging(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        NapiHelpers::ThrowTypeError(env, "Expected configuration object");
+        return env.Undefined();
+    }
+    Napi::Object config = info[0].As<Napi::Object>();
+
+    int level = -1;
+    Napi::Value level_value = config.Get("level");
+    if (!level_value.IsUndefined()) {
+        const std::string name = level_value.IsString() ? level_value.As<Napi::String>().Utf8Value() : "";
+        for (int i = 0; i < static_cast<int>(std::size(kLogLevelNames)); i++) {
+            if (name == kLogLevelNames[i]) {
+                level = i;
+            }
+        }
+        if (level < 0) {
+            NapiHelpers::ThrowTypeError(env, "level must be 'off', 'error', 'warn', 'info', 'debug' or 'trace'");
+            return env.Undefined();
+        }
+    }
+
+    int async = -1;
+    Napi::Value async_value = config.Get("async");
+    if (!async_value.IsUndefined()) {
+        if (!async_value.IsBoolean()) {
+            NapiHelpers::ThrowTypeError(env, "async must be a boolean");
+            return env.Undefined();
+        }
+        async = async_value.As<Napi::Boolean>().Value() ? 1 : 0;
+    }
+
+    size_t ring_bytes = 0;
+    Napi::Value ring_value = config.Get("ringBytes");
+    if (!ring_value.IsUndefined()) {
+        if (!ring_value.IsNumber() || ring_value.As<Napi::Number>().DoubleValue() <= 0) {
+            NapiHelpers::ThrowTypeError(env, "ringBytes must be a positive number");
+            return env.Undefined();
+        }
+        ring_bytes = static_cast<size_t>(ring_value.As<Napi::Number>().DoubleValue());
+    }
+
+    log::configure(level, async, ring_bytes);
+    return Napi::Boolean::New(env, true);
+}
+
+/**
+ * Write all queued log records to stderr
+ */
+Napi::Value FlushLogs(const Napi::CallbackInfo& info) {
+    log::flush();
+    return info.Env().Undefined();
+}
+
+/**
+ * Get logger statistics
+ */
+Napi::Value GetLoggingStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    const log::LogStats stats = log::get_stats();
+
+    Napi::Object result = Napi::Object::New(env);
+    const int level = std::max(0, std::min(stats.level, static_cast<int>(std::size(kLogLevelNames)) - 1));
+    result.Set("level", Napi::String::New(env, kLogLevelNames[level]));
+    result.Set("async", Napi::Boolean::New(env, stats.async));
+    result.Set("ringBytes", Napi::Number::New(env, static_cast<double>(stats.ring_bytes)));
+    result.Set("threads", Napi::Number::New(env, static_cast<double>(stats.threads)));
+    result.Set("records", NapiHelpers::CreateBigUint64(env, stats.records));
+    result.Set("dropped", NapiHelpers::CreateBigUint64(env, stats.dropped));
+    result.Set("bytesWritten", NapiHelpers::CreateBigUint64(env, stats.bytes_written));
+    return result;
+}
+
 /**
  * Module initialization
  */
@@ -117,6 +220,11 @@ napi_value Init(napi_env env, napi_value exports) {
     napiExports.Set("mount", Napi::Function::New(napiEnv, Mount));
     napiExports.Set("unmount", Napi::Function::New(napiEnv, Unmount));
     napiExports.Set("isReady", Napi::Function::New(napiEnv, IsReady));
+    napiExports.Set("handoffSession", Napi::Function::New(napiEnv, HandoffSession));
+    napiExports.Set("adoptSession", Napi::Function::New(napiEnv, AdoptSession));
+    napiExports.Set("notifyBatch", Napi::Function::New(napiEnv, NotifyBatch));
+    napiExports.Set("notifyStore", Napi::Function::New(napiEnv, NotifyStore));
+    napiExports.Set("notifyRetrieve", Napi::Function::New(napiEnv, NotifyRetrieve));
     
     // Register operation management functions
     napiExports.Set("setOperationHandler", Napi::Function::New(napiEnv, SetOperationHandler));
@@ -139,6 +247,10 @@ napi_value Init(napi_env env, napi_value exports) {
     napiExports.Set("getWriteQueueStats", Napi::Function::New(napiEnv, GetWriteQueueStats));
     napiExports.Set("resetWriteQueueStats", Napi::Function::New(napiEnv, ResetWriteQueueStats));
     napiExports.Set("configureWriteQueues", Napi::Function::New(napiEnv, ConfigureWriteQueues));
+    napiExports.Set("configureWriteCoalescing", Napi::Function::New(napiEnv, ConfigureWriteCoalescing));
+    napiExports.Set("getWriteCoalescingStats", Napi::Function::New(napiEnv, GetWriteCoalescingStats));
+    napiExports.Set("configureWriteBehind", Napi::Function::New(napiEnv, ConfigureWriteBehind));
+    napiExports.Set("getWriteBehindStats", Napi::Function::New(napiEnv, GetWriteBehindStats));
     
     // Register shutdown management functions
     napiExports.Set("initializeShutdownManager", Napi::Function::New(napiEnv, InitializeShutdownManager));
@@ -149,9 +261,13 @@ napi_value Init(napi_env env, napi_value exports) {
     napiExports.Set("registerShutdownCallback", Napi::Function::New(napiEnv, RegisterShutdownCallback));
     napiExports.Set("waitForShutdownCompletion", Napi::Function::New(napiEnv, WaitForShutdownCompletion));
     napiExports.Set("configureShutdownTimeouts", Napi::Function::New(napiEnv, ConfigureShutdownTimeouts));
+    napiExports.Set("configureShutdownHandoff", Napi::Function::New(napiEnv, ConfigureShutdownHandoff));
     
     // Register utility functions
     napiExports.Set("getVersion", Napi::Function::New(napiEnv, GetVersion));
+    napiExports.Set("configureLogging", Napi::Function::New(napiEnv, ConfigureLogging));
+    napiExports.Set("flushLogs", Napi::Function::New(napiEnv, FlushLogs));
+    napiExports.Set("getLoggingStats", Napi::Function::New(napiEnv, GetLoggingStats));
     
     // Register buffer bridge functions
     napiExports.Set("createExternalBuffer", Napi::Function::New(napiEnv, CreateExternalBuffer));
@@ -160,9 +276,20 @@ napi_value Init(napi_env env, napi_value exports) {
     napiExports.Set("validateBufferRange", Napi::Function::New(napiEnv, ValidateBufferRange));
     napiExports.Set("createBufferSlice", Napi::Function::New(napiEnv, CreateBufferSlice));
     napiExports.Set("getBufferStats", Napi::Function::New(napiEnv, GetBufferStats));
+    napiExports.Set("configureBufferPool", Napi::Function::New(napiEnv, ConfigureBufferPool));
+    napiExports.Set("getBufferPoolStats", Napi::Function::New(napiEnv, GetBufferPoolStats));
+    napiExports.Set("trimBufferPool", Napi::Function::New(napiEnv, TrimBufferPool));
+    napiExports.Set("mapFile", Napi::Function::New(napiEnv, MapFile));
+    napiExports.Set("adviseFileMapping", Napi::Function::New(napiEnv, AdviseFileMapping));
+    napiExports.Set("getFileMappingStats", Napi::Function::New(napiEnv, GetFileMappingStats));
+    napiExports.Set("hashBuffer", Napi::Function::New(napiEnv, HashBuffer));
+    napiExports.Set("hashBuffers", Napi::Function::New(napiEnv, HashBuffers));
+    napiExports.Set("configureWriteDigest", Napi::Function::New(napiEnv, ConfigureWriteDigest));
+    napiExports.Set("getHashImplementations", Napi::Function::New(napiEnv, GetHashImplementations));
     
     // Register copy file range functions
     napiExports.Set("copyFileRange", Napi::Function::New(napiEnv, CopyFileRange));
+    napiExports.Set("copyFileRangeAsync", Napi::Function::New(napiEnv, CopyFileRangeAsync));
     napiExports.Set("setCopyChunkSize", Napi::Function::New(napiEnv, SetCopyChunkSize));
     napiExports.Set("getCopyChunkSize", Napi::Function::New(napiEnv, GetCopyChunkSize));
     napiExports.Set("getCopyStats", Napi::Function::New(napiEnv, GetCopyStats));
@@ -173,6 +300,48 @@ napi_value Init(napi_env env, napi_value exports) {
     napiExports.Set("setxattr", Napi::Function::New(napiEnv, SetXAttr));
     napiExports.Set("listxattr", Napi::Function::New(napiEnv, ListXAttr));
     napiExports.Set("removexattr", Napi::Function::New(napiEnv, RemoveXAttr));
+    napiExports.Set("getxattrAsync", Napi::Function::New(napiEnv, GetXAttrAsync));
+    napiExports.Set("setxattrAsync", Napi::Function::New(napiEnv, SetXAttrAsync));
+    napiExports.Set("listxattrAsync", Napi::Function::New(napiEnv, ListXAttrAsync));
+    napiExports.Set("removexattrAsync", Napi::Function::New(napiEnv, RemoveXAttrAsync));
+    napiExports.Set("getxattrBatch", Napi::Function::New(napiEnv, GetXAttrBatch));
+    napiExports.Set("configureXattrFdCache", Napi::Function::New(napiEnv, ConfigureXAttrFdCache));
+    napiExports.Set("invalidateXattrFdCache", Napi::Function::New(napiEnv, InvalidateXAttrFdCache));
+    napiExports.Set("getXattrFdCacheStats", Napi::Function::New(napiEnv, GetXAttrFdCacheStats));
+    napiExports.Set("configureXattrCache", Napi::Function::New(napiEnv, ConfigureXAttrCache));
+    napiExports.Set("invalidateXattrCache", Napi::Function::New(napiEnv, InvalidateXAttrCache));
+    napiExports.Set("getXattrCacheStats", Napi::Function::New(napiEnv, GetXAttrCacheStats));
+    napiExports.Set("clearXattrCache", Napi::Function::New(napiEnv, ClearXAttrCache));
+    
+    // Register directory snapshot cache functions
+    napiExports.Set("configureDirSnapshotCache", Napi::Function::New(napiEnv, ConfigureDirSnapshotCache));
+    napiExports.Set("getDirSnapshotCacheStats", Napi::Function::New(napiEnv, GetDirSnapshotCacheStats));
+    napiExports.Set("clearDirSnapshotCache", Napi::Function::New(napiEnv, ClearDirSnapshotCache));
+    
+    // Register attribute cache functions
+    napiExports.Set("configureAttrCache", Napi::Function::New(napiEnv, ConfigureAttrCache));
+    napiExports.Set("updateAttrCache", Napi::Function::New(napiEnv, UpdateAttrCache));
+    napiExports.Set("invalidateAttrCache", Napi::Function::New(napiEnv, InvalidateAttrCache));
+    napiExports.Set("getAttrCacheStats", Napi::Function::New(napiEnv, GetAttrCacheStats));
+    napiExports.Set("clearAttrCache", Napi::Function::New(napiEnv, ClearAttrCache));
+    
+    // Register dentry cache functions
+    napiExports.Set("configureDentryCache", Napi::Function::New(napiEnv, ConfigureDentryCache));
+    napiExports.Set("invalidateDentryCache", Napi::Function::New(napiEnv, InvalidateDentryCache));
+    napiExports.Set("getDentryCacheStats", Napi::Function::New(napiEnv, GetDentryCacheStats));
+    napiExports.Set("clearDentryCache", Napi::Function::New(napiEnv, ClearDentryCache));
+    
+    // Register inode table functions
+    napiExports.Set("configureInodeTable", Napi::Function::New(napiEnv, ConfigureInodeTable));
+    napiExports.Set("getInodeLookupCount", Napi::Function::New(napiEnv, GetInodeLookupCount));
+    napiExports.Set("getInodeTableStats", Napi::Function::New(napiEnv, GetInodeTableStats));
+
+    // Register passthrough functions
+    napiExports.Set("getPassthroughStats", Napi::Function::New(napiEnv, GetPassthroughStats));
+
+    // Register native I/O executor functions
+    napiExports.Set("configureNativeIo", Napi::Function::New(napiEnv, ConfigureNativeIo));
+    napiExports.Set("getNativeIoStats", Napi::Function::New(napiEnv, GetNativeIoStats));
     
     // Register init bridge functions
     napiExports.Set("initializeInitBridge", Napi::Function::New(napiEnv, InitializeInitBridge));
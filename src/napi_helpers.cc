@@ -503,6 +503,17 @@ std::string NapiHelpers::ErrnoToString(int errno_code) {
     case EROFS:   return "EROFS";
     case ENOSYS:  return "ENOSYS";
     case ENOTEMPTY:return "ENOTEMPTY";
+    case EPIPE:   return "EPIPE";
+    case EDEADLK: return "EDEADLK";
+    case ENAMETOOLONG: return "ENAMETOOLONG";
+    case EPROTO:  return "EPROTO";
+    case EBADMSG: return "EBADMSG";
+    case EMSGSIZE: return "EMSGSIZE";
+    case ECONNRESET: return "ECONNRESET";
+    case ENOTCONN: return "ENOTCONN";
+    case ETIMEDOUT: return "ETIMEDOUT";
+    case ECONNREFUSED: return "ECONNREFUSED";
+    case ECANCELED: return "ECANCELED";
     default:      return "UNKNOWN";
   }
 }
@@ -597,6 +608,12 @@ Napi::Object NapiHelpers::FileInfoToObject(Napi::Env env, const struct fuse_file
     obj.Set("nonseekable", Napi::Boolean::New(env, fi.nonseekable));
     obj.Set("flock_release", Napi::Boolean::New(env, fi.flock_release));
     obj.Set("cache_readdir", Napi::Boolean::New(env, fi.cache_readdir));
+#if FUSE_MAJOR_VERSION > 3 || (FUSE_MAJOR_VERSION == 3 && FUSE_MINOR_VERSION >= 12)
+    obj.Set("noflush", Napi::Boolean::New(env, fi.noflush));
+#endif
+#if FUSE_MAJOR_VERSION > 3 || (FUSE_MAJOR_VERSION == 3 && FUSE_MINOR_VERSION >= 14)
+    obj.Set("parallel_direct_writes", Napi::Boolean::New(env, fi.parallel_direct_writes));
+#endif
     obj.Set("fh", CreateBigUint64(env, fi.fh));
     obj.Set("lock_owner", CreateBigUint64(env, fi.lock_owner));
     obj.Set("poll_events", Napi::Number::New(env, fi.poll_events));
@@ -663,6 +680,17 @@ bool NapiHelpers::ObjectToFileInfo(Napi::Object obj, struct fuse_file_info* fi)
   if (obj.Has("cache_readdir") && obj.Get("cache_readdir").IsBoolean()) {
     fi->cache_readdir = obj.Get("cache_readdir").As<Napi::Boolean>().Value() ? 1 : 0;
   }
+  // noflush/parallel_direct_writes gibt es erst in neueren libfuse-Versionen
+#if FUSE_MAJOR_VERSION > 3 || (FUSE_MAJOR_VERSION == 3 && FUSE_MINOR_VERSION >= 12)
+  if (obj.Has("noflush") && obj.Get("noflush").IsBoolean()) {
+    fi->noflush = obj.Get("noflush").As<Napi::Boolean>().Value() ? 1 : 0;
+  }
+#endif
+#if FUSE_MAJOR_VERSION > 3 || (FUSE_MAJOR_VERSION == 3 && FUSE_MINOR_VERSION >= 14)
+  if (obj.Has("parallel_direct_writes") && obj.Get("parallel_direct_writes").IsBoolean()) {
+    fi->parallel_direct_writes = obj.Get("parallel_direct_writes").As<Napi::Boolean>().Value() ? 1 : 0;
+  }
+#endif
 
   // fh (u64)
   {
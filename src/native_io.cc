@@ -0,0 +1,266 @@
+/**
+ * @file native_io.cc
+ * @brief Declarative native I/O: execute "pread/pwrite on fd X" descriptors off the JS thread
+ */
+
+#include "native_io.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <string>
+#include <unistd.h>
+
+#include "logging.h"
+#include "napi_helpers.h"
+
+namespace fuse_native {
+
+NativeIoExecutor& NativeIoExecutor::Instance() {
+    static NativeIoExecutor instance;
+    return instance;
+}
+
+NativeIoExecutor::~NativeIoExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (std::thread& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void NativeIoExecutor::Configure(size_t threads) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        target_threads_ = std::clamp<size_t>(threads, 1, kMaxThreads);
+        if (live_threads_ > 0) {
+            EnsureWorkersLocked();
+        }
+    }
+    // Überzählige Worker beenden sich, sobald sie aufwachen
+    cv_.notify_all();
+    FUSE_LOG_DEBUG("native io: threads=%zu", threads);
+}
+
+bool NativeIoExecutor::Submit(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            return false;
+        }
+        EnsureWorkersLocked();
+        tasks_.push_back(std::move(task));
+        peak_queued_ = std::max(peak_queued_, tasks_.size());
+    }
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+    cv_.notify_one();
+    return true;
+}
+
+void NativeIoExecutor::EnsureWorkersLocked() {
+    while (live_threads_ < target_threads_) {
+        ++live_threads_;
+        workers_.emplace_back([this] { WorkerLoop(); });
+    }
+}
+
+void NativeIoExecutor::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        cv_.wait(lock, [this] {
+            return stopping_ || !tasks_.empty() || live_threads_ > target_threads_;
+        });
+        if (stopping_ || (tasks_.empty() && live_threads_ > target_threads_)) {
+            --live_threads_;
+            return;
+        }
+        Task task = std::move(tasks_.front());
+        tasks_.pop_front();
+        lock.unlock();
+        task();
+        completed_.fetch_add(1, std::memory_order_relaxed);
+        lock.lock();
+    }
+}
+
+void NativeIoExecutor::RecordRead(int64_t result) {
+    if (result < 0) {
+        errors_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        bytes_read_.fetch_add(static_cast<uint64_t>(result), std::memory_order_relaxed);
+    }
+}
+
+void NativeIoExecutor::RecordWrite(int64_t result) {
+    if (result < 0) {
+        errors_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        bytes_written_.fetch_add(static_cast<uint64_t>(result), std::memory_order_relaxed);
+    }
+}
+
+NativeIoStats NativeIoExecutor::GetStats() const {
+    NativeIoStats stats;
+    stats.submitted = submitted_.load(std::memory_order_relaxed);
+    stats.completed = completed_.load(std::memory_order_relaxed);
+    stats.errors = errors_.load(std::memory_order_relaxed);
+    stats.bytes_read = bytes_read_.load(std::memory_order_relaxed);
+    stats.bytes_written = bytes_written_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.queued = tasks_.size();
+    stats.peak_queued = peak_queued_;
+    stats.threads = live_threads_;
+    return stats;
+}
+
+bool DecodeNativeIoDescriptor(Napi::Value value, NativeIoDescriptor::Op op, NativeIoDescriptor* out) {
+    // Buffer/TypedArray sind ebenfalls Objekte – nur reine Deskriptoren zählen
+    if (!out || !value.IsObject() || value.IsTypedArray() || value.IsArrayBuffer() || value.IsArray()) {
+        return false;
+    }
+    Napi::Object obj = value.As<Napi::Object>();
+
+    Napi::Value op_value = obj.Get("op");
+    if (!op_value.IsString()) {
+        return false;
+    }
+    const std::string name = op_value.As<Napi::String>().Utf8Value();
+    if (name != (op == NativeIoDescriptor::Op::PREAD ? "pread" : "pwrite")) {
+        return false;
+    }
+
+    Napi::Value fd_value = obj.Get("fd");
+    if (!fd_value.IsNumber()) {
+        return false;
+    }
+    const double fd = fd_value.As<Napi::Number>().DoubleValue();
+    if (fd < 0 || fd > INT_MAX || fd != static_cast<double>(static_cast<int>(fd))) {
+        return false;
+    }
+
+    uint64_t offset = 0;
+    Napi::Value offset_value = obj.Get("offset");
+    if (offset_value.IsBigInt()) {
+        bool lossless = false;
+        offset = offset_value.As<Napi::BigInt>().Uint64Value(&lossless);
+        if (!lossless) {
+            return false;
+        }
+    } else if (offset_value.IsNumber()) {
+        const double number = offset_value.As<Napi::Number>().DoubleValue();
+        if (number < 0) {
+            return false;
+        }
+        offset = static_cast<uint64_t>(number);
+    } else if (!offset_value.IsUndefined()) {
+        return false;
+    }
+
+    size_t size = 0;
+    Napi::Value size_value = obj.Get("size");
+    if (size_value.IsNumber()) {
+        const double number = size_value.As<Napi::Number>().DoubleValue();
+        if (number < 0) {
+            return false;
+        }
+        size = static_cast<size_t>(number);
+    }
+
+    out->op = op;
+    out->fd = static_cast<int>(fd);
+    out->offset = offset;
+    out->size = size;
+    return true;
+}
+
+int64_t PreadFully(int fd, void* buffer, size_t size, uint64_t offset) {
+    auto* dest = static_cast<char*>(buffer);
+    size_t done = 0;
+    while (done < size) {
+        const ssize_t n = pread(fd, dest + done, size - done, static_cast<off_t>(offset + done));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return done > 0 ? static_cast<int64_t>(done) : -errno;
+        }
+        if (n == 0) {
+            break;
+        }
+        done += static_cast<size_t>(n);
+    }
+    return static_cast<int64_t>(done);
+}
+
+int64_t PwriteFully(int fd, std::vector<struct iovec> iov, uint64_t offset) {
+    int64_t total = 0;
+    size_t index = 0;
+    while (index < iov.size()) {
+        const int count = static_cast<int>(std::min<size_t>(iov.size() - index, IOV_MAX));
+        const ssize_t written = pwritev(fd, iov.data() + index, count, static_cast<off_t>(offset + total));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return total > 0 ? total : -errno;
+        }
+        if (written == 0) {
+            return total > 0 ? total : -EIO;
+        }
+        total += written;
+        // Teilweise geschriebene iovecs vorrücken
+        size_t remaining = static_cast<size_t>(written);
+        while (index < iov.size() && remaining >= iov[index].iov_len) {
+            remaining -= iov[index].iov_len;
+            ++index;
+        }
+        if (index < iov.size() && remaining > 0) {
+            iov[index].iov_base = static_cast<char*>(iov[index].iov_base) + remaining;
+            iov[index].iov_len -= remaining;
+        }
+    }
+    return total;
+}
+
+Napi::Value ConfigureNativeIo(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        NapiHelpers::ThrowTypeError(env, "Expected configuration object");
+        return env.Undefined();
+    }
+
+    Napi::Value threads = info[0].As<Napi::Object>().Get("threads");
+    if (!threads.IsUndefined()) {
+        if (!threads.IsNumber() || threads.As<Napi::Number>().DoubleValue() < 1 ||
+            threads.As<Napi::Number>().DoubleValue() > NativeIoExecutor::kMaxThreads) {
+            NapiHelpers::ThrowTypeError(env, "threads must be between 1 and 64");
+            return env.Undefined();
+        }
+        NativeIoExecutor::Instance().Configure(threads.As<Napi::Number>().Uint32Value());
+    }
+    return Napi::Boolean::New(env, true);
+}
+
+Napi::Value GetNativeIoStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    const NativeIoStats stats = NativeIoExecutor::Instance().GetStats();
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("submitted", Napi::Number::New(env, static_cast<double>(stats.submitted)));
+    result.Set("completed", Napi::Number::New(env, static_cast<double>(stats.completed)));
+    result.Set("errors", Napi::Number::New(env, static_cast<double>(stats.errors)));
+    result.Set("bytesRead", NapiHelpers::CreateBigUint64(env, stats.bytes_read));
+    result.Set("bytesWritten", NapiHelpers::CreateBigUint64(env, stats.bytes_written));
+    result.Set("queued", Napi::Number::New(env, static_cast<double>(stats.queued)));
+    result.Set("peakQueued", Napi::Number::New(env, static_cast<double>(stats.peak_queued)));
+    result.Set("threads", Napi::Number::New(env, static_cast<double>(stats.threads)));
+    return result;
+}
+
+} // namespace fuse_native
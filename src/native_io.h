@@ -0,0 +1,160 @@
+/**
+ * @file native_io.h
+ * @brief Declarative native I/O: execute "pread/pwrite on fd X" descriptors off the JS thread
+ *
+ * Handlers that only translate (ino, offset) into (backing fd, offset) can
+ * return a descriptor instead of doing the I/O in JS:
+ *
+ *   read / read_buf  ->  { op: 'pread',  fd, offset, size? }
+ *   write / write_buf ->  { op: 'pwrite', fd, offset }
+ *
+ * The bridge hands the descriptor to a small native worker pool. Reads are
+ * pread into a native buffer, writes pwritev the request data that is still
+ * held natively. The reply goes out from the worker; neither the data nor
+ * the I/O touch the JS thread or libuv.
+ *
+ * read_buf results that already contain FUSE_BUF_IS_FD segments are replied
+ * with fuse_reply_data on the same pool instead of on the JS thread.
+ */
+
+#ifndef NATIVE_IO_H
+#define NATIVE_IO_H
+
+#include <napi.h>
+#include <sys/uio.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fuse_native {
+
+/**
+ * Decoded I/O descriptor returned by a read or write handler
+ */
+struct NativeIoDescriptor {
+    enum class Op { PREAD, PWRITE };
+
+    Op op = Op::PREAD;
+    int fd = -1;
+    uint64_t offset = 0;
+    size_t size = 0;        ///< pread only; 0 = the size the kernel asked for
+};
+
+/**
+ * Native I/O executor statistics
+ */
+struct NativeIoStats {
+    uint64_t submitted = 0;
+    uint64_t completed = 0;
+    uint64_t errors = 0;            ///< Tasks that replied with an errno
+    uint64_t bytes_read = 0;
+    uint64_t bytes_written = 0;
+    size_t queued = 0;
+    size_t peak_queued = 0;
+    size_t threads = 0;
+};
+
+/**
+ * Fixed-size worker pool for descriptor I/O.
+ */
+class NativeIoExecutor {
+public:
+    using Task = std::function<void()>;
+
+    static constexpr size_t kDefaultThreads = 4;
+    static constexpr size_t kMaxThreads = 64;
+
+    static NativeIoExecutor& Instance();
+
+    ~NativeIoExecutor();
+
+    /**
+     * @brief Set the number of worker threads (takes effect for new workers)
+     *
+     * Growing starts workers immediately; shrinking lets surplus workers exit
+     * once they are idle.
+     */
+    void Configure(size_t threads);
+
+    /**
+     * @brief Queue a task; workers are started on first use
+     * @return false if the executor is shutting down
+     */
+    bool Submit(Task task);
+
+    void RecordRead(int64_t result);
+    void RecordWrite(int64_t result);
+
+    NativeIoStats GetStats() const;
+
+private:
+    NativeIoExecutor() = default;
+
+    void EnsureWorkersLocked();
+    void WorkerLoop();
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Task> tasks_;
+    std::vector<std::thread> workers_;
+    size_t target_threads_ = kDefaultThreads;
+    size_t live_threads_ = 0;
+    size_t peak_queued_ = 0;
+    bool stopping_ = false;
+
+    std::atomic<uint64_t> submitted_{0};
+    std::atomic<uint64_t> completed_{0};
+    std::atomic<uint64_t> errors_{0};
+    std::atomic<uint64_t> bytes_read_{0};
+    std::atomic<uint64_t> bytes_written_{0};
+};
+
+/**
+ * @brief Decode a handler result as I/O descriptor
+ * @param value Handler result
+ * @param op Expected operation (a pwrite descriptor is not valid for read)
+ * @param out Decoded descriptor
+ * @return true if @p value is a well-formed descriptor for @p op
+ */
+bool DecodeNativeIoDescriptor(Napi::Value value, NativeIoDescriptor::Op op, NativeIoDescriptor* out);
+
+/**
+ * @brief pread until @p size bytes or end of file
+ * @return Bytes read or negative errno (only if nothing was read)
+ */
+int64_t PreadFully(int fd, void* buffer, size_t size, uint64_t offset);
+
+/**
+ * @brief pwritev until everything is written
+ * @return Bytes written or negative errno
+ */
+int64_t PwriteFully(int fd, std::vector<struct iovec> iov, uint64_t offset);
+
+/**
+ * N-API exposed functions
+ */
+
+/**
+ * Configure the native I/O executor (N-API exposed function)
+ * @param info N-API callback info containing `{threads?}`
+ * @return Boolean indicating success
+ */
+Napi::Value ConfigureNativeIo(const Napi::CallbackInfo& info);
+
+/**
+ * Get native I/O executor statistics (N-API exposed function)
+ * @param info N-API callback info
+ * @return Object containing statistics
+ */
+Napi::Value GetNativeIoStats(const Napi::CallbackInfo& info);
+
+} // namespace fuse_native
+
+#endif // NATIVE_IO_H
@@ -0,0 +1,548 @@
+/**
+ * @file notify_bridge.cc
+ * @brief Kernel cache notifications (invalidation, page-cache store and retrieve)
+ */
+
+#include "notify_bridge.h"
+
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "attr_cache.h"
+#include "dentry_cache.h"
+#include "logging.h"
+#include "napi_helpers.h"
+#include "session_manager.h"
+
+namespace fuse_native {
+
+namespace {
+
+bool ReadSessionId(const Napi::Value& value, uint64_t* out) {
+    if (!value.IsObject()) {
+        return false;
+    }
+    Napi::Object handle = value.As<Napi::Object>();
+    if (!handle.Has("id") || !handle.Get("id").IsNumber()) {
+        return false;
+    }
+    *out = static_cast<uint64_t>(handle.Get("id").As<Napi::Number>().Int64Value());
+    return true;
+}
+
+bool ReadIno(const Napi::Object& obj, const char* key, fuse_ino_t* out) {
+    Napi::Value value = obj.Get(key);
+    if (!value.IsBigInt()) {
+        return false;
+    }
+    bool lossless = false;
+    *out = static_cast<fuse_ino_t>(value.As<Napi::BigInt>().Uint64Value(&lossless));
+    return lossless && *out != 0;
+}
+
+bool ReadInt64(const Napi::Object& obj, const char* key, int64_t* out) {
+    Napi::Value value = obj.Get(key);
+    if (value.IsUndefined()) {
+        return true;
+    }
+    if (value.IsBigInt()) {
+        bool lossless = false;
+        *out = value.As<Napi::BigInt>().Int64Value(&lossless);
+        return lossless;
+    }
+    if (value.IsNumber()) {
+        *out = value.As<Napi::Number>().Int64Value();
+        return true;
+    }
+    return false;
+}
+
+bool ReadName(const Napi::Object& obj, std::string* out) {
+    Napi::Value value = obj.Get("name");
+    if (!value.IsString()) {
+        return false;
+    }
+    *out = value.As<Napi::String>().Utf8Value();
+    return !out->empty() && out->find('/') == std::string::npos;
+}
+
+bool DecodeNotifyOp(const Napi::Value& item, NotifyOp* op, std::string* error) {
+    if (!item.IsObject()) {
+        *error = "notification must be an object";
+        return false;
+    }
+    Napi::Object obj = item.As<Napi::Object>();
+    Napi::Value kind = obj.Get("op");
+    if (!kind.IsString()) {
+        *error = "notification op must be a string";
+        return false;
+    }
+
+    const std::string type = kind.As<Napi::String>().Utf8Value();
+    if (type == "invalInode") {
+        op->type = NotifyOpType::INVAL_INODE;
+        if (!ReadIno(obj, "ino", &op->ino) || !ReadInt64(obj, "offset", &op->offset) ||
+            !ReadInt64(obj, "length", &op->length)) {
+            *error = "invalInode expects ino (bigint) and optional offset/length";
+            return false;
+        }
+        return true;
+    }
+
+    if (type == "invalEntry" || type == "expireEntry") {
+        op->type = type == "invalEntry" ? NotifyOpType::INVAL_ENTRY : NotifyOpType::EXPIRE_ENTRY;
+        if (!ReadIno(obj, "parent", &op->ino) || !ReadName(obj, &op->name)) {
+            *error = type + " expects parent (bigint) and name";
+            return false;
+        }
+        return true;
+    }
+
+    if (type == "delete") {
+        op->type = NotifyOpType::DELETE;
+        if (!ReadIno(obj, "parent", &op->ino) || !ReadIno(obj, "child", &op->child) ||
+            !ReadName(obj, &op->name)) {
+            *error = "delete expects parent, child (bigint) and name";
+            return false;
+        }
+        return true;
+    }
+
+    *error = "unknown notification op: " + type;
+    return false;
+}
+
+/**
+ * A notify_retrieve waiting for its RETRIEVE_REPLY
+ */
+struct PendingRetrieve {
+    uint64_t session_id;
+    Napi::Promise::Deferred deferred;
+    Napi::ThreadSafeFunction tsfn;
+};
+
+struct RetrieveResult {
+    int error = 0;          ///< 0 or negative errno
+    fuse_ino_t ino = 0;
+    off_t offset = 0;
+    std::vector<uint8_t> data;
+};
+
+std::mutex g_retrieve_mutex;
+std::unordered_map<uint64_t, std::shared_ptr<PendingRetrieve>> g_pending_retrieves;
+std::atomic<uint64_t> g_next_retrieve_cookie{1};
+
+std::shared_ptr<PendingRetrieve> TakePendingRetrieve(uint64_t cookie) {
+    std::lock_guard<std::mutex> lock(g_retrieve_mutex);
+    auto it = g_pending_retrieves.find(cookie);
+    if (it == g_pending_retrieves.end()) {
+        return nullptr;
+    }
+    std::shared_ptr<PendingRetrieve> pending = std::move(it->second);
+    g_pending_retrieves.erase(it);
+    return pending;
+}
+
+void DeliverRetrieve(const std::shared_ptr<PendingRetrieve>& pending,
+                     std::unique_ptr<RetrieveResult> result) {
+    RetrieveResult* payload = result.release();
+    const napi_status status = pending->tsfn.BlockingCall(
+        payload, [pending](Napi::Env env, Napi::Function, RetrieveResult* raw) {
+            std::unique_ptr<RetrieveResult> res(raw);
+            if (res->error != 0) {
+                pending->deferred.Reject(
+                    NapiHelpers::CreateErrnoError(
+                        env, -res->error, NapiHelpers::ErrnoToString(-res->error) + ": notify_retrieve failed").Value());
+                return;
+            }
+            Napi::Object obj = Napi::Object::New(env);
+            obj.Set("ino", NapiHelpers::CreateBigUint64(env, res->ino));
+            obj.Set("offset", NapiHelpers::CreateBigInt64(env, static_cast<int64_t>(res->offset)));
+            obj.Set("data", Napi::Buffer<uint8_t>::Copy(env, res->data.data(), res->data.size()));
+            pending->deferred.Resolve(obj);
+        });
+    if (status != napi_ok) {
+        delete payload;
+    }
+    pending->tsfn.Release();
+}
+
+/**
+ * Dedicated thread for notifications
+ *
+ * inval_* and notify_store may block in the kernel until requests on the
+ * same inode are answered. Those answers can depend on JS handlers that use
+ * libuv's fs threads, so a notification must never occupy a thread of the
+ * libuv pool (4 by default): blocked notifications would starve the very
+ * handlers they wait for. One thread also keeps notifications in order.
+ */
+class NotifyThread {
+public:
+    using Task = std::function<void()>;
+
+    static NotifyThread& Instance() {
+        static NotifyThread instance;
+        return instance;
+    }
+
+    ~NotifyThread() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    /**
+     * @brief Queue a task; the thread is started on first use
+     * @return false if the thread is shutting down
+     */
+    bool Submit(Task task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) {
+                return false;
+            }
+            if (!thread_.joinable()) {
+                thread_ = std::thread([this] { Run(); });
+            }
+            tasks_.push_back(std::move(task));
+        }
+        cv_.notify_one();
+        return true;
+    }
+
+private:
+    NotifyThread() = default;
+
+    void Run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;
+            }
+            Task task = std::move(tasks_.front());
+            tasks_.pop_front();
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Task> tasks_;
+    std::thread thread_;
+    bool stopping_ = false;
+};
+
+/**
+ * Promise of a notifyBatch/notifyStore call, settled from the notify thread
+ */
+struct NotifyCall {
+    explicit NotifyCall(Napi::Env env) : deferred(Napi::Promise::Deferred::New(env)) {}
+
+    Napi::Promise::Deferred deferred;
+    Napi::ThreadSafeFunction tsfn;
+    Napi::ObjectReference owner;   ///< notifyStore: keeps the buffer alive
+};
+
+using NotifySettler = std::function<void(Napi::Env, NotifyCall&)>;
+
+std::shared_ptr<NotifyCall> NewNotifyCall(Napi::Env env, const char* name) {
+    auto noop = Napi::Function::New(env, [](const Napi::CallbackInfo&) {});
+    auto call = std::make_shared<NotifyCall>(env);
+    call->tsfn = Napi::ThreadSafeFunction::New(env, noop, name, 0, 1);
+    return call;
+}
+
+// Auf dem JS-Thread auflösen; gibt die TSFN des Aufrufs frei
+void SettleNotifyCall(const std::shared_ptr<NotifyCall>& call, NotifySettler settle) {
+    auto* payload = new NotifySettler(std::move(settle));
+    const napi_status status = call->tsfn.BlockingCall(
+        payload, [call](Napi::Env env, Napi::Function, NotifySettler* raw) {
+            std::unique_ptr<NotifySettler> fn(raw);
+            (*fn)(env, *call);
+            call->owner.Reset();
+        });
+    if (status != napi_ok) {
+        // Env wird abgebaut: die Referenz nicht mehr vom falschen Thread löschen
+        delete payload;
+        call->owner.SuppressDestruct();
+    }
+    call->tsfn.Release();
+}
+
+// Submit gescheitert (Prozessende): auf dem JS-Thread sofort ablehnen
+Napi::Value RejectUnsubmitted(Napi::Env env, const std::shared_ptr<NotifyCall>& call) {
+    call->tsfn.Release();
+    call->owner.Reset();
+    call->deferred.Reject(NapiHelpers::CreateErrnoError(env, ESHUTDOWN, "notification thread stopped").Value());
+    return call->deferred.Promise();
+}
+
+} // namespace
+
+int ExecuteNotifyOp(struct fuse_session* se, const NotifyOp& op) {
+    int rc = -ENOSYS;
+    switch (op.type) {
+        case NotifyOpType::INVAL_INODE:
+            AttrCache::Instance().Invalidate(op.ino);
+            rc = fuse_lowlevel_notify_inval_inode(se, op.ino, static_cast<off_t>(op.offset),
+                                                  static_cast<off_t>(op.length));
+            break;
+        case NotifyOpType::INVAL_ENTRY:
+            DentryCache::Instance().Invalidate(op.ino, op.name);
+            AttrCache::Instance().Invalidate(op.ino);
+            rc = fuse_lowlevel_notify_inval_entry(se, op.ino, op.name.c_str(), op.name.size());
+            break;
+        case NotifyOpType::EXPIRE_ENTRY:
+            DentryCache::Instance().Invalidate(op.ino, op.name);
+#if FUSE_MAJOR_VERSION > 3 || (FUSE_MAJOR_VERSION == 3 && FUSE_MINOR_VERSION >= 16)
+            rc = fuse_lowlevel_notify_expire_entry(se, op.ino, op.name.c_str(), op.name.size());
+#else
+            rc = -ENOSYS;
+#endif
+            break;
+        case NotifyOpType::DELETE:
+            DentryCache::Instance().Invalidate(op.ino, op.name);
+            AttrCache::Instance().Invalidate(op.ino);
+            AttrCache::Instance().Invalidate(op.child);
+            rc = fuse_lowlevel_notify_delete(se, op.ino, op.child, op.name.c_str(), op.name.size());
+            break;
+        case NotifyOpType::RETRIEVE:
+            // Nur ein write() auf /dev/fuse; die Antwort kommt asynchron als RETRIEVE_REPLY
+            rc = fuse_lowlevel_notify_retrieve(se, op.ino, static_cast<size_t>(op.length),
+                                               static_cast<off_t>(op.offset),
+                                               reinterpret_cast<void*>(static_cast<uintptr_t>(op.cookie)));
+            // ENOENT heißt hier nicht "nichts zu tun": das Promise muss scheitern
+            return rc;
+    }
+
+    // ENOENT: der Kernel kennt das Objekt nicht – nichts zu invalidieren
+    if (rc != 0 && rc != -ENOENT) {
+        FUSE_LOG_DEBUG("notify: op=%d ino=%llu failed rc=%d", static_cast<int>(op.type),
+                       static_cast<unsigned long long>(op.ino), rc);
+    }
+    return rc == -ENOENT ? 0 : rc;
+}
+
+Napi::Value NotifyBatch(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsArray()) {
+        NapiHelpers::ThrowTypeError(env, "Expected (sessionHandle, notifications[])");
+        return env.Undefined();
+    }
+
+    uint64_t session_id = 0;
+    if (!ReadSessionId(info[0], &session_id)) {
+        NapiHelpers::ThrowTypeError(env, "Invalid session handle");
+        return env.Undefined();
+    }
+
+    Napi::Array items = info[1].As<Napi::Array>();
+    std::vector<NotifyOp> ops(items.Length());
+    for (uint32_t i = 0; i < items.Length(); ++i) {
+        std::string error;
+        if (!DecodeNotifyOp(items.Get(i), &ops[i], &error)) {
+            NapiHelpers::ThrowTypeError(env, "notification[" + std::to_string(i) + "]: " + error);
+            return env.Undefined();
+        }
+    }
+
+    std::shared_ptr<NotifyCall> call = NewNotifyCall(env, "fuse-native:notify");
+    const bool submitted = NotifyThread::Instance().Submit([call, session_id, ops = std::move(ops)] {
+        std::vector<int> results(ops.size(), 0);
+        const int rc = WithMountedSession(session_id, [&ops, &results](struct fuse_session* se) {
+            for (size_t i = 0; i < ops.size(); ++i) {
+                results[i] = ExecuteNotifyOp(se, ops[i]);
+            }
+            return 0;
+        });
+        if (rc != 0) {
+            results.assign(ops.size(), rc);
+        }
+        SettleNotifyCall(call, [results = std::move(results)](Napi::Env env, NotifyCall& settled) {
+            Napi::Array result = Napi::Array::New(env, results.size());
+            for (size_t i = 0; i < results.size(); ++i) {
+                result.Set(static_cast<uint32_t>(i), Napi::Number::New(env, results[i]));
+            }
+            settled.deferred.Resolve(result);
+        });
+    });
+    if (!submitted) {
+        return RejectUnsubmitted(env, call);
+    }
+    return call->deferred.Promise();
+}
+
+Napi::Value NotifyStore(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    uint64_t session_id = 0;
+    if (info.Length() < 4 || !ReadSessionId(info[0], &session_id) || !info[1].IsBigInt() ||
+        !info[2].IsBigInt() || !info[3].IsTypedArray() ||
+        info[3].As<Napi::TypedArray>().TypedArrayType() != napi_uint8_array) {
+        NapiHelpers::ThrowTypeError(env, "Expected (sessionHandle, ino: bigint, offset: bigint, data: Uint8Array)");
+        return env.Undefined();
+    }
+
+    const uint64_t ino = NapiHelpers::GetBigUint64(env, info[1]);
+    if (env.IsExceptionPending()) {
+        return env.Undefined();
+    }
+    const int64_t offset = NapiHelpers::SafeGetBigInt64(info[2]).value_or(-1);
+    if (ino == 0 || offset < 0) {
+        NapiHelpers::ThrowTypeError(env, "ino must be non-zero and offset non-negative");
+        return env.Undefined();
+    }
+
+    // Buffer bleibt über owner referenziert – kein Kopieren
+    Napi::Uint8Array data = info[3].As<Napi::Uint8Array>();
+    std::shared_ptr<NotifyCall> call = NewNotifyCall(env, "fuse-native:notify-store");
+    call->owner = Napi::Persistent(data.As<Napi::Object>());
+    const uint8_t* bytes = data.Data();
+    const size_t size = data.ByteLength();
+    const bool submitted = NotifyThread::Instance().Submit([call, session_id, ino, offset, bytes, size] {
+        // notify_store sperrt Seiten im Page-Cache, die ein auf JS wartender read halten kann
+        const int rc = WithMountedSession(session_id, [&](struct fuse_session* se) {
+            struct fuse_bufvec bufv = FUSE_BUFVEC_INIT(size);
+            bufv.buf[0].mem = const_cast<uint8_t*>(bytes);
+            return fuse_lowlevel_notify_store(se, static_cast<fuse_ino_t>(ino), static_cast<off_t>(offset), &bufv,
+                                              static_cast<enum fuse_buf_copy_flags>(0));
+        });
+        // notify_store kann i_size vergrößern
+        AttrCache::Instance().Invalidate(static_cast<fuse_ino_t>(ino));
+        SettleNotifyCall(call, [rc](Napi::Env env, NotifyCall& settled) {
+            settled.deferred.Resolve(Napi::Number::New(env, rc));
+        });
+    });
+    if (!submitted) {
+        return RejectUnsubmitted(env, call);
+    }
+    return call->deferred.Promise();
+}
+
+Napi::Value NotifyRetrieve(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    uint64_t session_id = 0;
+    if (info.Length() < 4 || !ReadSessionId(info[0], &session_id) || !info[1].IsBigInt() ||
+        !info[2].IsBigInt() || !info[3].IsNumber()) {
+        NapiHelpers::ThrowTypeError(env, "Expected (sessionHandle, ino: bigint, offset: bigint, size: number)");
+        return env.Undefined();
+    }
+
+    const uint64_t ino = NapiHelpers::GetBigUint64(env, info[1]);
+    if (env.IsExceptionPending()) {
+        return env.Undefined();
+    }
+    const int64_t offset = NapiHelpers::SafeGetBigInt64(info[2]).value_or(-1);
+    const double size = info[3].As<Napi::Number>().DoubleValue();
+    if (ino == 0 || offset < 0 || !(size > 0) || size > UINT32_MAX) {
+        NapiHelpers::ThrowTypeError(env, "ino must be non-zero, offset non-negative and size in (0, 2^32)");
+        return env.Undefined();
+    }
+
+    auto noop = Napi::Function::New(env, [](const Napi::CallbackInfo&) {});
+    auto pending = std::make_shared<PendingRetrieve>(PendingRetrieve{
+        session_id,
+        Napi::Promise::Deferred::New(env),
+        Napi::ThreadSafeFunction::New(env, noop, "fuse-native:retrieve", 0, 1),
+    });
+    Napi::Promise promise = pending->deferred.Promise();
+
+    const uint64_t cookie = g_next_retrieve_cookie.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(g_retrieve_mutex);
+        g_pending_retrieves.emplace(cookie, pending);
+    }
+
+    // Wie alle Notifies auf dem Notify-Thread: der write() kann im Kernel blockieren
+    NotifyOp op;
+    op.type = NotifyOpType::RETRIEVE;
+    op.ino = static_cast<fuse_ino_t>(ino);
+    op.offset = offset;
+    op.length = static_cast<int64_t>(size);
+    op.cookie = cookie;
+    auto send = [session_id, op] {
+        const int rc = WithMountedSession(session_id, [&op](struct fuse_session* se) {
+            return ExecuteNotifyOp(se, op);
+        });
+        if (rc == 0) {
+            return;  // RETRIEVE_REPLY (oder Cancel) löst das Promise auf
+        }
+        if (std::shared_ptr<PendingRetrieve> failed = TakePendingRetrieve(op.cookie)) {
+            auto result = std::make_unique<RetrieveResult>();
+            result->error = rc;
+            DeliverRetrieve(failed, std::move(result));
+        }
+    };
+    if (!NotifyThread::Instance().Submit(std::move(send))) {
+        if (std::shared_ptr<PendingRetrieve> failed = TakePendingRetrieve(cookie)) {
+            failed->tsfn.Release();
+            failed->deferred.Reject(NapiHelpers::CreateErrnoError(env, ESHUTDOWN, "notification thread stopped").Value());
+        }
+    }
+    return promise;
+}
+
+bool CompleteRetrieve(uint64_t cookie, fuse_ino_t ino, off_t offset, struct fuse_bufvec* bufv) {
+    std::shared_ptr<PendingRetrieve> pending = TakePendingRetrieve(cookie);
+    if (!pending) {
+        return false;
+    }
+
+    auto result = std::make_unique<RetrieveResult>();
+    result->ino = ino;
+    result->offset = offset;
+    const size_t size = bufv ? fuse_buf_size(bufv) : 0;
+    if (size > 0) {
+        result->data.resize(size);
+        struct fuse_bufvec dst = FUSE_BUFVEC_INIT(size);
+        dst.buf[0].mem = result->data.data();
+        const ssize_t copied = fuse_buf_copy(&dst, bufv, static_cast<enum fuse_buf_copy_flags>(0));
+        if (copied < 0) {
+            result->error = static_cast<int>(copied);
+            result->data.clear();
+        } else {
+            result->data.resize(static_cast<size_t>(copied));
+        }
+    }
+    DeliverRetrieve(pending, std::move(result));
+    return true;
+}
+
+void CancelPendingRetrieves(uint64_t session_id, int error) {
+    std::vector<std::shared_ptr<PendingRetrieve>> cancelled;
+    {
+        std::lock_guard<std::mutex> lock(g_retrieve_mutex);
+        for (auto it = g_pending_retrieves.begin(); it != g_pending_retrieves.end();) {
+            if (it->second->session_id == session_id) {
+                cancelled.push_back(std::move(it->second));
+                it = g_pending_retrieves.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    for (const auto& pending : cancelled) {
+        auto result = std::make_unique<RetrieveResult>();
+        result->error = error;
+        DeliverRetrieve(pending, std::move(result));
+    }
+}
+
+} // namespace fuse_native
@@ -0,0 +1,109 @@
+/**
+ * @file notify_bridge.h
+ * @brief Kernel cache notifications (invalidation, page-cache store and retrieve)
+ *
+ * Filesystems whose backend changes behind the mount (other nodes, change
+ * feeds) otherwise have to run with tiny entry/attr timeouts and without
+ * keep_cache. These notifications let them keep long timeouts and tell the
+ * kernel precisely what changed.
+ *
+ * Notifications are executed in order on a dedicated native thread, never on
+ * the JS thread or the libuv pool: inval_* and delete may block in the kernel
+ * until in-flight requests on the same inode have been answered, and those
+ * answers come from JS handlers that may need libuv's fs threads. A batch is executed in order with the session pinned but no lock
+ * held, and resolves to one errno per operation. Native attribute and dentry caches are updated
+ * alongside the kernel.
+ *
+ * notify_store pushes data into the page cache of an inode so that reads of
+ * prefetched ranges never reach the bridge; notify_retrieve asks the kernel
+ * for cached pages, which arrive asynchronously as a RETRIEVE_REPLY request
+ * and resolve the pending promise by cookie.
+ */
+
+#ifndef NOTIFY_BRIDGE_H
+#define NOTIFY_BRIDGE_H
+
+#include <napi.h>
+#include <fuse3/fuse_lowlevel.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fuse_native {
+
+/**
+ * Notification kinds
+ */
+enum class NotifyOpType {
+    INVAL_INODE,
+    INVAL_ENTRY,
+    DELETE,
+    EXPIRE_ENTRY,
+    RETRIEVE,
+};
+
+/**
+ * One decoded notification
+ */
+struct NotifyOp {
+    NotifyOpType type = NotifyOpType::INVAL_INODE;
+    fuse_ino_t ino = 0;     ///< inval_inode: inode; entry ops: parent
+    fuse_ino_t child = 0;   ///< delete: child inode
+    std::string name;       ///< entry ops: name in parent
+    int64_t offset = 0;     ///< inval_inode, retrieve: start of the data range
+    int64_t length = 0;     ///< inval_inode: 0 = attributes only, <0 = to end of file;
+                            ///< retrieve: bytes to request
+    uint64_t cookie = 0;    ///< retrieve: key of the pending promise
+};
+
+/**
+ * @brief Execute one notification against a session
+ * @param se Mounted FUSE session
+ * @param op Notification
+ * @return 0 on success, negative errno on failure
+ */
+int ExecuteNotifyOp(struct fuse_session* se, const NotifyOp& op);
+
+/**
+ * Send a batch of notifications (N-API exposed function)
+ * @param info N-API callback info containing the session handle and an array of
+ *             `{op, ino?, parent?, child?, name?, offset?, length?}` objects
+ * @return Promise resolving to one result per notification (0 or negative errno)
+ */
+Napi::Value NotifyBatch(const Napi::CallbackInfo& info);
+
+/**
+ * Store data in the kernel page cache of an inode (N-API exposed function)
+ * @param info N-API callback info containing the session handle, ino (bigint),
+ *             offset (bigint) and data (Buffer/Uint8Array)
+ * @return Promise resolving to 0 or negative errno
+ */
+Napi::Value NotifyStore(const Napi::CallbackInfo& info);
+
+/**
+ * Retrieve cached pages of an inode from the kernel (N-API exposed function)
+ * @param info N-API callback info containing the session handle, ino (bigint),
+ *             offset (bigint) and size (number)
+ * @return Promise resolving to `{ino, offset, data}` once the kernel replied
+ */
+Napi::Value NotifyRetrieve(const Napi::CallbackInfo& info);
+
+/**
+ * @brief Resolve a pending retrieve with the data of a RETRIEVE_REPLY
+ *
+ * Called on the FUSE loop thread; the data is copied before returning.
+ * @return false if the cookie is unknown (already cancelled)
+ */
+bool CompleteRetrieve(uint64_t cookie, fuse_ino_t ino, off_t offset, struct fuse_bufvec* bufv);
+
+/**
+ * @brief Reject all pending retrieves of a session
+ * @param session_id Session whose loop has stopped
+ * @param error Negative errno to reject with
+ */
+void CancelPendingRetrieves(uint64_t session_id, int error);
+
+} // namespace fuse_native
+
+#endif // NOTIFY_BRIDGE_H
@@ -0,0 +1,153 @@
+/**
+ * @file passthrough.cc
+ * @brief FUSE passthrough: register backing files so the kernel serves read/write directly
+ */
+
+#include "passthrough.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include "logging.h"
+
+namespace fuse_native {
+
+PassthroughRegistry& PassthroughRegistry::Instance() {
+    static PassthroughRegistry instance;
+    return instance;
+}
+
+void PassthroughRegistry::Negotiate(struct fuse_conn_info* conn, bool requested) {
+    bool active = false;
+#if defined(FUSE_CAP_PASSTHROUGH)
+    if (requested && conn && (conn->capable & FUSE_CAP_PASSTHROUGH)) {
+        conn->want |= FUSE_CAP_PASSTHROUGH;
+        // Der Kernel verweigert passthrough zusammen mit writeback cache
+        conn->want &= ~FUSE_CAP_WRITEBACK_CACHE;
+        active = true;
+    } else if (requested) {
+        FUSE_LOG_INFO("passthrough: not offered by the kernel, using regular read/write");
+    }
+#else
+    (void)conn;
+    if (requested) {
+        FUSE_LOG_INFO("passthrough: libfuse built without passthrough support, using regular read/write");
+    }
+#endif
+    active_.store(active, std::memory_order_release);
+    FUSE_LOG_DEBUG("passthrough: requested=%d active=%d", requested ? 1 : 0, active ? 1 : 0);
+}
+
+bool PassthroughRegistry::Attach(fuse_req_t req, int fd, struct fuse_file_info* fi) {
+    if (!fi) {
+        return false;
+    }
+#if defined(FUSE_CAP_PASSTHROUGH)
+    if (req && fd >= 0 && Active()) {
+        const int backing_id = fuse_passthrough_open(req, fd);
+        if (backing_id > 0) {
+            fi->backing_id = backing_id;
+            // Seitencache und direct_io gelten für passthrough-Handles nicht
+            fi->keep_cache = 0;
+            fi->direct_io = 0;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                backing_ids_[fi->fh].push_back(backing_id);
+            }
+            opened_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        FUSE_LOG_DEBUG("passthrough: backing fd %d rejected (%s), falling back", fd, std::strerror(errno));
+    }
+#else
+    (void)req;
+    (void)fd;
+#endif
+    fallbacks_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void PassthroughRegistry::Release(fuse_req_t req, uint64_t fh) {
+    int backing_id = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = backing_ids_.find(fh);
+        if (it == backing_ids_.end()) {
+            return;
+        }
+        backing_id = it->second.back();
+        it->second.pop_back();
+        if (it->second.empty()) {
+            backing_ids_.erase(it);
+        }
+    }
+#if defined(FUSE_CAP_PASSTHROUGH)
+    if (req && fuse_passthrough_close(req, backing_id) < 0) {
+        FUSE_LOG_WARN("passthrough: closing backing id %d for fh %llu failed: %s", backing_id,
+                      static_cast<unsigned long long>(fh), std::strerror(errno));
+        return;
+    }
+#else
+    (void)req;
+#endif
+    closed_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PassthroughRegistry::Reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    backing_ids_.clear();
+    active_.store(false, std::memory_order_release);
+}
+
+std::vector<std::pair<uint64_t, int>> PassthroughRegistry::SnapshotBackingIds() const {
+    std::vector<std::pair<uint64_t, int>> ids;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& entry : backing_ids_) {
+        for (int backing_id : entry.second) {
+            ids.emplace_back(entry.first, backing_id);
+        }
+    }
+    return ids;
+}
+
+void PassthroughRegistry::RestoreBackingIds(const std::vector<std::pair<uint64_t, int>>& ids) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    backing_ids_.clear();
+    for (const auto& entry : ids) {
+        if (entry.second > 0) {
+            backing_ids_[entry.first].push_back(entry.second);
+        }
+    }
+}
+
+PassthroughStats PassthroughRegistry::GetStats() const {
+    PassthroughStats stats;
+#if defined(FUSE_CAP_PASSTHROUGH)
+    stats.supported = true;
+#endif
+    stats.active = Active();
+    stats.opened = opened_.load(std::memory_order_relaxed);
+    stats.fallbacks = fallbacks_.load(std::memory_order_relaxed);
+    stats.closed = closed_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& entry : backing_ids_) {
+        stats.live += entry.second.size();
+    }
+    return stats;
+}
+
+Napi::Value GetPassthroughStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    const PassthroughStats stats = PassthroughRegistry::Instance().GetStats();
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("supported", Napi::Boolean::New(env, stats.supported));
+    result.Set("active", Napi::Boolean::New(env, stats.active));
+    result.Set("opened", Napi::Number::New(env, static_cast<double>(stats.opened)));
+    result.Set("fallbacks", Napi::Number::New(env, static_cast<double>(stats.fallbacks)));
+    result.Set("closed", Napi::Number::New(env, static_cast<double>(stats.closed)));
+    result.Set("live", Napi::Number::New(env, static_cast<double>(stats.live)));
+    return result;
+}
+
+} // namespace fuse_native
@@ -0,0 +1,133 @@
+/**
+ * @file passthrough.h
+ * @brief FUSE passthrough: register backing files so the kernel serves read/write directly
+ *
+ * With FUSE_CAP_PASSTHROUGH (Linux 6.9+, libfuse 3.16+) an open or create
+ * reply may carry a backing id. The kernel then forwards read, write and mmap
+ * on that handle to the backing file and never sends them to the bridge.
+ *
+ * An `open`/`create` handler opts in per handle by returning `backingFd` in
+ * its FileInfo. The registry turns that fd into a backing id, stores it under
+ * the file handle and closes the id again on `release`. Whenever passthrough
+ * is unavailable (not requested at mount, kernel or libfuse too old, missing
+ * CAP_SYS_ADMIN, fd rejected) the reply goes out without a backing id and the
+ * handle is served by the regular read/write handlers.
+ *
+ * The bridge never takes ownership of the fd. The kernel holds its own
+ * reference to the backing file, so the handler may close the fd as soon as
+ * open/create has returned.
+ */
+
+#ifndef PASSTHROUGH_H
+#define PASSTHROUGH_H
+
+#include <napi.h>
+#include <fuse3/fuse_lowlevel.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <utility>
+
+namespace fuse_native {
+
+/**
+ * Passthrough statistics
+ */
+struct PassthroughStats {
+    bool supported = false;   ///< Built against a libfuse with passthrough support
+    bool active = false;      ///< Negotiated with the kernel for the current mount
+    uint64_t opened = 0;      ///< Handles opened in passthrough mode
+    uint64_t fallbacks = 0;   ///< Handles that asked for passthrough but use the regular path
+    uint64_t closed = 0;      ///< Backing ids closed on release
+    size_t live = 0;          ///< Backing ids currently registered
+};
+
+/**
+ * Backing id registry keyed by file handle.
+ */
+class PassthroughRegistry {
+public:
+    static PassthroughRegistry& Instance();
+
+    /**
+     * @brief Negotiate the capability during FUSE init
+     * @param conn Connection info; FUSE_CAP_PASSTHROUGH is added to `want`
+     * @param requested Whether the session asked for passthrough
+     *
+     * Passthrough and the writeback cache exclude each other in the kernel,
+     * so the writeback cache is dropped when passthrough is negotiated.
+     */
+    void Negotiate(struct fuse_conn_info* conn, bool requested);
+
+    bool Active() const { return active_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Register a backing fd for an open/create reply
+     * @param req Request being answered (not yet replied)
+     * @param fd Backing file descriptor returned by the handler
+     * @param fi Reply file info; `backing_id` is set on success
+     * @return true if the handle will be served in passthrough mode
+     *
+     * On failure @p fi is left untouched and the handle falls back to the
+     * regular read/write path.
+     */
+    bool Attach(fuse_req_t req, int fd, struct fuse_file_info* fi);
+
+    /**
+     * @brief Close the backing id registered for a file handle
+     * @param req Release request (not yet replied)
+     * @param fh File handle being released
+     */
+    void Release(fuse_req_t req, uint64_t fh);
+
+    /**
+     * @brief Session ended: forget all ids (the kernel dropped them at unmount)
+     */
+    void Reset();
+
+    /**
+     * @brief All registered (fh, backing id) pairs, for a session handoff
+     *
+     * Backing ids belong to the kernel connection, so the successor closes
+     * them on release through the same connection.
+     */
+    std::vector<std::pair<uint64_t, int>> SnapshotBackingIds() const;
+
+    /**
+     * @brief Take over ids from SnapshotBackingIds(), replacing the current ones
+     */
+    void RestoreBackingIds(const std::vector<std::pair<uint64_t, int>>& ids);
+
+    PassthroughStats GetStats() const;
+
+private:
+    PassthroughRegistry() = default;
+
+    std::atomic<bool> active_{false};
+
+    // Mehrere opens dürfen denselben fh liefern – jede Backing-ID wird einzeln geschlossen
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, std::vector<int>> backing_ids_;
+
+    std::atomic<uint64_t> opened_{0};
+    std::atomic<uint64_t> fallbacks_{0};
+    std::atomic<uint64_t> closed_{0};
+};
+
+/**
+ * N-API exposed functions
+ */
+
+/**
+ * Get passthrough statistics (N-API exposed function)
+ * @param info N-API callback info
+ * @return Object containing statistics
+ */
+Napi::Value GetPassthroughStats(const Napi::CallbackInfo& info);
+
+} // namespace fuse_native
+
+#endif // PASSTHROUGH_H
@@ -0,0 +1,586 @@
+/**
+ * @file session_handoff.cc
+ * @brief /dev/fuse fd handoff over Unix sockets (SCM_RIGHTS)
+ */
+
+#include "session_handoff.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "logging.h"
+#include "napi_helpers.h"
+#include "session_manager.h"
+
+namespace fuse_native {
+
+namespace {
+
+constexpr uint32_t kHandoffMagic = 0x464e484f;  // "FNHO"
+constexpr uint16_t kHandoffVersion = 4;
+
+// Obergrenzen gegen kaputte oder fremde Nachrichten
+constexpr uint32_t kMaxMountpointLength = 4096;
+constexpr uint32_t kMaxInitRequestLength = 64 * 1024;
+constexpr uint64_t kMaxStateLength = 64ull * 1024 * 1024;
+constexpr uint64_t kMaxLookupCount = 8ull * 1024 * 1024;
+constexpr uint64_t kMaxHandleCount = 8ull * 1024 * 1024;
+
+struct HandoffHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t mountpoint_length;
+    uint32_t init_length;
+    uint64_t state_length;
+    uint64_t lookup_count;
+    uint64_t open_count;
+    uint64_t backing_count;
+};
+
+using Clock = std::chrono::steady_clock;
+
+int RemainingMs(Clock::time_point deadline) {
+    const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+    return left > 0 ? static_cast<int>(std::min<int64_t>(left, 60000)) : 0;
+}
+
+// Wartet auf @p events; 0, -ETIMEDOUT oder -errno
+int WaitFd(int fd, short events, Clock::time_point deadline) {
+    for (;;) {
+        struct pollfd pfd{fd, events, 0};
+        const int rc = poll(&pfd, 1, RemainingMs(deadline));
+        if (rc > 0) {
+            return 0;
+        }
+        if (rc == 0) {
+            if (Clock::now() >= deadline) {
+                return -ETIMEDOUT;
+            }
+            continue;
+        }
+        if (errno != EINTR) {
+            return -errno;
+        }
+    }
+}
+
+int SendAll(int fd, const void* data, size_t length, Clock::time_point deadline) {
+    const auto* cursor = static_cast<const uint8_t*>(data);
+    while (length > 0) {
+        const ssize_t sent = send(fd, cursor, length, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent > 0) {
+            cursor += sent;
+            length -= static_cast<size_t>(sent);
+            continue;
+        }
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            const int rc = WaitFd(fd, POLLOUT, deadline);
+            if (rc != 0) {
+                return rc;
+            }
+            continue;
+        }
+        return sent < 0 ? -errno : -EPIPE;
+    }
+    return 0;
+}
+
+int RecvAll(int fd, void* data, size_t length, Clock::time_point deadline) {
+    auto* cursor = static_cast<uint8_t*>(data);
+    while (length > 0) {
+        const ssize_t got = recv(fd, cursor, length, MSG_DONTWAIT);
+        if (got > 0) {
+            cursor += got;
+            length -= static_cast<size_t>(got);
+            continue;
+        }
+        if (got == 0) {
+            return -ECONNRESET;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            const int rc = WaitFd(fd, POLLIN, deadline);
+            if (rc != 0) {
+                return rc;
+            }
+            continue;
+        }
+        return -errno;
+    }
+    return 0;
+}
+
+// "@name" adressiert den abstrakten Namensraum
+int MakeAddress(const std::string& path, struct sockaddr_un* address, socklen_t* length) {
+    std::memset(address, 0, sizeof(*address));
+    address->sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address->sun_path)) {
+        return -ENAMETOOLONG;
+    }
+    std::memcpy(address->sun_path, path.data(), path.size());
+    if (path[0] == '@') {
+        address->sun_path[0] = '\0';
+    }
+    *length = static_cast<socklen_t>(offsetof(struct sockaddr_un, sun_path) + path.size());
+    return 0;
+}
+
+// Nur Prozesse desselben Benutzers (oder root) dürfen die Verbindung bekommen bzw. übergeben
+int CheckPeer(int fd) {
+    struct ucred credentials{};
+    socklen_t length = sizeof(credentials);
+    if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &credentials, &length) != 0) {
+        return -errno;
+    }
+    if (credentials.uid != geteuid() && credentials.uid != 0) {
+        FUSE_LOG_WARN("handoff: rejecting peer pid=%d uid=%u", static_cast<int>(credentials.pid),
+                      static_cast<unsigned>(credentials.uid));
+        return -EPERM;
+    }
+    return 0;
+}
+
+} // namespace
+
+int SendHandoff(const std::string& socket_path, int fuse_fd, const HandoffPayload& payload,
+                uint32_t timeout_ms, bool* may_resume) {
+    *may_resume = true;
+    if (payload.mountpoint.size() > kMaxMountpointLength || payload.init_request.size() > kMaxInitRequestLength ||
+        payload.state.size() > kMaxStateLength || payload.lookups.size() > kMaxLookupCount ||
+        payload.opens.size() > kMaxHandleCount || payload.backing.size() > kMaxHandleCount) {
+        return -EMSGSIZE;
+    }
+    struct sockaddr_un address;
+    socklen_t address_length = 0;
+    int rc = MakeAddress(socket_path, &address, &address_length);
+    if (rc != 0) {
+        return rc;
+    }
+
+    const auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+    int fd = -1;
+    // Der Nachfolger lauscht eventuell noch nicht
+    for (;;) {
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            return -errno;
+        }
+        if (connect(fd, reinterpret_cast<struct sockaddr*>(&address), address_length) == 0) {
+            break;
+        }
+        rc = -errno;
+        close(fd);
+        fd = -1;
+        if (rc != -ENOENT && rc != -ECONNREFUSED && rc != -EINTR) {
+            return rc;
+        }
+        if (Clock::now() >= deadline) {
+            return -ETIMEDOUT;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    rc = CheckPeer(fd);
+
+    HandoffHeader header{};
+    header.magic = kHandoffMagic;
+    header.version = kHandoffVersion;
+    header.mountpoint_length = static_cast<uint32_t>(payload.mountpoint.size());
+    header.init_length = static_cast<uint32_t>(payload.init_request.size());
+    header.state_length = payload.state.size();
+    header.lookup_count = payload.lookups.size();
+    header.open_count = payload.opens.size();
+    header.backing_count = payload.backing.size();
+
+    if (rc == 0) {
+        // Kopf und fd in einer Nachricht, der Rest als Strom
+        struct iovec iov{&header, sizeof(header)};
+        alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+        struct msghdr message{};
+        message.msg_iov = &iov;
+        message.msg_iovlen = 1;
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+        struct cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        std::memcpy(CMSG_DATA(cmsg), &fuse_fd, sizeof(int));
+
+        ssize_t sent;
+        do {
+            sent = sendmsg(fd, &message, MSG_NOSIGNAL);
+        } while (sent < 0 && errno == EINTR);
+        if (sent < 0) {
+            rc = -errno;
+        } else {
+            // Ab hier hält der Empfänger die Verbindung
+            *may_resume = false;
+        }
+        if (sent >= 0 && static_cast<size_t>(sent) < sizeof(header)) {
+            rc = SendAll(fd, reinterpret_cast<const uint8_t*>(&header) + sent, sizeof(header) - sent, deadline);
+        }
+    }
+    if (rc == 0) {
+        rc = SendAll(fd, payload.mountpoint.data(), payload.mountpoint.size(), deadline);
+    }
+    if (rc == 0) {
+        rc = SendAll(fd, payload.init_request.data(), payload.init_request.size(), deadline);
+    }
+    if (rc == 0) {
+        rc = SendAll(fd, payload.state.data(), payload.state.size(), deadline);
+    }
+    if (rc == 0) {
+        rc = SendAll(fd, payload.lookups.data(), payload.lookups.size() * sizeof(HandoffLookup), deadline);
+    }
+    if (rc == 0) {
+        rc = SendAll(fd, payload.opens.data(), payload.opens.size() * sizeof(HandoffOpen), deadline);
+    }
+    if (rc == 0) {
+        rc = SendAll(fd, payload.backing.data(), payload.backing.size() * sizeof(HandoffBacking), deadline);
+    }
+
+    int32_t result = 0;
+    if (rc == 0) {
+        rc = RecvAll(fd, &result, sizeof(result), deadline);
+    }
+    if (rc == 0 && result == 0) {
+        // Commit: danach liest nur noch der Empfänger
+        const int32_t commit = 0;
+        rc = SendAll(fd, &commit, sizeof(commit), deadline);
+    }
+    close(fd);
+    if (rc != 0) {
+        FUSE_LOG_WARN("handoff: sending to %s failed: %s", socket_path.c_str(), std::strerror(-rc));
+        return rc;
+    }
+    if (result != 0) {
+        // Ausdrückliche Absage: der Empfänger bedient die Verbindung nicht
+        *may_resume = true;
+        FUSE_LOG_WARN("handoff: receiver at %s refused: %s", socket_path.c_str(), std::strerror(-result));
+    }
+    return result > 0 ? -result : result;
+}
+
+HandoffReceiver::~HandoffReceiver() {
+    if (conn_fd_ >= 0) {
+        Complete(-ECANCELED);
+    }
+    CloseListener();
+}
+
+void HandoffReceiver::CloseListener() {
+    if (listen_fd_ >= 0) {
+        close(listen_fd_);
+        listen_fd_ = -1;
+    }
+    if (!bound_path_.empty()) {
+        unlink(bound_path_.c_str());
+        bound_path_.clear();
+    }
+}
+
+int HandoffReceiver::Receive(const std::string& socket_path, uint32_t timeout_ms, int* fuse_fd,
+                             HandoffPayload* payload) {
+    *fuse_fd = -1;
+    struct sockaddr_un address;
+    socklen_t address_length = 0;
+    int rc = MakeAddress(socket_path, &address, &address_length);
+    if (rc != 0) {
+        return rc;
+    }
+
+    listen_fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd_ < 0) {
+        return -errno;
+    }
+    if (socket_path[0] != '@') {
+        // Verwaiste Socket-Datei eines früheren Laufs ersetzen, alles andere nicht anfassen
+        struct stat st;
+        if (lstat(socket_path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) {
+            unlink(socket_path.c_str());
+        }
+    }
+    if (bind(listen_fd_, reinterpret_cast<struct sockaddr*>(&address), address_length) != 0 ||
+        listen(listen_fd_, 1) != 0) {
+        rc = -errno;
+        CloseListener();
+        return rc;
+    }
+    if (socket_path[0] != '@') {
+        bound_path_ = socket_path;
+        chmod(socket_path.c_str(), 0600);
+    }
+
+    const auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+    for (;;) {
+        rc = WaitFd(listen_fd_, POLLIN, deadline);
+        if (rc != 0) {
+            CloseListener();
+            return rc;
+        }
+        conn_fd_ = accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (conn_fd_ < 0) {
+            if (errno == EINTR || errno == EAGAIN || errno == ECONNABORTED) {
+                continue;
+            }
+            rc = -errno;
+            CloseListener();
+            return rc;
+        }
+        if (CheckPeer(conn_fd_) == 0) {
+            break;
+        }
+        Complete(-EPERM);
+    }
+    CloseListener();
+
+    // Kopf mit fd
+    HandoffHeader header{};
+    struct iovec iov{&header, sizeof(header)};
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+    struct msghdr message{};
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    rc = WaitFd(conn_fd_, POLLIN, deadline);
+    ssize_t got = -1;
+    if (rc == 0) {
+        do {
+            got = recvmsg(conn_fd_, &message, MSG_CMSG_CLOEXEC);
+        } while (got < 0 && errno == EINTR);
+        rc = got < 0 ? -errno : (got == 0 ? -ECONNRESET : 0);
+    }
+    if (rc == 0) {
+        for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&message); cmsg; cmsg = CMSG_NXTHDR(&message, cmsg)) {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS &&
+                cmsg->cmsg_len == CMSG_LEN(sizeof(int))) {
+                std::memcpy(fuse_fd, CMSG_DATA(cmsg), sizeof(int));
+            }
+        }
+        if (*fuse_fd < 0 || (message.msg_flags & MSG_CTRUNC)) {
+            rc = -EBADMSG;
+        } else if (static_cast<size_t>(got) < sizeof(header)) {
+            rc = RecvAll(conn_fd_, reinterpret_cast<uint8_t*>(&header) + got, sizeof(header) - got, deadline);
+        }
+    }
+    if (rc == 0 && (header.magic != kHandoffMagic || header.version != kHandoffVersion)) {
+        rc = -EPROTO;
+    }
+    if (rc == 0 && (header.mountpoint_length > kMaxMountpointLength || header.init_length > kMaxInitRequestLength ||
+                    header.state_length > kMaxStateLength || header.lookup_count > kMaxLookupCount ||
+                    header.open_count > kMaxHandleCount || header.backing_count > kMaxHandleCount)) {
+        rc = -EMSGSIZE;
+    }
+    if (rc == 0) {
+        payload->mountpoint.resize(header.mountpoint_length);
+        payload->init_request.resize(header.init_length);
+        payload->state.resize(static_cast<size_t>(header.state_length));
+        payload->lookups.resize(static_cast<size_t>(header.lookup_count));
+        payload->opens.resize(static_cast<size_t>(header.open_count));
+        payload->backing.resize(static_cast<size_t>(header.backing_count));
+        rc = RecvAll(conn_fd_, &payload->mountpoint[0], payload->mountpoint.size(), deadline);
+    }
+    if (rc == 0) {
+        rc = RecvAll(conn_fd_, payload->init_request.data(), payload->init_request.size(), deadline);
+    }
+    if (rc == 0) {
+        rc = RecvAll(conn_fd_, payload->state.data(), payload->state.size(), deadline);
+    }
+    if (rc == 0) {
+        rc = RecvAll(conn_fd_, payload->lookups.data(), payload->lookups.size() * sizeof(HandoffLookup), deadline);
+    }
+    if (rc == 0) {
+        rc = RecvAll(conn_fd_, payload->opens.data(), payload->opens.size() * sizeof(HandoffOpen), deadline);
+    }
+    if (rc == 0) {
+        rc = RecvAll(conn_fd_, payload->backing.data(), payload->backing.size() * sizeof(HandoffBacking), deadline);
+    }
+
+    if (rc != 0) {
+        if (*fuse_fd >= 0) {
+            close(*fuse_fd);
+            *fuse_fd = -1;
+        }
+        Complete(rc);
+        return rc;
+    }
+    return 0;
+}
+
+int HandoffReceiver::Complete(int result, uint32_t timeout_ms) {
+    if (conn_fd_ < 0) {
+        return -ENOTCONN;
+    }
+    const auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+    const int32_t value = result;
+    int rc = SendAll(conn_fd_, &value, sizeof(value), deadline);
+    if (rc == 0 && result == 0) {
+        int32_t commit = -1;
+        rc = RecvAll(conn_fd_, &commit, sizeof(commit), deadline);
+        if (rc == 0 && commit != 0) {
+            rc = -EPROTO;
+        }
+    }
+    close(conn_fd_);
+    conn_fd_ = -1;
+    if (rc != 0) {
+        return rc;
+    }
+    return result > 0 ? -result : result;
+}
+
+namespace {
+
+struct HandoffRequest {
+    std::string socket_path;
+    uint32_t timeout_ms = 10000;
+    std::vector<uint8_t> state;
+};
+
+// handle + {socketPath, state?, timeoutMs?}
+SessionManager* ParseHandoffArgs(const Napi::CallbackInfo& info, bool with_state, HandoffRequest* request) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsObject()) {
+        NapiHelpers::ThrowTypeError(env, "Expected session handle and options object");
+        return nullptr;
+    }
+    Napi::Value id = info[0].As<Napi::Object>().Get("id");
+    if (!id.IsNumber()) {
+        NapiHelpers::ThrowTypeError(env, "Invalid session handle");
+        return nullptr;
+    }
+    Napi::Object options = info[1].As<Napi::Object>();
+    Napi::Value path = options.Get("socketPath");
+    if (!path.IsString() || path.As<Napi::String>().Utf8Value().empty()) {
+        NapiHelpers::ThrowTypeError(env, "socketPath must be a non-empty string");
+        return nullptr;
+    }
+    request->socket_path = path.As<Napi::String>().Utf8Value();
+
+    Napi::Value timeout = options.Get("timeoutMs");
+    if (!timeout.IsUndefined()) {
+        if (!timeout.IsNumber() || timeout.As<Napi::Number>().DoubleValue() < 0) {
+            NapiHelpers::ThrowTypeError(env, "timeoutMs must be a non-negative number");
+            return nullptr;
+        }
+        request->timeout_ms = timeout.As<Napi::Number>().Uint32Value();
+    }
+
+    if (with_state) {
+        Napi::Value state = options.Get("state");
+        if (state.IsTypedArray()) {
+            Napi::TypedArray array = state.As<Napi::TypedArray>();
+            const auto* data = static_cast<const uint8_t*>(array.ArrayBuffer().Data()) + array.ByteOffset();
+            request->state.assign(data, data + array.ByteLength());
+        } else if (state.IsArrayBuffer()) {
+            Napi::ArrayBuffer buffer = state.As<Napi::ArrayBuffer>();
+            const auto* data = static_cast<const uint8_t*>(buffer.Data());
+            request->state.assign(data, data + buffer.ByteLength());
+        } else if (!state.IsUndefined()) {
+            NapiHelpers::ThrowTypeError(env, "state must be an ArrayBuffer or TypedArray");
+            return nullptr;
+        }
+    }
+
+    SessionManager* session = FindSession(static_cast<uint64_t>(id.As<Napi::Number>().Int64Value()));
+    if (!session) {
+        NapiHelpers::ThrowErrnoError(env, ENOENT, "Session not found");
+    }
+    return session;
+}
+
+class HandoffWorker : public Napi::AsyncWorker {
+public:
+    HandoffWorker(Napi::Env env, SessionManager* session, HandoffRequest request, bool adopt)
+        : Napi::AsyncWorker(env, adopt ? "fuse-native:adopt" : "fuse-native:handoff"),
+          deferred_(Napi::Promise::Deferred::New(env)),
+          session_(session),
+          request_(std::move(request)),
+          adopt_(adopt) {}
+
+    Napi::Promise Promise() const { return deferred_.Promise(); }
+
+    void Execute() override {
+        if (adopt_) {
+            result_ = session_->Adopt(request_.socket_path, request_.timeout_ms, &request_.state);
+        } else {
+            result_ = session_->Handoff(request_.socket_path, std::move(request_.state), request_.timeout_ms);
+        }
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        if (result_ != 0) {
+            Napi::Error error = NapiHelpers::CreateErrnoError(
+                env, -result_,
+                NapiHelpers::ErrnoToString(-result_) + (adopt_ ? ": session adoption failed" : ": session handoff failed"));
+            // Fehler nach Übergabe des fd: die Session bedient die Verbindung nicht mehr
+            error.Value().Set("handedOff", Napi::Boolean::New(env, !adopt_ && session_->IsHandedOff()));
+            deferred_.Reject(error.Value());
+            return;
+        }
+        if (adopt_ && !request_.state.empty()) {
+            deferred_.Resolve(Napi::Buffer<uint8_t>::Copy(env, request_.state.data(), request_.state.size()));
+            return;
+        }
+        deferred_.Resolve(env.Undefined());
+    }
+
+    void OnError(const Napi::Error& error) override {
+        deferred_.Reject(error.Value());
+    }
+
+private:
+    Napi::Promise::Deferred deferred_;
+    SessionManager* session_;
+    HandoffRequest request_;
+    bool adopt_;
+    int result_ = 0;
+};
+
+} // namespace
+
+Napi::Value HandoffSession(const Napi::CallbackInfo& info) {
+    HandoffRequest request;
+    SessionManager* session = ParseHandoffArgs(info, true, &request);
+    if (!session) {
+        return info.Env().Undefined();
+    }
+    auto* worker = new HandoffWorker(info.Env(), session, std::move(request), false);
+    Napi::Promise promise = worker->Promise();
+    worker->Queue();
+    return promise;
+}
+
+Napi::Value AdoptSession(const Napi::CallbackInfo& info) {
+    HandoffRequest request;
+    SessionManager* session = ParseHandoffArgs(info, false, &request);
+    if (!session) {
+        return info.Env().Undefined();
+    }
+    auto* worker = new HandoffWorker(info.Env(), session, std::move(request), true);
+    Napi::Promise promise = worker->Promise();
+    worker->Queue();
+    return promise;
+}
+
+} // namespace fuse_native
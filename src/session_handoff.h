@@ -0,0 +1,142 @@
+/**
+ * @file session_handoff.h
+ * @brief Hot restart: pass a mounted /dev/fuse connection to another process
+ *
+ * Unmounting for an upgrade breaks every open file in client processes
+ * (ENOTCONN) and discards all caches. Instead, the running process stops
+ * reading /dev/fuse, answers the requests it has already read, and sends
+ * the device fd to its successor over a Unix socket (SCM_RIGHTS). The
+ * kernel connection stays open the whole time; requests issued during the
+ * switch wait in the kernel queue and are served by the new process.
+ *
+ * Besides the fd the message carries the mountpoint, the FUSE_INIT request
+ * the kernel sent at mount time, the kernel lookup counts tracked by the
+ * inode table, the open counts per file handle, the passthrough backing ids
+ * and an opaque application payload. The new process replays
+ * FUSE_INIT into its own libfuse session (the reply is discarded, the kernel
+ * already has one) so libfuse sees the negotiated protocol; the JS init
+ * handler already ran in the first process and is not called again. It then
+ * serves through fuse_session_custom_io.
+ *
+ * Wire format (stream socket, host byte order; both ends are on one host):
+ *   HandoffHeader + fd as SCM_RIGHTS, mountpoint, init request, payload,
+ *   lookup counts, open counts, backing ids, answered by a 4-byte result from the receiver (0 or -errno).
+ *   On 0 the sender replies with a 4-byte commit (0) and stops serving; the
+ *   receiver starts serving only after reading it. Without a commit the
+ *   receiver backs out, and a sender that already passed the fd never
+ *   resumes unless the receiver refused explicitly, so at most one process
+ *   ever reads the connection.
+ */
+
+#ifndef FUSE_NATIVE_SESSION_HANDOFF_H
+#define FUSE_NATIVE_SESSION_HANDOFF_H
+
+#include <napi.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fuse_native {
+
+/**
+ * Kernel references to one inode
+ */
+struct HandoffLookup {
+    uint64_t ino;
+    uint64_t nlookup;
+};
+
+/**
+ * Kernel opens sharing one file handle
+ */
+struct HandoffOpen {
+    uint64_t fh;
+    uint64_t opens;
+};
+
+/**
+ * Passthrough backing id registered for a file handle
+ */
+struct HandoffBacking {
+    uint64_t fh;
+    int64_t backing_id;
+};
+
+/**
+ * Everything besides the fd that the successor needs
+ */
+struct HandoffPayload {
+    std::string mountpoint;
+    std::vector<uint8_t> init_request;  ///< FUSE_INIT as read from /dev/fuse (header + fuse_init_in)
+    std::vector<uint8_t> state;         ///< Opaque application state
+    std::vector<HandoffLookup> lookups; ///< Inode table counts, so FORGETs keep balancing
+    std::vector<HandoffOpen> opens;     ///< Opens per fh, so a release keeps a shared handle's queue
+    std::vector<HandoffBacking> backing; ///< Backing ids, so release still closes them
+};
+
+/**
+ * @brief Connect to @p socket_path, send @p fuse_fd and @p payload, wait for the result and commit
+ *
+ * Retries the connect until the receiver listens or @p timeout_ms passes (-ETIMEDOUT).
+ * The peer must run as the same user (or root).
+ * @param may_resume Set to false once the receiver may serve the connection: after the fd
+ *                   was delivered, only an explicit refusal by the receiver leaves it true
+ * @return 0 once the commit was sent, otherwise -errno (including the receiver's error);
+ *         the fd stays open either way
+ */
+int SendHandoff(const std::string& socket_path, int fuse_fd, const HandoffPayload& payload,
+                uint32_t timeout_ms, bool* may_resume);
+
+/**
+ * Receiving side: listens on a socket path and accepts one handoff
+ */
+class HandoffReceiver {
+public:
+    HandoffReceiver() = default;
+    ~HandoffReceiver();
+
+    HandoffReceiver(const HandoffReceiver&) = delete;
+    HandoffReceiver& operator=(const HandoffReceiver&) = delete;
+
+    /**
+     * @brief Bind @p socket_path (a stale socket file is replaced) and wait for one message
+     * @param fuse_fd Receives the /dev/fuse fd (O_CLOEXEC); owned by the caller on success
+     * @return 0 or -errno
+     */
+    int Receive(const std::string& socket_path, uint32_t timeout_ms, int* fuse_fd, HandoffPayload* payload);
+
+    /**
+     * @brief Report the adoption result to the sender and close the connection
+     *
+     * On success waits up to @p timeout_ms for the sender's commit.
+     * @return 0 if @p result was 0 and the sender committed (start serving),
+     *         otherwise -errno; the receiver must not serve then
+     */
+    int Complete(int result, uint32_t timeout_ms = 1000);
+
+private:
+    int listen_fd_ = -1;
+    int conn_fd_ = -1;
+    std::string bound_path_;  ///< Removed again in the destructor
+
+    void CloseListener();
+};
+
+/**
+ * Hand a mounted session to another process (N-API exposed function)
+ * @param info N-API callback info containing session handle and `{socketPath, state?, timeoutMs?}`
+ * @return Promise resolving once the successor has adopted the session
+ */
+Napi::Value HandoffSession(const Napi::CallbackInfo& info);
+
+/**
+ * Take over a session from a previous process instead of mounting (N-API exposed function)
+ * @param info N-API callback info containing session handle and `{socketPath, timeoutMs?}`
+ * @return Promise resolving to the sender's state Buffer (undefined if none was sent)
+ */
+Napi::Value AdoptSession(const Napi::CallbackInfo& info);
+
+} // namespace fuse_native
+
+#endif // FUSE_NATIVE_SESSION_HANDOFF_H
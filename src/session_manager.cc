@@ -8,21 +8,38 @@
 
 #include "session_manager.h"
 #include "fuse_bridge.h"
+#include "inode_table.h"
 #include "napi_helpers.h"
 #include "errno_mapping.h"
 #include "logging.h"
+#include "notify_bridge.h"
+#include "passthrough.h"
+#include "session_handoff.h"
+#include "shutdown.h"
+#include "trace_probes.h"
+#include "write_queue.h"
+#include <algorithm>
 #include <unordered_map>
 #include <memory>
 #include <thread>
 #include <chrono>
 #include <cstring>
+#include <climits>
 #if defined(_WIN32)
 // TODO: Windows support
 #else
+  #include <fcntl.h>
   #include <poll.h>
+  #include <spawn.h>
+  #include <sys/mount.h>
+  #include <sys/uio.h>
+  #include <sys/wait.h>
+  #include <unistd.h>
 #endif
 #include <errno.h>
 
+extern char** environ;
+
 namespace fuse_native {
 
 /**
@@ -32,6 +49,76 @@ static std::unordered_map<uint64_t, std::unique_ptr<SessionManager>> active_sess
 static std::mutex sessions_mutex;
 static uint64_t next_session_id = 1;
 
+/**
+ * Leading fields of the kernel's struct fuse_in_header (stable ABI; the
+ * libfuse headers do not export fuse_kernel.h)
+ */
+struct KernelInHeader {
+    uint32_t len;
+    uint32_t opcode;
+    uint64_t unique;
+    uint64_t nodeid;
+};
+
+static constexpr uint32_t kFuseInitOpcode = 26;
+
+// Kopf der Anfrage aus dem Empfangspuffer (nur bei Speicherpuffern)
+static bool ReadKernelHeader(const struct fuse_buf& fbuf, size_t length, KernelInHeader* header) {
+    if ((fbuf.flags & FUSE_BUF_IS_FD) || !fbuf.mem || length < sizeof(*header)) {
+        return false;
+    }
+    std::memcpy(header, fbuf.mem, sizeof(*header));
+    return true;
+}
+
+// loop_receive: Kopf der Anfrage aus dem Empfangspuffer
+static void TraceLoopReceive(const struct fuse_buf& fbuf, int res) {
+    KernelInHeader header{};
+    ReadKernelHeader(fbuf, static_cast<size_t>(res), &header);
+    FUSE_PROBE(loop_receive, header.opcode, header.nodeid, static_cast<uint32_t>(res), header.unique);
+}
+
+/**
+ * I/O for adopted connections. Plain syscalls on the received fd, except
+ * that the reply to the replayed FUSE_INIT is dropped: the kernel answered
+ * INIT once, in the previous process. Splice is forwarded so the negotiated
+ * SPLICE_READ capability stays available.
+ */
+static ssize_t HandoffWritev(int fd, struct iovec* iov, int count, void* userdata) {
+    auto* session = static_cast<SessionManager*>(userdata);
+    if (session && session->IsReplayingInit()) {
+        ssize_t length = 0;
+        for (int i = 0; i < count; ++i) {
+            length += static_cast<ssize_t>(iov[i].iov_len);
+        }
+        return length;
+    }
+    return writev(fd, iov, count);
+}
+
+static ssize_t HandoffRead(int fd, void* buf, size_t buf_len, void*) {
+    return read(fd, buf, buf_len);
+}
+
+static ssize_t HandoffSplice(int fdin, off_t* offin, int fdout, off_t* offout, size_t len, unsigned int flags,
+                             void*) {
+    return splice(fdin, offin, fdout, offout, len, flags);
+}
+
+static const struct fuse_custom_io kHandoffIo = {
+    HandoffWritev, HandoffRead, HandoffSplice, HandoffSplice, nullptr,
+};
+
+// Vergleich über realpath, damit "./mnt" und "/abs/mnt" als gleich gelten
+static bool SameMountpoint(const std::string& a, const std::string& b) {
+    char resolved_a[PATH_MAX];
+    char resolved_b[PATH_MAX];
+    if (realpath(a.c_str(), resolved_a) && realpath(b.c_str(), resolved_b)) {
+        return std::strcmp(resolved_a, resolved_b) == 0;
+    }
+    return a == b;
+}
+
 /**
  * SessionManager implementation
  */
@@ -65,6 +152,34 @@ bool SessionManager::IsReady() const {
     return state_ == SessionState::MOUNTED && fuse_session_ != nullptr;
 }
 
+int SessionManager::WithFuseSession(const std::function<int(struct fuse_session*)>& fn) {
+    struct fuse_session* se = nullptr;
+    const int rc = PinFuseSession(&se);
+    if (rc != 0) {
+        return rc;
+    }
+    const int result = fn(se);
+    UnpinFuseSession();
+    return result;
+}
+
+int SessionManager::PinFuseSession(struct fuse_session** se) {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    if (state_ != SessionState::MOUNTED || fuse_session_ == nullptr) {
+        return -ENOTCONN;
+    }
+    pins_++;
+    *se = fuse_session_;
+    return 0;
+}
+
+void SessionManager::UnpinFuseSession() {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    if (--pins_ == 0) {
+        pins_cv_.notify_all();
+    }
+}
+
 bool SessionManager::Initialize() {
     std::lock_guard<std::mutex> lock(state_mutex_);
 
@@ -190,14 +305,232 @@ bool SessionManager::Mount() {
     FUSE_LOG_INFO("SessionManager::Mount - fuse_session_mount succeeded for %s", mountpoint_.c_str());
 
     state_ = SessionState::MOUNTED;
+    StartFuseLoop();
+
+    return true;
+}
 
+void SessionManager::StartFuseLoop() {
     // Start the FUSE loop in a separate thread
     mount_thread_running_ = true;
     mount_thread_ = std::thread([this]() {
         this->RunFuseLoop();
     });
+}
 
-    return true;
+int SessionManager::Handoff(const std::string& socket_path, std::vector<uint8_t> state, uint32_t timeout_ms) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        if (state_ != SessionState::MOUNTED || !fuse_session_ || !bridge_) {
+            return -ENOTCONN;
+        }
+        // fusermount3 -o auto_unmount hängt die Verbindung beim Prozessende ab
+        if (options_.auto_unmount) {
+            FUSE_LOG_WARN("SessionManager::Handoff - autoUnmount sessions cannot be handed off");
+            return -EINVAL;
+        }
+        if (std::this_thread::get_id() == mount_thread_.get_id()) {
+            return -EDEADLK;
+        }
+        // Übergangszustand: Unmount/Mount/Handoff greifen nicht parallel zu
+        state_ = SessionState::UNMOUNTING;
+        mount_thread_running_.store(false, std::memory_order_release);
+    }
+
+    // Loop hält nach spätestens einem poll-Intervall, ohne fuse_session_exit
+    if (mount_thread_.joinable()) {
+        mount_thread_.join();
+    }
+
+    int rc = 0;
+    if (fuse_session_exited(fuse_session_)) {
+        rc = -ENOTCONN;
+    } else if (init_request_.empty()) {
+        rc = -EPROTO;
+    }
+
+    // Bereits gelesene Anfragen beantworten, bevor der Nachfolger liest
+    if (rc == 0 && !WaitForDrain([this] { return bridge_->UnrepliedRequests() == 0; }, deadline)) {
+        FUSE_LOG_WARN("SessionManager::Handoff - %zu requests still unanswered", bridge_->UnrepliedRequests());
+        rc = -ETIMEDOUT;
+    }
+
+    // Bestätigte, noch nicht ausgeführte Writes (Write-behind) zählen nicht als unbeantwortet
+    if (rc == 0) {
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        WriteQueueManager& writes = GetKernelWriteQueueManager();
+        if (!writes.FlushAll(static_cast<uint32_t>(std::max<int64_t>(remaining, 0)))) {
+            FUSE_LOG_WARN("SessionManager::Handoff - acknowledged writes not flushed in time");
+            rc = -ETIMEDOUT;
+        } else if (const int deferred = writes.PeekDeferredError()) {
+            // Der Fehler gehört zum nächsten flush/fsync hier, der Nachfolger kennt ihn nicht
+            FUSE_LOG_WARN("SessionManager::Handoff - acknowledged write failed (%s)", strerror(-deferred));
+            rc = deferred;
+        }
+    }
+
+    bool may_resume = true;
+    if (rc == 0) {
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        HandoffPayload payload{mountpoint_, init_request_, std::move(state), {}, {}, {}};
+        for (const auto& entry : InodeTable::Instance().SnapshotCounts()) {
+            payload.lookups.push_back(HandoffLookup{entry.first, entry.second});
+        }
+        for (const auto& entry : GetKernelWriteQueueManager().SnapshotHandles()) {
+            payload.opens.push_back(HandoffOpen{entry.first, entry.second});
+        }
+        for (const auto& entry : PassthroughRegistry::Instance().SnapshotBackingIds()) {
+            payload.backing.push_back(HandoffBacking{entry.first, entry.second});
+        }
+        rc = SendHandoff(socket_path, fuse_session_fd(fuse_session_), payload,
+                         static_cast<uint32_t>(std::max<int64_t>(remaining, 1)), &may_resume);
+    }
+
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    if (rc != 0 && !may_resume) {
+        // Der Nachfolger hält den fd und liest evtl. schon: nie parallel weiterlesen
+        FUSE_LOG_ERROR("SessionManager::Handoff - %s after the fd was sent, leaving %s to the receiver",
+                       strerror(-rc), mountpoint_.c_str());
+        fuse_session_exit(fuse_session_);
+        handed_off_.store(true, std::memory_order_release);
+        state_ = SessionState::HANDED_OFF;
+        CancelPendingRetrieves(session_id_, -ENOTCONN);
+        return rc;
+    }
+    if (rc != 0) {
+        FUSE_LOG_WARN("SessionManager::Handoff - %s, resuming (%s)", strerror(-rc), mountpoint_.c_str());
+        state_ = SessionState::MOUNTED;
+        if (!fuse_session_exited(fuse_session_)) {
+            StartFuseLoop();
+        }
+        return rc;
+    }
+
+    FUSE_LOG_INFO("SessionManager::Handoff - %s handed off via %s", mountpoint_.c_str(), socket_path.c_str());
+    handed_off_.store(true, std::memory_order_release);
+    state_ = SessionState::HANDED_OFF;
+    CancelPendingRetrieves(session_id_, -ENOTCONN);
+    return 0;
+}
+
+int SessionManager::Adopt(const std::string& socket_path, uint32_t timeout_ms, std::vector<uint8_t>* state) {
+    if (GetState() != SessionState::INITIALIZED || !fuse_session_) {
+        return -EINVAL;
+    }
+
+    HandoffReceiver receiver;
+    HandoffPayload payload;
+    int fd = -1;
+    int rc = receiver.Receive(socket_path, timeout_ms, &fd, &payload);
+    if (rc != 0) {
+        return rc;
+    }
+
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    KernelInHeader header{};
+    struct fuse_buf init_buf = {};
+    init_buf.mem = payload.init_request.data();
+    init_buf.size = payload.init_request.size();
+    if (state_ != SessionState::INITIALIZED) {
+        rc = -EBUSY;
+    } else if (!SameMountpoint(payload.mountpoint, mountpoint_)) {
+        FUSE_LOG_ERROR("SessionManager::Adopt - offered %s, session is for %s", payload.mountpoint.c_str(),
+                       mountpoint_.c_str());
+        rc = -EXDEV;
+    } else if (!ReadKernelHeader(init_buf, init_buf.size, &header) || header.opcode != kFuseInitOpcode ||
+               header.len != init_buf.size) {
+        rc = -EPROTO;
+    }
+    if (rc != 0) {
+        close(fd);
+        receiver.Complete(rc);
+        return rc;
+    }
+
+    // Ab hier gehört fd der Session (fuse_session_destroy schließt ihn)
+    rc = fuse_session_custom_io(fuse_session_, &kHandoffIo, fd);
+    if (rc != 0) {
+        close(fd);
+        receiver.Complete(rc < 0 ? rc : -EIO);
+        return rc < 0 ? rc : -EIO;
+    }
+
+    // INIT erneut durch libfuse (nicht an JS), die Antwort verwirft HandoffWritev
+    std::vector<uint8_t> init_copy = payload.init_request;
+    init_buf.mem = init_copy.data();
+    replaying_init_.store(true, std::memory_order_release);
+    fuse_session_process_buf(fuse_session_, &init_buf);
+    replaying_init_.store(false, std::memory_order_release);
+    if (fuse_session_exited(fuse_session_)) {
+        FUSE_LOG_ERROR("SessionManager::Adopt - replayed FUSE_INIT was rejected");
+        receiver.Complete(-EPROTO);
+        return -EPROTO;
+    }
+
+    // Erst nach dem Commit des Senders lesen, sonst bedienen zwei Prozesse die Verbindung
+    rc = receiver.Complete(0, timeout_ms);
+    if (rc != 0) {
+        FUSE_LOG_ERROR("SessionManager::Adopt - sender did not commit (%s), not serving %s", strerror(-rc),
+                       mountpoint_.c_str());
+        fuse_session_exit(fuse_session_);
+        state_ = SessionState::UNMOUNTED;
+        return rc;
+    }
+    // Lookup-Zähler des Vorgängers, sonst laufen spätere FORGETs ins Leere
+    std::vector<std::pair<fuse_ino_t, uint64_t>> lookups;
+    lookups.reserve(payload.lookups.size());
+    for (const HandoffLookup& lookup : payload.lookups) {
+        lookups.emplace_back(static_cast<fuse_ino_t>(lookup.ino), lookup.nlookup);
+    }
+    InodeTable::Instance().RestoreCounts(lookups);
+    // Offene Handles: geteilte fh behalten ihre Queue, Backing-IDs werden bei release geschlossen
+    std::vector<std::pair<uint64_t, uint32_t>> opens;
+    opens.reserve(payload.opens.size());
+    for (const HandoffOpen& open : payload.opens) {
+        opens.emplace_back(open.fh, static_cast<uint32_t>(std::min<uint64_t>(open.opens, UINT32_MAX)));
+    }
+    GetKernelWriteQueueManager().RestoreHandles(opens);
+    std::vector<std::pair<uint64_t, int>> backing;
+    backing.reserve(payload.backing.size());
+    for (const HandoffBacking& entry : payload.backing) {
+        if (entry.backing_id > 0 && entry.backing_id <= INT_MAX) {
+            backing.emplace_back(entry.fh, static_cast<int>(entry.backing_id));
+        }
+    }
+    PassthroughRegistry::Instance().RestoreBackingIds(backing);
+    if (options_.install_signal_handlers && fuse_set_signal_handlers(fuse_session_) != 0) {
+        FUSE_LOG_WARN("SessionManager::Adopt - fuse_set_signal_handlers failed (continuing)");
+    }
+    init_request_ = std::move(payload.init_request);
+    *state = std::move(payload.state);
+    adopted_ = true;
+    state_ = SessionState::MOUNTED;
+    StartFuseLoop();
+    FUSE_LOG_INFO("SessionManager::Adopt - serving %s from handed-off connection", mountpoint_.c_str());
+    return 0;
+}
+
+void SessionManager::UnmountAdopted() {
+    if (umount2(mountpoint_.c_str(), MNT_DETACH) == 0) {
+        return;
+    }
+    if (errno != EPERM) {
+        FUSE_LOG_WARN("SessionManager::UnmountAdopted - umount2 %s: %s", mountpoint_.c_str(), strerror(errno));
+        return;
+    }
+    // Ohne CAP_SYS_ADMIN wie libfuse über fusermount3
+    const char* argv[] = {"fusermount3", "-u", "-z", "--", mountpoint_.c_str(), nullptr};
+    pid_t pid = 0;
+    if (posix_spawnp(&pid, "fusermount3", nullptr, nullptr, const_cast<char* const*>(argv), environ) != 0) {
+        FUSE_LOG_WARN("SessionManager::UnmountAdopted - cannot run fusermount3 for %s", mountpoint_.c_str());
+        return;
+    }
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+    }
 }
 
 bool SessionManager::Unmount() {
@@ -205,12 +538,21 @@ bool SessionManager::Unmount() {
   {
     std::lock_guard<std::mutex> lock(state_mutex_);
 
+    // Handoff läuft oder ist erfolgt: die Verbindung gehört nicht (mehr) uns
+    if (state_ == SessionState::UNMOUNTING || state_ == SessionState::HANDED_OFF) {
+      return false;
+    }
+
     if (state_ == SessionState::MOUNTED) {
       if (fuse_session_) {
         // Robuster: erst Loop beenden, dann unmounten
         mount_thread_running_.store(false, std::memory_order_release);
         fuse_session_exit(fuse_session_);     // signalisiert der Loop zu enden
-        fuse_session_unmount(fuse_session_);  // unmount
+        if (adopted_) {
+          UnmountAdopted();                   // libfuse kennt den Mountpoint nicht
+        } else {
+          fuse_session_unmount(fuse_session_);  // unmount
+        }
      }
       state_ = SessionState::INITIALIZED;
     }
@@ -228,6 +570,9 @@ bool SessionManager::Unmount() {
     mount_thread_.join();
   }
 
+  // Loop steht – auf notify_retrieve kommt keine Antwort mehr
+  CancelPendingRetrieves(session_id_, -ENOTCONN);
+
   return true;
 }
 
@@ -237,7 +582,9 @@ void SessionManager::Destroy() {
         Unmount();
     }
 
-    std::lock_guard<std::mutex> lock(state_mutex_);
+    std::unique_lock<std::mutex> lock(state_mutex_);
+    // Laufende Notifies halten die Session noch (WithMountedSession)
+    pins_cv_.wait(lock, [this] { return pins_ == 0; });
     fuse_remove_signal_handlers(fuse_session_);
     // Clean up FUSE session
     if (fuse_session_) {
@@ -307,6 +654,17 @@ void SessionManager::RunFuseLoop() {
           FUSE_LOG_WARN("SessionManager::RunFuseLoop - poll revents=0x%x (unexpected)", pfd.revents);
         }
 
+        if (FUSE_PROBE_ACTIVE(loop_receive)) {
+            TraceLoopReceive(fbuf, res);
+        }
+        // FUSE_INIT für einen späteren Handoff aufheben
+        if (init_request_.empty()) {
+            KernelInHeader header{};
+            if (ReadKernelHeader(fbuf, static_cast<size_t>(res), &header) && header.opcode == kFuseInitOpcode) {
+                const auto* bytes = static_cast<const uint8_t*>(fbuf.mem);
+                init_request_.assign(bytes, bytes + res);
+            }
+        }
         fuse_session_process_buf(fuse_session_, &fbuf);
         // libfuse hat allokiert → wir geben frei
         if (fbuf.mem) {
@@ -373,6 +731,15 @@ Napi::Value CreateSession(const Napi::CallbackInfo& info) {
           options_obj.Has("installSignalHandlers") &&
           options_obj.Get("installSignalHandlers").As<Napi::Boolean>().Value();
 
+    // TS übergibt die Session-Optionen verschachtelt unter "options"
+    Napi::Object nested = options_obj.Has("options") && options_obj.Get("options").IsObject()
+                              ? options_obj.Get("options").As<Napi::Object>()
+                              : options_obj;
+    options.passthrough = (options_obj.Get("passthrough").IsBoolean() &&
+                           options_obj.Get("passthrough").As<Napi::Boolean>().Value()) ||
+                          (nested.Get("passthrough").IsBoolean() &&
+                           nested.Get("passthrough").As<Napi::Boolean>().Value());
+
     if (options_obj.Has("maxRead")) {
         options.max_read = options_obj.Get("maxRead").As<Napi::Number>().Uint32Value();
     } else {
@@ -590,4 +957,44 @@ Napi::Value IsReady(const Napi::CallbackInfo& info) {
     return Napi::Boolean::New(env, false);
 }
 
+SessionManager* FindSession(uint64_t session_id) {
+    std::lock_guard<std::mutex> lock(sessions_mutex);
+    auto it = active_sessions.find(session_id);
+    return it != active_sessions.end() ? it->second.get() : nullptr;
+}
+
+size_t CountUnrepliedRequests() {
+    std::lock_guard<std::mutex> lock(sessions_mutex);
+    size_t total = 0;
+    for (const auto& entry : active_sessions) {
+        if (FuseBridge* bridge = entry.second->GetBridge()) {
+            total += bridge->UnrepliedRequests();
+        }
+    }
+    return total;
+}
+
+int WithMountedSession(uint64_t session_id, const std::function<int(struct fuse_session*)>& fn) {
+    SessionManager* mgr = nullptr;
+    struct fuse_session* se = nullptr;
+    {
+        // Pin unter dem Registry-Lock: Destroy wartet darauf, bevor die Session verschwindet
+        std::lock_guard<std::mutex> lock(sessions_mutex);
+        auto it = active_sessions.find(session_id);
+        if (it == active_sessions.end()) {
+            return -ENOENT;
+        }
+        const int rc = it->second->PinFuseSession(&se);
+        if (rc != 0) {
+            return rc;
+        }
+        mgr = it->second.get();
+    }
+
+    // Ohne Lock: der Kernel kann hier auf eine Antwort aus JS warten
+    const int result = fn(se);
+    mgr->UnpinFuseSession();
+    return result;
+}
+
 } // namespace fuse_native
@@ -17,6 +17,9 @@
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <vector>
 
 namespace fuse_native {
 
@@ -32,6 +35,7 @@ enum class SessionState {
     MOUNTED,      // Session mounted and running
     UNMOUNTING,   // Session in process of unmounting
     UNMOUNTED,    // Session unmounted but not destroyed
+    HANDED_OFF,   // /dev/fuse connection passed to another process (still mounted)
     DESTROYED     // Session destroyed and cleaned up
 };
 
@@ -49,6 +53,7 @@ struct SessionOptions {
     uint32_t max_write = 131072;     // Maximum write size (128KB)
     double timeout = 1.0;            // Default timeout
     bool install_signal_handlers = true;
+    bool passthrough = false;        // Request FUSE passthrough (backing files)
 };
 
 /**
@@ -90,6 +95,12 @@ public:
      */
     std::string GetMountpoint() const;
 
+    /**
+     * Get session options
+     * @return Options the session was created with
+     */
+    const SessionOptions& GetOptions() const { return options_; }
+
     /**
      * Get current session state
      * @return Current state
@@ -131,6 +142,64 @@ public:
      */
     FuseBridge* GetBridge() const { return bridge_.get(); }
 
+    /**
+     * Run a callback against the mounted fuse_session
+     *
+     * The session is pinned (see PinFuseSession) but no lock is held while
+     * @p fn runs, so it may block in the kernel. Must not be called from the
+     * FUSE loop thread.
+     * @param fn Callback receiving the session, returns 0 or negative errno
+     * @return Callback result, or -ENOTCONN if the session is not mounted
+     */
+    int WithFuseSession(const std::function<int(struct fuse_session*)>& fn);
+
+    /**
+     * Take a reference on the mounted fuse_session
+     *
+     * Destroy() waits until every pin is released before it frees the
+     * fuse_session, and with it this object. Unmounting is not delayed; calls
+     * on an unmounted but pinned session fail in the kernel (ENODEV).
+     * @param se Receives the session
+     * @return 0, or -ENOTCONN if the session is not mounted
+     */
+    int PinFuseSession(struct fuse_session** se);
+
+    /**
+     * Release a reference taken with PinFuseSession()
+     */
+    void UnpinFuseSession();
+
+    /**
+     * Hand the mounted connection to another process (see session_handoff.h)
+     *
+     * Stops reading /dev/fuse, waits until every request already read has
+     * been answered and sends the fd to the process listening on
+     * @p socket_path. On failure the loop is resumed and the session keeps
+     * serving. On success the session is HANDED_OFF and Destroy() leaves
+     * the mount in place. Must not be called from the JS thread, which has
+     * to answer the outstanding requests.
+     * @return 0 or negative errno (-EINVAL for autoUnmount sessions,
+     *         -ETIMEDOUT if requests did not drain in time)
+     */
+    int Handoff(const std::string& socket_path, std::vector<uint8_t> state, uint32_t timeout_ms);
+
+    /**
+     * Take over a connection from a previous process instead of mounting
+     * @param state Receives the application state sent by the previous process
+     * @return 0 or negative errno; the session stays INITIALIZED on failure
+     */
+    int Adopt(const std::string& socket_path, uint32_t timeout_ms, std::vector<uint8_t>* state);
+
+    /**
+     * True once the connection belongs to another process (lock-free, used from FUSE callbacks)
+     */
+    bool IsHandedOff() const { return handed_off_.load(std::memory_order_acquire); }
+
+    /**
+     * True while a replayed FUSE_INIT is processed; its reply must not reach the kernel
+     */
+    bool IsReplayingInit() const { return replaying_init_.load(std::memory_order_acquire); }
+
 private:
     // Session configuration
     const std::string mountpoint_;
@@ -140,6 +209,8 @@ private:
     // Session state
     mutable std::mutex state_mutex_;
     SessionState state_;
+    std::condition_variable pins_cv_;  // signalled when pins_ drops to 0
+    uint32_t pins_ = 0;                // guarded by state_mutex_
 
     // FUSE components
     napi_env env_;
@@ -151,10 +222,26 @@ private:
     std::thread mount_thread_;
     std::atomic<bool> mount_thread_running_{false};
 
+    // Hot restart
+    std::vector<uint8_t> init_request_;  // FUSE_INIT as received from the kernel (loop thread only while running)
+    std::atomic<bool> handed_off_{false};
+    std::atomic<bool> replaying_init_{false};
+    bool adopted_ = false;               // Connection came from SCM_RIGHTS, no libfuse mount state
+
     /**
      * Main FUSE loop (runs in separate thread)
      */
     void RunFuseLoop();
+
+    /**
+     * Start the loop thread (state_mutex_ held, state MOUNTED)
+     */
+    void StartFuseLoop();
+
+    /**
+     * Detach the mount of an adopted session (libfuse does not know the mountpoint)
+     */
+    void UnmountAdopted();
 };
 
 /**
@@ -196,6 +283,32 @@ Napi::Value Unmount(const Napi::CallbackInfo& info);
  */
 Napi::Value IsReady(const Napi::CallbackInfo& info);
 
+/**
+ * Run a callback against the mounted fuse_session of a registered session
+ *
+ * The session is pinned under the registry lock and @p fn runs without any
+ * lock held: kernel notifications can block until a request on the mount is
+ * answered, and that answer may need the JS thread.
+ * @param session_id Session ID from the session handle
+ * @param fn Callback receiving the session, returns 0 or negative errno
+ * @return Callback result, -ENOENT for unknown sessions, -ENOTCONN if not mounted
+ */
+int WithMountedSession(uint64_t session_id, const std::function<int(struct fuse_session*)>& fn);
+
+/**
+ * Look up a registered session
+ *
+ * Like the N-API mount functions this returns the raw pointer without
+ * holding the registry lock; callers must not race DestroySession.
+ * @return Session or nullptr
+ */
+SessionManager* FindSession(uint64_t session_id);
+
+/**
+ * Requests read from /dev/fuse that no session has answered yet (shutdown drain)
+ */
+size_t CountUnrepliedRequests();
+
 // SessionManager namespace removed to avoid naming conflicts
 // Functions are exposed directly from the main namespace
 
@@ -9,10 +9,13 @@
 
 #include "shutdown.h"
 #include "napi_helpers.h"
+#include "session_manager.h"
 #include "tsfn_dispatcher.h"
 #include "write_queue.h"
 #include <fuse3/fuse.h>
 #include <algorithm>
+#include <stdexcept>
+#include <system_error>
 #include <thread>
 #include <csignal>
 #include <cstring>
@@ -38,6 +41,145 @@ static std::unordered_map<uint64_t, struct fuse_session*> registered_fuse_sessio
 static ShutdownManager* signal_shutdown_manager_ = nullptr;
 static std::mutex signal_handler_mutex_;
 
+/**
+ * Drain wakeups (NotifyDrainProgress / WaitForDrain)
+ */
+static std::mutex drain_mutex_;
+static std::condition_variable drain_cv_;
+static std::atomic<int> drain_waiters_{0};
+static uint64_t drain_generation_ = 0;  // guarded by drain_mutex_
+
+// Rückfall für Bedingungen, deren Besitzer nicht benachrichtigen
+static constexpr auto kDrainRecheck = std::chrono::milliseconds(50);
+
+// Nachlauf für Tasks, die ihre Deadline knapp verpassen
+static constexpr auto kTaskGrace = std::chrono::milliseconds(100);
+
+static uint32_t RemainingMs(std::chrono::steady_clock::time_point deadline) {
+    const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadline - std::chrono::steady_clock::now()).count();
+    return static_cast<uint32_t>(std::max<int64_t>(left, 1));
+}
+
+static std::chrono::microseconds ElapsedUs(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - since);
+}
+
+/**
+ * Tasks of one phase and their results
+ */
+struct TaskBatch {
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t pending = 0;
+    std::vector<ShutdownTaskMetrics> results;
+};
+
+/**
+ * Batches whose tasks outlived their phase (guarded by lingering_mutex_)
+ */
+static std::mutex lingering_mutex_;
+static std::vector<std::shared_ptr<TaskBatch>> lingering_batches_;
+
+/**
+ * Waits for tasks left running by earlier phases. They may still use the
+ * dispatcher or write queues through raw pointers, so nothing may release
+ * those before they are done.
+ * @return false if some are still running at the deadline
+ */
+static bool JoinLingeringTasks(std::chrono::steady_clock::time_point deadline) {
+    std::vector<std::shared_ptr<TaskBatch>> batches;
+    {
+        std::lock_guard<std::mutex> lock(lingering_mutex_);
+        batches.swap(lingering_batches_);
+    }
+
+    bool joined = true;
+    std::vector<std::shared_ptr<TaskBatch>> still_running;
+    for (auto& batch : batches) {
+        std::unique_lock<std::mutex> lock(batch->mutex);
+        if (!batch->cv.wait_until(lock, deadline, [&batch] { return batch->pending == 0; })) {
+            joined = false;
+            still_running.push_back(batch);
+        }
+    }
+    if (!still_running.empty()) {
+        std::lock_guard<std::mutex> lock(lingering_mutex_);
+        lingering_batches_.insert(lingering_batches_.end(), still_running.begin(), still_running.end());
+    }
+    return joined;
+}
+
+/**
+ * Runs the tasks of one phase on their own threads and waits for all of them
+ * or the deadline. Threads still running at the deadline are left detached
+ * and recorded; the next phase joins them before it starts.
+ */
+static bool RunPhaseTasks(const std::vector<std::pair<std::string, ShutdownTask>>& tasks,
+                          std::chrono::steady_clock::time_point deadline,
+                          std::vector<ShutdownTaskMetrics>* results) {
+    auto batch = std::make_shared<TaskBatch>();
+    batch->pending = tasks.size();
+    batch->results.resize(tasks.size());
+    const auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        batch->results[i].name = tasks[i].first;
+        batch->results[i].timed_out = true;
+        auto run = [batch, i, task = tasks[i].second, deadline]() {
+            const auto task_start = std::chrono::steady_clock::now();
+            bool ok = false;
+            try {
+                ok = task(deadline);
+            } catch (const std::exception& e) {
+                ok = false;
+            }
+            std::lock_guard<std::mutex> lock(batch->mutex);
+            auto& result = batch->results[i];
+            result.duration = ElapsedUs(task_start);
+            result.success = ok;
+            result.timed_out = false;
+            if (--batch->pending == 0) {
+                batch->cv.notify_all();
+            }
+        };
+        try {
+            std::thread(run).detach();
+        } catch (const std::system_error& e) {
+            run();  // Kein Thread verfügbar: seriell weiter
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    batch->cv.wait_until(lock, deadline + kTaskGrace, [&batch] { return batch->pending == 0; });
+    if (batch->pending > 0) {
+        std::lock_guard<std::mutex> lingering_lock(lingering_mutex_);
+        lingering_batches_.push_back(batch);
+    }
+
+    bool all_succeeded = true;
+    for (auto& result : batch->results) {
+        if (result.timed_out) {
+            result.duration = ElapsedUs(start);
+        }
+        all_succeeded = all_succeeded && result.success;
+    }
+    *results = batch->results;
+    return all_succeeded;
+}
+
+/**
+ * Dispatcher and write queues are independent and are released in parallel
+ */
+static void AddReleaseTasks(ShutdownPhase* phase) {
+    phase->tasks.emplace_back("dispatcher", [](std::chrono::steady_clock::time_point deadline) {
+        return ShutdownGlobalDispatcher(std::min<uint32_t>(5000, RemainingMs(deadline)));
+    });
+    phase->tasks.emplace_back("write-queues", [](std::chrono::steady_clock::time_point deadline) {
+        return ShutdownGlobalWriteQueueManager(std::min<uint32_t>(3000, RemainingMs(deadline)));
+    });
+}
+
 /**
  * ShutdownManager implementation
  */
@@ -228,6 +370,48 @@ void ShutdownManager::RegisterPhaseCompletionCheck(ShutdownState state, std::fun
     }
 }
 
+void ShutdownManager::SetHandoff(uint64_t session_id, const std::string& socket_path, std::vector<uint8_t> state) {
+    std::lock_guard<std::mutex> lock(handoff_mutex_);
+    handoff_configured_ = true;
+    handoff_session_id_ = session_id;
+    handoff_socket_path_ = socket_path;
+    handoff_state_ = std::move(state);
+}
+
+void ShutdownManager::ClearHandoff() {
+    std::lock_guard<std::mutex> lock(handoff_mutex_);
+    handoff_configured_ = false;
+    handoff_socket_path_.clear();
+    handoff_state_.clear();
+}
+
+bool ShutdownManager::HasHandoff() const {
+    std::lock_guard<std::mutex> lock(handoff_mutex_);
+    return handoff_configured_;
+}
+
+void ShutdownManager::RunHandoff(std::chrono::milliseconds timeout) {
+    uint64_t session_id;
+    std::string socket_path;
+    std::vector<uint8_t> state;
+    {
+        std::lock_guard<std::mutex> lock(handoff_mutex_);
+        session_id = handoff_session_id_;
+        socket_path = handoff_socket_path_;
+        state = handoff_state_;
+    }
+
+    SessionManager* session = FindSession(session_id);
+    if (!session) {
+        throw std::runtime_error("handoff session not found");
+    }
+    // Läuft im Shutdown-Thread, der JS-Thread beantwortet derweil die offenen Anfragen
+    const int rc = session->Handoff(socket_path, std::move(state), static_cast<uint32_t>(timeout.count()));
+    if (rc != 0) {
+        throw std::runtime_error(std::string("handoff failed: ") + strerror(-rc));
+    }
+}
+
 void ShutdownManager::InstallSignalHandlers() {
     if (signal_handlers_installed_) {
         return;
@@ -286,6 +470,8 @@ void ShutdownManager::ExecuteShutdown(const std::string& reason, uint32_t timeou
     {
         std::lock_guard<std::mutex> lock(stats_mutex_);
         stats_.shutdown_start = std::chrono::steady_clock::now();
+        stats_.phase_durations.clear();
+        stats_.phase_metrics.clear();
     }
     
     // Notify callbacks about shutdown begin
@@ -301,7 +487,14 @@ void ShutdownManager::ExecuteShutdown(const std::string& reason, uint32_t timeou
     {
         std::lock_guard<std::mutex> lock(phases_mutex_);
         
+        const bool handoff = HasHandoff();
         for (const auto& phase : shutdown_phases_) {
+            // Handoff ersetzt das Unmounten
+            if ((phase->state == ShutdownState::HANDING_OFF && !handoff) ||
+                (phase->state == ShutdownState::UNMOUNTING && handoff)) {
+                continue;
+            }
+
             auto elapsed = std::chrono::steady_clock::now() - total_start;
             if (elapsed >= total_timeout) {
                 all_phases_succeeded = false;
@@ -325,16 +518,16 @@ void ShutdownManager::ExecuteShutdown(const std::string& reason, uint32_t timeou
             });
             
             // Execute phase
-            bool phase_success = ExecutePhase(*phase);
+            ShutdownPhaseMetrics metrics;
+            bool phase_success = ExecutePhase(*phase, &metrics);
             
             // Record phase duration
-            auto phase_end = std::chrono::steady_clock::now();
-            auto phase_duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-                phase_end - phase->start_time);
+            auto phase_duration = std::chrono::duration_cast<std::chrono::milliseconds>(metrics.duration);
             
             {
                 std::lock_guard<std::mutex> stats_lock(stats_mutex_);
                 stats_.phase_durations.emplace_back(phase->state, phase_duration);
+                stats_.phase_metrics.push_back(std::move(metrics));
             }
             
             if (!phase_success) {
@@ -346,7 +539,10 @@ void ShutdownManager::ExecuteShutdown(const std::string& reason, uint32_t timeou
                     callback.OnShutdownFailed(phase->state, failure_reason);
                 });
                 
-                break;
+                // Ein zu langsamer Drain soll das Unmounten nicht verhindern
+                if (!phase->best_effort) {
+                    break;
+                }
             }
         }
     }
@@ -375,33 +571,42 @@ void ShutdownManager::ExecuteShutdown(const std::string& reason, uint32_t timeou
     shutdown_in_progress_ = false;
 }
 
-bool ShutdownManager::ExecutePhase(const ShutdownPhase& phase) {
+bool ShutdownManager::ExecutePhase(const ShutdownPhase& phase, ShutdownPhaseMetrics* metrics) {
     auto start_time = std::chrono::steady_clock::now();
+    const auto deadline = start_time + phase.timeout;
+    metrics->state = phase.state;
+    metrics->description = phase.description;
+    
+    bool success = true;
+    
+    // Nachzügler des Drains zuerst: Release-Tasks würden ihnen Dispatcher und Queues wegziehen
+    if (!JoinLingeringTasks(deadline)) {
+        success = false;
+    }
     
     // Execute cleanup action if provided
-    if (phase.cleanup_action) {
+    if (success && phase.cleanup_action) {
         try {
             phase.cleanup_action();
         } catch (const std::exception& e) {
-            return false;
+            success = false;
         }
     }
     
-    // Wait for completion check if provided
-    if (phase.completion_check) {
-        while (std::chrono::steady_clock::now() - start_time < phase.timeout) {
-            if (phase.completion_check()) {
-                return true; // Phase completed successfully
-            }
-            
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        }
-        
-        return false; // Timeout
+    // Unabhängige Subsysteme parallel leeren
+    if (success && !phase.tasks.empty()) {
+        success = RunPhaseTasks(phase.tasks, deadline, &metrics->tasks);
     }
     
-    // If no completion check, just execute cleanup and return success
-    return true;
+    // Wait for completion check if provided (woken by NotifyDrainProgress)
+    if (success && phase.completion_check) {
+        success = WaitForDrain(phase.completion_check, deadline);
+    }
+    
+    metrics->duration = ElapsedUs(start_time);
+    metrics->success = success;
+    metrics->timed_out = !success && std::chrono::steady_clock::now() >= deadline;
+    return success;
 }
 
 void ShutdownManager::TransitionState(ShutdownState new_state) {
@@ -450,15 +655,32 @@ void ShutdownManager::InitializeDefaultPhases() {
         std::chrono::milliseconds(5000)
     );
     
-    draining_phase->cleanup_action = []() {
-        // Flush all write queues
+    draining_phase->best_effort = true;
+    
+    draining_phase->tasks.emplace_back("write-queues", [](std::chrono::steady_clock::time_point deadline) {
         auto write_queue_manager = GetGlobalWriteQueueManager();
-        if (write_queue_manager) {
-            write_queue_manager->FlushAll(5000);
-        }
-    };
+        return !write_queue_manager || write_queue_manager->FlushAll(RemainingMs(deadline));
+    });
+    
+    // Per Write-behind bestätigte Kernel-Writes
+    draining_phase->tasks.emplace_back("kernel-write-queues", [](std::chrono::steady_clock::time_point deadline) {
+        return GetKernelWriteQueueManager().FlushAll(RemainingMs(deadline));
+    });
+    
+    draining_phase->tasks.emplace_back("dispatcher", [](std::chrono::steady_clock::time_point deadline) {
+        auto dispatcher = GetGlobalDispatcher();
+        return !dispatcher || dispatcher->WaitForAllCompletion(RemainingMs(deadline));
+    });
+    
+    // Vom Kernel gelesene, noch unbeantwortete Anfragen
+    draining_phase->tasks.emplace_back("fuse-requests", [](std::chrono::steady_clock::time_point deadline) {
+        return WaitForDrain([] { return CountUnrepliedRequests() == 0; }, deadline);
+    });
     
     draining_phase->completion_check = []() {
+        if (GetKernelWriteQueueManager().GetAggregateStats().queue_size != 0) {
+            return false;
+        }
         auto write_queue_manager = GetGlobalWriteQueueManager();
         if (write_queue_manager) {
             auto stats = write_queue_manager->GetAggregateStats();
@@ -469,6 +691,21 @@ void ShutdownManager::InitializeDefaultPhases() {
     
     shutdown_phases_.push_back(std::move(draining_phase));
     
+    // Phase 2a: HANDING_OFF - pass sessions to a successor (only with SetHandoff)
+    auto handoff_phase = std::make_unique<ShutdownPhase>(
+        ShutdownState::HANDING_OFF,
+        "Handing off FUSE session",
+        std::chrono::milliseconds(10000)
+    );
+    
+    const ShutdownPhase* handoff_phase_ptr = handoff_phase.get();
+    handoff_phase->cleanup_action = [this, handoff_phase_ptr]() {
+        RunHandoff(handoff_phase_ptr->timeout);
+    };
+    AddReleaseTasks(handoff_phase.get());
+    
+    shutdown_phases_.push_back(std::move(handoff_phase));
+    
     // Phase 2: UNMOUNTING - unmount FUSE sessions
     auto unmounting_phase = std::make_unique<ShutdownPhase>(
         ShutdownState::UNMOUNTING, 
@@ -479,13 +716,8 @@ void ShutdownManager::InitializeDefaultPhases() {
     unmounting_phase->cleanup_action = []() {
         // Signal all FUSE sessions to exit
         SignalAllFuseSessions();
-        
-        // Shutdown dispatcher
-        ShutdownGlobalDispatcher(5000);
-        
-        // Shutdown write queue manager
-        ShutdownGlobalWriteQueueManager(3000);
     };
+    AddReleaseTasks(unmounting_phase.get());
     
     unmounting_phase->completion_check = []() {
         // Check if all FUSE sessions have exited
@@ -505,6 +737,48 @@ void ShutdownManager::CleanupExpiredCallbacks() {
     );
 }
 
+/**
+ * Drain wakeups
+ */
+void NotifyDrainProgress() {
+    // Gegenstück zum Zaun in WaitForDrain: Zähleränderung vor dem Lesen der Wartenden
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (drain_waiters_.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(drain_mutex_);
+        ++drain_generation_;
+    }
+    drain_cv_.notify_all();
+}
+
+bool WaitForDrain(const std::function<bool()>& done, std::chrono::steady_clock::time_point deadline) {
+    drain_waiters_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    
+    bool result = false;
+    for (;;) {
+        uint64_t generation;
+        {
+            std::lock_guard<std::mutex> lock(drain_mutex_);
+            generation = drain_generation_;
+        }
+        // Prüfung ohne Lock, sie darf selbst blockieren
+        result = done();
+        const auto now = std::chrono::steady_clock::now();
+        if (result || now >= deadline) {
+            break;
+        }
+        std::unique_lock<std::mutex> lock(drain_mutex_);
+        drain_cv_.wait_until(lock, std::min(deadline, now + kDrainRecheck),
+                             [generation] { return drain_generation_ != generation; });
+    }
+    
+    drain_waiters_.fetch_sub(1, std::memory_order_relaxed);
+    return result;
+}
+
 /**
  * FUSE session registry functions
  */
@@ -707,11 +981,36 @@ Napi::Value GetShutdownStats(const Napi::CallbackInfo& info) {
     }
     result.Set("phaseDurations", phases);
     
+    // Per-phase metrics with task breakdown
+    Napi::Array phase_metrics = Napi::Array::New(env, stats.phase_metrics.size());
+    for (size_t i = 0; i < stats.phase_metrics.size(); ++i) {
+        const ShutdownPhaseMetrics& metrics = stats.phase_metrics[i];
+        Napi::Object phase = Napi::Object::New(env);
+        phase.Set("state", Napi::Number::New(env, static_cast<int>(metrics.state)));
+        phase.Set("description", Napi::String::New(env, metrics.description));
+        phase.Set("durationUs", Napi::Number::New(env, static_cast<double>(metrics.duration.count())));
+        phase.Set("success", Napi::Boolean::New(env, metrics.success));
+        phase.Set("timedOut", Napi::Boolean::New(env, metrics.timed_out));
+        Napi::Array tasks = Napi::Array::New(env, metrics.tasks.size());
+        for (size_t j = 0; j < metrics.tasks.size(); ++j) {
+            Napi::Object task = Napi::Object::New(env);
+            task.Set("name", Napi::String::New(env, metrics.tasks[j].name));
+            task.Set("durationUs", Napi::Number::New(env, static_cast<double>(metrics.tasks[j].duration.count())));
+            task.Set("success", Napi::Boolean::New(env, metrics.tasks[j].success));
+            task.Set("timedOut", Napi::Boolean::New(env, metrics.tasks[j].timed_out));
+            tasks.Set(j, task);
+        }
+        phase.Set("tasks", tasks);
+        phase_metrics.Set(i, phase);
+    }
+    result.Set("phases", phase_metrics);
+    
     // Add total duration if shutdown completed
     if (stats.shutdown_end > stats.shutdown_start) {
-        auto total_duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        auto total_duration = std::chrono::duration_cast<std::chrono::microseconds>(
             stats.shutdown_end - stats.shutdown_start);
-        result.Set("totalDurationMs", Napi::Number::New(env, static_cast<double>(total_duration.count())));
+        result.Set("totalDurationMs", Napi::Number::New(env, static_cast<double>(total_duration.count() / 1000)));
+        result.Set("totalDurationUs", Napi::Number::New(env, static_cast<double>(total_duration.count())));
     }
     
     return result;
@@ -784,6 +1083,69 @@ Napi::Value ConfigureShutdownTimeouts(const Napi::CallbackInfo& info) {
         manager->SetPhaseTimeout(ShutdownState::UNMOUNTING, timeout);
     }
     
+    if (config.Has("handoff")) {
+        uint32_t timeout = config.Get("handoff").As<Napi::Number>().Uint32Value();
+        manager->SetPhaseTimeout(ShutdownState::HANDING_OFF, timeout);
+    }
+    
+    return Napi::Boolean::New(env, true);
+}
+
+Napi::Value ConfigureShutdownHandoff(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    auto manager = GetGlobalShutdownManager();
+    if (!manager) {
+        NapiHelpers::ThrowError(env, "Shutdown manager not initialized");
+        return env.Undefined();
+    }
+    
+    if (info.Length() < 1 || info[0].IsNull() || info[0].IsUndefined()) {
+        manager->ClearHandoff();
+        return Napi::Boolean::New(env, true);
+    }
+    
+    if (!info[0].IsObject() || !info[0].As<Napi::Object>().Get("id").IsNumber() ||
+        info.Length() < 2 || !info[1].IsObject()) {
+        NapiHelpers::ThrowTypeError(env, "Expected session handle and handoff options");
+        return env.Undefined();
+    }
+    
+    const uint64_t session_id =
+        static_cast<uint64_t>(info[0].As<Napi::Object>().Get("id").As<Napi::Number>().Int64Value());
+    SessionManager* session = FindSession(session_id);
+    if (!session) {
+        NapiHelpers::ThrowErrnoError(env, ENOENT, "Session not found");
+        return env.Undefined();
+    }
+    if (session->GetOptions().auto_unmount) {
+        NapiHelpers::ThrowErrnoError(env, EINVAL, "autoUnmount sessions cannot be handed off");
+        return env.Undefined();
+    }
+    
+    Napi::Object options = info[1].As<Napi::Object>();
+    Napi::Value socket_path = options.Get("socketPath");
+    if (!socket_path.IsString() || socket_path.As<Napi::String>().Utf8Value().empty()) {
+        NapiHelpers::ThrowTypeError(env, "socketPath must be a non-empty string");
+        return env.Undefined();
+    }
+    
+    std::vector<uint8_t> state;
+    Napi::Value state_value = options.Get("state");
+    if (state_value.IsTypedArray()) {
+        Napi::TypedArray array = state_value.As<Napi::TypedArray>();
+        const auto* data = static_cast<const uint8_t*>(array.ArrayBuffer().Data()) + array.ByteOffset();
+        state.assign(data, data + array.ByteLength());
+    } else if (state_value.IsArrayBuffer()) {
+        Napi::ArrayBuffer buffer = state_value.As<Napi::ArrayBuffer>();
+        const auto* data = static_cast<const uint8_t*>(buffer.Data());
+        state.assign(data, data + buffer.ByteLength());
+    } else if (!state_value.IsUndefined()) {
+        NapiHelpers::ThrowTypeError(env, "state must be an ArrayBuffer or TypedArray");
+        return env.Undefined();
+    }
+    
+    manager->SetHandoff(session_id, socket_path.As<Napi::String>().Utf8Value(), std::move(state));
     return Napi::Boolean::New(env, true);
 }
 
@@ -19,6 +19,7 @@
 #include <memory>
 #include <chrono>
 #include <csignal>
+#include <string>
 #include <thread>
 
 namespace fuse_native {
@@ -30,9 +31,18 @@ enum class ShutdownState {
     RUNNING = 0,     // Normal operation
     DRAINING = 1,    // Draining pending operations
     UNMOUNTING = 2,  // Unmounting FUSE session
-    CLOSED = 3       // Fully shut down
+    CLOSED = 3,      // Fully shut down
+    HANDING_OFF = 4  // Passing the session to a successor instead of unmounting
 };
 
+/**
+ * Independent piece of work inside a phase
+ *
+ * Tasks of one phase run concurrently and must return by the deadline they
+ * are given (the phase deadline); true means the subsystem is drained.
+ */
+using ShutdownTask = std::function<bool(std::chrono::steady_clock::time_point deadline)>;
+
 /**
  * Shutdown phase information
  */
@@ -43,12 +53,36 @@ struct ShutdownPhase {
     std::chrono::steady_clock::time_point start_time;
     std::function<bool()> completion_check;
     std::function<void()> cleanup_action;
+    std::vector<std::pair<std::string, ShutdownTask>> tasks;  ///< Run in parallel after cleanup_action
+    bool best_effort = false;  ///< A timeout is recorded but does not stop the following phases
     
     ShutdownPhase(ShutdownState s, const std::string& desc, 
                   std::chrono::milliseconds to = std::chrono::milliseconds(5000))
         : state(s), description(desc), timeout(to), start_time(std::chrono::steady_clock::now()) {}
 };
 
+/**
+ * Outcome of one phase task
+ */
+struct ShutdownTaskMetrics {
+    std::string name;
+    std::chrono::microseconds duration{0};
+    bool success = false;
+    bool timed_out = false;  ///< Still running at the phase deadline
+};
+
+/**
+ * Outcome of one executed phase
+ */
+struct ShutdownPhaseMetrics {
+    ShutdownState state = ShutdownState::RUNNING;
+    std::string description;
+    std::chrono::microseconds duration{0};
+    bool success = false;
+    bool timed_out = false;
+    std::vector<ShutdownTaskMetrics> tasks;
+};
+
 /**
  * Shutdown statistics
  */
@@ -57,6 +91,7 @@ struct ShutdownStats {
     std::chrono::steady_clock::time_point shutdown_end;
     ShutdownState final_state;
     std::vector<std::pair<ShutdownState, std::chrono::milliseconds>> phase_durations;
+    std::vector<ShutdownPhaseMetrics> phase_metrics;  ///< Executed phases of the last shutdown
     bool graceful_completion;
     std::string failure_reason;
     
@@ -200,6 +235,28 @@ public:
      */
     void RegisterPhaseCompletionCheck(ShutdownState state, std::function<bool()> check_fn);
 
+    /**
+     * Hand a session to a successor process instead of unmounting it
+     *
+     * With a handoff target the HANDING_OFF phase replaces UNMOUNTING. If
+     * the handoff fails the session keeps serving and the shutdown ends
+     * with gracefulCompletion = false.
+     * @param session_id Session to hand off
+     * @param socket_path Socket the successor listens on
+     * @param state Opaque state passed to the successor
+     */
+    void SetHandoff(uint64_t session_id, const std::string& socket_path, std::vector<uint8_t> state);
+
+    /**
+     * Unmount on shutdown again
+     */
+    void ClearHandoff();
+
+    /**
+     * @return true if a handoff target is configured
+     */
+    bool HasHandoff() const;
+
 private:
     // State management
     mutable std::mutex state_mutex_;
@@ -224,6 +281,19 @@ private:
     // Shutdown execution
     std::atomic<bool> shutdown_in_progress_;
     std::thread shutdown_thread_;
+
+    // Handoff target (HANDING_OFF phase)
+    mutable std::mutex handoff_mutex_;
+    bool handoff_configured_ = false;
+    uint64_t handoff_session_id_ = 0;
+    std::string handoff_socket_path_;
+    std::vector<uint8_t> handoff_state_;
+
+    /**
+     * Run the configured handoff (cleanup action of HANDING_OFF)
+     * @param timeout Phase timeout
+     */
+    void RunHandoff(std::chrono::milliseconds timeout);
     
     /**
      * Install signal handlers for SIGINT and SIGTERM
@@ -251,9 +321,10 @@ private:
     /**
      * Execute a specific shutdown phase
      * @param phase Phase to execute
+     * @param metrics Receives duration and per-task results
      * @return true if phase completed successfully
      */
-    bool ExecutePhase(const ShutdownPhase& phase);
+    bool ExecutePhase(const ShutdownPhase& phase, ShutdownPhaseMetrics* metrics);
     
     /**
      * Transition to next shutdown state
@@ -278,6 +349,22 @@ private:
     void CleanupExpiredCallbacks();
 };
 
+/**
+ * Wake drain waiters after a drain-relevant counter dropped (e.g. to zero)
+ *
+ * Cheap while nobody waits: a single atomic load.
+ */
+void NotifyDrainProgress();
+
+/**
+ * Wait until @p done returns true or @p deadline passes
+ *
+ * Woken by NotifyDrainProgress(); @p done is re-evaluated at least every
+ * 50 ms for conditions whose owners do not notify.
+ * @return Result of the last @p done evaluation
+ */
+bool WaitForDrain(const std::function<bool()>& done, std::chrono::steady_clock::time_point deadline);
+
 /**
  * FUSE session specific shutdown helpers
  */
@@ -393,6 +480,13 @@ Napi::Value WaitForShutdownCompletion(const Napi::CallbackInfo& info);
  */
 Napi::Value ConfigureShutdownTimeouts(const Napi::CallbackInfo& info);
 
+/**
+ * Configure a shutdown handoff (N-API exposed function)
+ * @param info N-API callback info containing session handle (or null to clear) and `{socketPath, state?}`
+ * @return Boolean indicating success
+ */
+Napi::Value ConfigureShutdownHandoff(const Napi::CallbackInfo& info);
+
 } // namespace fuse_native
 
 #endif // SHUTDOWN_H
\ No newline at end of file
@@ -0,0 +1,76 @@
+/**
+ * @file trace_probes.h
+ * @brief USDT tracepoints (provider `fuse_native`) along the request path
+ *
+ * The probes are NOPs with an ELF note describing their arguments. Each one
+ * has a semaphore that the kernel raises while a tracer (bpftrace, bcc,
+ * perf) is attached; the arguments, including clock reads for latencies,
+ * are only evaluated while that semaphore is set. A running mount can be
+ * profiled by attaching to the loaded addon, see examples/bpftrace/.
+ *
+ * | Probe              | Arguments                                              |
+ * |--------------------|--------------------------------------------------------|
+ * | `loop_receive`     | kernel opcode, nodeid, length, kernel unique            |
+ * | `request_receive`  | op, ino, size, request_id                               |
+ * | `dispatch_enqueue` | op, request_id (0: no request), queue depth             |
+ * | `dispatch_start`   | op, request_id (0: no request), queue wait ns           |
+ * | `js_start`         | op, ino, size, request_id, ns since receive             |
+ * | `js_settle`        | op, ino, rejected (0/1), request_id, ns in JS           |
+ * | `request_reply`    | op, ino, size, request_id, ns since receive             |
+ * | `request_error`    | op, ino, errno, request_id, ns since receive            |
+ *
+ * `op` is the operation name as a C string (bpftrace: `str(arg0)`).
+ * `request_id` is the bridge-wide request sequence, not the kernel unique.
+ *
+ * FUSE_NATIVE_USDT=0 compiles the probes out; they are only available on
+ * Linux x86-64 / aarch64.
+ */
+
+#ifndef FUSE_NATIVE_TRACE_PROBES_H
+#define FUSE_NATIVE_TRACE_PROBES_H
+
+#include <chrono>
+#include <cstdint>
+
+#ifndef FUSE_NATIVE_USDT
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+#define FUSE_NATIVE_USDT 1
+#else
+#define FUSE_NATIVE_USDT 0
+#endif
+#endif
+
+#if FUSE_NATIVE_USDT
+
+#include "usdt.h"
+
+#define FUSE_PROBE_ACTIVE(name) USDT_IS_ACTIVE(fuse_native, name)
+
+// Argumente nur auswerten, solange ein Tracer angehängt ist
+#define FUSE_PROBE(name, ...)                                  \
+    do {                                                       \
+        if (FUSE_PROBE_ACTIVE(name)) {                         \
+            USDT_WITH_SEMA(fuse_native, name, __VA_ARGS__);    \
+        }                                                      \
+    } while (0)
+
+#else
+
+#define FUSE_PROBE_ACTIVE(name) false
+#define FUSE_PROBE(name, ...) do { } while (0)
+
+#endif
+
+namespace fuse_native {
+
+/**
+ * @brief Nanoseconds since @p since (probe argument)
+ */
+inline uint64_t ProbeElapsedNs(std::chrono::steady_clock::time_point since) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - since).count());
+}
+
+} // namespace fuse_native
+
+#endif // FUSE_NATIVE_TRACE_PROBES_H
@@ -1,6 +1,7 @@
 #include "tsfn_dispatcher.h"
 
 #include "logging.h"
+#include "trace_probes.h"
 
 #include <algorithm>
 #include <exception>
@@ -295,6 +296,7 @@ uint64_t TSFNDispatcher::Dispatch(const std::string& operation_name,
       return 0;
     }
     callback_queue_.push(pending);
+    FUSE_PROBE(dispatch_enqueue, operation_name.c_str(), uint64_t{0}, static_cast<uint64_t>(callback_queue_.size()));
     std::lock_guard<std::mutex> stats_lock(stats_mutex_);
     stats_.queue_size = callback_queue_.size();
     stats_.max_queue_size = std::max(stats_.max_queue_size, stats_.queue_size);
@@ -309,7 +311,8 @@ uint64_t TSFNDispatcher::Dispatch(const std::string& operation_name,
 uint64_t TSFNDispatcher::DispatchCustom(const std::string& operation_name,
                                         std::function<void(Napi::Env, Napi::Function)> callback_fn,
                                         CallbackPriority priority,
-                                        std::function<void(int)> error_callback) {
+                                        std::function<void(int)> error_callback,
+                                        uint64_t trace_id) {
   FUSE_LOG_TRACE("DispatchCustom: Attempting to dispatch %s", operation_name.c_str());
   if (state_.load(std::memory_order_acquire) != DispatcherState::RUNNING ||
       !accepting_.load(std::memory_order_acquire)) {
@@ -321,6 +324,7 @@ uint64_t TSFNDispatcher::DispatchCustom(const std::string& operation_name,
   auto context = std::make_unique<CallbackContext>(operation_name, request_id, priority);
   context->callback_fn = std::move(callback_fn);
   context->error_callback = std::move(error_callback);
+  context->trace_id = trace_id;
 
   auto pending = std::make_shared<PendingCallback>(std::move(context));
 
@@ -338,6 +342,7 @@ uint64_t TSFNDispatcher::DispatchCustom(const std::string& operation_name,
       return 0;
     }
     callback_queue_.push(pending);
+    FUSE_PROBE(dispatch_enqueue, operation_name.c_str(), trace_id, static_cast<uint64_t>(callback_queue_.size()));
     std::lock_guard<std::mutex> stats_lock(stats_mutex_);
     stats_.queue_size = callback_queue_.size();
     stats_.max_queue_size = std::max(stats_.max_queue_size, stats_.queue_size);
@@ -368,10 +373,9 @@ bool TSFNDispatcher::WaitForCompletion(uint64_t request_id, uint32_t timeout_ms)
 }
 
 bool TSFNDispatcher::WaitForAllCompletion(uint32_t timeout_ms) {
-  const auto timeout = std::chrono::milliseconds(timeout_ms);
-  const auto start = std::chrono::steady_clock::now();
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
 
-  while (std::chrono::steady_clock::now() - start < timeout) {
+  for (;;) {
     {
       std::lock_guard<std::mutex> pending_lock(pending_requests_mutex_);
       std::lock_guard<std::mutex> queue_lock(queue_mutex_);
@@ -379,10 +383,21 @@ bool TSFNDispatcher::WaitForAllCompletion(uint32_t timeout_ms) {
         return true;
       }
     }
-    std::this_thread::sleep_for(std::chrono::milliseconds(5));
-  }
+    const auto now = std::chrono::steady_clock::now();
+    if (now >= deadline) {
+      return false;
+    }
 
-  return false;
+    // DecInflight weckt beim Übergang auf 0; nur inflight_ im Prädikat (Lock-Reihenfolge)
+    std::unique_lock<std::mutex> inflight_lock(inflight_mtx_);
+    if (inflight_.load(std::memory_order_acquire) == 0) {
+      // Eingetragen, aber noch nicht gezählt: kurz nachfassen statt zu kreisen
+      inflight_cv_.wait_until(inflight_lock, std::min(deadline, now + std::chrono::milliseconds(5)));
+    } else {
+      inflight_cv_.wait_until(inflight_lock, deadline,
+                              [this] { return inflight_.load(std::memory_order_acquire) == 0; });
+    }
+  }
 }
 
 size_t TSFNDispatcher::GetQueueSize() const {
@@ -480,6 +495,8 @@ void TSFNDispatcher::ProcessCallback(std::shared_ptr<PendingCallback> callback)
 
     bool ok = false;
     const uint64_t request_id = pending->context->request_id;
+    FUSE_PROBE(dispatch_start, pending->context->operation_name.c_str(), pending->context->trace_id,
+               ProbeElapsedNs(pending->context->timestamp));
 
     try {
       if (pending->context->callback_fn) {
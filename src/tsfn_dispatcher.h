@@ -46,6 +46,7 @@ struct CallbackContext {
     std::chrono::steady_clock::time_point timestamp;
     std::function<void(Napi::Env, Napi::Function)> callback_fn;
     std::function<void(int)> error_callback;  // For error handling
+    uint64_t trace_id = 0;                     // Bridge-wide request_id for trace probes (0 = none)
     
     CallbackContext(const std::string& op_name, uint64_t req_id, CallbackPriority prio)
         : operation_name(op_name), request_id(req_id), priority(prio), 
@@ -136,12 +137,14 @@ public:
      * @param callback_fn Custom callback function to execute in JS thread
      * @param priority Callback priority level
      * @param error_callback Optional error callback for C++ thread
+     * @param trace_id Bridge-wide request_id reported by the dispatch probes (0 = none)
      * @return Request ID for tracking, 0 on failure
      */
     uint64_t DispatchCustom(const std::string& operation_name,
                            std::function<void(Napi::Env, Napi::Function)> callback_fn,
                            CallbackPriority priority = CallbackPriority::NORMAL,
-                           std::function<void(int)> error_callback = nullptr);
+                           std::function<void(int)> error_callback = nullptr,
+                           uint64_t trace_id = 0);
     
     /**
      * Wait for a specific request to complete
@@ -20,27 +20,78 @@ namespace fuse_native {
 static std::unique_ptr<WriteQueueManager> global_write_queue_manager_;
 static std::mutex global_write_queue_mutex_;
 
+/**
+ * Write coalescing settings
+ */
+static std::mutex coalescing_config_mutex_;
+static WriteCoalescingConfig coalescing_config_;
+static std::atomic<bool> coalescing_enabled_{false};
+
+/**
+ * Write-behind settings and counters
+ */
+static std::mutex write_behind_mutex_;
+static WriteBehindConfig write_behind_config_;
+static std::atomic<bool> write_behind_enabled_{false};
+static std::atomic<uint64_t> global_dirty_bytes_{0};
+static WriteBehindStats write_behind_stats_;   // guarded by write_behind_mutex_
+
 /**
  * FDWriteQueue implementation
  */
 FDWriteQueue::FDWriteQueue(uint64_t fd, size_t max_queue_size)
     : fd_(fd), max_queue_size_(max_queue_size), next_operation_id_(1),
-      priority_ordering_enabled_(true), operation_queue_(ComparePriority) {
+      priority_ordering_enabled_(true) {
 }
 
 FDWriteQueue::~FDWriteQueue() {
     CancelAll(-ECANCELED);
 }
 
+std::deque<std::unique_ptr<WriteOperation>>* FDWriteQueue::HeadLevelLocked() {
+    for (auto& level : levels_) {
+        if (!level.empty()) {
+            return &level;
+        }
+    }
+    return nullptr;
+}
+
+std::unique_ptr<WriteOperation> FDWriteQueue::PopHeadLocked() {
+    auto* level = HeadLevelLocked();
+    if (!level) {
+        return nullptr;
+    }
+    auto operation = std::move(level->front());
+    level->pop_front();
+    queued_--;
+    stats_.queue_size = queued_;
+    return operation;
+}
+
+std::vector<std::function<void()>> FDWriteQueue::TakeIdleWaitersLocked() {
+    std::vector<std::function<void()>> waiters;
+    if (IdleLocked()) {
+        waiters.swap(idle_waiters_);
+    }
+    return waiters;
+}
+
 uint64_t FDWriteQueue::Enqueue(std::unique_ptr<WriteOperation> operation) {
     if (!operation) {
         return 0;
     }
     
+    // Ohne Prioritäten landet alles in einem FIFO
+    const size_t level = priority_ordering_enabled_.load(std::memory_order_relaxed)
+                             ? std::min(static_cast<size_t>(operation->priority), kPriorityLevels - 1)
+                             : 0;
+    
     std::lock_guard<std::mutex> lock(queue_mutex_);
     
     // Check queue size limits
-    if (max_queue_size_ > 0 && operation_queue_.size() >= max_queue_size_) {
+    const size_t max_size = max_queue_size_.load(std::memory_order_relaxed);
+    if (max_size > 0 && queued_ >= max_size) {
         return 0; // Queue is full
     }
     
@@ -49,12 +100,12 @@ uint64_t FDWriteQueue::Enqueue(std::unique_ptr<WriteOperation> operation) {
     operation->operation_id = operation_id;
     
     // Add to queue
-    operation_queue_.push(std::move(operation));
-    stats_.queue_size = operation_queue_.size();
-    stats_.max_queue_size = std::max(stats_.max_queue_size, stats_.queue_size);
+    levels_[level].push_back(std::move(operation));
+    queued_++;
+    stats_.queue_size = queued_;
+    stats_.max_queue_size = std::max<uint64_t>(stats_.max_queue_size, queued_);
     stats_.total_operations++;
     
-    queue_cv_.notify_one();
     return operation_id;
 }
 
@@ -71,17 +122,11 @@ size_t FDWriteQueue::ProcessQueue(std::function<int(const WriteOperation&)> exec
         // Get next operation
         {
             std::lock_guard<std::mutex> lock(queue_mutex_);
-            if (operation_queue_.empty()) {
+            operation = PopHeadLocked();
+            if (!operation) {
                 break;
             }
-            
-            operation = std::move(const_cast<std::unique_ptr<WriteOperation>&>(operation_queue_.top()));
-            operation_queue_.pop();
-            stats_.queue_size = operation_queue_.size();
-        }
-        
-        if (!operation) {
-            continue;
+            executing_++;
         }
         
         // Execute the operation
@@ -94,7 +139,10 @@ size_t FDWriteQueue::ProcessQueue(std::function<int(const WriteOperation&)> exec
         double latency_ms = latency.count() / 1000.0;
         
         bool success = (result >= 0);
-        UpdateStats(*operation, success, latency_ms);
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            UpdateStats(*operation, success, latency_ms);
+        }
         
         // Call completion callback
         if (operation->completion_callback) {
@@ -103,6 +151,17 @@ size_t FDWriteQueue::ProcessQueue(std::function<int(const WriteOperation&)> exec
             operation->error_callback(result);
         }
         
+        std::vector<std::function<void()>> waiters;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            executing_--;
+            waiters = TakeIdleWaitersLocked();
+        }
+        queue_cv_.notify_all();
+        for (auto& waiter : waiters) {
+            waiter();
+        }
+        
         processed++;
     }
     
@@ -110,81 +169,66 @@ size_t FDWriteQueue::ProcessQueue(std::function<int(const WriteOperation&)> exec
 }
 
 bool FDWriteQueue::Flush(uint32_t timeout_ms) {
-    auto start_time = std::chrono::steady_clock::now();
-    auto timeout = std::chrono::milliseconds(timeout_ms);
-    
-    while (std::chrono::steady_clock::now() - start_time < timeout) {
-        {
-            std::lock_guard<std::mutex> lock(queue_mutex_);
-            if (operation_queue_.empty()) {
-                return true;
-            }
-        }
-        
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    }
-    
-    return false; // Timeout
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    return queue_cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                              [this] { return IdleLocked(); });
 }
 
 void FDWriteQueue::CancelAll(int error_code) {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
+    std::vector<std::unique_ptr<WriteOperation>> cancelled;
+    std::vector<std::function<void()>> waiters;
     
-    while (!operation_queue_.empty()) {
-        auto operation = std::move(const_cast<std::unique_ptr<WriteOperation>&>(operation_queue_.top()));
-        operation_queue_.pop();
-        
-        if (operation && operation->error_callback) {
-            operation->error_callback(error_code);
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        cancelled.reserve(queued_);
+        while (auto operation = PopHeadLocked()) {
+            cancelled.push_back(std::move(operation));
+            stats_.failed_operations++;
         }
-        
-        stats_.failed_operations++;
+        waiters = TakeIdleWaitersLocked();
     }
+    queue_cv_.notify_all();
     
-    stats_.queue_size = 0;
+    // Rückrufe ohne Lock: sie dürfen wieder einreihen
+    for (auto& operation : cancelled) {
+        if (operation->error_callback) {
+            operation->error_callback(error_code);
+        }
+    }
+    for (auto& waiter : waiters) {
+        waiter();
+    }
 }
 
 bool FDWriteQueue::IsEmpty() const {
     std::lock_guard<std::mutex> lock(queue_mutex_);
-    return operation_queue_.empty();
+    return queued_ == 0;
 }
 
 size_t FDWriteQueue::GetQueueSize() const {
     std::lock_guard<std::mutex> lock(queue_mutex_);
-    return operation_queue_.size();
+    return queued_;
 }
 
 WriteQueueStats FDWriteQueue::GetStats() const {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
     return stats_;
 }
 
 void FDWriteQueue::ResetStats() {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
     stats_ = WriteQueueStats();
+    stats_.queue_size = queued_;
 }
 
 void FDWriteQueue::SetMaxQueueSize(size_t max_size) {
-    max_queue_size_ = max_size;
+    max_queue_size_.store(max_size, std::memory_order_relaxed);
 }
 
 void FDWriteQueue::SetPriorityOrdering(bool enable) {
     priority_ordering_enabled_ = enable;
 }
 
-bool FDWriteQueue::ComparePriority(const std::unique_ptr<WriteOperation>& a,
-                                  const std::unique_ptr<WriteOperation>& b) {
-    if (!a || !b) {
-        return false;
-    }
-    
-    // Higher priority (lower enum value) comes first
-    if (a->priority != b->priority) {
-        return static_cast<int>(a->priority) > static_cast<int>(b->priority);
-    }
-    
-    // Same priority, use timestamp (older first)
-    return a->timestamp > b->timestamp;
-}
-
 void FDWriteQueue::UpdateStats(const WriteOperation& operation, bool success, double latency_ms) {
     if (success) {
         stats_.completed_operations++;
@@ -196,12 +240,123 @@ void FDWriteQueue::UpdateStats(const WriteOperation& operation, bool success, do
     // Update rolling average latency
     double current_avg = stats_.avg_latency_ms;
     uint64_t total_completed = stats_.completed_operations;
-    if (total_completed > 0) {
+    if (success && total_completed > 0) {
         double new_avg = ((current_avg * (total_completed - 1)) + latency_ms) / total_completed;
         stats_.avg_latency_ms = new_avg;
     }
 }
 
+std::vector<std::unique_ptr<WriteOperation>> FDWriteQueue::TakeBatch(size_t max_bytes, size_t max_operations) {
+    std::vector<std::unique_ptr<WriteOperation>> batch;
+    
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    auto* level = batch_in_flight_ ? nullptr : HeadLevelLocked();
+    if (!level) {
+        return batch;
+    }
+    
+    // Höhere Prioritäten sind leer: Batch nur aus dieser Stufe
+    uint64_t total = 0;
+    while (!level->empty()) {
+        const auto& next = level->front();
+        if (!batch.empty()) {
+            const WriteOperation& last = *batch.back();
+            if (batch.size() >= max_operations ||
+                next->offset != last.offset + last.size ||
+                total + next->size > max_bytes) {
+                break;
+            }
+        }
+        total += next->size;
+        batch.push_back(std::move(level->front()));
+        level->pop_front();
+        queued_--;
+    }
+    
+    batch_in_flight_ = true;
+    stats_.queue_size = queued_;
+    stats_.batches++;
+    stats_.merged_operations += batch.size() - 1;
+    return batch;
+}
+
+void FDWriteQueue::CompleteBatch(std::vector<std::unique_ptr<WriteOperation>>& batch,
+                                 int64_t result, double latency_ms) {
+    // Ergebnis der Sammelschreibung auf die einzelnen Operationen verteilen
+    uint64_t remaining = result > 0 ? static_cast<uint64_t>(result) : 0;
+    for (auto& operation : batch) {
+        if (!operation) {
+            continue;
+        }
+        int op_result;
+        if (result < 0) {
+            op_result = static_cast<int>(result);
+        } else if (remaining == 0 && operation->size > 0) {
+            op_result = -EIO;
+        } else {
+            const uint64_t share = std::min<uint64_t>(remaining, operation->size);
+            remaining -= share;
+            op_result = static_cast<int>(share);
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            UpdateStats(*operation, op_result >= 0, latency_ms);
+        }
+        
+        if (operation->completion_callback) {
+            operation->completion_callback(op_result);
+        } else if (op_result < 0 && operation->error_callback) {
+            operation->error_callback(op_result);
+        }
+    }
+    batch.clear();
+    
+    std::vector<std::function<void()>> waiters;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        batch_in_flight_ = false;
+        waiters = TakeIdleWaitersLocked();
+    }
+    queue_cv_.notify_all();
+    
+    for (auto& waiter : waiters) {
+        waiter();
+    }
+}
+
+bool FDWriteQueue::DeferUntilIdle(std::function<void()> callback) {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if (IdleLocked()) {
+        return false;
+    }
+    idle_waiters_.push_back(std::move(callback));
+    return true;
+}
+
+bool FDWriteQueue::ReserveDirty(size_t bytes, size_t limit) {
+    size_t current = dirty_bytes_.load(std::memory_order_acquire);
+    do {
+        if (limit > 0 && current + bytes > limit) {
+            return false;
+        }
+    } while (!dirty_bytes_.compare_exchange_weak(current, current + bytes, std::memory_order_acq_rel));
+    return true;
+}
+
+void FDWriteQueue::ReleaseDirty(size_t bytes) {
+    dirty_bytes_.fetch_sub(bytes, std::memory_order_acq_rel);
+}
+
+void FDWriteQueue::SetDeferredError(int error_code) {
+    int expected = 0;
+    deferred_error_.compare_exchange_strong(expected, error_code, std::memory_order_acq_rel);
+}
+
+int FDWriteQueue::TakeDeferredError() {
+    return deferred_error_.exchange(0, std::memory_order_acq_rel);
+}
+
 /**
  * WriteQueueManager implementation
  */
@@ -213,37 +368,56 @@ WriteQueueManager::~WriteQueueManager() {
     FlushAll(1000); // Give 1 second for cleanup
 }
 
-FDWriteQueue* WriteQueueManager::GetQueue(uint64_t fd) {
-    std::lock_guard<std::mutex> lock(queues_mutex_);
-    return GetQueueLocked(fd);
+std::vector<std::shared_ptr<FDWriteQueue>> WriteQueueManager::CollectQueues() const {
+    std::vector<std::shared_ptr<FDWriteQueue>> queues;
+    for (const Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (const auto& pair : shard.queues) {
+            if (pair.second) {
+                queues.push_back(pair.second);
+            }
+        }
+    }
+    return queues;
 }
 
-FDWriteQueue* WriteQueueManager::GetQueueLocked(uint64_t fd) {
-    auto it = fd_queues_.find(fd);
-    if (it != fd_queues_.end()) {
-        return it->second.get();
+std::shared_ptr<FDWriteQueue> WriteQueueManager::GetQueue(uint64_t fd) {
+    Shard& shard = ShardFor(fd);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    
+    auto it = shard.queues.find(fd);
+    if (it != shard.queues.end()) {
+        return it->second;
     }
     
     // Create new queue
-    auto queue = std::make_unique<FDWriteQueue>(fd, default_max_queue_size_);
-    auto* queue_ptr = queue.get();
-    fd_queues_[fd] = std::move(queue);
+    auto queue = std::make_shared<FDWriteQueue>(fd, default_max_queue_size_.load(std::memory_order_relaxed));
+    shard.queues.emplace(fd, queue);
     
-    return queue_ptr;
+    return queue;
+}
+
+std::shared_ptr<FDWriteQueue> WriteQueueManager::FindQueue(uint64_t fd) const {
+    const Shard& shard = ShardFor(fd);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.queues.find(fd);
+    return it != shard.queues.end() ? it->second : nullptr;
 }
 
 bool WriteQueueManager::RemoveQueue(uint64_t fd, uint32_t timeout_ms) {
-    std::unique_ptr<FDWriteQueue> queue;
+    // Nur aushängen: laufende Batches halten die Queue selbst am Leben
+    std::shared_ptr<FDWriteQueue> queue;
     
     {
-        std::lock_guard<std::mutex> lock(queues_mutex_);
-        auto it = fd_queues_.find(fd);
-        if (it == fd_queues_.end()) {
+        Shard& shard = ShardFor(fd);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.queues.find(fd);
+        if (it == shard.queues.end()) {
             return true; // Already removed
         }
         
         queue = std::move(it->second);
-        fd_queues_.erase(it);
+        shard.queues.erase(it);
     }
     
     if (queue) {
@@ -253,6 +427,91 @@ bool WriteQueueManager::RemoveQueue(uint64_t fd, uint32_t timeout_ms) {
     return true;
 }
 
+void WriteQueueManager::RetainHandle(uint64_t fd) {
+    Shard& shard = ShardFor(fd);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.opens[fd]++;
+}
+
+bool WriteQueueManager::ReleaseHandle(uint64_t fd) {
+    Shard& shard = ShardFor(fd);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.opens.find(fd);
+    if (it == shard.opens.end()) {
+        return true;
+    }
+    if (--it->second > 0) {
+        return false;
+    }
+    shard.opens.erase(it);
+    return true;
+}
+
+void WriteQueueManager::ResetHandles() {
+    for (Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.opens.clear();
+    }
+}
+
+std::vector<std::pair<uint64_t, uint32_t>> WriteQueueManager::SnapshotHandles() const {
+    std::vector<std::pair<uint64_t, uint32_t>> counts;
+    for (const Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        counts.insert(counts.end(), shard.opens.begin(), shard.opens.end());
+    }
+    return counts;
+}
+
+void WriteQueueManager::RestoreHandles(const std::vector<std::pair<uint64_t, uint32_t>>& counts) {
+    for (const auto& entry : counts) {
+        if (entry.second == 0) {
+            continue;
+        }
+        Shard& shard = ShardFor(entry.first);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.opens[entry.first] = entry.second;
+    }
+}
+
+void WriteQueueManager::RetainInodeWrite(uint64_t ino) {
+    Shard& shard = ShardFor(ino);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.inode_writes[ino].pending++;
+}
+
+void WriteQueueManager::ReleaseInodeWrite(uint64_t ino) {
+    std::vector<std::function<void()>> waiters;
+    {
+        Shard& shard = ShardFor(ino);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.inode_writes.find(ino);
+        if (it == shard.inode_writes.end()) {
+            return;
+        }
+        if (--it->second.pending > 0) {
+            return;
+        }
+        waiters.swap(it->second.waiters);
+        shard.inode_writes.erase(it);
+    }
+    // Ohne Lock: Wartende dürfen wieder schreiben
+    for (auto& waiter : waiters) {
+        waiter();
+    }
+}
+
+bool WriteQueueManager::DeferUntilInodeIdle(uint64_t ino, std::function<void()> callback) {
+    Shard& shard = ShardFor(ino);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.inode_writes.find(ino);
+    if (it == shard.inode_writes.end()) {
+        return false;
+    }
+    it->second.waiters.push_back(std::move(callback));
+    return true;
+}
+
 uint64_t WriteQueueManager::EnqueueWrite(uint64_t fd, std::unique_ptr<WriteOperation> operation) {
     if (!operation) {
         return 0;
@@ -271,44 +530,24 @@ size_t WriteQueueManager::ProcessAllQueues(std::function<int(const WriteOperatio
         return 0;
     }
     
-    std::vector<FDWriteQueue*> queues;
-    
-    // Collect all queues
-    {
-        std::lock_guard<std::mutex> lock(queues_mutex_);
-        queues.reserve(fd_queues_.size());
-        for (auto& pair : fd_queues_) {
-            queues.push_back(pair.second.get());
-        }
-    }
-    
     // Process each queue
     size_t total_processed = 0;
-    for (auto queue : queues) {
-        if (queue) {
-            total_processed += queue->ProcessQueue(executor);
-        }
+    for (auto queue : CollectQueues()) {
+        total_processed += queue->ProcessQueue(executor);
     }
     
     return total_processed;
 }
 
 bool WriteQueueManager::FlushAll(uint32_t timeout_ms) {
-    std::vector<FDWriteQueue*> queues;
+    // Ein gemeinsames Zeitbudget für alle Queues
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
     
-    // Collect all queues
-    {
-        std::lock_guard<std::mutex> lock(queues_mutex_);
-        queues.reserve(fd_queues_.size());
-        for (auto& pair : fd_queues_) {
-            queues.push_back(pair.second.get());
-        }
-    }
-    
-    // Flush each queue
     bool all_success = true;
-    for (auto queue : queues) {
-        if (queue && !queue->Flush(timeout_ms)) {
+    for (auto queue : CollectQueues()) {
+        const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        if (!queue->Flush(static_cast<uint32_t>(std::max<int64_t>(0, left)))) {
             all_success = false;
         }
     }
@@ -317,7 +556,7 @@ bool WriteQueueManager::FlushAll(uint32_t timeout_ms) {
 }
 
 bool WriteQueueManager::FlushFD(uint64_t fd, uint32_t timeout_ms) {
-    auto queue = GetQueue(fd);
+    auto queue = FindQueue(fd);
     if (!queue) {
         return true; // No queue exists
     }
@@ -325,52 +564,54 @@ bool WriteQueueManager::FlushFD(uint64_t fd, uint32_t timeout_ms) {
     return queue->Flush(timeout_ms);
 }
 
-void WriteQueueManager::CancelAll(int error_code) {
-    std::lock_guard<std::mutex> lock(queues_mutex_);
-    
-    for (auto& pair : fd_queues_) {
-        if (pair.second) {
-            pair.second->CancelAll(error_code);
+int WriteQueueManager::PeekDeferredError() const {
+    for (const auto& queue : CollectQueues()) {
+        if (const int error_code = queue->PeekDeferredError()) {
+            return error_code;
         }
     }
+    return 0;
+}
+
+void WriteQueueManager::CancelAll(int error_code) {
+    for (auto queue : CollectQueues()) {
+        queue->CancelAll(error_code);
+    }
 }
 
 std::vector<uint64_t> WriteQueueManager::GetActiveFDs() const {
-    std::lock_guard<std::mutex> lock(queues_mutex_);
-    
     std::vector<uint64_t> fds;
-    fds.reserve(fd_queues_.size());
-    
-    for (const auto& pair : fd_queues_) {
-        fds.push_back(pair.first);
+    for (const Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (const auto& pair : shard.queues) {
+            fds.push_back(pair.first);
+        }
     }
     
     return fds;
 }
 
 WriteQueueStats WriteQueueManager::GetAggregateStats() const {
-    std::lock_guard<std::mutex> lock(queues_mutex_);
-    
     WriteQueueStats aggregate;
     double total_weighted_latency = 0.0;
     uint64_t total_completed = 0;
     
-    for (const auto& pair : fd_queues_) {
-        if (pair.second) {
-            auto stats = pair.second->GetStats();
-            aggregate.total_operations += stats.total_operations;
-            aggregate.completed_operations += stats.completed_operations;
-            aggregate.failed_operations += stats.failed_operations;
-            aggregate.bytes_written += stats.bytes_written;
-            aggregate.queue_size += stats.queue_size;
-            aggregate.max_queue_size = std::max(aggregate.max_queue_size, stats.max_queue_size);
-            
-            // Calculate weighted average latency
-            uint64_t completed = stats.completed_operations;
-            if (completed > 0) {
-                total_weighted_latency += stats.avg_latency_ms * completed;
-                total_completed += completed;
-            }
+    for (auto queue : CollectQueues()) {
+        auto stats = queue->GetStats();
+        aggregate.total_operations += stats.total_operations;
+        aggregate.completed_operations += stats.completed_operations;
+        aggregate.failed_operations += stats.failed_operations;
+        aggregate.bytes_written += stats.bytes_written;
+        aggregate.queue_size += stats.queue_size;
+        aggregate.max_queue_size = std::max(aggregate.max_queue_size, stats.max_queue_size);
+        aggregate.batches += stats.batches;
+        aggregate.merged_operations += stats.merged_operations;
+        
+        // Calculate weighted average latency
+        uint64_t completed = stats.completed_operations;
+        if (completed > 0) {
+            total_weighted_latency += stats.avg_latency_ms * completed;
+            total_completed += completed;
         }
     }
     
@@ -382,28 +623,22 @@ WriteQueueStats WriteQueueManager::GetAggregateStats() const {
 }
 
 std::optional<WriteQueueStats> WriteQueueManager::GetFDStats(uint64_t fd) const {
-    std::lock_guard<std::mutex> lock(queues_mutex_);
-    
-    auto it = fd_queues_.find(fd);
-    if (it != fd_queues_.end() && it->second) {
-        return it->second->GetStats();
+    auto queue = FindQueue(fd);
+    if (queue) {
+        return queue->GetStats();
     }
     
     return std::nullopt;
 }
 
 void WriteQueueManager::ResetAllStats() {
-    std::lock_guard<std::mutex> lock(queues_mutex_);
-    
-    for (auto& pair : fd_queues_) {
-        if (pair.second) {
-            pair.second->ResetStats();
-        }
+    for (auto queue : CollectQueues()) {
+        queue->ResetStats();
     }
 }
 
 void WriteQueueManager::SetDefaultMaxQueueSize(size_t max_size) {
-    const_cast<size_t&>(default_max_queue_size_) = max_size;
+    default_max_queue_size_.store(max_size, std::memory_order_relaxed);
 }
 
 void WriteQueueManager::SetFDMaxQueueSize(uint64_t fd, size_t max_size) {
@@ -444,6 +679,161 @@ bool ShutdownGlobalWriteQueueManager(uint32_t timeout_ms) {
     return success;
 }
 
+/**
+ * Write coalescing
+ */
+WriteCoalescingConfig GetWriteCoalescingConfig() {
+    std::lock_guard<std::mutex> lock(coalescing_config_mutex_);
+    return coalescing_config_;
+}
+
+bool IsWriteCoalescingEnabled() {
+    return coalescing_enabled_.load(std::memory_order_acquire);
+}
+
+WriteQueueManager& GetKernelWriteQueueManager() {
+    // Kernel-Writes sind durch max_background begrenzt → keine Queue-Grenze
+    static WriteQueueManager manager(0);
+    return manager;
+}
+
+/**
+ * Write-behind
+ */
+WriteBehindConfig GetWriteBehindConfig() {
+    std::lock_guard<std::mutex> lock(write_behind_mutex_);
+    return write_behind_config_;
+}
+
+bool IsWriteBehindEnabled() {
+    return write_behind_enabled_.load(std::memory_order_acquire);
+}
+
+bool ReserveWriteBehind(FDWriteQueue& queue, size_t bytes) {
+    const WriteBehindConfig config = GetWriteBehindConfig();
+    
+    bool reserved = queue.ReserveDirty(bytes, config.max_dirty_bytes_per_handle);
+    if (reserved) {
+        uint64_t current = global_dirty_bytes_.load(std::memory_order_acquire);
+        do {
+            if (config.max_dirty_bytes > 0 && current + bytes > config.max_dirty_bytes) {
+                queue.ReleaseDirty(bytes);
+                reserved = false;
+                break;
+            }
+        } while (!global_dirty_bytes_.compare_exchange_weak(current, current + bytes,
+                                                             std::memory_order_acq_rel));
+    }
+    
+    std::lock_guard<std::mutex> lock(write_behind_mutex_);
+    if (reserved) {
+        write_behind_stats_.acknowledged_writes++;
+        write_behind_stats_.peak_dirty_bytes = std::max<uint64_t>(
+            write_behind_stats_.peak_dirty_bytes, global_dirty_bytes_.load(std::memory_order_acquire));
+    } else {
+        write_behind_stats_.throttled_writes++;
+    }
+    return reserved;
+}
+
+void ReleaseWriteBehind(FDWriteQueue& queue, size_t bytes) {
+    queue.ReleaseDirty(bytes);
+    global_dirty_bytes_.fetch_sub(bytes, std::memory_order_acq_rel);
+}
+
+void CompleteWriteBehind(FDWriteQueue& queue, size_t bytes, int result, double latency_ms) {
+    ReleaseWriteBehind(queue, bytes);
+    
+    // Kurzer Write zählt wie ein Fehler: der Kernel hat bereits alles bestätigt
+    const bool failed = result < 0 || static_cast<size_t>(result) < bytes;
+    if (failed) {
+        queue.SetDeferredError(result < 0 ? result : -EIO);
+    }
+    
+    std::lock_guard<std::mutex> lock(write_behind_mutex_);
+    WriteBehindStats& stats = write_behind_stats_;
+    stats.flushes++;
+    if (failed) {
+        stats.failed_writes++;
+    } else {
+        stats.flushed_bytes += bytes;
+    }
+    stats.avg_flush_latency_ms += (latency_ms - stats.avg_flush_latency_ms) / static_cast<double>(stats.flushes);
+    stats.max_flush_latency_ms = std::max(stats.max_flush_latency_ms, latency_ms);
+}
+
+WriteBehindStats CollectWriteBehindStats() {
+    std::lock_guard<std::mutex> lock(write_behind_mutex_);
+    WriteBehindStats stats = write_behind_stats_;
+    stats.dirty_bytes = global_dirty_bytes_.load(std::memory_order_acquire);
+    return stats;
+}
+
+/**
+ * Shared completion channel for JS write callbacks
+ *
+ * One ThreadSafeFunction serves every enqueueWrite() callback instead of one
+ * per write. It is referenced only while callbacks are pending so that it
+ * does not keep the event loop alive on its own.
+ */
+struct PendingCompletion {
+    Napi::FunctionReference callback;
+    int result;
+};
+
+static std::mutex completion_mutex_;
+static Napi::ThreadSafeFunction completion_tsfn_;
+static bool completion_tsfn_ready_ = false;
+static size_t completion_pending_ = 0;      // JS thread only
+
+static bool EnsureCompletionChannel(Napi::Env env) {
+    std::lock_guard<std::mutex> lock(completion_mutex_);
+    if (completion_tsfn_ready_) {
+        return true;
+    }
+    
+    Napi::Function noop = Napi::Function::New(env, [](const Napi::CallbackInfo& info) {
+        return info.Env().Undefined();
+    });
+    completion_tsfn_ = Napi::ThreadSafeFunction::New(env, noop, "WriteCompletion", 0, 1);
+    completion_tsfn_.Unref(env);
+    completion_tsfn_ready_ = true;
+    
+    napi_add_env_cleanup_hook(env, [](void*) {
+        std::lock_guard<std::mutex> lock(completion_mutex_);
+        if (completion_tsfn_ready_) {
+            completion_tsfn_.Abort();
+            completion_tsfn_ready_ = false;
+        }
+    }, nullptr);
+    return true;
+}
+
+static void RefCompletionChannel(Napi::Env env) {
+    if (completion_pending_++ == 0) {
+        completion_tsfn_.Ref(env);
+    }
+}
+
+static void PostCompletion(PendingCompletion* pending) {
+    std::lock_guard<std::mutex> lock(completion_mutex_);
+    if (!completion_tsfn_ready_) {
+        return; // Environment wird abgebaut
+    }
+    completion_tsfn_.NonBlockingCall(pending, [](Napi::Env env, Napi::Function, PendingCompletion* data) {
+        std::unique_ptr<PendingCompletion> owned(data);
+        if (env != nullptr) {
+            owned->callback.Value().Call({Napi::Number::New(env, owned->result)});
+            if (env.IsExceptionPending()) {
+                env.GetAndClearPendingException();
+            }
+            if (--completion_pending_ == 0) {
+                completion_tsfn_.Unref(env);
+            }
+        }
+    });
+}
+
 /**
  * N-API exposed functions
  */
@@ -497,26 +887,37 @@ Napi::Value EnqueueWrite(const Napi::CallbackInfo& info) {
     auto operation = std::make_unique<WriteOperation>(fd, offset, size, buffer_data, false, priority);
     
     // Set completion callback if provided
+    PendingCompletion* pending = nullptr;
     if (info.Length() > 5 && info[5].IsFunction()) {
-        Napi::Function callback = info[5].As<Napi::Function>();
-        auto tsfn = Napi::ThreadSafeFunction::New(env, callback, "WriteCompletion", 0, 1);
+        if (!EnsureCompletionChannel(env)) {
+            NapiHelpers::ThrowError(env, "Failed to create write completion channel");
+            return env.Undefined();
+        }
+        pending = new PendingCompletion{Napi::Persistent(info[5].As<Napi::Function>()), 0};
         
-        operation->completion_callback = [tsfn](int result) {
-            tsfn.BlockingCall([result](Napi::Env env, Napi::Function js_callback) {
-                js_callback.Call({Napi::Number::New(env, result)});
-            });
-            tsfn.Release();
+        operation->completion_callback = [pending](int result) {
+            pending->result = result;
+            PostCompletion(pending);
         };
+        operation->error_callback = operation->completion_callback;
     }
     
     // Enqueue the operation
     auto manager = GetGlobalWriteQueueManager();
     if (!manager) {
+        delete pending;
         NapiHelpers::ThrowError(env, "Write queue manager not initialized");
         return env.Undefined();
     }
     
     uint64_t operation_id = manager->EnqueueWrite(fd, std::move(operation));
+    if (pending) {
+        if (operation_id == 0) {
+            delete pending;   // Queue voll: Callback wird nie aufgerufen
+        } else {
+            RefCompletionChannel(env);
+        }
+    }
     return NapiHelpers::CreateBigUint64(env, operation_id);
 }
 
@@ -529,7 +930,6 @@ Napi::Value ProcessWriteQueues(const Napi::CallbackInfo& info) {
     }
     
     Napi::Function executor_js = info[0].As<Napi::Function>();
-    auto executor_tsfn = Napi::ThreadSafeFunction::New(env, executor_js, "WriteExecutor", 0, 1);
     
     auto manager = GetGlobalWriteQueueManager();
     if (!manager) {
@@ -537,36 +937,28 @@ Napi::Value ProcessWriteQueues(const Napi::CallbackInfo& info) {
         return env.Undefined();
     }
     
-    // Create executor function
-    auto executor = [executor_tsfn](const WriteOperation& operation) -> int {
-        int result = -EIO;
+    // Läuft auf dem JS-Thread: Executor direkt aufrufen, kein TSFN
+    auto executor = [env, &executor_js](const WriteOperation& operation) -> int {
+        Napi::HandleScope scope(env);
+        Napi::Object op_obj = Napi::Object::New(env);
+        op_obj.Set("fd", NapiHelpers::CreateBigUint64(env, operation.fd));
+        op_obj.Set("offset", NapiHelpers::CreateBigUint64(env, operation.offset));
+        op_obj.Set("size", NapiHelpers::CreateBigUint64(env, operation.size));
+        op_obj.Set("priority", Napi::Number::New(env, static_cast<int>(operation.priority)));
         
-        auto status = executor_tsfn.BlockingCall([&operation, &result](Napi::Env env, Napi::Function js_executor) {
-            try {
-                Napi::Object op_obj = Napi::Object::New(env);
-                op_obj.Set("fd", NapiHelpers::CreateBigUint64(env, operation.fd));
-                op_obj.Set("offset", NapiHelpers::CreateBigUint64(env, operation.offset));
-                op_obj.Set("size", NapiHelpers::CreateBigUint64(env, operation.size));
-                op_obj.Set("priority", Napi::Number::New(env, static_cast<int>(operation.priority)));
-                
-                // Create buffer view
-                Napi::ArrayBuffer buffer = Napi::ArrayBuffer::New(env, operation.buffer, operation.size);
-                op_obj.Set("buffer", buffer);
-                
-                Napi::Value js_result = js_executor.Call({op_obj});
-                if (js_result.IsNumber()) {
-                    result = js_result.As<Napi::Number>().Int32Value();
-                }
-            } catch (const std::exception& e) {
-                result = -EIO;
-            }
-        });
+        // Create buffer view
+        Napi::ArrayBuffer buffer = Napi::ArrayBuffer::New(env, operation.buffer, operation.size);
+        op_obj.Set("buffer", buffer);
         
-        return (status == napi_ok) ? result : -EIO;
+        Napi::Value js_result = executor_js.Call({op_obj});
+        if (env.IsExceptionPending()) {
+            env.GetAndClearPendingException();
+            return -EIO;
+        }
+        return js_result.IsNumber() ? js_result.As<Napi::Number>().Int32Value() : -EIO;
     };
     
     size_t processed = manager->ProcessAllQueues(executor);
-    executor_tsfn.Release();
     
     return Napi::Number::New(env, static_cast<double>(processed));
 }
@@ -720,4 +1112,134 @@ Napi::Value ConfigureWriteQueues(const Napi::CallbackInfo& info) {
     return Napi::Boolean::New(env, true);
 }
 
-} // namespace fuse_native
\ No newline at end of file
+Napi::Value ConfigureWriteCoalescing(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        NapiHelpers::ThrowTypeError(env, "Expected configuration object");
+        return env.Undefined();
+    }
+    
+    Napi::Object config = info[0].As<Napi::Object>();
+    WriteCoalescingConfig updated = GetWriteCoalescingConfig();
+    
+    Napi::Value enabled = config.Get("enabled");
+    if (!enabled.IsUndefined()) {
+        if (!enabled.IsBoolean()) {
+            NapiHelpers::ThrowTypeError(env, "enabled must be a boolean");
+            return env.Undefined();
+        }
+        updated.enabled = enabled.As<Napi::Boolean>().Value();
+    }
+    
+    const char* keys[2] = {"maxExtentBytes", "maxBatchWrites"};
+    size_t* targets[2] = {&updated.max_extent_bytes, &updated.max_batch_writes};
+    for (size_t i = 0; i < 2; ++i) {
+        Napi::Value value = config.Get(keys[i]);
+        if (value.IsUndefined()) {
+            continue;
+        }
+        if (!value.IsNumber() || value.As<Napi::Number>().DoubleValue() < 1 ||
+            value.As<Napi::Number>().DoubleValue() > UINT32_MAX) {
+            NapiHelpers::ThrowTypeError(env, std::string(keys[i]) + " must be a positive number");
+            return env.Undefined();
+        }
+        *targets[i] = static_cast<size_t>(value.As<Napi::Number>().DoubleValue());
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(coalescing_config_mutex_);
+        coalescing_config_ = updated;
+    }
+    coalescing_enabled_.store(updated.enabled, std::memory_order_release);
+    return Napi::Boolean::New(env, true);
+}
+
+Napi::Value GetWriteCoalescingStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    const WriteCoalescingConfig config = GetWriteCoalescingConfig();
+    const WriteQueueStats stats = GetKernelWriteQueueManager().GetAggregateStats();
+    
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("enabled", Napi::Boolean::New(env, config.enabled));
+    result.Set("maxExtentBytes", Napi::Number::New(env, static_cast<double>(config.max_extent_bytes)));
+    result.Set("maxBatchWrites", Napi::Number::New(env, static_cast<double>(config.max_batch_writes)));
+    result.Set("queuedWrites", NapiHelpers::CreateBigUint64(env, stats.total_operations));
+    result.Set("completedWrites", NapiHelpers::CreateBigUint64(env, stats.completed_operations));
+    result.Set("failedWrites", NapiHelpers::CreateBigUint64(env, stats.failed_operations));
+    result.Set("bytesWritten", NapiHelpers::CreateBigUint64(env, stats.bytes_written));
+    result.Set("batches", NapiHelpers::CreateBigUint64(env, stats.batches));
+    result.Set("mergedWrites", NapiHelpers::CreateBigUint64(env, stats.merged_operations));
+    result.Set("pending", NapiHelpers::CreateBigUint64(env, stats.queue_size));
+    result.Set("openHandles", Napi::Number::New(env, static_cast<double>(
+        GetKernelWriteQueueManager().GetActiveFDs().size())));
+    return result;
+}
+
+Napi::Value ConfigureWriteBehind(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        NapiHelpers::ThrowTypeError(env, "Expected configuration object");
+        return env.Undefined();
+    }
+    
+    Napi::Object config = info[0].As<Napi::Object>();
+    WriteBehindConfig updated = GetWriteBehindConfig();
+    
+    Napi::Value enabled = config.Get("enabled");
+    if (!enabled.IsUndefined()) {
+        if (!enabled.IsBoolean()) {
+            NapiHelpers::ThrowTypeError(env, "enabled must be a boolean");
+            return env.Undefined();
+        }
+        updated.enabled = enabled.As<Napi::Boolean>().Value();
+    }
+    
+    const char* keys[2] = {"maxDirtyBytesPerHandle", "maxDirtyBytes"};
+    size_t* targets[2] = {&updated.max_dirty_bytes_per_handle, &updated.max_dirty_bytes};
+    for (size_t i = 0; i < 2; ++i) {
+        Napi::Value value = config.Get(keys[i]);
+        if (value.IsUndefined()) {
+            continue;
+        }
+        if (!value.IsNumber() || value.As<Napi::Number>().DoubleValue() < 0 ||
+            value.As<Napi::Number>().DoubleValue() > static_cast<double>(SIZE_MAX)) {
+            NapiHelpers::ThrowTypeError(env, std::string(keys[i]) + " must be a non-negative number");
+            return env.Undefined();
+        }
+        *targets[i] = static_cast<size_t>(value.As<Napi::Number>().DoubleValue());
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(write_behind_mutex_);
+        write_behind_config_ = updated;
+    }
+    write_behind_enabled_.store(updated.enabled, std::memory_order_release);
+    return Napi::Boolean::New(env, true);
+}
+
+Napi::Value GetWriteBehindStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    const WriteBehindConfig config = GetWriteBehindConfig();
+    const WriteBehindStats stats = CollectWriteBehindStats();
+    
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("enabled", Napi::Boolean::New(env, config.enabled));
+    result.Set("maxDirtyBytesPerHandle", Napi::Number::New(env, static_cast<double>(config.max_dirty_bytes_per_handle)));
+    result.Set("maxDirtyBytes", Napi::Number::New(env, static_cast<double>(config.max_dirty_bytes)));
+    result.Set("dirtyBytes", Napi::Number::New(env, static_cast<double>(stats.dirty_bytes)));
+    result.Set("peakDirtyBytes", Napi::Number::New(env, static_cast<double>(stats.peak_dirty_bytes)));
+    result.Set("acknowledgedWrites", NapiHelpers::CreateBigUint64(env, stats.acknowledged_writes));
+    result.Set("throttledWrites", NapiHelpers::CreateBigUint64(env, stats.throttled_writes));
+    result.Set("flushedBytes", NapiHelpers::CreateBigUint64(env, stats.flushed_bytes));
+    result.Set("failedWrites", NapiHelpers::CreateBigUint64(env, stats.failed_writes));
+    result.Set("flushes", NapiHelpers::CreateBigUint64(env, stats.flushes));
+    result.Set("avgFlushLatencyMs", Napi::Number::New(env, stats.avg_flush_latency_ms));
+    result.Set("maxFlushLatencyMs", Napi::Number::New(env, stats.max_flush_latency_ms));
+    return result;
+}
+
+} // namespace fuse_native
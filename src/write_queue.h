@@ -15,13 +15,16 @@
 #include <memory>
 #include <mutex>
 #include <condition_variable>
-#include <queue>
+#include <array>
+#include <deque>
 #include <unordered_map>
 #include <atomic>
 #include <functional>
 #include <thread>
 #include <chrono>
 #include <optional>
+#include <vector>
+#include <utility>
 
 namespace fuse_native {
 
@@ -49,6 +52,7 @@ struct WriteOperation {
     std::function<void(int)> completion_callback;     // Completion callback (errno)
     std::function<void(int)> error_callback;          // Error callback
     uint64_t operation_id;                 // Unique operation ID
+    std::shared_ptr<void> owner;           // Opaque originator state (e.g. the FUSE request)
     
     WriteOperation(uint64_t file_fd, uint64_t write_offset, uint64_t write_size,
                    void* write_buffer, bool buffer_owned = false,
@@ -74,7 +78,7 @@ struct WriteOperation {
           priority(other.priority), timestamp(other.timestamp),
           completion_callback(std::move(other.completion_callback)),
           error_callback(std::move(other.error_callback)),
-          operation_id(other.operation_id) {
+          operation_id(other.operation_id), owner(std::move(other.owner)) {
         other.buffer = nullptr;
         other.owns_buffer = false;
     }
@@ -95,6 +99,7 @@ struct WriteOperation {
             completion_callback = std::move(other.completion_callback);
             error_callback = std::move(other.error_callback);
             operation_id = other.operation_id;
+            owner = std::move(other.owner);
             
             other.buffer = nullptr;
             other.owns_buffer = false;
@@ -114,6 +119,8 @@ struct WriteQueueStats {
     uint64_t queue_size = 0;
     uint64_t max_queue_size = 0;
     double avg_latency_ms = 0.0;
+    uint64_t batches = 0;              // Batches taken via TakeBatch
+    uint64_t merged_operations = 0;    // Operations that shared a batch with a predecessor
     std::chrono::steady_clock::time_point creation_time;
     
     WriteQueueStats() : creation_time(std::chrono::steady_clock::now()) {}
@@ -121,6 +128,10 @@ struct WriteQueueStats {
 
 /**
  * Per-FD write queue class
+ *
+ * One FIFO per priority level under a short per-queue lock; Enqueue and
+ * dequeue are O(1). Flush and idle waiters are woken by completion instead
+ * of polling.
  */
 class FDWriteQueue {
 public:
@@ -207,29 +218,124 @@ public:
      * @param enable true to enable priority ordering
      */
     void SetPriorityOrdering(bool enable);
+    
+    /**
+     * Take the next batch of contiguous operations for a single execution
+     *
+     * Pops the head operation and every following operation that continues
+     * it (same priority, offset == end of the previous one) until max_bytes
+     * or max_operations would be exceeded. Only one batch can be in flight;
+     * while it is, an empty vector is returned.
+     * @param max_bytes Upper bound for the summed size (the head is always taken)
+     * @param max_operations Upper bound for the number of operations
+     * @return Operations in submission order, empty if nothing to do
+     */
+    std::vector<std::unique_ptr<WriteOperation>> TakeBatch(size_t max_bytes, size_t max_operations);
+    
+    /**
+     * Complete the in-flight batch
+     *
+     * A non-negative result is the number of bytes written for the whole
+     * batch and is distributed over the operations in order; operations
+     * beyond a short write complete with -EIO. A negative result (errno)
+     * completes every operation with it. Idle waiters run afterwards if
+     * nothing is queued.
+     * @param batch Batch returned by TakeBatch
+     * @param result Bytes written or negative errno
+     * @param latency_ms Execution latency of the batch
+     */
+    void CompleteBatch(std::vector<std::unique_ptr<WriteOperation>>& batch, int64_t result, double latency_ms);
+    
+    /**
+     * Run a callback once the queue is empty and no batch is in flight
+     * @param callback Callback, invoked from CompleteBatch
+     * @return false if the queue is already idle (callback not stored)
+     */
+    bool DeferUntilIdle(std::function<void()> callback);
+    
+    /**
+     * Reserve dirty bytes for a write acknowledged before execution
+     * @param bytes Size of the write
+     * @param limit Per-queue cap (0 = unlimited)
+     * @return false if the cap would be exceeded (nothing reserved)
+     */
+    bool ReserveDirty(size_t bytes, size_t limit);
+    
+    /**
+     * Release dirty bytes once an acknowledged write was executed
+     * @param bytes Size of the write
+     */
+    void ReleaseDirty(size_t bytes);
+    
+    /**
+     * Get bytes acknowledged but not yet executed
+     * @return Dirty bytes of this queue
+     */
+    size_t GetDirtyBytes() const { return dirty_bytes_.load(std::memory_order_acquire); }
+    
+    /**
+     * Remember the failure of an acknowledged write (first error wins)
+     * @param error_code Negative errno
+     */
+    void SetDeferredError(int error_code);
+    
+    /**
+     * Take and clear the remembered failure
+     * @return Negative errno, or 0 if none
+     */
+    int TakeDeferredError();
+    
+    /**
+     * Read the remembered failure without clearing it
+     * @return Negative errno, or 0 if none
+     */
+    int PeekDeferredError() const { return deferred_error_.load(std::memory_order_acquire); }
 
 private:
+    static constexpr size_t kPriorityLevels = 4;
+    
     const uint64_t fd_;
-    size_t max_queue_size_;
+    std::atomic<size_t> max_queue_size_;
     std::atomic<uint64_t> next_operation_id_;
     std::atomic<bool> priority_ordering_enabled_;
     
-    // Queue management
+    // Queue management: ein FIFO pro Prioritätsstufe, O(1) ohne Heap
     mutable std::mutex queue_mutex_;
     std::condition_variable queue_cv_;
-    std::priority_queue<std::unique_ptr<WriteOperation>,
-                       std::vector<std::unique_ptr<WriteOperation>>,
-                       std::function<bool(const std::unique_ptr<WriteOperation>&,
-                                        const std::unique_ptr<WriteOperation>&)>> operation_queue_;
+    std::array<std::deque<std::unique_ptr<WriteOperation>>, kPriorityLevels> levels_;
+    size_t queued_ = 0;
+    size_t executing_ = 0;              // Operations running in ProcessQueue
+    
+    // Batch execution
+    bool batch_in_flight_ = false;
+    std::vector<std::function<void()>> idle_waiters_;
     
-    // Statistics
-    mutable WriteQueueStats stats_;
+    // Write-behind
+    std::atomic<size_t> dirty_bytes_{0};
+    std::atomic<int> deferred_error_{0};
+    
+    // Statistics (guarded by queue_mutex_)
+    WriteQueueStats stats_;
+    
+    /**
+     * First non-empty priority level (requires queue_mutex_)
+     */
+    std::deque<std::unique_ptr<WriteOperation>>* HeadLevelLocked();
     
     /**
-     * Priority comparison function for operation queue
+     * Pop the highest-priority, oldest operation (requires queue_mutex_)
      */
-    static bool ComparePriority(const std::unique_ptr<WriteOperation>& a,
-                               const std::unique_ptr<WriteOperation>& b);
+    std::unique_ptr<WriteOperation> PopHeadLocked();
+    
+    /**
+     * Nothing queued, executing or in flight (requires queue_mutex_)
+     */
+    bool IdleLocked() const { return queued_ == 0 && executing_ == 0 && !batch_in_flight_; }
+    
+    /**
+     * Hand out idle waiters if the queue is idle (requires queue_mutex_)
+     */
+    std::vector<std::function<void()>> TakeIdleWaitersLocked();
     
     /**
      * Update statistics after operation completion
@@ -242,6 +348,11 @@ private:
 
 /**
  * Write queue manager class - manages all per-FD queues
+ *
+ * The FD map is split into shards with their own locks so that thousands of
+ * active descriptors do not contend on a single mutex. Queues are shared:
+ * callers keep the handle they got for as long as they touch the queue, so a
+ * concurrent RemoveQueue never frees a queue with a batch in flight.
  */
 class WriteQueueManager {
 public:
@@ -263,18 +374,86 @@ public:
     /**
      * Get or create write queue for a file descriptor
      * @param fd File descriptor
-     * @return Pointer to write queue, or nullptr on error
+     * @return Write queue, or nullptr on error
+     */
+    std::shared_ptr<FDWriteQueue> GetQueue(uint64_t fd);
+    
+    /**
+     * Look up the write queue of a file descriptor without creating it
+     * @param fd File descriptor
+     * @return Write queue, or nullptr if none exists
      */
-    FDWriteQueue* GetQueue(uint64_t fd);
+    std::shared_ptr<FDWriteQueue> FindQueue(uint64_t fd) const;
     
     /**
      * Remove write queue for a file descriptor
+     *
+     * Unlinks the queue and flushes it; the last holder frees it.
      * @param fd File descriptor
      * @param timeout_ms Timeout for flush operations
      * @return true if queue was removed successfully
      */
     bool RemoveQueue(uint64_t fd, uint32_t timeout_ms = 5000);
     
+    /**
+     * Count an open that returned this handle
+     *
+     * Filesystems may hand out the same handle for every open (often 0), so
+     * the queue, its dirty bytes and its deferred error belong to all of them.
+     * @param fd File handle
+     */
+    void RetainHandle(uint64_t fd);
+    
+    /**
+     * Drop an open counted with RetainHandle
+     * @param fd File handle
+     * @return true if no other open uses the handle (also for untracked handles)
+     */
+    bool ReleaseHandle(uint64_t fd);
+    
+    /**
+     * Forget all open counts (the kernel dropped every open)
+     */
+    void ResetHandles();
+    
+    /**
+     * Open counts of all tracked handles (for a session handoff)
+     */
+    std::vector<std::pair<uint64_t, uint32_t>> SnapshotHandles() const;
+    
+    /**
+     * Take over open counts from SnapshotHandles()
+     *
+     * Counts are set, not added: the kernel's opens did not change.
+     */
+    void RestoreHandles(const std::vector<std::pair<uint64_t, uint32_t>>& counts);
+    
+    /**
+     * Count a queued write on an inode that has not run yet
+     *
+     * Write-behind acknowledges writes before they run; other handles and
+     * inode-wide operations (getattr, setattr, copy_file_range) must not
+     * overtake them.
+     * @param ino Inode written to
+     */
+    void RetainInodeWrite(uint64_t ino);
+    
+    /**
+     * A write counted with RetainInodeWrite has run or failed
+     *
+     * Runs the inode's waiters once no counted write is left.
+     * @param ino Inode written to
+     */
+    void ReleaseInodeWrite(uint64_t ino);
+    
+    /**
+     * Run a callback once no counted write of an inode is pending
+     * @param ino Inode
+     * @param callback Callback, invoked from ReleaseInodeWrite
+     * @return false if nothing is pending (callback not stored)
+     */
+    bool DeferUntilInodeIdle(uint64_t ino, std::function<void()> callback);
+    
     /**
      * Enqueue a write operation
      * @param fd File descriptor
@@ -305,6 +484,12 @@ public:
      */
     bool FlushFD(uint64_t fd, uint32_t timeout_ms = 5000);
     
+    /**
+     * Find a failure of an acknowledged write that no open has collected yet
+     * @return Negative errno of the first such queue, or 0 if none
+     */
+    int PeekDeferredError() const;
+    
     /**
      * Cancel all operations for all file descriptors
      * @param error_code Error code to report
@@ -349,20 +534,135 @@ public:
     void SetFDMaxQueueSize(uint64_t fd, size_t max_size);
 
 private:
-    const size_t default_max_queue_size_;
+    static constexpr size_t kShardCount = 16;
+    
+    struct InodeWrites {
+        size_t pending = 0;
+        std::vector<std::function<void()>> waiters;
+    };
+    
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<uint64_t, std::shared_ptr<FDWriteQueue>> queues;
+        std::unordered_map<uint64_t, uint32_t> opens;   // Opens per handle
+        std::unordered_map<uint64_t, InodeWrites> inode_writes;   // Keyed by inode, not handle
+    };
+    
+    std::atomic<size_t> default_max_queue_size_;
+    
+    // Queue management: nach FD verteilt, damit Lookups nicht global serialisieren
+    std::array<Shard, kShardCount> shards_;
     
-    // Queue management
-    mutable std::mutex queues_mutex_;
-    std::unordered_map<uint64_t, std::unique_ptr<FDWriteQueue>> fd_queues_;
+    Shard& ShardFor(uint64_t fd) { return shards_[fd % kShardCount]; }
+    const Shard& ShardFor(uint64_t fd) const { return shards_[fd % kShardCount]; }
     
     /**
-     * Get or create queue (internal, assumes mutex is locked)
-     * @param fd File descriptor
-     * @return Pointer to write queue
+     * Snapshot of all queues
+     * @return Every linked queue
      */
-    FDWriteQueue* GetQueueLocked(uint64_t fd);
+    std::vector<std::shared_ptr<FDWriteQueue>> CollectQueues() const;
+};
+
+/**
+ * Write coalescing settings for kernel writes
+ */
+struct WriteCoalescingConfig {
+    bool enabled = false;
+    size_t max_extent_bytes = 1024 * 1024;   // Upper bound for one merged write
+    size_t max_batch_writes = 256;           // Upper bound for requests per merged write
 };
 
+/**
+ * Get current write coalescing settings
+ * @return Settings snapshot
+ */
+WriteCoalescingConfig GetWriteCoalescingConfig();
+
+/**
+ * Check whether kernel writes are coalesced
+ * @return true if enabled
+ */
+bool IsWriteCoalescingEnabled();
+
+/**
+ * Get the queue manager for kernel writes, keyed by file handle
+ *
+ * Kept apart from the global manager so that `processWriteQueues()` never
+ * executes queued kernel writes.
+ * @return Manager instance (never null)
+ */
+WriteQueueManager& GetKernelWriteQueueManager();
+
+/**
+ * Write-behind settings for kernel writes
+ */
+struct WriteBehindConfig {
+    bool enabled = false;
+    size_t max_dirty_bytes_per_handle = 8 * 1024 * 1024;   // 0 = unlimited
+    size_t max_dirty_bytes = 64 * 1024 * 1024;             // Across all handles, 0 = unlimited
+};
+
+/**
+ * Write-behind statistics
+ */
+struct WriteBehindStats {
+    uint64_t dirty_bytes = 0;           // Acknowledged, not yet executed
+    uint64_t peak_dirty_bytes = 0;
+    uint64_t acknowledged_writes = 0;   // Answered before execution
+    uint64_t throttled_writes = 0;      // Over the cap, answered after execution
+    uint64_t flushed_bytes = 0;         // Acknowledged bytes executed successfully
+    uint64_t failed_writes = 0;         // Acknowledged writes that failed later
+    uint64_t flushes = 0;               // Acknowledged writes executed (ok or failed)
+    double avg_flush_latency_ms = 0.0;  // Acknowledgement to execution
+    double max_flush_latency_ms = 0.0;
+};
+
+/**
+ * Get current write-behind settings
+ * @return Settings snapshot
+ */
+WriteBehindConfig GetWriteBehindConfig();
+
+/**
+ * Check whether kernel writes may be acknowledged before execution
+ * @return true if enabled
+ */
+bool IsWriteBehindEnabled();
+
+/**
+ * Reserve dirty bytes on a queue and globally
+ *
+ * Counts the write as acknowledged on success and as throttled otherwise.
+ * @param queue Queue of the file handle
+ * @param bytes Size of the write
+ * @return true if the write may be acknowledged now
+ */
+bool ReserveWriteBehind(FDWriteQueue& queue, size_t bytes);
+
+/**
+ * Undo a reservation whose write was never queued
+ * @param queue Queue of the file handle
+ * @param bytes Size of the write
+ */
+void ReleaseWriteBehind(FDWriteQueue& queue, size_t bytes);
+
+/**
+ * Account an acknowledged write after execution
+ *
+ * Releases its dirty bytes and remembers a failure on the queue.
+ * @param queue Queue of the file handle
+ * @param bytes Size of the write
+ * @param result Bytes written or negative errno
+ * @param latency_ms Time since acknowledgement
+ */
+void CompleteWriteBehind(FDWriteQueue& queue, size_t bytes, int result, double latency_ms);
+
+/**
+ * Get write-behind statistics
+ * @return Statistics snapshot
+ */
+WriteBehindStats CollectWriteBehindStats();
+
 /**
  * N-API exposed functions for write queue management
  */
@@ -416,6 +716,35 @@ Napi::Value ResetWriteQueueStats(const Napi::CallbackInfo& info);
  */
 Napi::Value ConfigureWriteQueues(const Napi::CallbackInfo& info);
 
+/**
+ * Configure write coalescing for kernel writes (N-API exposed function)
+ * @param info N-API callback info containing `{enabled?, maxExtentBytes?, maxBatchWrites?}`
+ * @return Boolean indicating success
+ */
+Napi::Value ConfigureWriteCoalescing(const Napi::CallbackInfo& info);
+
+/**
+ * Get write coalescing statistics (N-API exposed function)
+ * @param info N-API callback info
+ * @return Statistics object including the current settings
+ */
+Napi::Value GetWriteCoalescingStats(const Napi::CallbackInfo& info);
+
+/**
+ * Configure write-behind for kernel writes (N-API exposed function)
+ * @param info N-API callback info containing
+ *             `{enabled?, maxDirtyBytesPerHandle?, maxDirtyBytes?}`
+ * @return Boolean indicating success
+ */
+Napi::Value ConfigureWriteBehind(const Napi::CallbackInfo& info);
+
+/**
+ * Get write-behind statistics (N-API exposed function)
+ * @param info N-API callback info
+ * @return Statistics object including the current settings
+ */
+Napi::Value GetWriteBehindStats(const Napi::CallbackInfo& info);
+
 /**
  * Get global write queue manager instance
  * @return Pointer to global manager
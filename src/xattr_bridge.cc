@@ -4,11 +4,14 @@
 #include <fuse3/fuse.h>
 #include <cstring>
 #include <cerrno>
+#include <climits>
 #include <algorithm>
+#include <utility>
 
 #include "xattr_bridge.h"
 #include "napi_helpers.h"
 #include "errno_mapping.h"
+#include "xattr_fd_cache.h"
 
 namespace fuse_native {
 
@@ -51,6 +54,38 @@ int platform_removexattr(const char* path, const char* name) {
 #endif
 }
 
+int platform_fgetxattr(int fd, const char* name, void* value, size_t size) {
+#ifdef __APPLE__
+    return fgetxattr(fd, name, value, size, 0, 0);
+#else
+    return fgetxattr(fd, name, value, size);
+#endif
+}
+
+int platform_fsetxattr(int fd, const char* name, const void* value, size_t size, int flags) {
+#ifdef __APPLE__
+    return fsetxattr(fd, name, value, size, 0, flags);
+#else
+    return fsetxattr(fd, name, value, size, flags);
+#endif
+}
+
+int platform_flistxattr(int fd, char* list, size_t size) {
+#ifdef __APPLE__
+    return flistxattr(fd, list, size, 0);
+#else
+    return flistxattr(fd, list, size);
+#endif
+}
+
+int platform_fremovexattr(int fd, const char* name) {
+#ifdef __APPLE__
+    return fremovexattr(fd, name, 0);
+#else
+    return fremovexattr(fd, name);
+#endif
+}
+
 // Helper functions
 
 std::vector<std::string> ParseAttributeList(const char* buffer, size_t size) {
@@ -92,6 +127,67 @@ int ConvertXAttrFlags(int flags) {
     return flags;
 }
 
+namespace {
+
+// Deckt praktisch alle Labels (SELinux, ACLs, Capabilities) ab
+constexpr size_t kXAttrStackBytes = 4096;
+
+// Wert kann zwischen Größenabfrage und Lesen wachsen
+constexpr int kXAttrRangeRetries = 4;
+
+/**
+ * Stack buffer first, ERANGE -> size query + heap buffer
+ */
+template <typename Call>
+ssize_t ReadVariableXAttr(Call call, std::vector<char>* out) {
+    char stack[kXAttrStackBytes];
+    ssize_t result = call(stack, sizeof(stack));
+    if (result >= 0) {
+        out->assign(stack, stack + result);
+        return result;
+    }
+
+    for (int attempt = 0; errno == ERANGE && attempt < kXAttrRangeRetries; ++attempt) {
+        const ssize_t needed = call(nullptr, 0);
+        if (needed < 0) {
+            return -errno;
+        }
+        out->resize(static_cast<size_t>(needed));
+        result = call(out->data(), out->size());
+        if (result >= 0) {
+            out->resize(static_cast<size_t>(result));
+            return result;
+        }
+    }
+    return -errno;
+}
+
+} // namespace
+
+ssize_t ReadXAttrValue(const char* path, const char* name, std::vector<char>* out) {
+    return ReadVariableXAttr([path, name](char* buffer, size_t size) -> ssize_t {
+        return platform_getxattr(path, name, buffer, size);
+    }, out);
+}
+
+ssize_t ReadXAttrList(const char* path, std::vector<char>* out) {
+    return ReadVariableXAttr([path](char* buffer, size_t size) -> ssize_t {
+        return platform_listxattr(path, buffer, size);
+    }, out);
+}
+
+ssize_t ReadXAttrValueFd(int fd, const char* name, std::vector<char>* out) {
+    return ReadVariableXAttr([fd, name](char* buffer, size_t size) -> ssize_t {
+        return platform_fgetxattr(fd, name, buffer, size);
+    }, out);
+}
+
+ssize_t ReadXAttrListFd(int fd, std::vector<char>* out) {
+    return ReadVariableXAttr([fd](char* buffer, size_t size) -> ssize_t {
+        return platform_flistxattr(fd, buffer, size);
+    }, out);
+}
+
 // N-API implementations
 
 Napi::Value GetXAttr(const Napi::CallbackInfo& info) {
@@ -269,4 +365,407 @@ Napi::Value RemoveXAttr(const Napi::CallbackInfo& info) {
     return NapiHelpers::CreateBigInt64(env, 0);
 }
 
+namespace {
+
+enum class XAttrOp { GET, SET, LIST, REMOVE, BATCH };
+
+/**
+ * One attribute request and its result
+ */
+struct XAttrItem {
+    std::string path;
+    int fd = -1;                        ///< >= 0: f*xattr on this descriptor instead of path
+    uint64_t ino = 0;
+    bool has_ino = false;               ///< Resolve through the inode handle cache
+    std::string name;
+    bool all = false;                   ///< BATCH: every attribute of path
+    std::vector<char> value;            ///< GET result / SET input
+    std::vector<std::string> names;     ///< LIST result / names for `all`
+    std::vector<std::vector<char>> values;  ///< Values for `all`, parallel to names
+    std::vector<int> value_errors;          ///< Per-name errno for `all` (0 = ok)
+    size_t list_size = 0;
+    int flags = 0;
+    int error = 0;                      ///< Positive errno, 0 = ok
+};
+
+/**
+ * Where the syscalls of one item go: caller fd, cached inode handle or path
+ */
+class XAttrTarget {
+public:
+    explicit XAttrTarget(const XAttrItem& item) : fd_(item.fd), path_(item.path.c_str()) {
+        if (fd_ >= 0 || !item.has_ino) {
+            return;
+        }
+        // Miss oder Fehler beim Öffnen: normaler Pfad
+        handle_ = XAttrFdCache::Instance().Acquire(item.ino, item.path);
+        if (!handle_) {
+            return;
+        }
+        if (handle_->PathOnly()) {
+            path_ = handle_->ProcPath().c_str();
+        } else {
+            fd_ = handle_->Fd();
+        }
+    }
+
+    ssize_t ReadValue(const char* name, std::vector<char>* out) const {
+        return fd_ >= 0 ? ReadXAttrValueFd(fd_, name, out) : ReadXAttrValue(path_, name, out);
+    }
+
+    ssize_t ReadList(std::vector<char>* out) const {
+        return fd_ >= 0 ? ReadXAttrListFd(fd_, out) : ReadXAttrList(path_, out);
+    }
+
+    int Set(const char* name, const std::vector<char>& value, int flags) const {
+        const int result = fd_ >= 0
+            ? platform_fsetxattr(fd_, name, value.data(), value.size(), flags)
+            : platform_setxattr(path_, name, value.data(), value.size(), flags);
+        return result < 0 ? errno : 0;
+    }
+
+    int Remove(const char* name) const {
+        const int result = fd_ >= 0 ? platform_fremovexattr(fd_, name) : platform_removexattr(path_, name);
+        return result < 0 ? errno : 0;
+    }
+
+private:
+    int fd_;
+    const char* path_;
+    std::shared_ptr<XAttrHandle> handle_;   ///< Hält den Deskriptor während der Operation offen
+};
+
+/**
+ * Runs xattr syscalls on the libuv thread pool
+ */
+class XAttrWorker : public Napi::AsyncWorker {
+public:
+    XAttrWorker(Napi::Env env, XAttrOp op, std::vector<XAttrItem> items)
+        : Napi::AsyncWorker(env, "fuse-native:xattr"),
+          deferred_(Napi::Promise::Deferred::New(env)),
+          op_(op),
+          items_(std::move(items)) {}
+
+    Napi::Promise Promise() const { return deferred_.Promise(); }
+
+    void Execute() override {
+        for (XAttrItem& item : items_) {
+            ExecuteItem(item);
+        }
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        if (op_ == XAttrOp::BATCH) {
+            Napi::Array result = Napi::Array::New(env, items_.size());
+            for (size_t i = 0; i < items_.size(); ++i) {
+                result.Set(static_cast<uint32_t>(i), BatchResult(env, items_[i]));
+            }
+            deferred_.Resolve(result);
+            return;
+        }
+
+        const XAttrItem& item = items_.front();
+        if (item.error != 0) {
+            deferred_.Reject(NapiHelpers::CreateErrnoError(
+                env, item.error, std::string(OpName()) + " failed: " + errno_to_message(item.error)).Value());
+            return;
+        }
+        switch (op_) {
+            case XAttrOp::GET:
+                deferred_.Resolve(Napi::Buffer<char>::Copy(env, item.value.data(), item.value.size()));
+                break;
+            case XAttrOp::LIST: {
+                Napi::Object obj = Napi::Object::New(env);
+                obj.Set("size", NapiHelpers::CreateBigIntU64(env, static_cast<uint64_t>(item.list_size)));
+                obj.Set("names", NamesArray(env, item.names));
+                deferred_.Resolve(obj);
+                break;
+            }
+            default:
+                deferred_.Resolve(env.Undefined());
+                break;
+        }
+    }
+
+    void OnError(const Napi::Error& error) override {
+        deferred_.Reject(error.Value());
+    }
+
+private:
+    void ExecuteItem(XAttrItem& item) {
+        if (!item.all && (op_ == XAttrOp::GET || op_ == XAttrOp::SET || op_ == XAttrOp::REMOVE ||
+                          op_ == XAttrOp::BATCH) && !IsValidAttributeName(item.name)) {
+            item.error = EINVAL;
+            return;
+        }
+
+        const XAttrTarget target(item);
+        switch (op_) {
+            case XAttrOp::GET:
+                item.error = ToError(target.ReadValue(item.name.c_str(), &item.value));
+                break;
+            case XAttrOp::SET:
+                item.error = target.Set(item.name.c_str(), item.value, ConvertXAttrFlags(item.flags));
+                break;
+            case XAttrOp::REMOVE:
+                item.error = target.Remove(item.name.c_str());
+                break;
+            case XAttrOp::LIST:
+                ReadNames(target, item);
+                break;
+            case XAttrOp::BATCH:
+                if (!item.all) {
+                    item.error = ToError(target.ReadValue(item.name.c_str(), &item.value));
+                    break;
+                }
+                if (ReadNames(target, item)) {
+                    item.values.resize(item.names.size());
+                    item.value_errors.assign(item.names.size(), 0);
+                    for (size_t i = 0; i < item.names.size(); ++i) {
+                        item.value_errors[i] = ToError(target.ReadValue(item.names[i].c_str(), &item.values[i]));
+                    }
+                }
+                break;
+        }
+    }
+
+    static bool ReadNames(const XAttrTarget& target, XAttrItem& item) {
+        std::vector<char> list;
+        const ssize_t size = target.ReadList(&list);
+        if (size < 0) {
+            item.error = static_cast<int>(-size);
+            return false;
+        }
+        item.list_size = static_cast<size_t>(size);
+        item.names = ParseAttributeList(list.data(), list.size());
+        return true;
+    }
+
+    static int ToError(ssize_t result) {
+        return result < 0 ? static_cast<int>(-result) : 0;
+    }
+
+    static Napi::Array NamesArray(Napi::Env env, const std::vector<std::string>& names) {
+        Napi::Array array = Napi::Array::New(env, names.size());
+        for (size_t i = 0; i < names.size(); ++i) {
+            array.Set(static_cast<uint32_t>(i), Napi::String::New(env, names[i]));
+        }
+        return array;
+    }
+
+    static Napi::Object BatchResult(Napi::Env env, const XAttrItem& item) {
+        Napi::Object obj = Napi::Object::New(env);
+        if (item.fd >= 0) {
+            obj.Set("fd", Napi::Number::New(env, item.fd));
+        } else {
+            obj.Set("path", Napi::String::New(env, item.path));
+        }
+        if (item.has_ino) {
+            obj.Set("ino", NapiHelpers::CreateBigUint64(env, item.ino));
+        }
+        if (!item.all) {
+            obj.Set("name", Napi::String::New(env, item.name));
+        }
+        if (item.error != 0) {
+            obj.Set("error", Napi::String::New(env, errno_to_string(item.error)));
+            return obj;
+        }
+        if (!item.all) {
+            obj.Set("value", Napi::Buffer<char>::Copy(env, item.value.data(), item.value.size()));
+            return obj;
+        }
+
+        // Attribute, die zwischen list und get verschwinden, fehlen einfach
+        Napi::Object values = Napi::Object::New(env);
+        for (size_t i = 0; i < item.names.size(); ++i) {
+            if (item.value_errors[i] == 0) {
+                values.Set(item.names[i], Napi::Buffer<char>::Copy(env, item.values[i].data(),
+                                                                    item.values[i].size()));
+            }
+        }
+        obj.Set("values", values);
+        return obj;
+    }
+
+    const char* OpName() const {
+        switch (op_) {
+            case XAttrOp::GET: return "getxattr";
+            case XAttrOp::SET: return "setxattr";
+            case XAttrOp::LIST: return "listxattr";
+            case XAttrOp::REMOVE: return "removexattr";
+            default: return "xattr batch";
+        }
+    }
+
+    Napi::Promise::Deferred deferred_;
+    XAttrOp op_;
+    std::vector<XAttrItem> items_;
+};
+
+bool ReadStringArg(const Napi::CallbackInfo& info, size_t index, const char* what, std::string* out) {
+    if (info.Length() <= index || !info[index].IsString()) {
+        NapiHelpers::ThrowTypeError(info.Env(), std::string(what) + " must be a string");
+        return false;
+    }
+    *out = info[index].As<Napi::String>().Utf8Value();
+    return true;
+}
+
+/**
+ * Decode `{ path?, fd?, ino? }` into the target fields of @p item
+ */
+bool DecodeTargetObject(Napi::Env env, Napi::Object obj, XAttrItem* item) {
+    Napi::Value fd = obj.Get("fd");
+    Napi::Value path = obj.Get("path");
+    Napi::Value ino = obj.Get("ino");
+
+    if (!fd.IsUndefined()) {
+        const double value = fd.IsNumber() ? fd.As<Napi::Number>().DoubleValue() : -1.0;
+        if (value < 0 || value > INT_MAX || value != static_cast<double>(static_cast<int>(value))) {
+            NapiHelpers::ThrowTypeError(env, "fd must be a non-negative integer");
+            return false;
+        }
+        item->fd = static_cast<int>(value);
+        return true;
+    }
+    if (!path.IsString()) {
+        NapiHelpers::ThrowTypeError(env, "Target needs path (string) or fd (number)");
+        return false;
+    }
+    item->path = path.As<Napi::String>().Utf8Value();
+    if (!ino.IsUndefined()) {
+        if (!ino.IsBigInt()) {
+            NapiHelpers::ThrowTypeError(env, "ino must be a bigint");
+            return false;
+        }
+        item->ino = NapiHelpers::GetBigUint64(env, ino);
+        if (env.IsExceptionPending()) {
+            return false;
+        }
+        item->has_ino = true;
+    }
+    return true;
+}
+
+/**
+ * Target argument: path string, fd number or `{ path, ino }`
+ */
+bool ReadTargetArg(const Napi::CallbackInfo& info, size_t index, XAttrItem* item) {
+    Napi::Env env = info.Env();
+    if (info.Length() <= index) {
+        NapiHelpers::ThrowTypeError(env, "path must be a string");
+        return false;
+    }
+    Napi::Value value = info[index];
+    if (value.IsString()) {
+        item->path = value.As<Napi::String>().Utf8Value();
+        return true;
+    }
+    if (value.IsNumber()) {
+        Napi::Object wrapper = Napi::Object::New(env);
+        wrapper.Set("fd", value);
+        return DecodeTargetObject(env, wrapper, item);
+    }
+    if (value.IsObject()) {
+        return DecodeTargetObject(env, value.As<Napi::Object>(), item);
+    }
+    NapiHelpers::ThrowTypeError(env, "path must be a string");
+    return false;
+}
+
+Napi::Value QueueXAttr(Napi::Env env, XAttrOp op, std::vector<XAttrItem> items) {
+    auto* worker = new XAttrWorker(env, op, std::move(items));
+    Napi::Promise promise = worker->Promise();
+    worker->Queue();
+    return promise;
+}
+
+} // namespace
+
+Napi::Value GetXAttrAsync(const Napi::CallbackInfo& info) {
+    XAttrItem item;
+    if (!ReadTargetArg(info, 0, &item) || !ReadStringArg(info, 1, "name", &item.name)) {
+        return info.Env().Undefined();
+    }
+    std::vector<XAttrItem> items;
+    items.push_back(std::move(item));
+    return QueueXAttr(info.Env(), XAttrOp::GET, std::move(items));
+}
+
+Napi::Value SetXAttrAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    XAttrItem item;
+    if (!ReadTargetArg(info, 0, &item) || !ReadStringArg(info, 1, "name", &item.name)) {
+        return env.Undefined();
+    }
+    if (info.Length() < 3 || !info[2].IsBuffer()) {
+        NapiHelpers::ThrowTypeError(env, "Value must be a Buffer");
+        return env.Undefined();
+    }
+    // Kopie: der JS-Buffer darf sich ändern, während der Worker läuft
+    Napi::Buffer<char> value = info[2].As<Napi::Buffer<char>>();
+    item.value.assign(value.Data(), value.Data() + value.Length());
+    item.flags = (info.Length() > 3 && info[3].IsNumber()) ? info[3].As<Napi::Number>().Int32Value() : 0;
+
+    std::vector<XAttrItem> items;
+    items.push_back(std::move(item));
+    return QueueXAttr(env, XAttrOp::SET, std::move(items));
+}
+
+Napi::Value ListXAttrAsync(const Napi::CallbackInfo& info) {
+    XAttrItem item;
+    if (!ReadTargetArg(info, 0, &item)) {
+        return info.Env().Undefined();
+    }
+    std::vector<XAttrItem> items;
+    items.push_back(std::move(item));
+    return QueueXAttr(info.Env(), XAttrOp::LIST, std::move(items));
+}
+
+Napi::Value RemoveXAttrAsync(const Napi::CallbackInfo& info) {
+    XAttrItem item;
+    if (!ReadTargetArg(info, 0, &item) || !ReadStringArg(info, 1, "name", &item.name)) {
+        return info.Env().Undefined();
+    }
+    std::vector<XAttrItem> items;
+    items.push_back(std::move(item));
+    return QueueXAttr(info.Env(), XAttrOp::REMOVE, std::move(items));
+}
+
+Napi::Value GetXAttrBatch(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 1 || !info[0].IsArray()) {
+        NapiHelpers::ThrowTypeError(env, "Expected an array of { path | fd, ino?, name? }");
+        return env.Undefined();
+    }
+
+    Napi::Array requests = info[0].As<Napi::Array>();
+    std::vector<XAttrItem> items;
+    items.reserve(requests.Length());
+    for (uint32_t i = 0; i < requests.Length(); ++i) {
+        Napi::Value entry = requests.Get(i);
+        if (!entry.IsObject()) {
+            NapiHelpers::ThrowTypeError(env, "Batch entries must be objects");
+            return env.Undefined();
+        }
+        Napi::Object obj = entry.As<Napi::Object>();
+        Napi::Value name = obj.Get("name");
+        if (!(name.IsString() || name.IsUndefined())) {
+            NapiHelpers::ThrowTypeError(env, "Batch entry name must be a string");
+            return env.Undefined();
+        }
+        XAttrItem item;
+        if (!DecodeTargetObject(env, obj, &item)) {
+            return env.Undefined();
+        }
+        item.all = name.IsUndefined();
+        if (!item.all) {
+            item.name = name.As<Napi::String>().Utf8Value();
+        }
+        items.push_back(std::move(item));
+    }
+    return QueueXAttr(env, XAttrOp::BATCH, std::move(items));
+}
+
 } // namespace fuse_native
@@ -2,6 +2,7 @@
 #define FUSE_NATIVE_XATTR_BRIDGE_H
 
 #include <napi.h>
+#include <sys/types.h>
 #include <string>
 #include <vector>
 
@@ -58,8 +59,99 @@ Napi::Value ListXAttr(const Napi::CallbackInfo& info);
  */
 Napi::Value RemoveXAttr(const Napi::CallbackInfo& info);
 
+/**
+ * Asynchronous variants (libuv thread pool)
+ *
+ * The syscalls run off the JS thread; each returns a Promise. Failures
+ * reject with an Error carrying `errno` and `code`.
+ *
+ * The target may be a path string, an open fd (number, f*xattr) or
+ * `{ path, ino }`: with the xattr fd cache enabled the inode is addressed
+ * through its cached handle, `path` is only opened on a miss.
+ */
+
+/**
+ * Get extended attribute value
+ *
+ * @param target Path, fd or `{ path, ino }`
+ * @param name Attribute name
+ * @return Promise<Buffer> with the value
+ */
+Napi::Value GetXAttrAsync(const Napi::CallbackInfo& info);
+
+/**
+ * Set extended attribute value
+ *
+ * @param target Path, fd or `{ path, ino }`
+ * @param name Attribute name
+ * @param value Attribute value (Buffer, copied before the call returns)
+ * @param flags Creation flags (XATTR_CREATE, XATTR_REPLACE)
+ * @return Promise<void>
+ */
+Napi::Value SetXAttrAsync(const Napi::CallbackInfo& info);
+
+/**
+ * List extended attribute names
+ *
+ * @param target Path, fd or `{ path, ino }`
+ * @return Promise<{ size: bigint, names: string[] }>
+ */
+Napi::Value ListXAttrAsync(const Napi::CallbackInfo& info);
+
+/**
+ * Remove extended attribute
+ *
+ * @param target Path, fd or `{ path, ino }`
+ * @param name Attribute name
+ * @return Promise<void>
+ */
+Napi::Value RemoveXAttrAsync(const Napi::CallbackInfo& info);
+
+/**
+ * Read many attributes in one worker job
+ *
+ * @param items Array of `{ path | fd, ino?, name }` (one value) or
+ *              `{ path | fd, ino? }` (every attribute: list plus one read per name)
+ * @return Promise<Array<{ path | fd, ino?, name?, value?: Buffer, values?: object, error?: string }>>
+ *         in input order; per-item failures are reported, not thrown
+ */
+Napi::Value GetXAttrBatch(const Napi::CallbackInfo& info);
+
 // Internal helpers
 
+/**
+ * Read an attribute value, trying a stack buffer first
+ *
+ * Most values fit the stack buffer, so a read costs one syscall; only on
+ * ERANGE the size is queried and the read repeated.
+ *
+ * @param path File path
+ * @param name Attribute name
+ * @param out Value bytes
+ * @return Value size or negative errno
+ */
+ssize_t ReadXAttrValue(const char* path, const char* name, std::vector<char>* out);
+
+/**
+ * Read the attribute name list, trying a stack buffer first
+ *
+ * @param path File path
+ * @param out NUL-separated names
+ * @return List size or negative errno
+ */
+ssize_t ReadXAttrList(const char* path, std::vector<char>* out);
+
+/**
+ * ReadXAttrValue on an open file descriptor
+ */
+ssize_t ReadXAttrValueFd(int fd, const char* name, std::vector<char>* out);
+
+/**
+ * ReadXAttrList on an open file descriptor
+ */
+ssize_t ReadXAttrListFd(int fd, std::vector<char>* out);
+
+
 /**
  * Platform-specific getxattr implementation
  * Handles macOS position parameter internally
@@ -82,6 +174,14 @@ int platform_listxattr(const char* path, char* list, size_t size);
  */
 int platform_removexattr(const char* path, const char* name);
 
+/**
+ * Platform-specific fd variants (f*xattr)
+ */
+int platform_fgetxattr(int fd, const char* name, void* value, size_t size);
+int platform_fsetxattr(int fd, const char* name, const void* value, size_t size, int flags);
+int platform_flistxattr(int fd, char* list, size_t size);
+int platform_fremovexattr(int fd, const char* name);
+
 /**
  * Parse attribute names from null-separated list
  * 
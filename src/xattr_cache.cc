@@ -0,0 +1,420 @@
+/**
+ * @file xattr_cache.cc
+ * @brief Native per-inode getxattr/listxattr cache with negative entries
+ */
+
+#include "xattr_cache.h"
+
+#include <cmath>
+
+#include "logging.h"
+#include "napi_helpers.h"
+
+namespace fuse_native {
+
+XAttrCache& XAttrCache::Instance() {
+    static XAttrCache instance;
+    return instance;
+}
+
+void XAttrCache::Configure(double ttl, double negative_ttl, size_t max_entries) {
+    const bool enable = ttl > 0.0 || negative_ttl > 0.0;
+    ttl_ns_.store(static_cast<int64_t>(ttl * 1e9), std::memory_order_relaxed);
+    negative_ttl_ns_.store(static_cast<int64_t>(negative_ttl * 1e9), std::memory_order_relaxed);
+    max_entries_.store(max_entries, std::memory_order_relaxed);
+    shard_capacity_.store(max_entries == 0 ? 0 : (max_entries + kShardCount - 1) / kShardCount,
+                          std::memory_order_relaxed);
+    enabled_.store(enable, std::memory_order_release);
+    Clear();
+    FUSE_LOG_DEBUG("xattr cache: ttl=%.3fs negative_ttl=%.3fs max_entries=%zu",
+                   ttl, negative_ttl, max_entries);
+}
+
+XAttrLookup XAttrCache::LookupValue(fuse_ino_t ino, const std::string& name, Value* value) {
+    if (!Enabled()) {
+        return XAttrLookup::MISS;
+    }
+
+    Shard& shard = ShardFor(ino);
+    const Clock::time_point now = Clock::now();
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto inode = shard.inodes.find(ino);
+        if (inode != shard.inodes.end()) {
+            auto it = inode->second.names.find(name);
+            if (it != inode->second.names.end()) {
+                if (it->second.expires > now) {
+                    if (it->second.negative) {
+                        negative_hits_.fetch_add(1, std::memory_order_relaxed);
+                        return XAttrLookup::NEGATIVE;
+                    }
+                    *value = it->second.value;
+                    hits_.fetch_add(1, std::memory_order_relaxed);
+                    return XAttrLookup::POSITIVE;
+                }
+                inode->second.names.erase(it);
+                shard.count--;
+                expirations_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return XAttrLookup::MISS;
+}
+
+XAttrLookup XAttrCache::LookupList(fuse_ino_t ino, List* list) {
+    if (!Enabled()) {
+        return XAttrLookup::MISS;
+    }
+
+    Shard& shard = ShardFor(ino);
+    const Clock::time_point now = Clock::now();
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto inode = shard.inodes.find(ino);
+        if (inode != shard.inodes.end() && inode->second.list) {
+            if (inode->second.list_expires > now) {
+                *list = inode->second.list;
+                list_hits_.fetch_add(1, std::memory_order_relaxed);
+                return XAttrLookup::POSITIVE;
+            }
+            inode->second.list.reset();
+            shard.count--;
+            expirations_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return XAttrLookup::MISS;
+}
+
+uint64_t XAttrCache::Epoch(fuse_ino_t ino) {
+    Shard& shard = ShardFor(ino);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.epoch;
+}
+
+void XAttrCache::MakeRoomLocked(Shard& shard) {
+    const size_t capacity = shard_capacity_.load(std::memory_order_relaxed);
+    if (capacity == 0 || shard.count < capacity) {
+        return;
+    }
+
+    // Erst abgelaufene Einträge verwerfen, dann notfalls ein ganzes Inode
+    const Clock::time_point now = Clock::now();
+    for (auto inode = shard.inodes.begin(); inode != shard.inodes.end();) {
+        auto& names = inode->second.names;
+        for (auto it = names.begin(); it != names.end();) {
+            if (it->second.expires <= now) {
+                it = names.erase(it);
+                shard.count--;
+                expirations_.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                ++it;
+            }
+        }
+        if (inode->second.list && inode->second.list_expires <= now) {
+            inode->second.list.reset();
+            shard.count--;
+            expirations_.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (names.empty() && !inode->second.list) {
+            inode = shard.inodes.erase(inode);
+        } else {
+            ++inode;
+        }
+    }
+    while (shard.count >= capacity && !shard.inodes.empty()) {
+        evictions_.fetch_add(EraseInodeLocked(shard, shard.inodes.begin()->first),
+                             std::memory_order_relaxed);
+    }
+}
+
+size_t XAttrCache::EraseInodeLocked(Shard& shard, fuse_ino_t ino) {
+    auto inode = shard.inodes.find(ino);
+    if (inode == shard.inodes.end()) {
+        return 0;
+    }
+    const size_t removed = inode->second.names.size() + (inode->second.list ? 1 : 0);
+    shard.count -= removed;
+    shard.inodes.erase(inode);
+    return removed;
+}
+
+void XAttrCache::StoreLocked(Shard& shard, fuse_ino_t ino, const std::string& name, Entry entry) {
+    auto inode = shard.inodes.find(ino);
+    if (inode != shard.inodes.end()) {
+        auto it = inode->second.names.find(name);
+        if (it != inode->second.names.end()) {
+            it->second = std::move(entry);
+            return;
+        }
+    }
+    MakeRoomLocked(shard);
+    shard.inodes[ino].names.emplace(name, std::move(entry));
+    shard.count++;
+}
+
+void XAttrCache::StoreValue(fuse_ino_t ino, const std::string& name, Value value, uint64_t epoch) {
+    const int64_t ttl_ns = ttl_ns_.load(std::memory_order_relaxed);
+    if (!Enabled() || ttl_ns <= 0 || !value) {
+        return;
+    }
+
+    Shard& shard = ShardFor(ino);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.epoch != epoch) {
+        return;
+    }
+    StoreLocked(shard, ino, name,
+                Entry{false, std::move(value), Clock::now() + std::chrono::nanoseconds(ttl_ns)});
+    inserts_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void XAttrCache::StoreNegative(fuse_ino_t ino, const std::string& name, uint64_t epoch) {
+    const int64_t ttl_ns = negative_ttl_ns_.load(std::memory_order_relaxed);
+    if (!Enabled() || ttl_ns <= 0) {
+        return;
+    }
+
+    Shard& shard = ShardFor(ino);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.epoch != epoch) {
+        return;
+    }
+    StoreLocked(shard, ino, name, Entry{true, nullptr, Clock::now() + std::chrono::nanoseconds(ttl_ns)});
+    negative_inserts_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void XAttrCache::StoreList(fuse_ino_t ino, List list, uint64_t epoch) {
+    const int64_t ttl_ns = ttl_ns_.load(std::memory_order_relaxed);
+    if (!Enabled() || ttl_ns <= 0 || !list) {
+        return;
+    }
+
+    Shard& shard = ShardFor(ino);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.epoch != epoch) {
+        return;
+    }
+    auto inode = shard.inodes.find(ino);
+    if (inode == shard.inodes.end() || !inode->second.list) {
+        MakeRoomLocked(shard);
+        shard.count++;
+    }
+    InodeEntry& entry = shard.inodes[ino];
+    entry.list = std::move(list);
+    entry.list_expires = Clock::now() + std::chrono::nanoseconds(ttl_ns);
+    inserts_.fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t XAttrCache::Invalidate(fuse_ino_t ino, const std::string& name) {
+    Shard& shard = ShardFor(ino);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.epoch++;
+    auto inode = shard.inodes.find(ino);
+    if (inode == shard.inodes.end()) {
+        return 0;
+    }
+    size_t removed = inode->second.names.erase(name);
+    if (inode->second.list) {
+        inode->second.list.reset();
+        removed++;
+    }
+    shard.count -= removed;
+    if (inode->second.names.empty()) {
+        shard.inodes.erase(inode);
+    }
+    invalidations_.fetch_add(removed, std::memory_order_relaxed);
+    return removed;
+}
+
+void XAttrCache::InvalidatePositive(fuse_ino_t ino) {
+    Shard& shard = ShardFor(ino);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto inode = shard.inodes.find(ino);
+    if (inode == shard.inodes.end()) {
+        return;
+    }
+    // Negative Einträge bleiben: chmod/chown/write legen keine Attribute an
+    shard.epoch++;
+    size_t removed = 0;
+    auto& names = inode->second.names;
+    for (auto it = names.begin(); it != names.end();) {
+        if (!it->second.negative) {
+            it = names.erase(it);
+            removed++;
+        } else {
+            ++it;
+        }
+    }
+    if (inode->second.list) {
+        inode->second.list.reset();
+        removed++;
+    }
+    shard.count -= removed;
+    if (names.empty()) {
+        shard.inodes.erase(inode);
+    }
+    invalidations_.fetch_add(removed, std::memory_order_relaxed);
+}
+
+size_t XAttrCache::InvalidateInode(fuse_ino_t ino) {
+    Shard& shard = ShardFor(ino);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.epoch++;
+    const size_t removed = EraseInodeLocked(shard, ino);
+    invalidations_.fetch_add(removed, std::memory_order_relaxed);
+    return removed;
+}
+
+void XAttrCache::Clear() {
+    for (Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.epoch++;
+        shard.inodes.clear();
+        shard.count = 0;
+    }
+}
+
+XAttrCacheStats XAttrCache::GetStats() const {
+    XAttrCacheStats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.negative_hits = negative_hits_.load(std::memory_order_relaxed);
+    stats.list_hits = list_hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.inserts = inserts_.load(std::memory_order_relaxed);
+    stats.negative_inserts = negative_inserts_.load(std::memory_order_relaxed);
+    stats.invalidations = invalidations_.load(std::memory_order_relaxed);
+    stats.expirations = expirations_.load(std::memory_order_relaxed);
+    stats.evictions = evictions_.load(std::memory_order_relaxed);
+    stats.max_entries = max_entries_.load(std::memory_order_relaxed);
+    stats.ttl = static_cast<double>(ttl_ns_.load(std::memory_order_relaxed)) / 1e9;
+    stats.negative_ttl = static_cast<double>(negative_ttl_ns_.load(std::memory_order_relaxed)) / 1e9;
+    for (const Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        stats.entries += shard.count;
+        for (const auto& inode : shard.inodes) {
+            for (const auto& kv : inode.second.names) {
+                if (kv.second.negative) {
+                    stats.negative_entries++;
+                }
+            }
+        }
+    }
+    return stats;
+}
+
+void XAttrCache::ResetStats() {
+    hits_.store(0, std::memory_order_relaxed);
+    negative_hits_.store(0, std::memory_order_relaxed);
+    list_hits_.store(0, std::memory_order_relaxed);
+    misses_.store(0, std::memory_order_relaxed);
+    inserts_.store(0, std::memory_order_relaxed);
+    negative_inserts_.store(0, std::memory_order_relaxed);
+    invalidations_.store(0, std::memory_order_relaxed);
+    expirations_.store(0, std::memory_order_relaxed);
+    evictions_.store(0, std::memory_order_relaxed);
+}
+
+Napi::Value ConfigureXAttrCache(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        NapiHelpers::ThrowTypeError(env, "Expected configuration object");
+        return env.Undefined();
+    }
+
+    Napi::Object config = info[0].As<Napi::Object>();
+    auto read_ttl = [&config](const char* key, double* out) {
+        Napi::Value value = config.Get(key);
+        if (value.IsUndefined()) {
+            *out = 0.0;
+            return true;
+        }
+        if (!value.IsNumber()) {
+            return false;
+        }
+        *out = value.As<Napi::Number>().DoubleValue();
+        return std::isfinite(*out) && *out >= 0.0;
+    };
+
+    double ttl = 0.0;
+    double negative_ttl = 0.0;
+    if (!read_ttl("ttl", &ttl) || !read_ttl("negativeTtl", &negative_ttl)) {
+        NapiHelpers::ThrowTypeError(env, "ttl and negativeTtl must be non-negative numbers of seconds");
+        return env.Undefined();
+    }
+
+    size_t max_entries = 0;
+    Napi::Value max_value = config.Get("maxEntries");
+    if (!max_value.IsUndefined()) {
+        if (!max_value.IsNumber() || max_value.As<Napi::Number>().DoubleValue() < 0) {
+            NapiHelpers::ThrowTypeError(env, "maxEntries must be a non-negative number");
+            return env.Undefined();
+        }
+        max_entries = static_cast<size_t>(max_value.As<Napi::Number>().Int64Value());
+    }
+
+    XAttrCache::Instance().Configure(ttl, negative_ttl, max_entries);
+    return Napi::Boolean::New(env, true);
+}
+
+Napi::Value InvalidateXAttrCache(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsBigInt()) {
+        NapiHelpers::ThrowTypeError(env, "Expected ino as bigint");
+        return env.Undefined();
+    }
+
+    const uint64_t ino = NapiHelpers::GetBigUint64(env, info[0]);
+    if (env.IsExceptionPending()) {
+        return env.Undefined();
+    }
+
+    XAttrCache& cache = XAttrCache::Instance();
+    if (info.Length() < 2 || info[1].IsUndefined()) {
+        return Napi::Number::New(env, static_cast<double>(cache.InvalidateInode(static_cast<fuse_ino_t>(ino))));
+    }
+    if (!info[1].IsString()) {
+        NapiHelpers::ThrowTypeError(env, "name must be a string");
+        return env.Undefined();
+    }
+    return Napi::Number::New(env, static_cast<double>(
+        cache.Invalidate(static_cast<fuse_ino_t>(ino), info[1].As<Napi::String>().Utf8Value())));
+}
+
+Napi::Value GetXAttrCacheStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    const XAttrCacheStats stats = XAttrCache::Instance().GetStats();
+    const uint64_t answered = stats.hits + stats.negative_hits + stats.list_hits;
+    const uint64_t requests = answered + stats.misses;
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("hits", NapiHelpers::CreateBigUint64(env, stats.hits));
+    result.Set("negativeHits", NapiHelpers::CreateBigUint64(env, stats.negative_hits));
+    result.Set("listHits", NapiHelpers::CreateBigUint64(env, stats.list_hits));
+    result.Set("misses", NapiHelpers::CreateBigUint64(env, stats.misses));
+    result.Set("inserts", NapiHelpers::CreateBigUint64(env, stats.inserts));
+    result.Set("negativeInserts", NapiHelpers::CreateBigUint64(env, stats.negative_inserts));
+    result.Set("invalidations", NapiHelpers::CreateBigUint64(env, stats.invalidations));
+    result.Set("expirations", NapiHelpers::CreateBigUint64(env, stats.expirations));
+    result.Set("evictions", NapiHelpers::CreateBigUint64(env, stats.evictions));
+    result.Set("hitRate", Napi::Number::New(
+        env, requests == 0 ? 0.0 : static_cast<double>(answered) / static_cast<double>(requests)));
+    result.Set("entries", Napi::Number::New(env, static_cast<double>(stats.entries)));
+    result.Set("negativeEntries", Napi::Number::New(env, static_cast<double>(stats.negative_entries)));
+    result.Set("maxEntries", Napi::Number::New(env, static_cast<double>(stats.max_entries)));
+    result.Set("ttl", Napi::Number::New(env, stats.ttl));
+    result.Set("negativeTtl", Napi::Number::New(env, stats.negative_ttl));
+    return result;
+}
+
+Napi::Value ClearXAttrCache(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    XAttrCache::Instance().Clear();
+    XAttrCache::Instance().ResetStats();
+    return Napi::Boolean::New(env, true);
+}
+
+} // namespace fuse_native
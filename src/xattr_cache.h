@@ -0,0 +1,228 @@
+/**
+ * @file xattr_cache.h
+ * @brief Native per-inode getxattr/listxattr cache with negative entries
+ *
+ * The kernel does not cache xattrs for FUSE and probes some on every write
+ * and exec (`security.capability`, `system.posix_acl_access`); almost all of
+ * these probes end in ENODATA. The bridge records getxattr and listxattr
+ * replies, including ENODATA, and answers repeats itself while they are
+ * younger than the configured TTLs.
+ *
+ * Replies to setxattr and removexattr drop the name and the name list of the
+ * inode. Operations that may strip privileges or rewrite ACLs (setattr,
+ * chmod, chown, truncate, write) drop the positive entries of the inode;
+ * they never create attributes, so negative entries stay valid. Forgotten
+ * inodes are dropped entirely.
+ *
+ * Like the dentry cache, every shard carries an epoch that invalidations
+ * advance; a reply is only stored if the epoch seen at dispatch is current.
+ */
+
+#ifndef XATTR_CACHE_H
+#define XATTR_CACHE_H
+
+#include <napi.h>
+#include <fuse3/fuse_lowlevel.h>
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fuse_native {
+
+// Fehlendes Attribut: ENOATTR (macOS) bzw. ENODATA (Linux)
+#ifdef ENOATTR
+constexpr int kXAttrMissingErrno = ENOATTR;
+#else
+constexpr int kXAttrMissingErrno = ENODATA;
+#endif
+
+/**
+ * xattr cache statistics
+ */
+struct XAttrCacheStats {
+    uint64_t hits = 0;            ///< getxattr answered natively with a value
+    uint64_t negative_hits = 0;   ///< getxattr answered natively with ENODATA
+    uint64_t list_hits = 0;       ///< listxattr answered natively
+    uint64_t misses = 0;          ///< Requests forwarded to JS
+    uint64_t inserts = 0;
+    uint64_t negative_inserts = 0;
+    uint64_t invalidations = 0;
+    uint64_t expirations = 0;
+    uint64_t evictions = 0;
+    size_t entries = 0;           ///< Values, negative entries and name lists
+    size_t negative_entries = 0;
+    size_t max_entries = 0;
+    double ttl = 0.0;             ///< Seconds
+    double negative_ttl = 0.0;    ///< Seconds
+};
+
+/**
+ * Result of an xattr cache lookup
+ */
+enum class XAttrLookup {
+    MISS,
+    POSITIVE,
+    NEGATIVE,
+};
+
+/**
+ * Sharded ino -> (name -> value) cache.
+ */
+class XAttrCache {
+public:
+    static constexpr size_t kShardCount = 16;
+
+    using Value = std::shared_ptr<const std::vector<uint8_t>>;
+    using List = std::shared_ptr<const std::string>;
+
+    static XAttrCache& Instance();
+
+    /**
+     * @brief Configure TTLs and capacity
+     * @param ttl Lifetime of values and name lists in seconds (0 = not cached)
+     * @param negative_ttl Lifetime of ENODATA entries in seconds (0 = not cached)
+     * @param max_entries Capacity across all shards (0 = unbounded)
+     */
+    void Configure(double ttl, double negative_ttl, size_t max_entries);
+
+    bool Enabled() const { return enabled_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Look up a value
+     * @param value Receives the value on POSITIVE
+     */
+    XAttrLookup LookupValue(fuse_ino_t ino, const std::string& name, Value* value);
+
+    /**
+     * @brief Look up the NUL-separated name list
+     * @param list Receives the list on POSITIVE
+     */
+    XAttrLookup LookupList(fuse_ino_t ino, List* list);
+
+    /**
+     * @brief Current epoch of the shard holding @p ino
+     *
+     * Capture before dispatching getxattr/listxattr and pass to Store*().
+     */
+    uint64_t Epoch(fuse_ino_t ino);
+
+    void StoreValue(fuse_ino_t ino, const std::string& name, Value value, uint64_t epoch);
+    void StoreNegative(fuse_ino_t ino, const std::string& name, uint64_t epoch);
+    void StoreList(fuse_ino_t ino, List list, uint64_t epoch);
+
+    /**
+     * @brief Drop one name and the name list of an inode (setxattr/removexattr)
+     * @return Number of removed entries
+     */
+    size_t Invalidate(fuse_ino_t ino, const std::string& name);
+
+    /**
+     * @brief Drop values and the name list, keep negative entries
+     */
+    void InvalidatePositive(fuse_ino_t ino);
+
+    /**
+     * @brief Drop everything cached for an inode
+     * @return Number of removed entries
+     */
+    size_t InvalidateInode(fuse_ino_t ino);
+
+    void Clear();
+
+    XAttrCacheStats GetStats() const;
+
+    void ResetStats();
+
+private:
+    XAttrCache() = default;
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        bool negative;
+        Value value;
+        Clock::time_point expires;
+    };
+
+    struct InodeEntry {
+        std::unordered_map<std::string, Entry> names;
+        List list;
+        Clock::time_point list_expires;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<fuse_ino_t, InodeEntry> inodes;
+        size_t count = 0;             ///< Names plus lists
+        uint64_t epoch = 0;
+    };
+
+    Shard& ShardFor(fuse_ino_t ino) { return shards_[ino % kShardCount]; }
+
+    void StoreLocked(Shard& shard, fuse_ino_t ino, const std::string& name, Entry entry);
+    void MakeRoomLocked(Shard& shard);
+    size_t EraseInodeLocked(Shard& shard, fuse_ino_t ino);
+
+    std::array<Shard, kShardCount> shards_;
+    std::atomic<bool> enabled_{false};
+    std::atomic<int64_t> ttl_ns_{0};
+    std::atomic<int64_t> negative_ttl_ns_{0};
+    std::atomic<size_t> shard_capacity_{0};
+    std::atomic<size_t> max_entries_{0};
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> negative_hits_{0};
+    std::atomic<uint64_t> list_hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> inserts_{0};
+    std::atomic<uint64_t> negative_inserts_{0};
+    std::atomic<uint64_t> invalidations_{0};
+    std::atomic<uint64_t> expirations_{0};
+    std::atomic<uint64_t> evictions_{0};
+};
+
+/**
+ * N-API exposed functions
+ */
+
+/**
+ * Configure the xattr cache (N-API exposed function)
+ * @param info N-API callback info containing `{ttl, negativeTtl, maxEntries?}`
+ * @return Boolean indicating success
+ */
+Napi::Value ConfigureXAttrCache(const Napi::CallbackInfo& info);
+
+/**
+ * Drop cached attributes (N-API exposed function)
+ * @param info N-API callback info containing ino (bigint) and optional name;
+ *             without a name everything cached for the inode is dropped
+ * @return Number of removed entries
+ */
+Napi::Value InvalidateXAttrCache(const Napi::CallbackInfo& info);
+
+/**
+ * Get xattr cache statistics (N-API exposed function)
+ * @param info N-API callback info
+ * @return Object containing statistics
+ */
+Napi::Value GetXAttrCacheStats(const Napi::CallbackInfo& info);
+
+/**
+ * Drop all cached attributes and reset statistics (N-API exposed function)
+ * @param info N-API callback info
+ * @return Boolean indicating success
+ */
+Napi::Value ClearXAttrCache(const Napi::CallbackInfo& info);
+
+} // namespace fuse_native
+
+#endif // XATTR_CACHE_H
@@ -0,0 +1,192 @@
+/**
+ * @file xattr_fd_cache.cc
+ * @brief Inode -> O_PATH handle cache for xattr operations
+ */
+
+#include "xattr_fd_cache.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "logging.h"
+#include "napi_helpers.h"
+
+namespace fuse_native {
+
+namespace {
+
+#ifdef O_PATH
+constexpr int kHandleFlags = O_PATH | O_CLOEXEC;
+constexpr bool kPathOnly = true;
+#else
+// Ohne O_PATH: lesbarer Deskriptor, O_NONBLOCK damit FIFOs nicht blockieren
+constexpr int kHandleFlags = O_RDONLY | O_NONBLOCK | O_CLOEXEC;
+constexpr bool kPathOnly = false;
+#endif
+
+} // namespace
+
+XAttrHandle::XAttrHandle(int fd, bool path_only)
+    : fd_(fd),
+      path_only_(path_only),
+      proc_path_("/proc/self/fd/" + std::to_string(fd)) {}
+
+XAttrHandle::~XAttrHandle() {
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+XAttrFdCache& XAttrFdCache::Instance() {
+    static XAttrFdCache instance;
+    return instance;
+}
+
+void XAttrFdCache::Configure(size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_.store(capacity, std::memory_order_release);
+    EvictLocked(capacity);
+    FUSE_LOG_DEBUG("xattr fd cache: capacity=%zu", capacity);
+}
+
+std::shared_ptr<XAttrHandle> XAttrFdCache::Acquire(uint64_t ino, const std::string& path) {
+    if (!Enabled()) {
+        return nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(ino);
+        if (it != entries_.end()) {
+            lru_.splice(lru_.begin(), lru_, it->second.lru);
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return it->second.handle;
+        }
+    }
+
+    // Pfadauflösung ohne Lock – sie kann auf langsamen Backends dauern
+    const int fd = open(path.c_str(), kHandleFlags);
+    if (fd < 0) {
+        open_errors_.fetch_add(1, std::memory_order_relaxed);
+        FUSE_LOG_DEBUG("xattr fd cache: open %s failed: %s", path.c_str(), std::strerror(errno));
+        return nullptr;
+    }
+    auto handle = std::make_shared<XAttrHandle>(fd, kPathOnly);
+    misses_.fetch_add(1, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const size_t capacity = capacity_.load(std::memory_order_acquire);
+    if (capacity == 0) {
+        return handle;
+    }
+    auto it = entries_.find(ino);
+    if (it != entries_.end()) {
+        // Paralleler Miss hat schon eingetragen; dessen Handle gewinnt
+        lru_.splice(lru_.begin(), lru_, it->second.lru);
+        return it->second.handle;
+    }
+    lru_.push_front(ino);
+    entries_.emplace(ino, Entry{handle, lru_.begin()});
+    EvictLocked(capacity);
+    return handle;
+}
+
+bool XAttrFdCache::Invalidate(uint64_t ino) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(ino);
+    if (it == entries_.end()) {
+        return false;
+    }
+    lru_.erase(it->second.lru);
+    entries_.erase(it);
+    invalidations_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void XAttrFdCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    invalidations_.fetch_add(entries_.size(), std::memory_order_relaxed);
+    entries_.clear();
+    lru_.clear();
+}
+
+void XAttrFdCache::EvictLocked(size_t capacity) {
+    while (entries_.size() > capacity) {
+        entries_.erase(lru_.back());
+        lru_.pop_back();
+        evictions_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+XAttrFdCacheStats XAttrFdCache::GetStats() const {
+    XAttrFdCacheStats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.open_errors = open_errors_.load(std::memory_order_relaxed);
+    stats.evictions = evictions_.load(std::memory_order_relaxed);
+    stats.invalidations = invalidations_.load(std::memory_order_relaxed);
+    stats.capacity = capacity_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.entries = entries_.size();
+    return stats;
+}
+
+Napi::Value ConfigureXAttrFdCache(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        NapiHelpers::ThrowTypeError(env, "Expected configuration object");
+        return env.Undefined();
+    }
+
+    Napi::Value capacity = info[0].As<Napi::Object>().Get("capacity");
+    if (!capacity.IsNumber() || capacity.As<Napi::Number>().DoubleValue() < 0) {
+        NapiHelpers::ThrowTypeError(env, "capacity must be a non-negative number");
+        return env.Undefined();
+    }
+    XAttrFdCache::Instance().Configure(static_cast<size_t>(capacity.As<Napi::Number>().Int64Value()));
+    return Napi::Boolean::New(env, true);
+}
+
+Napi::Value InvalidateXAttrFdCache(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    XAttrFdCache& cache = XAttrFdCache::Instance();
+
+    if (info.Length() < 1 || info[0].IsUndefined()) {
+        const size_t entries = cache.GetStats().entries;
+        cache.Clear();
+        return Napi::Number::New(env, static_cast<double>(entries));
+    }
+    if (!info[0].IsBigInt()) {
+        NapiHelpers::ThrowTypeError(env, "Expected ino as bigint");
+        return env.Undefined();
+    }
+    const uint64_t ino = NapiHelpers::GetBigUint64(env, info[0]);
+    if (env.IsExceptionPending()) {
+        return env.Undefined();
+    }
+    return Napi::Number::New(env, cache.Invalidate(ino) ? 1 : 0);
+}
+
+Napi::Value GetXAttrFdCacheStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    const XAttrFdCacheStats stats = XAttrFdCache::Instance().GetStats();
+    const uint64_t lookups = stats.hits + stats.misses + stats.open_errors;
+
+    Napi::Object result = Napi::Object::New(env);
+    result.Set("hits", NapiHelpers::CreateBigUint64(env, stats.hits));
+    result.Set("misses", NapiHelpers::CreateBigUint64(env, stats.misses));
+    result.Set("openErrors", NapiHelpers::CreateBigUint64(env, stats.open_errors));
+    result.Set("evictions", NapiHelpers::CreateBigUint64(env, stats.evictions));
+    result.Set("invalidations", NapiHelpers::CreateBigUint64(env, stats.invalidations));
+    result.Set("hitRate", Napi::Number::New(
+        env, lookups == 0 ? 0.0 : static_cast<double>(stats.hits) / static_cast<double>(lookups)));
+    result.Set("entries", Napi::Number::New(env, static_cast<double>(stats.entries)));
+    result.Set("capacity", Napi::Number::New(env, static_cast<double>(stats.capacity)));
+    return result;
+}
+
+} // namespace fuse_native
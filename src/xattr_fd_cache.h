@@ -0,0 +1,160 @@
+/**
+ * @file xattr_fd_cache.h
+ * @brief Inode -> O_PATH handle cache for xattr operations
+ *
+ * Every path-based xattr syscall resolves the full path again. Label-heavy
+ * workloads (SELinux contexts, Finder metadata) read a handful of attributes
+ * of the same inode over and over, so the bridge can keep an O_PATH handle
+ * per inode and address the inode through it instead.
+ *
+ * Linux does not allow f*xattr on O_PATH descriptors; the handle is used via
+ * its /proc/self/fd magic link, which resolves in procfs without walking
+ * the backing path. Platforms without O_PATH keep a read-only descriptor
+ * and use the f*xattr calls directly.
+ *
+ * Handles are reference counted: an evicted or invalidated handle stays open
+ * until the last in-flight operation using it finishes.
+ */
+
+#ifndef XATTR_FD_CACHE_H
+#define XATTR_FD_CACHE_H
+
+#include <napi.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace fuse_native {
+
+/**
+ * Cached inode handle
+ */
+class XAttrHandle {
+public:
+    XAttrHandle(int fd, bool path_only);
+    ~XAttrHandle();
+
+    XAttrHandle(const XAttrHandle&) = delete;
+    XAttrHandle& operator=(const XAttrHandle&) = delete;
+
+    int Fd() const { return fd_; }
+
+    /**
+     * @brief true for O_PATH handles: use ProcPath() with the path syscalls
+     */
+    bool PathOnly() const { return path_only_; }
+
+    /**
+     * @brief /proc/self/fd/<fd>
+     */
+    const std::string& ProcPath() const { return proc_path_; }
+
+private:
+    int fd_;
+    bool path_only_;
+    std::string proc_path_;
+};
+
+/**
+ * xattr fd cache statistics
+ */
+struct XAttrFdCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;          ///< Handles opened
+    uint64_t open_errors = 0;     ///< Opens that failed (operation fell back to the path)
+    uint64_t evictions = 0;
+    uint64_t invalidations = 0;
+    size_t entries = 0;
+    size_t capacity = 0;
+};
+
+/**
+ * LRU-bounded inode -> handle cache.
+ */
+class XAttrFdCache {
+public:
+    static XAttrFdCache& Instance();
+
+    /**
+     * @brief Set the capacity (0 = disabled, drops all handles)
+     */
+    void Configure(size_t capacity);
+
+    bool Enabled() const { return capacity_.load(std::memory_order_acquire) > 0; }
+
+    /**
+     * @brief Handle for @p ino, opening @p path on a miss
+     *
+     * The open runs without the cache lock held; blocking callers must be
+     * off the JS thread.
+     *
+     * @return Handle, or nullptr if the cache is disabled or the open failed
+     */
+    std::shared_ptr<XAttrHandle> Acquire(uint64_t ino, const std::string& path);
+
+    /**
+     * @brief Drop the handle of one inode (after unlink/rename of the path)
+     * @return true if a handle was removed
+     */
+    bool Invalidate(uint64_t ino);
+
+    void Clear();
+
+    XAttrFdCacheStats GetStats() const;
+
+private:
+    XAttrFdCache() = default;
+
+    struct Entry {
+        std::shared_ptr<XAttrHandle> handle;
+        std::list<uint64_t>::iterator lru;
+    };
+
+    void EvictLocked(size_t capacity);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, Entry> entries_;
+    std::list<uint64_t> lru_;           ///< Front = most recently used
+    std::atomic<size_t> capacity_{0};
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> open_errors_{0};
+    std::atomic<uint64_t> evictions_{0};
+    std::atomic<uint64_t> invalidations_{0};
+};
+
+/**
+ * N-API exposed functions
+ */
+
+/**
+ * Configure the xattr fd cache (N-API exposed function)
+ * @param info N-API callback info containing `{capacity}`
+ * @return Boolean indicating success
+ */
+Napi::Value ConfigureXAttrFdCache(const Napi::CallbackInfo& info);
+
+/**
+ * Drop cached handles (N-API exposed function)
+ * @param info N-API callback info containing ino (bigint); without it every handle is dropped
+ * @return Number of removed handles
+ */
+Napi::Value InvalidateXAttrFdCache(const Napi::CallbackInfo& info);
+
+/**
+ * Get xattr fd cache statistics (N-API exposed function)
+ * @param info N-API callback info
+ * @return Object containing statistics
+ */
+Napi::Value GetXAttrFdCacheStats(const Napi::CallbackInfo& info);
+
+} // namespace fuse_native
+
+#endif // XATTR_FD_CACHE_H
@@ -16,6 +16,9 @@ import type {
   StatResult,
   DirentEntry,
   ReaddirResult,
+  ColumnarReaddirResult,
+  NativeReadDescriptor,
+  NativeWriteDescriptor,
 } from './types.ts';
 
 import {
@@ -531,6 +534,40 @@ export class DirentUtils {
     };
   }
 
+  /**
+   * Convert directory entries to the columnar readdir format.
+   *
+   * Names are packed as NUL-terminated UTF-8 so the native side can pass
+   * them to fuse_add_direntry without copying.
+   */
+  static toColumnarResult(
+    entries: readonly DirentEntry[],
+    hasMore: boolean = false,
+    nextOffset?: bigint
+  ): ColumnarReaddirResult {
+    const count = entries.length;
+    const inos = new BigUint64Array(count);
+    const offsets = new BigUint64Array(count);
+    const types = new Uint8Array(count);
+    let byteLength = 0;
+    for (const entry of entries) {
+      byteLength += Buffer.byteLength(entry.name, 'utf8') + 1;
+    }
+
+    const names = Buffer.alloc(byteLength);
+    let pos = 0;
+    for (let i = 0; i < count; i++) {
+      const entry = entries[i]!;
+      inos[i] = entry.ino;
+      offsets[i] = entry.nextOffset;
+      types[i] = entry.type;
+      pos += names.write(entry.name, pos, 'utf8');
+      names[pos++] = 0;
+    }
+
+    return { names, inos, offsets, types, hasMore, nextOffset };
+  }
+
   /**
    * Create standard directory entries (. and ..)
    */
@@ -626,6 +663,41 @@ export class BufferUtils {
   }
 }
 
+/**
+ * Native I/O descriptors for read/write handlers
+ */
+export class NativeIo {
+  /**
+   * Let the bridge read from a backing fd instead of returning data
+   */
+  static pread(fd: number, offset: bigint, size?: number): NativeReadDescriptor {
+    return size === undefined ? { op: 'pread', fd, offset } : { op: 'pread', fd, offset, size };
+  }
+
+  /**
+   * Let the bridge write the request data to a backing fd
+   */
+  static pwrite(fd: number, offset: bigint): NativeWriteDescriptor {
+    return { op: 'pwrite', fd, offset };
+  }
+
+  /**
+   * Check whether a handler result is a native I/O descriptor
+   */
+  static isDescriptor(value: unknown): value is NativeReadDescriptor | NativeWriteDescriptor {
+    if (!value || typeof value !== 'object' || ArrayBuffer.isView(value) || value instanceof ArrayBuffer) {
+      return false;
+    }
+    const candidate = value as { op?: unknown; fd?: unknown };
+    return (
+      (candidate.op === 'pread' || candidate.op === 'pwrite') &&
+      typeof candidate.fd === 'number' &&
+      Number.isInteger(candidate.fd) &&
+      candidate.fd >= 0
+    );
+  }
+}
+
 /**
  * Validation utility functions
  */
@@ -701,5 +773,6 @@ export default {
   StatUtils,
   DirentUtils,
   BufferUtils,
+  NativeIo,
   ValidationUtils,
 };
@@ -61,6 +61,7 @@ import { FuseErrno } from './errors.ts';
 import {
     createEffectiveSignal,
     withAbort,
+    throwIfAborted,
     validateAbortOptions,
     type AbortOptions,
 } from './abort.ts';
@@ -82,6 +83,10 @@ import type {
     WriteOperationPriority,
     WriteQueueStats,
     FDWriteQueueConfig,
+    WriteCoalescingConfig,
+    WriteCoalescingStats,
+    WriteBehindConfig,
+    WriteBehindStats,
     WriteCompletionCallback,
     ShutdownState,
     ShutdownStats,
@@ -89,6 +94,39 @@ import type {
     ShutdownCallback,
     FuseOperationName,
     PollHandle,
+    DirSnapshotCacheConfig,
+    DirSnapshotCacheStats,
+    AttrCacheConfig,
+    AttrCacheStats,
+    DentryCacheConfig,
+    DentryCacheStats,
+    XattrCacheConfig,
+    XattrCacheStats,
+    InodeTableConfig,
+    InodeTableStats,
+    PassthroughStats,
+    NativeIoConfig,
+    NativeIoStats,
+    BufferPoolConfig,
+    BufferPoolStats,
+    FileMappingAdvice,
+    FileMappingOptions,
+    FileMappingStats,
+    HashAlgorithm,
+    HashDigest,
+    HashImplementations,
+    WriteDigestConfig,
+    LoggingConfig,
+    LoggingStats,
+    CopyFileRangeOptions,
+    CopyStats,
+    XattrBatchItem,
+    XattrBatchResult,
+    XattrCallOptions,
+    XattrFdCacheConfig,
+    XattrFdCacheStats,
+    Ino,
+    StatResult,
 } from './types.ts';
 
 import { createFuseSession } from './session.ts';
@@ -196,6 +234,35 @@ export type InitCallback = (
     config: FuseConfig
 ) => void | Promise<void>;
 
+/** Target argument of the native xattr workers */
+type XattrTarget = string | number | { path: string; ino: Ino };
+
+function validateXattrName(name: string): void {
+    if (typeof name !== 'string' || !name.length) {
+        throw new Error('Attribute name must be a non-empty string');
+    }
+}
+
+function validateXattrFd(fd: number): number {
+    if (!Number.isInteger(fd) || fd < 0) {
+        throw new TypeError('fd must be a non-negative integer');
+    }
+    return fd;
+}
+
+/**
+ * Map a native errno rejection of the xattr workers to FuseErrno
+ */
+function toXattrErrno<T>(promise: Promise<T>, syscall: string): Promise<T> {
+    return promise.catch((error: unknown) => {
+        const code = (error as { errno?: unknown } | null)?.errno;
+        if (typeof code === 'number') {
+            throw new FuseErrno(code, `${syscall} failed`);
+        }
+        throw error;
+    });
+}
+
 /**
  * Main FUSE Native class
  */
@@ -223,6 +290,41 @@ export class FuseNative {
         return this.binding.getVersion();
     }
 
+    /**
+     * Configure the native logger at runtime
+     *
+     * Lines are queued per thread and written by a background thread, so
+     * `debug` or `trace` can be enabled on a loaded mount without
+     * serializing the FUSE threads on stderr. Records that do not fit into a
+     * full ring are dropped and counted.
+     *
+     * @param config Level, async mode and ring size
+     * @returns Promise resolving to true on success
+     */
+    async configureLogging(config: LoggingConfig): Promise<boolean> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.configureLogging(config));
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Write all queued native log lines to stderr before returning
+     */
+    flushLogs(): void {
+        this.binding.flushLogs();
+    }
+
+    /**
+     * Get native logger statistics
+     */
+    getLoggingStats(): LoggingStats {
+        return this.binding.getLoggingStats();
+    }
+
     /**
      * Create a new FUSE session
      * @param mountpoint - Directory to mount the filesystem
@@ -341,13 +443,18 @@ export class FuseNative {
     /**
      * Copy data between file descriptors using copy_file_range
      *
+     * The copy runs on the libuv thread pool, so long chunked copies do not
+     * block the event loop; several copies run concurrently up to the pool
+     * size. Aborting stops the copy before the next chunk. The promise
+     * settles only once the worker no longer uses the descriptors.
+     *
      * @param fdIn - Source file descriptor
      * @param offsetIn - Source offset (null to use current position)
      * @param fdOut - Destination file descriptor
      * @param offsetOut - Destination offset (null to use current position)
      * @param length - Number of bytes to copy
      * @param flags - Optional copy flags
-     * @param options - Abort and timeout options
+     * @param options - Abort, timeout and progress options
      * @returns Promise resolving to number of bytes copied
      */
     async copyFileRange(
@@ -357,33 +464,40 @@ export class FuseNative {
         offsetOut: bigint | null,
         length: bigint,
         flags: number = 0,
-        options?: AbortOptions
+        options?: CopyFileRangeOptions
     ): Promise<bigint> {
         validateAbortOptions(options);
+        if (options?.onProgress !== undefined && typeof options.onProgress !== 'function') {
+            throw new TypeError('onProgress must be a function');
+        }
         const effectiveSignal = createEffectiveSignal(options);
+        throwIfAborted(effectiveSignal);
+
+        const offsetInValue = offsetIn === null ? 0xffffffffffffffffn : offsetIn;
+        const offsetOutValue = offsetOut === null ? 0xffffffffffffffffn : offsetOut;
+        const copy: { promise: Promise<bigint>; cancel: () => void } = this.binding.copyFileRangeAsync(
+            fdIn,
+            offsetInValue,
+            fdOut,
+            offsetOutValue,
+            length,
+            flags,
+            options?.onProgress
+        );
 
-        const copyPromise = new Promise<bigint>((resolve, reject) => {
-            try {
-                const offsetInValue = offsetIn === null ? 0xffffffffffffffffn : offsetIn;
-                const offsetOutValue =
-                    offsetOut === null ? 0xffffffffffffffffn : offsetOut;
-
-                const result = this.binding.copyFileRange(
-                    fdIn,
-                    offsetInValue,
-                    fdOut,
-                    offsetOutValue,
-                    length,
-                    flags
-                );
-
-                resolve(result);
-            } catch (error) {
-                reject(error);
+        // Nicht sofort ablehnen: erst wenn der Worker die fds losgelassen hat
+        const onAbort = () => copy.cancel();
+        effectiveSignal.addEventListener('abort', onAbort, { once: true });
+        try {
+            return await copy.promise;
+        } catch (error) {
+            if (effectiveSignal.aborted) {
+                throwIfAborted(effectiveSignal);
             }
-        });
-
-        return withAbort(copyPromise, effectiveSignal);
+            throw error;
+        } finally {
+            effectiveSignal.removeEventListener('abort', onAbort);
+        }
     }
 
     /**
@@ -409,11 +523,7 @@ export class FuseNative {
      *
      * @returns Statistics object with operation counts and performance data
      */
-    getCopyStats(): {
-        totalOperations: bigint;
-        totalBytesCopied: bigint;
-        kernelCopySupported: boolean;
-    } {
+    getCopyStats(): CopyStats {
         return this.binding.getCopyStats();
     }
 
@@ -581,6 +691,7 @@ export class FuseNative {
                     'init',
                     'destroy',
                     'lookup',
+                    'forget',
                     'getattr',
                     'setattr',
                     'truncate',
@@ -895,6 +1006,76 @@ export class FuseNative {
         });
     }
 
+    /**
+     * Configure coalescing of kernel writes
+     *
+     * When enabled, kernel writes are queued per file handle. While a write
+     * call is in flight, contiguous writes that arrive are merged into one
+     * extent and handed to the `write` handler in a single call; each kernel
+     * request is answered with its share of the result. flush, fsync and
+     * release wait until the queue of their handle is drained.
+     * @param config - Coalescing settings
+     * @returns Promise resolving to true on success
+     */
+    async configureWriteCoalescing(config: WriteCoalescingConfig): Promise<boolean> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.configureWriteCoalescing(config));
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Get write coalescing statistics
+     * @returns Promise resolving to queue counters and the current settings
+     */
+    async getWriteCoalescingStats(): Promise<WriteCoalescingStats> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.getWriteCoalescingStats());
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Configure write-behind for kernel writes
+     *
+     * When enabled, kernel writes are acknowledged as soon as they are
+     * buffered in the queue of their file handle and executed by the `write`
+     * handler in the background, merged like coalesced writes. Once a dirty
+     * cap is reached, writes are acknowledged only after execution. Failures
+     * are reported by the next flush or fsync of the handle.
+     * @param config - Write-behind settings
+     * @returns Promise resolving to true on success
+     */
+    async configureWriteBehind(config: WriteBehindConfig): Promise<boolean> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.configureWriteBehind(config));
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Get write-behind statistics
+     * @returns Promise resolving to dirty-byte and flush-latency counters
+     */
+    async getWriteBehindStats(): Promise<WriteBehindStats> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.getWriteBehindStats());
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
 // =============================================================================
 // Phase 7: Shutdown Management Functions
 // =============================================================================
@@ -981,6 +1162,7 @@ export class FuseNative {
                     'DRAINING',
                     'UNMOUNTING',
                     'CLOSED',
+                    'HANDING_OFF',
                 ];
                 const state = states[stateValue] || 'RUNNING';
                 resolve(state);
@@ -1087,177 +1269,891 @@ export class FuseNative {
     }
 
 // =============================================================================
-// Extended Attributes (xattr) API
+// Native Caches
 // =============================================================================
 
     /**
-     * Get extended attribute value
+     * Configure the directory snapshot cache
      *
-     * @param path File path
-     * @param name Attribute name
-     * @param size Optional buffer size (0 for size query)
-     * @param options Abort and timeout options
-     * @returns Object with size and optional data buffer
+     * Snapshots are offered by opendir (`snapshot` listing) or readdir
+     * (`snapshot: true`) and serve readdir continuations until releasedir.
+     * @param config - Byte budget (0 disables the cache)
+     * @returns Promise resolving to true if configuration succeeded
      */
-    async getxattr(
-        path: string,
-        name: string,
-        size?: bigint,
-        options?: AbortOptions
-    ): Promise<{ size: bigint; data?: Buffer }> {
-        if (typeof path !== 'string' || !path.length) {
-            throw new Error('Path must be a non-empty string');
-        }
-
-        if (typeof name !== 'string' || !name.length) {
-            throw new Error('Attribute name must be a non-empty string');
-        }
-
-        validateAbortOptions(options);
-        const effectiveSignal = createEffectiveSignal(options);
-
-        const getxattrPromise = Promise.resolve(
-            this.binding.getxattr(path, name, size || 0n)
-        );
-
-        const processResult = getxattrPromise.then(result => {
-            if (typeof result === 'bigint') {
-                // Check if it's an error (negative value)
-                if (result < 0n) {
-                    throw new FuseErrno(Number(-result), 'getxattr failed');
+    async configureDirSnapshotCache(
+        config: DirSnapshotCacheConfig
+    ): Promise<boolean> {
+        return new Promise((resolve, reject) => {
+            try {
+                if (!Number.isFinite(config.maxBytes) || config.maxBytes < 0) {
+                    throw new Error('Invalid maxBytes');
                 }
-                // Size query result - positive or zero values are success
-                return {size: result};
+                resolve(this.binding.configureDirSnapshotCache(config));
+            } catch (error) {
+                reject(error);
             }
+        });
+    }
 
-            // Success with data
-            return {
-                size: result.size,
-                data: result.data,
-            };
+    /**
+     * Get directory snapshot cache statistics
+     * @returns Promise resolving to cache statistics
+     */
+    async getDirSnapshotCacheStats(): Promise<DirSnapshotCacheStats> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.getDirSnapshotCacheStats());
+            } catch (error) {
+                reject(error);
+            }
         });
+    }
 
-        return withAbort(processResult, effectiveSignal);
+    /**
+     * Drop all directory snapshots and reset statistics
+     * @returns Promise resolving to true on success
+     */
+    async clearDirSnapshotCache(): Promise<boolean> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.clearDirSnapshotCache());
+            } catch (error) {
+                reject(error);
+            }
+        });
     }
 
     /**
-     * Set extended attribute value
+     * Configure the native attribute cache
      *
-     * @param path File path
-     * @param name Attribute name
-     * @param value Attribute value
-     * @param flags Creation flags (XATTR_CREATE, XATTR_REPLACE)
-     * @param options Abort and timeout options
+     * Attributes replied by getattr, setattr, lookup, create and readdirplus
+     * are kept per inode and answer later getattr requests without calling
+     * the handler until the TTL expires or a mutating operation drops them.
+     * @param config - TTL in seconds (0 disables the cache) and optional capacity
+     * @returns Promise resolving to true if configuration succeeded
      */
-    async setxattr(
-        path: string,
-        name: string,
-        value: Buffer,
-        flags: number = 0,
-        options?: AbortOptions
-    ): Promise<void> {
-        if (typeof path !== 'string' || !path.length) {
-            throw new Error('Path must be a non-empty string');
-        }
-
-        if (typeof name !== 'string' || !name.length) {
-            throw new Error('Attribute name must be a non-empty string');
-        }
+    async configureAttrCache(config: AttrCacheConfig): Promise<boolean> {
+        return new Promise((resolve, reject) => {
+            try {
+                if (!Number.isFinite(config.ttl) || config.ttl < 0) {
+                    throw new Error('Invalid ttl');
+                }
+                if (config.maxEntries !== undefined &&
+                    (!Number.isInteger(config.maxEntries) || config.maxEntries < 0)) {
+                    throw new Error('Invalid maxEntries');
+                }
+                resolve(this.binding.configureAttrCache(config));
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
 
-        if (!Buffer.isBuffer(value)) {
-            throw new Error('Value must be a Buffer');
-        }
+    /**
+     * Store attributes for an inode, e.g. after an out-of-band change
+     * @param ino - Inode number
+     * @param attr - New attributes
+     * @param timeout - Kernel attribute timeout for replies (seconds, default 1)
+     * @returns Promise resolving to true if the entry was stored
+     */
+    async updateAttrCache(ino: Ino, attr: StatResult, timeout?: number): Promise<boolean> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.updateAttrCache(ino, attr, timeout));
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
 
-        validateAbortOptions(options);
-        const effectiveSignal = createEffectiveSignal(options);
+    /**
+     * Drop cached attributes for an inode
+     * @param ino - Inode number
+     * @returns Promise resolving to true if an entry was removed
+     */
+    async invalidateAttrCache(ino: Ino): Promise<boolean> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.invalidateAttrCache(ino));
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
 
-        const setxattrPromise = Promise.resolve(
-            this.binding.setxattr(path, name, value, flags)
-        ).then(result => {
-            if (result < 0n) {
-                throw new FuseErrno(Number(-result), 'setxattr failed');
+    /**
+     * Get attribute cache statistics
+     * @returns Promise resolving to cache statistics including the hit rate
+     */
+    async getAttrCacheStats(): Promise<AttrCacheStats> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.getAttrCacheStats());
+            } catch (error) {
+                reject(error);
             }
         });
+    }
 
-        return withAbort(setxattrPromise, effectiveSignal);
+    /**
+     * Drop all cached attributes and reset statistics
+     * @returns Promise resolving to true on success
+     */
+    async clearAttrCache(): Promise<boolean> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.clearAttrCache());
+            } catch (error) {
+                reject(error);
+            }
+        });
     }
 
     /**
-     * List extended attribute names
+     * Configure the native dentry (lookup) cache
      *
-     * @param path File path
-     * @param size Optional buffer size (0 for size query)
-     * @param options Abort and timeout options
-     * @returns Object with size and optional names array
+     * Lookup results, including ENOENT, are cached per (parent, name) and
+     * answer repeated lookups without calling the handler. Namespace
+     * operations passing through the bridge drop the names they touch.
+     * @param config - Positive/negative TTLs in seconds and optional capacity
+     * @returns Promise resolving to true if configuration succeeded
      */
-    async listxattr(
-        path: string,
-        size?: bigint,
-        options?: AbortOptions
-    ): Promise<{ size: bigint; names?: string[] }> {
-        if (typeof path !== 'string' || !path.length) {
-            throw new Error('Path must be a non-empty string');
-        }
-
-        validateAbortOptions(options);
-        const effectiveSignal = createEffectiveSignal(options);
-
-        const listxattrPromise = Promise.resolve(
-            this.binding.listxattr(path, size || 0n)
-        ).then(result => {
-            if (typeof result === 'bigint') {
-                // Check if it's an error (negative value)
-                if (result < 0n) {
-                    throw new FuseErrno(Number(-result), 'listxattr failed');
+    async configureDentryCache(config: DentryCacheConfig): Promise<boolean> {
+        return new Promise((resolve, reject) => {
+            try {
+                for (const ttl of [config.entryTtl, config.negativeTtl]) {
+                    if (ttl !== undefined && (!Number.isFinite(ttl) || ttl < 0)) {
+                        throw new Error('Invalid ttl');
+                    }
                 }
-                // Size query result
-                return {size: result};
+                if (config.maxEntries !== undefined &&
+                    (!Number.isInteger(config.maxEntries) || config.maxEntries < 0)) {
+                    throw new Error('Invalid maxEntries');
+                }
+                resolve(this.binding.configureDentryCache(config));
+            } catch (error) {
+                reject(error);
             }
-
-            // Success with names
-            return {
-                size: result.size,
-                names: result.names,
-            };
         });
+    }
 
-        return withAbort(listxattrPromise, effectiveSignal);
+    /**
+     * Drop cached lookups
+     * @param parent - Parent directory inode
+     * @param name - Entry name; omit to drop every name below the parent
+     * @returns Promise resolving to the number of removed entries
+     */
+    async invalidateDentryCache(parent: Ino, name?: string): Promise<number> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.invalidateDentryCache(parent, name));
+            } catch (error) {
+                reject(error);
+            }
+        });
     }
 
     /**
-     * Remove extended attribute
-     *
-     * @param path File path
-     * @param name Attribute name
-     * @param options Abort and timeout options
+     * Get dentry cache statistics
+     * @returns Promise resolving to cache statistics including the hit rate
      */
-    async removexattr(
-        path: string,
-        name: string,
-        options?: AbortOptions
-    ): Promise<void> {
+    async getDentryCacheStats(): Promise<DentryCacheStats> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.getDentryCacheStats());
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Drop all cached lookups and reset statistics
+     * @returns Promise resolving to true on success
+     */
+    async clearDentryCache(): Promise<boolean> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.clearDentryCache());
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Configure the native getxattr/listxattr cache
+     *
+     * Replies of the getxattr and listxattr handlers, including ENODATA, are
+     * answered natively while they are younger than the TTLs. setxattr and
+     * removexattr replies invalidate the inode; only enable it if handler
+     * results do not depend on the caller.
+     *
+     * @param config - TTLs and capacity; all TTLs 0 disables the cache
+     * @returns Promise resolving to true on success
+     */
+    async configureXattrCache(config: XattrCacheConfig): Promise<boolean> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.configureXattrCache(config));
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Drop cached attributes after an out-of-band change in the backend
+     * @param ino - Inode number
+     * @param name - Attribute name; omitted drops everything cached for the inode
+     * @returns Promise resolving to the number of removed entries
+     */
+    async invalidateXattrCache(ino: Ino, name?: string): Promise<number> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.invalidateXattrCache(ino, name));
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Get xattr cache statistics
+     * @returns Promise resolving to hit/miss counters and occupancy
+     */
+    async getXattrCacheStats(): Promise<XattrCacheStats> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.getXattrCacheStats());
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Drop all cached attributes and reset statistics
+     * @returns Promise resolving to true on success
+     */
+    async clearXattrCache(): Promise<boolean> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.clearXattrCache());
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Configure how released inodes are batched for the forget handler
+     * @param config - Batch size and flush interval
+     * @returns Promise resolving to true on success
+     */
+    async configureInodeTable(config: InodeTableConfig): Promise<boolean> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.configureInodeTable(config));
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Get the number of kernel references the inode table holds for an inode
+     * @param ino - Inode number
+     * @returns Promise resolving to the lookup count (0n if untracked)
+     */
+    async getInodeLookupCount(ino: Ino): Promise<bigint> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.getInodeLookupCount(ino));
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Get inode table statistics
+     * @returns Promise resolving to lookup/forget counters and batch state
+     */
+    async getInodeTableStats(): Promise<InodeTableStats> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.getInodeTableStats());
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Get FUSE passthrough statistics
+     * @returns Promise resolving to negotiation state and backing file counters
+     */
+    async getPassthroughStats(): Promise<PassthroughStats> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.getPassthroughStats());
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Configure the native I/O pool that executes pread/pwrite descriptors
+     * @param config Pool configuration
+     * @returns Promise that resolves to true when applied
+     */
+    async configureNativeIo(config: NativeIoConfig): Promise<boolean> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.configureNativeIo(config));
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Get native I/O pool statistics
+     * @returns Promise that resolves to the descriptor I/O counters
+     */
+    async getNativeIoStats(): Promise<NativeIoStats> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.getNativeIoStats());
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Allocate a page-aligned ArrayBuffer backed by the native buffer pool
+     *
+     * The block returns to its size class when the buffer is garbage
+     * collected; its contents are not zeroed.
+     *
+     * @param size Buffer size in bytes
+     * @returns Promise resolving to the buffer
+     */
+    async createManagedBuffer(size: bigint): Promise<ArrayBuffer> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.createManagedBuffer(size));
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Configure the size-classed pool behind managed buffers
+     *
+     * Drops all cached blocks, so the new huge page setting applies to
+     * every block allocated from now on.
+     *
+     * @param config Pool configuration; omitted fields take their defaults
+     * @returns Promise that resolves to true when applied
+     */
+    async configureBufferPool(config: BufferPoolConfig): Promise<boolean> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.configureBufferPool(config));
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Get buffer pool statistics
+     * @returns Promise that resolves to occupancy, GC-deferred bytes and per-class counters
+     */
+    async getBufferPoolStats(): Promise<BufferPoolStats> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.getBufferPoolStats());
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Free all blocks cached by the buffer pool
+     * @returns Promise that resolves to the number of freed bytes
+     */
+    async trimBufferPool(): Promise<number> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.trimBufferPool());
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Map a file range into an external ArrayBuffer
+     *
+     * The mapping is released when the buffer is garbage collected and no
+     * reply is using it. read and read_buf results that are views of the
+     * buffer (for example `Buffer.from(view, offset, length)`) are replied
+     * directly from the mapping without copying. The file must not shrink
+     * below the mapped range while it is mapped.
+     *
+     * @param target Path or open file descriptor
+     * @param options Range, mapping flags and advice
+     * @returns Promise resolving to the view (empty past the end of the file)
+     */
+    async mapFile(target: string | number, options: FileMappingOptions = {}): Promise<ArrayBuffer> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.mapFile(target, options));
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Apply madvise() to a file view or part of it
+     * @param view Buffer returned by `mapFile()` or a view into it
+     * @param advice Advice to apply to the pages covering the view
+     * @returns Promise resolving to true on success
+     */
+    async adviseFileMapping(view: ArrayBuffer | ArrayBufferView, advice: FileMappingAdvice): Promise<boolean> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.adviseFileMapping(view, advice));
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Get file mapping statistics
+     * @returns Promise resolving to live mappings and zero-copy reply counters
+     */
+    async getFileMappingStats(): Promise<FileMappingStats> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.getFileMappingStats());
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Hash a buffer synchronously on the calling thread
+     *
+     * crc32c continues from `seed` (pass the previous result to hash a
+     * stream piecewise), xxh3 uses it as its seed, blake3 ignores it.
+     *
+     * @param algorithm 'crc32c', 'xxh3' or 'blake3'
+     * @param data Buffer or view to hash (not copied)
+     * @param seed Optional seed
+     * @returns number (crc32c), bigint (xxh3) or 32-byte Buffer (blake3)
+     */
+    hashBuffer<A extends HashAlgorithm>(
+        algorithm: A,
+        data: ArrayBuffer | ArrayBufferView,
+        seed?: bigint | number
+    ): HashDigest<A> {
+        return this.binding.hashBuffer(algorithm, data, seed);
+    }
+
+    /**
+     * Hash several buffers on the libuv thread pool
+     *
+     * The buffers are referenced, not copied; do not modify them until the
+     * promise settles. Concurrent calls run on separate pool threads.
+     *
+     * @param algorithm 'crc32c', 'xxh3' or 'blake3'
+     * @param buffers Buffers or views to hash
+     * @param seed Optional seed applied to every buffer
+     * @returns Promise resolving to the digests in input order
+     */
+    async hashBuffers<A extends HashAlgorithm>(
+        algorithm: A,
+        buffers: ReadonlyArray<ArrayBuffer | ArrayBufferView>,
+        seed?: bigint | number
+    ): Promise<HashDigest<A>[]> {
+        return this.binding.hashBuffers(algorithm, buffers, seed);
+    }
+
+    /**
+     * Hash write payloads natively before the handler runs
+     *
+     * write and write_buf handlers then receive `options.digest`, computed on
+     * the FUSE thread. Coalesced writes carry no digest.
+     *
+     * @param config `{ algorithm }`, or `{}` to disable
+     * @returns Promise resolving to true on success
+     */
+    async configureWriteDigest(config: WriteDigestConfig = {}): Promise<boolean> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.configureWriteDigest(config));
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Get the hash kernels selected for this CPU
+     * @returns Backend name per algorithm and the bytes hashed for write digests
+     */
+    getHashImplementations(): HashImplementations {
+        return this.binding.getHashImplementations();
+    }
+
+// =============================================================================
+// Extended Attributes (xattr) API
+// =============================================================================
+
+    /**
+     * Get extended attribute value
+     *
+     * Runs on the libuv pool; the value is read with a single syscall into a
+     * stack buffer unless it is larger than 4 KiB.
+     *
+     * @param path File path
+     * @param name Attribute name
+     * @param size Optional buffer size (0 for size query)
+     * @param options Abort, timeout and inode handle options
+     * @returns Object with size and optional data buffer
+     */
+    async getxattr(
+        path: string,
+        name: string,
+        size?: bigint,
+        options?: XattrCallOptions
+    ): Promise<{ size: bigint; data?: Buffer }> {
+        return this.getxattrTarget(this.xattrPathTarget(path, options), name, size, options);
+    }
+
+    /**
+     * Get extended attribute value of an open file descriptor (fgetxattr)
+     *
+     * @param fd Open file descriptor
+     * @param name Attribute name
+     * @param size Optional buffer size (0 for size query)
+     * @param options Abort and timeout options
+     * @returns Object with size and optional data buffer
+     */
+    async fgetxattr(
+        fd: number,
+        name: string,
+        size?: bigint,
+        options?: AbortOptions
+    ): Promise<{ size: bigint; data?: Buffer }> {
+        return this.getxattrTarget(validateXattrFd(fd), name, size, options);
+    }
+
+    /**
+     * Set extended attribute value
+     *
+     * @param path File path
+     * @param name Attribute name
+     * @param value Attribute value
+     * @param flags Creation flags (XATTR_CREATE, XATTR_REPLACE)
+     * @param options Abort, timeout and inode handle options
+     */
+    async setxattr(
+        path: string,
+        name: string,
+        value: Buffer,
+        flags: number = 0,
+        options?: XattrCallOptions
+    ): Promise<void> {
+        return this.setxattrTarget(this.xattrPathTarget(path, options), name, value, flags, options);
+    }
+
+    /**
+     * Set extended attribute value of an open file descriptor (fsetxattr)
+     *
+     * @param fd Open file descriptor
+     * @param name Attribute name
+     * @param value Attribute value
+     * @param flags Creation flags (XATTR_CREATE, XATTR_REPLACE)
+     * @param options Abort and timeout options
+     */
+    async fsetxattr(
+        fd: number,
+        name: string,
+        value: Buffer,
+        flags: number = 0,
+        options?: AbortOptions
+    ): Promise<void> {
+        return this.setxattrTarget(validateXattrFd(fd), name, value, flags, options);
+    }
+
+    /**
+     * List extended attribute names
+     *
+     * @param path File path
+     * @param size Optional buffer size (0 for size query)
+     * @param options Abort, timeout and inode handle options
+     * @returns Object with size and optional names array
+     */
+    async listxattr(
+        path: string,
+        size?: bigint,
+        options?: XattrCallOptions
+    ): Promise<{ size: bigint; names?: string[] }> {
+        return this.listxattrTarget(this.xattrPathTarget(path, options), size, options);
+    }
+
+    /**
+     * List extended attribute names of an open file descriptor (flistxattr)
+     *
+     * @param fd Open file descriptor
+     * @param size Optional buffer size (0 for size query)
+     * @param options Abort and timeout options
+     * @returns Object with size and optional names array
+     */
+    async flistxattr(
+        fd: number,
+        size?: bigint,
+        options?: AbortOptions
+    ): Promise<{ size: bigint; names?: string[] }> {
+        return this.listxattrTarget(validateXattrFd(fd), size, options);
+    }
+
+    /**
+     * Remove extended attribute
+     *
+     * @param path File path
+     * @param name Attribute name
+     * @param options Abort, timeout and inode handle options
+     */
+    async removexattr(
+        path: string,
+        name: string,
+        options?: XattrCallOptions
+    ): Promise<void> {
+        return this.removexattrTarget(this.xattrPathTarget(path, options), name, options);
+    }
+
+    /**
+     * Remove extended attribute of an open file descriptor (fremovexattr)
+     *
+     * @param fd Open file descriptor
+     * @param name Attribute name
+     * @param options Abort and timeout options
+     */
+    async fremovexattr(
+        fd: number,
+        name: string,
+        options?: AbortOptions
+    ): Promise<void> {
+        return this.removexattrTarget(validateXattrFd(fd), name, options);
+    }
+
+    private xattrPathTarget(path: string, options?: XattrCallOptions): XattrTarget {
         if (typeof path !== 'string' || !path.length) {
             throw new Error('Path must be a non-empty string');
         }
+        if (options?.ino === undefined) {
+            return path;
+        }
+        if (typeof options.ino !== 'bigint') {
+            throw new TypeError('ino must be a bigint');
+        }
+        return {path, ino: options.ino};
+    }
 
-        if (typeof name !== 'string' || !name.length) {
-            throw new Error('Attribute name must be a non-empty string');
+    private getxattrTarget(
+        target: XattrTarget,
+        name: string,
+        size: bigint | undefined,
+        options: AbortOptions | undefined
+    ): Promise<{ size: bigint; data?: Buffer }> {
+        validateXattrName(name);
+        validateAbortOptions(options);
+        const effectiveSignal = createEffectiveSignal(options);
+
+        const getxattrPromise = toXattrErrno(
+            this.binding.getxattrAsync(target, name) as Promise<Buffer>,
+            'getxattr'
+        ).then(data => {
+            const valueSize = BigInt(data.length);
+            // Size query: Wert wurde trotzdem gelesen, nur die Größe zählt
+            if (!size) {
+                return {size: valueSize};
+            }
+            if (valueSize > size) {
+                throw new FuseErrno('ERANGE', 'getxattr failed');
+            }
+            return {size: valueSize, data};
+        });
+
+        return withAbort(getxattrPromise, effectiveSignal);
+    }
+
+    private setxattrTarget(
+        target: XattrTarget,
+        name: string,
+        value: Buffer,
+        flags: number,
+        options: AbortOptions | undefined
+    ): Promise<void> {
+        validateXattrName(name);
+        if (!Buffer.isBuffer(value)) {
+            throw new Error('Value must be a Buffer');
         }
 
         validateAbortOptions(options);
         const effectiveSignal = createEffectiveSignal(options);
 
-        const removexattrPromise = Promise.resolve(
-            this.binding.removexattr(path, name)
+        const setxattrPromise = toXattrErrno(
+            this.binding.setxattrAsync(target, name, value, flags) as Promise<void>,
+            'setxattr'
+        );
+
+        return withAbort(setxattrPromise, effectiveSignal);
+    }
+
+    private listxattrTarget(
+        target: XattrTarget,
+        size: bigint | undefined,
+        options: AbortOptions | undefined
+    ): Promise<{ size: bigint; names?: string[] }> {
+        validateAbortOptions(options);
+        const effectiveSignal = createEffectiveSignal(options);
+
+        const listxattrPromise = toXattrErrno(
+            this.binding.listxattrAsync(target) as Promise<{ size: bigint; names: string[] }>,
+            'listxattr'
         ).then(result => {
-            if (result < 0n) {
-                throw new FuseErrno(Number(-result), 'removexattr failed');
+            if (!size) {
+                return {size: result.size};
             }
+            if (result.size > size) {
+                throw new FuseErrno('ERANGE', 'listxattr failed');
+            }
+            return result;
         });
 
+        return withAbort(listxattrPromise, effectiveSignal);
+    }
+
+    private removexattrTarget(
+        target: XattrTarget,
+        name: string,
+        options: AbortOptions | undefined
+    ): Promise<void> {
+        validateXattrName(name);
+        validateAbortOptions(options);
+        const effectiveSignal = createEffectiveSignal(options);
+
+        const removexattrPromise = toXattrErrno(
+            this.binding.removexattrAsync(target, name) as Promise<void>,
+            'removexattr'
+        );
+
         return withAbort(removexattrPromise, effectiveSignal);
     }
 
+    /**
+     * Read many extended attributes in one native round trip
+     *
+     * All items are read by one worker on the libuv pool. An item without
+     * `name` returns every attribute of its target. Items address a path, an
+     * open `fd`, or a path plus `ino` to go through the xattr fd cache. Failures are reported per
+     * item (`error` holds the errno code) and never reject the batch.
+     *
+     * @param items Attributes to read, results keep this order
+     * @param options Abort and timeout options
+     * @returns Per-item results
+     */
+    async getxattrBatch(
+        items: readonly XattrBatchItem[],
+        options?: AbortOptions
+    ): Promise<XattrBatchResult[]> {
+        if (!Array.isArray(items)) {
+            throw new TypeError('items must be an array');
+        }
+        for (const item of items) {
+            if (item?.fd !== undefined) {
+                validateXattrFd(item.fd);
+            } else if (typeof item?.path !== 'string' || !item.path.length) {
+                throw new TypeError('Batch item needs a non-empty path or an fd');
+            }
+            if (item.ino !== undefined && typeof item.ino !== 'bigint') {
+                throw new TypeError('Batch item ino must be a bigint');
+            }
+            if (item.name !== undefined && (typeof item.name !== 'string' || !item.name.length)) {
+                throw new TypeError('Batch item name must be a non-empty string');
+            }
+        }
+
+        validateAbortOptions(options);
+        const effectiveSignal = createEffectiveSignal(options);
+        if (items.length === 0) {
+            return [];
+        }
+
+        return withAbort(
+            this.binding.getxattrBatch(items) as Promise<XattrBatchResult[]>,
+            effectiveSignal
+        );
+    }
+
+    /**
+     * Configure the inode -> O_PATH handle cache used by xattr calls with `ino`
+     * @param config Cache capacity (0 disables the cache and closes all handles)
+     * @returns Promise resolving to true on success
+     */
+    async configureXattrFdCache(config: XattrFdCacheConfig): Promise<boolean> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.configureXattrFdCache(config));
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Drop cached xattr handles, e.g. after the path of an inode changed
+     * @param ino Inode to drop; omitted drops every handle
+     * @returns Promise resolving to the number of removed handles
+     */
+    async invalidateXattrFdCache(ino?: Ino): Promise<number> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.invalidateXattrFdCache(ino));
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
+    /**
+     * Get xattr fd cache statistics
+     * @returns Promise resolving to hit/miss counters and occupancy
+     */
+    async getXattrFdCacheStats(): Promise<XattrFdCacheStats> {
+        return new Promise((resolve, reject) => {
+            try {
+                resolve(this.binding.getXattrFdCacheStats());
+            } catch (error) {
+                reject(error);
+            }
+        });
+    }
+
     /**
      * Initialize the init bridge for FUSE init callbacks
      */
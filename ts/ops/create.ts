@@ -1,6 +1,7 @@
 import { FuseErrno } from '../errors.ts';
 import { ModeUtils, ValidationUtils } from '../helpers.ts';
 import { ensureStatResult, normalizeTimeout } from './getattr.ts';
+import { validateOpenCacheFlags } from './open.ts';
 import type {
   BaseOperationOptions,
   Ino,
@@ -76,6 +77,7 @@ export async function createWrapper(
   if (typeof fi.flags !== 'number' || !Number.isInteger(fi.flags) || fi.flags < 0) {
     throw new FuseErrno('EIO', 'fi.flags must be a non-negative integer');
   }
+  validateOpenCacheFlags(fi, 'create');
 
   const normalizeTimeoutField = (value: unknown, fallback: Timeout): Timeout => {
     if (typeof value === 'number') {
@@ -15,7 +15,7 @@ export type { MknodResult } from './mknod.ts';
 export { validateCreate, createWrapper } from './create.ts';
 export { validateTruncate, truncateWrapper } from './truncate.ts';
 export type { TruncateResult } from './truncate.ts';
-export { validateOpen, openWrapper } from './open.ts';
+export { validateOpen, validateOpenCacheFlags, openWrapper } from './open.ts';
 export { validateRelease, releaseWrapper } from './release.ts';
 export { validateFlush, flushWrapper } from './flush.ts';
 export type { FlushResult } from './flush.ts';
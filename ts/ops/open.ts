@@ -33,6 +33,28 @@ export function validateOpen(
   }
 }
 
+const OPEN_CACHE_FLAGS = [
+  'direct_io',
+  'keep_cache',
+  'nonseekable',
+  'parallel_direct_writes',
+  'noflush',
+] as const;
+
+/**
+ * Validate the per-open cache policy of an open/create FileInfo.
+ * The bridge maps these fields to the FOPEN_* reply flags; anything that is
+ * not a boolean would be dropped silently there, so reject it here.
+ */
+export function validateOpenCacheFlags(fi: FileInfo, op: 'open' | 'create'): void {
+  for (const key of OPEN_CACHE_FLAGS) {
+    const value = fi[key];
+    if (value !== undefined && typeof value !== 'boolean') {
+      throw new FuseErrno('EIO', `${op} fi.${key} must be a boolean`);
+    }
+  }
+}
+
 export async function openWrapper(
   handlers: { open?: OpenHandler },
   ino: Ino,
@@ -57,6 +79,7 @@ export async function openWrapper(
   if (typeof fi.fh !== 'number' || typeof fi.flags !== 'number') {
     throw new FuseErrno('EIO', 'open handler returned invalid FileInfo');
   }
+  validateOpenCacheFlags(fi, 'open');
 
   return fi;
 }
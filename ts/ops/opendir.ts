@@ -5,7 +5,8 @@ import type {
   FileInfo,
   Flags,
   Ino,
-  OpenHandler,
+  OpendirHandler,
+  OpendirResult,
   RequestContext,
 } from '../types.ts';
 
@@ -35,12 +36,12 @@ export function ensureFileInfoResult(value: unknown): FileInfo {
 }
 
 export async function opendirWrapper(
-  handlers: { opendir?: OpenHandler },
+  handlers: { opendir?: OpendirHandler },
   ino: Ino,
   flags: number,
   context: RequestContext = DEFAULT_CONTEXT,
   options: BaseOperationOptions = DEFAULT_OPTIONS
-): Promise<FileInfo> {
+): Promise<OpendirResult> {
   validateOpendir(ino);
 
   const handler = handlers.opendir;
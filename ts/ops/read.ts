@@ -1,7 +1,8 @@
 import { FuseErrno } from '../errors.ts';
-import { ValidationUtils } from '../helpers.ts';
+import { NativeIo, ValidationUtils } from '../helpers.ts';
 import type {
   Ino,
+  NativeReadDescriptor,
   ReadHandler,
   ReadOptions,
   RequestContext,
@@ -48,7 +49,7 @@ export async function readWrapper(
   ino: Ino,
   context: RequestContext = DEFAULT_CONTEXT,
   options: ReadOptions = DEFAULT_OPTIONS
-): Promise<Buffer> {
+): Promise<Buffer | NativeReadDescriptor> {
   validateRead(ino, options);
 
   const handler = handlers.read;
@@ -57,7 +58,10 @@ export async function readWrapper(
   }
 
   const result = await handler(ino, context, options);
-  if (!(result instanceof ArrayBuffer)) {
+  if (NativeIo.isDescriptor(result) && result.op === 'pread') {
+    return result;
+  }
+  if (!(result instanceof ArrayBuffer) && !ArrayBuffer.isView(result)) {
     throw new FuseErrno('EIO', 'read handler returned invalid result');
   }
 
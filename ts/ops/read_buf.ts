@@ -1,15 +1,16 @@
 import { FuseErrno } from '../errors.ts';
-import { ValidationUtils } from '../helpers.ts';
+import { NativeIo, ValidationUtils } from '../helpers.ts';
 import { FuseBufFlags } from '../types.ts';
 import type {
   FuseBufvec,
   Ino,
+  NativeReadDescriptor,
   ReadBufHandler,
   ReadOptions,
   RequestContext,
 } from '../types.ts';
 
-export type ReadBufResult = FuseBufvec;
+export type ReadBufResult = FuseBufvec | NativeReadDescriptor;
 
 export function validateReadBuf(
   ino: unknown,
@@ -79,8 +80,8 @@ export function validateFuseBufvec(bufvec: unknown): asserts bufvec is FuseBufve
       }
     } else {
       // Memory buffer
-      if (!(buf.mem instanceof ArrayBuffer)) {
-        throw new FuseErrno('EINVAL', `Buffer ${i} mem must be an ArrayBuffer`);
+      if (!(buf.mem instanceof ArrayBuffer) && !ArrayBuffer.isView(buf.mem)) {
+        throw new FuseErrno('EINVAL', `Buffer ${i} mem must be an ArrayBuffer or ArrayBufferView`);
       }
       if (buf.mem.byteLength < buf.size) {
         throw new FuseErrno('EINVAL', `Buffer ${i} mem size must be at least ${buf.size} bytes`);
@@ -105,6 +106,9 @@ export async function readBufWrapper(
   // If there's a dedicated read_buf handler, use it
   if (handlers.read_buf) {
     const result = await handlers.read_buf(ino, context, options);
+    if (NativeIo.isDescriptor(result) && result.op === 'pread') {
+      return result;
+    }
     validateFuseBufvec(result);
     return result;
   }
@@ -115,6 +119,9 @@ export async function readBufWrapper(
   }
 
   const buffer = await handlers.read(ino, context, options);
+  if (NativeIo.isDescriptor(buffer) && buffer.op === 'pread') {
+    return buffer;
+  }
 
   if (!(buffer instanceof ArrayBuffer)) {
     throw new FuseErrno('EIO', 'read handler returned invalid buffer');
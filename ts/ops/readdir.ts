@@ -1,9 +1,10 @@
 import { FuseErrno } from '../errors.ts';
 import { ValidationUtils } from '../helpers.ts';
 import type {
+  AnyReaddirHandler,
+  ColumnarReaddirResult,
   FileInfo,
   Ino,
-  ReaddirHandler,
   ReaddirOptions,
   ReaddirResult,
   RequestContext,
@@ -28,14 +29,72 @@ export function validateReaddir(
   ValidationUtils.validateOffset(offset);
 }
 
+function ensureSnapshotFlag(record: Record<string, unknown>): void {
+  if (record['snapshot'] !== undefined && typeof record['snapshot'] !== 'boolean') {
+    throw new FuseErrno('EIO', 'readdir snapshot must be a boolean when present');
+  }
+}
+
+// Validate the columnar result shape; element contents are checked natively
+function ensureColumnarReaddirResult(
+  record: Record<string, unknown>
+): ColumnarReaddirResult {
+  const inos = record['inos'] as BigUint64Array;
+  const count = inos.length;
+
+  const names = record['names'];
+  if (Array.isArray(names)) {
+    if (names.length < count || names.some((name) => typeof name !== 'string')) {
+      throw new FuseErrno('EIO', 'readdir names must contain a string per ino');
+    }
+  } else if (!(names instanceof Uint8Array)) {
+    throw new FuseErrno('EIO', 'readdir names must be a string array or Uint8Array');
+  }
+
+  const nameLengths = record['nameLengths'];
+  if (nameLengths !== undefined) {
+    if (!(nameLengths instanceof Uint32Array) || nameLengths.length < count) {
+      throw new FuseErrno('EIO', 'readdir nameLengths must be a Uint32Array per ino');
+    }
+  }
+
+  const offsets = record['offsets'];
+  if (offsets !== undefined) {
+    if (!(offsets instanceof BigUint64Array) || offsets.length < count) {
+      throw new FuseErrno('EIO', 'readdir offsets must be a BigUint64Array per ino');
+    }
+  }
+
+  const types = record['types'];
+  if (types !== undefined) {
+    if (!(types instanceof Uint8Array) || types.length < count) {
+      throw new FuseErrno('EIO', 'readdir types must be a Uint8Array per ino');
+    }
+  }
+
+  if (typeof record['hasMore'] !== 'boolean') {
+    throw new FuseErrno('EIO', 'readdir hasMore must be a boolean');
+  }
+
+  ensureSnapshotFlag(record);
+
+  return record as unknown as ColumnarReaddirResult;
+}
+
 // Function to ensure the result from handler is a valid ReaddirResult
-export function ensureReaddirResult(value: unknown): ReaddirResult {
+export function ensureReaddirResult(
+  value: unknown
+): ReaddirResult | ColumnarReaddirResult {
   if (!value || typeof value !== 'object') {
     throw new FuseErrno('EIO', 'readdir handler returned invalid result');
   }
 
   const record = value as Record<string, unknown>;
 
+  if (record['inos'] instanceof BigUint64Array) {
+    return ensureColumnarReaddirResult(record);
+  }
+
   // Validate entries array
   if (!Array.isArray(record['entries'])) {
     throw new FuseErrno('EIO', 'readdir entries must be an array');
@@ -79,17 +138,19 @@ export function ensureReaddirResult(value: unknown): ReaddirResult {
     throw new FuseErrno('EIO', 'readdir nextOffset must be a BigInt when present');
   }
 
+  ensureSnapshotFlag(record);
+
   return value as ReaddirResult;
 }
 
 export async function readdirWrapper(
-  handlers: { readdir?: ReaddirHandler },
+  handlers: { readdir?: AnyReaddirHandler },
   ino: Ino,
   offset: bigint,
   context: RequestContext = DEFAULT_CONTEXT,
   fi?: FileInfo,
   options: ReaddirOptions = DEFAULT_OPTIONS
-): Promise<ReaddirResult> {
+): Promise<ReaddirResult | ColumnarReaddirResult> {
   validateReaddir(ino, offset);
 
   const handler = handlers.readdir;
@@ -1,7 +1,8 @@
 import { FuseErrno } from '../errors.ts';
-import { ValidationUtils } from '../helpers.ts';
+import { NativeIo, ValidationUtils } from '../helpers.ts';
 import type {
   Ino,
+  NativeWriteDescriptor,
   WriteHandler,
   WriteOptions,
   RequestContext,
@@ -49,7 +50,7 @@ export async function writeWrapper(
   data: ArrayBuffer,
   context: RequestContext = DEFAULT_CONTEXT,
   options: WriteOptions = DEFAULT_OPTIONS
-): Promise<number> {
+): Promise<number | NativeWriteDescriptor> {
   validateWrite(ino, data, options);
 
   const handler = handlers.write;
@@ -58,6 +59,9 @@ export async function writeWrapper(
   }
 
   const result = await handler(ino, data, context, options);
+  if (NativeIo.isDescriptor(result) && result.op === 'pwrite') {
+    return result;
+  }
   if (typeof result !== 'number' || !Number.isInteger(result) || result < 0) {
     throw new FuseErrno('EIO', 'write handler returned invalid result');
   }
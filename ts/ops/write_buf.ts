@@ -4,12 +4,13 @@ import { FuseBufFlags } from '../types.ts';
 import type {
   FuseBufvec,
   Ino,
+  NativeWriteDescriptor,
   RequestContext,
   WriteBufHandler,
   WriteOptions,
 } from '../types.ts';
 
-export type WriteBufResult = number;
+export type WriteBufResult = number | NativeWriteDescriptor;
 
 export function validateWriteBuf(
   ino: unknown,
@@ -123,7 +124,7 @@ function flattenBufvec(bufvec: FuseBufvec): ArrayBuffer {
     if (length <= 0) {
       continue;
     }
-    const source = new Uint8Array(buf.mem!, skip, length);
+    const source = new Uint8Array(buf.mem as ArrayBuffer, skip, length);
     target.set(source, cursor);
     cursor += length;
   }
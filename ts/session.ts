@@ -7,10 +7,15 @@
  */
 
 import type {
+  AdoptOptions,
   FuseSession,
   FuseSessionOptions,
   FuseOperationHandlers,
+  HandoffOptions,
+  Ino,
   MountOptions,
+  NotifyOperation,
+  RetrievedPages,
   UnmountOptions,
 } from './types.ts';
 
@@ -75,6 +80,7 @@ export class FuseSessionImpl implements FuseSession {
       maxRead: 131072,
       maxWrite: 131072,
       timeout: 1.0,
+      passthrough: false,
       ...options,
     };
 
@@ -212,6 +218,213 @@ export class FuseSessionImpl implements FuseSession {
     }
   }
 
+  /**
+   * Take over a mount from a previous process instead of mounting
+   *
+   * Listens on `socketPath` until the previous process calls `handoff()`,
+   * then serves the same kernel connection; open files stay valid.
+   * @returns The state the previous process sent, if any
+   */
+  async adopt(options: AdoptOptions): Promise<Buffer | undefined> {
+    if (this.state !== SessionState.CREATED) {
+      throw new FuseErrno('EINVAL', 'Only an unmounted session can adopt a connection');
+    }
+    validateSocketPath(options?.socketPath);
+
+    this.state = SessionState.MOUNTING;
+    let handedState: Buffer | undefined;
+    this.mountPromise = this.performAdopt(options).then((state) => {
+      handedState = state;
+    });
+
+    try {
+      await this.mountPromise;
+      this.state = SessionState.MOUNTED;
+      return handedState;
+    } catch (error) {
+      this.state = SessionState.CREATED;
+      this.mountPromise = null;
+      throw toFuseError(error);
+    }
+  }
+
+  /**
+   * Pass the mounted connection to a successor process
+   *
+   * Stops reading requests, waits for the ones in flight and sends the
+   * connection to the process adopting on `socketPath`. The session is then
+   * destroyed without unmounting; operation handlers stay registered. If the successor does not take over, the
+   * session keeps serving and the promise rejects. Once the connection was sent, a failure (e.g. a timeout
+   * waiting for the successor's answer) still rejects, but the session stops serving and is destroyed, since
+   * the successor may already be reading from it.
+   */
+  async handoff(options: HandoffOptions): Promise<void> {
+    if (this.state !== SessionState.MOUNTED || !this.sessionHandle) {
+      throw new FuseErrno('ENOTCONN', 'Session is not mounted');
+    }
+    validateSocketPath(options?.socketPath);
+    if (this.options.autoUnmount) {
+      throw new FuseErrno('EINVAL', 'autoUnmount sessions cannot be handed off');
+    }
+
+    this.state = SessionState.UNMOUNTING;
+    try {
+      await this.binding.handoffSession(this.sessionHandle, options);
+    } catch (error) {
+      if ((error as { handedOff?: unknown } | null)?.handedOff !== true) {
+        this.state = SessionState.MOUNTED;
+        throw toFuseError(error);
+      }
+      // fd bereits beim Nachfolger: nicht weiterlesen, nur die native Session freigeben
+      try {
+        this.binding.destroySession(this.sessionHandle);
+      } finally {
+        this.sessionHandle = null;
+        this.mountPromise = null;
+        this.state = SessionState.DESTROYED;
+      }
+      throw toFuseError(error);
+    }
+
+    // Die Verbindung gehört jetzt dem Nachfolger: nur die native Session freigeben.
+    // Handler sind prozessweit und bleiben für einen Nachfolger im selben Prozess registriert.
+    try {
+      this.binding.destroySession(this.sessionHandle);
+    } finally {
+      this.sessionHandle = null;
+      this.mountPromise = null;
+      this.state = SessionState.DESTROYED;
+    }
+  }
+
+  /**
+   * Hand this session off during graceful shutdown instead of unmounting it
+   * @param options - Handoff target, or null to unmount again
+   */
+  async setShutdownHandoff(options: HandoffOptions | null): Promise<void> {
+    if (options === null) {
+      this.binding.configureShutdownHandoff(null);
+      return;
+    }
+    validateSocketPath(options.socketPath);
+    if (this.options.autoUnmount) {
+      throw new FuseErrno('EINVAL', 'autoUnmount sessions cannot be handed off');
+    }
+    if (!this.sessionHandle) {
+      throw new FuseErrno('ENOTCONN', 'Session is not mounted');
+    }
+    try {
+      this.binding.configureShutdownHandoff(this.sessionHandle, options);
+    } catch (error) {
+      throw toFuseError(error);
+    }
+  }
+
+  /**
+   * Invalidate cached attributes (and optionally page cache) of an inode
+   * @param ino - Inode number
+   * @param offset - Start of the data range (default 0)
+   * @param length - Range length; 0 = attributes only, negative = to end of file
+   */
+  async notifyInvalInode(ino: Ino, offset = 0n, length = 0n): Promise<void> {
+    await this.notifyOne({ op: 'invalInode', ino, offset, length });
+  }
+
+  /**
+   * Invalidate a directory entry in the kernel dentry cache
+   */
+  async notifyInvalEntry(parent: Ino, name: string): Promise<void> {
+    await this.notifyOne({ op: 'invalEntry', parent, name });
+  }
+
+  /**
+   * Expire a directory entry (kept while in use, revalidated on next access)
+   */
+  async notifyExpireEntry(parent: Ino, name: string): Promise<void> {
+    await this.notifyOne({ op: 'expireEntry', parent, name });
+  }
+
+  /**
+   * Tell the kernel that an entry was deleted behind the mount
+   */
+  async notifyDelete(parent: Ino, child: Ino, name: string): Promise<void> {
+    await this.notifyOne({ op: 'delete', parent, child, name });
+  }
+
+  /**
+   * Send several notifications in order on a native worker thread
+   *
+   * Notifications never run on the JS thread, so they cannot deadlock
+   * against requests that are waiting for a JS handler.
+   * @returns One result per notification: 0 or a negative errno
+   */
+  async notifyBatch(notifications: readonly NotifyOperation[]): Promise<number[]> {
+    this.assertNotifiable();
+    if (notifications.length === 0) {
+      return [];
+    }
+    try {
+      return await this.binding.notifyBatch(this.sessionHandle, notifications);
+    } catch (error) {
+      throw toFuseError(error, -22);
+    }
+  }
+
+  /**
+   * Push data into the kernel page cache of an inode
+   *
+   * Reads of the stored range are answered by the kernel as long as the
+   * pages stay cached; open replies need `keep_cache` so the cache survives
+   * the next open. Storing past the end of file extends the file size.
+   * @param ino - Inode number (must be known to the kernel)
+   * @param offset - File offset of the first byte
+   * @param data - Data to store; referenced, not copied, until the promise settles
+   */
+  async notifyStore(ino: Ino, offset: bigint, data: Uint8Array): Promise<void> {
+    this.assertNotifiable();
+    let result: number;
+    try {
+      result = await this.binding.notifyStore(this.sessionHandle, ino, offset, data);
+    } catch (error) {
+      throw toFuseError(error, -22);
+    }
+    if (result !== 0) {
+      throw new FuseErrno(result, 'notify store failed');
+    }
+  }
+
+  /**
+   * Read back pages the kernel holds in its page cache
+   *
+   * The kernel answers with the contiguous cached range starting at
+   * `offset`, capped at `max_write`. Pending retrieves reject with
+   * `ENOTCONN` when the session is unmounted.
+   * @param ino - Inode number
+   * @param offset - File offset to start at
+   * @param size - Maximum number of bytes
+   */
+  async notifyRetrieve(ino: Ino, offset: bigint, size: number): Promise<RetrievedPages> {
+    this.assertNotifiable();
+    try {
+      return await this.binding.notifyRetrieve(this.sessionHandle, ino, offset, size);
+    } catch (error) {
+      throw toFuseError(error, -22);
+    }
+  }
+
+  private assertNotifiable(): void {
+    if (this.state !== SessionState.MOUNTED || !this.sessionHandle) {
+      throw new FuseErrno('ENOTCONN', 'Session is not mounted');
+    }
+  }
+
+  private async notifyOne(notification: NotifyOperation): Promise<void> {
+    const [result] = await this.notifyBatch([notification]);
+    if (result !== undefined && result !== 0) {
+      throw new FuseErrno(result, `notify ${notification.op} failed`);
+    }
+  }
+
   /**
    * Perform the actual mount operation
    */
@@ -245,6 +458,24 @@ export class FuseSessionImpl implements FuseSession {
     });
   }
 
+  /**
+   * Create the native session and wait for the previous process
+   */
+  private async performAdopt(options: AdoptOptions): Promise<Buffer | undefined> {
+    this.sessionHandle = this.binding.createSession({
+      mountpoint: this.mountpoint,
+      options: this.options,
+    });
+    try {
+      return await this.binding.adoptSession(this.sessionHandle, options);
+    } catch (error) {
+      // Nach einem fehlgeschlagenen Adopt ist die native Session nicht mehr mountbar
+      this.binding.destroySession(this.sessionHandle);
+      this.sessionHandle = null;
+      throw error;
+    }
+  }
+
   /**
    * Perform the actual unmount operation
    */
@@ -308,6 +539,12 @@ export class FuseSessionImpl implements FuseSession {
   }
 }
 
+function validateSocketPath(socketPath: unknown): void {
+  if (typeof socketPath !== 'string' || socketPath.length === 0) {
+    throw new FuseErrno('EINVAL', 'socketPath must be a non-empty string');
+  }
+}
+
 /**
  * Create a new FUSE session
  */
@@ -388,6 +625,7 @@ export const SessionUtils = {
       maxRead: 131072,
       maxWrite: 131072,
       timeout: 1.0,
+      passthrough: false,
     };
   },
 };
@@ -0,0 +1,109 @@
+/**
+ * @file ts/test/integration/buffer-pool.test.ts
+ * @brief Integration test for the size-classed managed buffer pool
+ */
+
+import { afterAll, beforeAll, describe, expect, test } from '@jest/globals';
+import v8 from 'v8';
+import vm from 'vm';
+import { FuseNative, type BufferPoolStats, type FuseSession } from '../../index.ts';
+import { fuseIntegrationSessionSetup } from './integration-setup.ts';
+import { FileSystemOperations } from './file-system-operations.ts';
+import { FileSystem } from './filesystem.ts';
+
+// gc() ohne --expose-gc beim Start von jest
+v8.setFlagsFromString('--expose-gc');
+const gc = vm.runInNewContext('gc') as () => void;
+
+const KiB = 1024;
+const MiB = 1024 * KiB;
+
+describe('Managed buffer pool Integration', () => {
+  let fuse: FuseNative | undefined;
+  let session: FuseSession | undefined;
+
+  beforeAll(async () => {
+    const sessionWrap = await fuseIntegrationSessionSetup(new FileSystemOperations(new FileSystem(), {}), {});
+    fuse = sessionWrap.fuseNative;
+    session = sessionWrap.session;
+  });
+
+  afterAll(async () => {
+    await fuse?.configureBufferPool({});
+    await fuse?.shutdownDispatcher(750);
+    await session?.destroy();
+  });
+
+  // Finalizer laufen nach dem GC asynchron auf dem JS-Thread
+  const collect = async (until: (stats: BufferPoolStats) => boolean): Promise<BufferPoolStats> => {
+    let stats = await fuse!.getBufferPoolStats();
+    for (let i = 0; i < 50 && !until(stats); i++) {
+      gc();
+      await new Promise((resolve) => setTimeout(resolve, 10));
+      stats = await fuse!.getBufferPoolStats();
+    }
+    return stats;
+  };
+
+  test('should recycle blocks per size class after GC', async () => {
+    await fuse!.configureBufferPool({ maxCachedBytes: 32 * MiB });
+    const before = await collect((stats) => stats.gcDeferredBuffers === 0);
+    const classOf = (stats: BufferPoolStats, size: number) => stats.classes.find((c) => c.blockSize === size)!;
+
+    let buffers: ArrayBuffer[] = [];
+    for (let i = 0; i < 8; i++) {
+      buffers.push(await fuse!.createManagedBuffer(BigInt(60 * KiB)));
+    }
+    expect(buffers[0]!.byteLength).toBe(60 * KiB);
+    new Uint8Array(buffers[0]!).fill(0xab);
+
+    let stats = await fuse!.getBufferPoolStats();
+    expect(stats.gcDeferredBuffers - before.gcDeferredBuffers).toBe(8);
+    expect(stats.gcDeferredBytes - before.gcDeferredBytes).toBe(8 * 64 * KiB);
+    expect(classOf(stats, 64 * KiB).outstanding).toBe(8);
+
+    buffers = [];
+    stats = await collect((current) => classOf(current, 64 * KiB).outstanding === 0);
+    expect(classOf(stats, 64 * KiB).cached).toBe(8);
+    expect(stats.cachedBytes).toBe(8 * 64 * KiB);
+    expect(stats.gcDeferredBytes).toBe(before.gcDeferredBytes);
+
+    // Zweite Runde kommt vollständig aus der Freiliste
+    const misses = classOf(stats, 64 * KiB).misses;
+    for (let i = 0; i < 8; i++) {
+      buffers.push(await fuse!.createManagedBuffer(BigInt(64 * KiB)));
+    }
+    stats = await fuse!.getBufferPoolStats();
+    expect(classOf(stats, 64 * KiB).misses).toBe(misses);
+    expect(classOf(stats, 64 * KiB).hits).toBeGreaterThanOrEqual(8n);
+    expect(stats.cachedBytes).toBe(0);
+    expect(stats.hitRate).toBeGreaterThan(0);
+  });
+
+  test('should honour the cache cap and map oversized buffers individually', async () => {
+    await fuse!.configureBufferPool({ maxCachedBytes: 4 * KiB, hugePages: true });
+    const before = await collect((stats) => stats.gcDeferredBuffers === 0);
+    const small = before.classes.find((c) => c.blockSize === 4 * KiB)!;
+
+    let buffers: ArrayBuffer[] = [];
+    buffers.push(await fuse!.createManagedBuffer(100n), await fuse!.createManagedBuffer(200n));
+    buffers.push(await fuse!.createManagedBuffer(BigInt(8 * MiB)));
+    new Uint8Array(buffers[2]!).fill(1);
+
+    let stats = await fuse!.getBufferPoolStats();
+    expect(stats.hugePages).toBe(true);
+    expect(stats.oversizeAllocations - before.oversizeAllocations).toBe(1n);
+    expect(stats.peakGcDeferredBytes).toBeGreaterThanOrEqual(8 * MiB);
+
+    buffers = [];
+    stats = await collect((current) => current.gcDeferredBuffers === 0);
+    const after = stats.classes.find((c) => c.blockSize === 4 * KiB)!;
+    // Nur ein 4K-Block passt unter die Grenze
+    expect(after.cached).toBe(1);
+    expect(after.dropped - small.dropped).toBe(1n);
+    expect(stats.cachedBytes).toBe(4 * KiB);
+
+    expect(await fuse!.trimBufferPool()).toBe(4 * KiB);
+    expect((await fuse!.getBufferPoolStats()).cachedBytes).toBe(0);
+  });
+});
@@ -0,0 +1,156 @@
+/**
+ * @file ts/test/integration/content-hash.test.ts
+ * @brief Integration test for native content hashing and write digests
+ */
+
+import { afterAll, beforeAll, describe, expect, test } from '@jest/globals';
+import fs from 'fs/promises';
+import {
+  FuseNative,
+  type ContentDigest,
+  type FuseSession,
+  type Ino,
+  type NativeWriteDescriptor,
+  type RequestContext,
+  type WriteOptions,
+} from '../../index.ts';
+import { fuseIntegrationSessionSetup } from './integration-setup.ts';
+import { FileSystemOperations } from './file-system-operations.ts';
+import { FileSystem } from './filesystem.ts';
+
+// Muster der Referenz-Testvektoren: Byte i = i % 251
+const pattern = (length: number): Buffer => Buffer.from(Array.from({ length }, (_, i) => i % 251));
+
+describe('Content hash Integration', () => {
+  const filesystem = new FileSystem();
+  const defaultOperations = new FileSystemOperations(filesystem, {});
+  const filesystemOperations = new FileSystemOperations(filesystem, {});
+  let fuse: FuseNative | undefined;
+  let session: FuseSession | undefined;
+  let mountPoint = '';
+
+  beforeAll(async () => {
+    const sessionWrap = await fuseIntegrationSessionSetup(filesystemOperations, {});
+    fuse = sessionWrap.fuseNative;
+    session = sessionWrap.session;
+    await session.mount();
+    mountPoint = sessionWrap.mountPoint;
+  });
+
+  afterAll(async () => {
+    await fuse?.configureWriteDigest({});
+    await session?.unmount();
+    await fuse?.shutdownDispatcher(750);
+    await session?.destroy();
+  });
+
+  test('should match the reference vectors', () => {
+    const check = Buffer.from('123456789');
+    expect(fuse!.hashBuffer('crc32c', check)).toBe(0xe3069283);
+    expect(fuse!.hashBuffer('xxh3', new ArrayBuffer(0))).toBe(0x2d06800538d394c2n);
+    expect(fuse!.hashBuffer('xxh3', Buffer.from('hello world'))).toBe(0xd447b1ea40e6988bn);
+    expect(fuse!.hashBuffer('blake3', Buffer.from('abc')).toString('hex')).toBe(
+      '6437b3ac38465133ffb63b75273a8db548c558465d79db03fd359c6cd5bd9d85'
+    );
+
+    // Mehrere Blöcke / Chunks
+    const large = pattern(100000);
+    expect(fuse!.hashBuffer('crc32c', large)).toBe(0x7247f66b);
+    expect(fuse!.hashBuffer('xxh3', large)).toBe(0x42c23aeead96750dn);
+    expect(fuse!.hashBuffer('xxh3', large, 42n)).toBe(0x6338586e7d48c4d6n);
+    expect(fuse!.hashBuffer('blake3', large).toString('hex')).toBe(
+      'd93c23eedaf165a7e0be908ba86f1a7a520d568d2d13cde787c8580c5c72cc54'
+    );
+
+    // Views hashen nur ihren Ausschnitt; CRC32C lässt sich verketten
+    const view = new Uint8Array(large.buffer, large.byteOffset + 1000, 5000);
+    expect(fuse!.hashBuffer('xxh3', view)).toBe(fuse!.hashBuffer('xxh3', Buffer.from(view)));
+    const head = fuse!.hashBuffer('crc32c', large.subarray(0, 12345));
+    expect(fuse!.hashBuffer('crc32c', large.subarray(12345), head)).toBe(0x7247f66b);
+
+    const impl = fuse!.getHashImplementations();
+    expect(['sse4.2', 'armv8-crc', 'slicing-by-8']).toContain(impl.crc32c);
+    expect(['sse2', 'scalar']).toContain(impl.xxh3);
+  });
+
+  test('should hash batches on the thread pool', async () => {
+    const buffers = [pattern(0), pattern(17), pattern(4096), pattern(100000)];
+    const [crcs, xxh, blake] = await Promise.all([
+      fuse!.hashBuffers('crc32c', buffers),
+      fuse!.hashBuffers('xxh3', buffers, 42),
+      fuse!.hashBuffers('blake3', buffers),
+    ]);
+    expect(crcs).toEqual(buffers.map((buffer) => fuse!.hashBuffer('crc32c', buffer)));
+    expect(xxh).toEqual(buffers.map((buffer) => fuse!.hashBuffer('xxh3', buffer, 42)));
+    expect(blake.map((digest) => digest.length)).toEqual([32, 32, 32, 32]);
+    expect(blake[3]!.equals(fuse!.hashBuffer('blake3', buffers[3]!))).toBe(true);
+
+    await expect(fuse!.hashBuffers('md5' as never, buffers)).rejects.toBeInstanceOf(TypeError);
+    await expect(fuse!.hashBuffers('xxh3', ['nope' as never])).rejects.toBeInstanceOf(TypeError);
+    expect(() => fuse!.hashBuffer('xxh3', Buffer.alloc(1), -1)).toThrow(TypeError);
+  });
+
+  test('should pass the payload digest to write handlers', async () => {
+    const digests: (ContentDigest | undefined)[] = [];
+    filesystemOperations.overrideOperationsWith({
+      write: async (ino: Ino, data: ArrayBuffer, context: RequestContext, options: WriteOptions): Promise<number | NativeWriteDescriptor> => {
+        digests.push(options.digest);
+        return defaultOperations.write(ino, data, context, options);
+      },
+    });
+
+    try {
+      const payload = 'digest me through the mount';
+      await fs.writeFile(`${mountPoint}/hashed.txt`, payload);
+      expect(digests.at(-1)).toBeUndefined();
+
+      await fuse!.configureWriteDigest({ algorithm: 'xxh3' });
+      const before = fuse!.getHashImplementations().writeDigestBytes;
+      await fs.writeFile(`${mountPoint}/hashed.txt`, payload);
+      expect(digests.at(-1)).toBe(0x9de5bca3f662bdacn);
+      expect(fuse!.getHashImplementations().writeDigestBytes - before).toBe(BigInt(payload.length));
+
+      await fuse!.configureWriteDigest({ algorithm: 'blake3' });
+      await fs.writeFile(`${mountPoint}/hashed.txt`, payload);
+      expect((digests.at(-1) as Buffer).equals(fuse!.hashBuffer('blake3', Buffer.from(payload)))).toBe(true);
+
+      await expect(fuse!.configureWriteDigest({ algorithm: 'sha1' as never })).rejects.toBeInstanceOf(TypeError);
+    } finally {
+      await fuse!.configureWriteDigest({});
+      filesystemOperations.overrideOperationsWith({});
+    }
+  });
+
+  test('should pass the digest of the merged payload to coalesced writes', async () => {
+    const calls: { digest: ContentDigest | undefined; expected: bigint; coalesced: number }[] = [];
+    filesystemOperations.overrideOperationsWith({
+      write: async (ino: Ino, data: ArrayBuffer, context: RequestContext, options: WriteOptions): Promise<number | NativeWriteDescriptor> => {
+        calls.push({
+          digest: options.digest,
+          expected: fuse!.hashBuffer('xxh3', data) as bigint,
+          coalesced: options.coalesced ?? 0,
+        });
+        return defaultOperations.write(ino, data, context, options);
+      },
+    });
+
+    await fuse!.configureWriteDigest({ algorithm: 'xxh3' });
+    await fuse!.configureWriteCoalescing({ enabled: true, maxExtentBytes: 64 * 1024 });
+    try {
+      const handle = await fs.open(`${mountPoint}/hashed-coalesced.txt`, 'w');
+      try {
+        await Promise.all(Array.from({ length: 16 }, (_, i) => handle.write(pattern(512), 0, 512, i * 512)));
+      } finally {
+        await handle.close();
+      }
+      expect(calls.some((call) => call.coalesced > 0)).toBe(true);
+      for (const call of calls) {
+        expect(call.digest).toBe(call.expected);
+      }
+    } finally {
+      await fuse!.configureWriteCoalescing({ enabled: false });
+      await fuse!.configureWriteDigest({});
+      filesystemOperations.overrideOperationsWith({});
+    }
+  });
+});
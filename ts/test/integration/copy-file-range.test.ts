@@ -0,0 +1,161 @@
+/**
+ * @file ts/test/integration/copy-file-range.test.ts
+ * @brief Integration test for the asynchronous copyFileRange API
+ */
+
+import { afterAll, beforeAll, describe, expect, test } from '@jest/globals';
+import fs, { type FileHandle } from 'fs/promises';
+import os from 'os';
+import path from 'path';
+import { AbortError, FuseNative, type FuseSession } from '../../index.ts';
+import { fuseIntegrationSessionSetup } from './integration-setup.ts';
+import { FileSystemOperations } from './file-system-operations.ts';
+import { FileSystem } from './filesystem.ts';
+
+describe('copyFileRange worker Integration', () => {
+  const size = 8 * 1024 * 1024;
+  const content = Buffer.alloc(size);
+  for (let i = 0; i < size; i += 4096) {
+    content.writeUInt32LE(i >>> 12, i);
+  }
+
+  let fuse: FuseNative | undefined;
+  let binding: any;
+  let session: FuseSession | undefined;
+  let workDir = '';
+  let mountPoint = '';
+  let source: FileHandle | undefined;
+
+  beforeAll(async () => {
+    const sessionWrap = await fuseIntegrationSessionSetup(new FileSystemOperations(new FileSystem(), {}), {});
+    fuse = sessionWrap.fuseNative;
+    binding = sessionWrap.binding;
+    session = sessionWrap.session;
+    await session.mount();
+    mountPoint = sessionWrap.mountPoint;
+    workDir = await fs.mkdtemp(path.join(os.tmpdir(), 'fuse-native-copy-'));
+    await fs.writeFile(path.join(workDir, 'source'), content);
+    source = await fs.open(path.join(workDir, 'source'), 'r');
+  });
+
+  afterAll(async () => {
+    fuse!.setCopyChunkSize(4n * 1024n * 1024n);
+    await source?.close();
+    await fs.rm(workDir, { recursive: true, force: true });
+    await session?.unmount();
+    await fuse?.shutdownDispatcher(750);
+    await session?.destroy();
+  });
+
+  test('should copy concurrently off the JS thread and report progress', async () => {
+    fuse!.setCopyChunkSize(1024n * 1024n);
+    const before = fuse!.getCopyStats();
+
+    const targets = await Promise.all(
+      [0, 1, 2].map((i) => fs.open(path.join(workDir, `target-${i}`), 'w+'))
+    );
+    const progress = targets.map(() => [] as bigint[]);
+    try {
+      const results = await Promise.all(
+        targets.map((target, i) =>
+          fuse!.copyFileRange(source!.fd, 0n, target.fd, 0n, BigInt(size), 0, {
+            onProgress: (bytesCopied) => progress[i]!.push(bytesCopied),
+          })
+        )
+      );
+
+      for (let i = 0; i < targets.length; i++) {
+        expect(results[i]).toBe(BigInt(size));
+        expect((await fs.readFile(path.join(workDir, `target-${i}`))).equals(content)).toBe(true);
+        const samples = progress[i]!;
+        expect(samples.length).toBeGreaterThan(0);
+        expect(samples.every((value, idx) => idx === 0 || value > samples[idx - 1]!)).toBe(true);
+        expect(samples[samples.length - 1]!).toBeLessThanOrEqual(BigInt(size));
+      }
+
+      const after = fuse!.getCopyStats();
+      expect(after.asyncOperations - before.asyncOperations).toBe(3n);
+      expect(after.totalBytesCopied - before.totalBytesCopied).toBe(BigInt(size) * 3n);
+      expect(after.activeCopies).toBe(0);
+    } finally {
+      await Promise.all(targets.map((target) => target.close()));
+    }
+  });
+
+  test('should stop between chunks when aborted', async () => {
+    fuse!.setCopyChunkSize(64n * 1024n);
+    const before = fuse!.getCopyStats();
+    const target = await fs.open(path.join(workDir, 'target-aborted'), 'w+');
+    const controller = new AbortController();
+
+    try {
+      const copy = fuse!.copyFileRange(source!.fd, 0n, target.fd, 0n, BigInt(size), 0, {
+        signal: controller.signal,
+        onProgress: () => controller.abort(),
+      });
+      await expect(copy).rejects.toBeInstanceOf(AbortError);
+
+      // Promise settled → Worker ist fertig und schreibt nicht mehr
+      const after = fuse!.getCopyStats();
+      expect(after.cancelledOperations - before.cancelledOperations).toBe(1n);
+      expect(after.activeCopies).toBe(0);
+      const { size: written } = await target.stat();
+      expect(written).toBeLessThan(size);
+    } finally {
+      await target.close();
+    }
+  });
+
+  test('should pass flags of the synchronous binding to the kernel', async () => {
+    const target = await fs.open(path.join(workDir, 'sync-flags'), 'w+');
+    try {
+      // copy_file_range(2) kennt noch keine Flags: ungleich 0 muss EINVAL liefern
+      expect(() => binding.copyFileRange(source!.fd, 0n, target.fd, 0n, 4096n, 1)).toThrow('EINVAL');
+      expect(binding.copyFileRange(source!.fd, 0n, target.fd, 0n, 4096n, 0)).toBe(4096n);
+      const copied = await fs.readFile(path.join(workDir, 'sync-flags'));
+      expect(copied.equals(content.subarray(0, 4096))).toBe(true);
+    } finally {
+      await target.close();
+    }
+  });
+
+  test('should preserve source holes when copying across filesystems', async () => {
+    const mib = 1024 * 1024;
+    fuse!.setCopyChunkSize(8n * 1024n * 1024n);
+    const sparsePath = path.join(workDir, 'sparse-source');
+    const sparse = await fs.open(sparsePath, 'w+');
+    const target = await fs.open(`${mountPoint}/sparse-copy`, 'w+');
+    const before = fuse!.getCopyStats();
+
+    try {
+      // 1 MiB Daten, 8 MiB Loch, 1 MiB Daten, 1 MiB Loch am Ende
+      await sparse.write(content.subarray(0, mib), 0, mib, 0);
+      await sparse.write(content.subarray(mib, 2 * mib), 0, mib, 9 * mib);
+      await sparse.truncate(11 * mib);
+
+      // tmpfs → FUSE: copy_file_range liefert EXDEV, der Fallback läuft
+      const copied = await fuse!.copyFileRange(sparse.fd, 0n, target.fd, 0n, BigInt(11 * mib));
+      expect(copied).toBe(BigInt(11 * mib));
+
+      const expected = Buffer.alloc(11 * mib);
+      content.copy(expected, 0, 0, mib);
+      content.copy(expected, 9 * mib, mib, 2 * mib);
+      const copiedContent = await fs.readFile(`${mountPoint}/sparse-copy`);
+      expect(copiedContent.length).toBe(expected.length);
+      expect(copiedContent.equals(expected)).toBe(true);
+
+      const after = fuse!.getCopyStats();
+      if (after.strategies.copyFileRange === before.strategies.copyFileRange) {
+        expect(after.holeBytes - before.holeBytes).toBeGreaterThanOrEqual(BigInt(9 * mib));
+        expect(after.strategies.sparse - before.strategies.sparse).toBeGreaterThanOrEqual(1n);
+        const moved =
+          after.strategies.splice + after.strategies.sendfile + after.strategies.buffered -
+          (before.strategies.splice + before.strategies.sendfile + before.strategies.buffered);
+        expect(moved).toBeGreaterThanOrEqual(2n);
+      }
+    } finally {
+      await target.close();
+      await sparse.close();
+    }
+  });
+});
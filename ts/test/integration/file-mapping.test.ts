@@ -0,0 +1,108 @@
+/**
+ * @file ts/test/integration/file-mapping.test.ts
+ * @brief Integration test for mmap-backed file views and zero-copy read replies
+ */
+
+import { afterAll, beforeAll, describe, expect, test } from '@jest/globals';
+import fs from 'fs/promises';
+import os from 'os';
+import path from 'path';
+import { FuseBufFlags, FuseNative, type FuseSession, type ReadBufHandler } from '../../index.ts';
+import { fuseIntegrationSessionSetup } from './integration-setup.ts';
+import { FileSystemOperations } from './file-system-operations.ts';
+import { FileSystem, DEFAULT_FILESYSTEM_SEED } from './filesystem.ts';
+
+describe('File mapping Integration', () => {
+  // Inhalt liegt im Pack hinter einem nicht seitenausgerichteten Präfix
+  const content = 'packed-object-'.repeat(1024);
+  const prefix = 'x'.repeat(1000);
+  const filesystem = new FileSystem({
+    ...DEFAULT_FILESYSTEM_SEED,
+    '/packed': { type: 'file', mode: 0o644, content },
+  });
+  const filesystemOperations = new FileSystemOperations(filesystem, {});
+  let fuse: FuseNative | undefined;
+  let session: FuseSession | undefined;
+  let mountPoint = '';
+  let workDir = '';
+  let packPath = '';
+
+  beforeAll(async () => {
+    workDir = await fs.mkdtemp(path.join(os.tmpdir(), 'fuse-native-mmap-'));
+    packPath = path.join(workDir, 'objects.pack');
+    await fs.writeFile(packPath, prefix + content);
+
+    const sessionWrap = await fuseIntegrationSessionSetup(filesystemOperations, {});
+    fuse = sessionWrap.fuseNative;
+    session = sessionWrap.session;
+    await session.mount();
+    mountPoint = sessionWrap.mountPoint;
+  });
+
+  afterAll(async () => {
+    await session?.unmount();
+    await fuse?.shutdownDispatcher(750);
+    await session?.destroy();
+    await fs.rm(workDir, { recursive: true, force: true });
+  });
+
+  test('should map unaligned ranges by path and fd and clamp them to the file', async () => {
+    const view = await fuse!.mapFile(packPath, { offset: BigInt(prefix.length), length: 14n, advice: 'random' });
+    expect(Buffer.from(view).toString()).toBe('packed-object-');
+
+    const handle = await fs.open(packPath, 'r');
+    try {
+      const tail = await fuse!.mapFile(handle.fd, { offset: prefix.length + content.length - 7, length: 4096 });
+      expect(Buffer.from(tail).toString()).toBe('object-');
+      expect((await fuse!.mapFile(handle.fd, { offset: 1n << 20n })).byteLength).toBe(0);
+    } finally {
+      await handle.close();
+    }
+
+    // Private Views sind copy-on-write: die Datei bleibt unverändert
+    const writable = await fuse!.mapFile(packPath, { length: 4n, populate: true });
+    new Uint8Array(writable).fill(0x41);
+    expect((await fs.readFile(packPath, 'utf8')).slice(0, 4)).toBe('xxxx');
+
+    await expect(fuse!.adviseFileMapping(new ArrayBuffer(16), 'willneed')).rejects.toMatchObject({ code: 'EINVAL' });
+    expect(await fuse!.adviseFileMapping(new Uint8Array(view, 2, 4), 'willneed')).toBe(true);
+    await expect(fuse!.mapFile(path.join(workDir, 'missing'))).rejects.toMatchObject({ code: 'ENOENT' });
+
+    const stats = await fuse!.getFileMappingStats();
+    expect(stats.created).toBeGreaterThanOrEqual(3n);
+    expect(stats.active).toBeGreaterThanOrEqual(1);
+    expect(stats.peakMappedBytes).toBeGreaterThan(0);
+  });
+
+  test('should reply to reads straight from a mapped pack file', async () => {
+    const view = await fuse!.mapFile(packPath, { shared: true, advice: 'sequential' });
+    const read_buf: ReadBufHandler = async (_ino, _context, options) => {
+      const start = prefix.length + Number(options.offset);
+      const size = Math.max(0, Math.min(prefix.length + content.length, start + options.size) - start);
+      return {
+        count: 1,
+        idx: 0,
+        off: 0,
+        buf: [{ size, flags: FuseBufFlags.NONE, mem: new Uint8Array(view, Math.min(start, view.byteLength), size) }],
+      };
+    };
+    filesystemOperations.overrideOperationsWith({ read_buf });
+
+    try {
+      const before = await fuse!.getFileMappingStats();
+      expect(await fs.readFile(`${mountPoint}/packed`, 'utf8')).toBe(content);
+
+      const stats = await fuse!.getFileMappingStats();
+      expect(stats.zeroCopyReplies).toBeGreaterThan(before.zeroCopyReplies);
+      expect(stats.zeroCopyBytes - before.zeroCopyBytes).toBe(BigInt(content.length));
+    } finally {
+      filesystemOperations.overrideOperationsWith({});
+    }
+  });
+
+  test('should reject invalid options', async () => {
+    await expect(fuse!.mapFile(packPath, { advice: 'bogus' as never })).rejects.toBeInstanceOf(TypeError);
+    await expect(fuse!.mapFile(packPath, { offset: -1 })).rejects.toBeInstanceOf(TypeError);
+    await expect(fuse!.mapFile(packPath, { shared: 'yes' as never })).rejects.toBeInstanceOf(TypeError);
+  });
+});
@@ -11,6 +11,7 @@
 import type {
   FuseOperationHandlers,
   GetattrHandler,
+  AnyReaddirHandler,
   ReaddirHandler,
   LookupHandler,
   CreateHandler,
@@ -62,6 +63,7 @@ import type {
   Timeout,
   StatvfsResult,
   FlushHandler,
+  ForgetHandler,
   SetattrOptions,
   FuseBufvec,
 } from "../../index.ts";
@@ -78,6 +80,7 @@ import {
   createFlags,
   getCurrentTimestamp,
   FuseBufFlags,
+  NativeIo,
 } from "../../index.ts";
 
 import { FuseErrno } from "../../errors.ts";
@@ -279,10 +282,16 @@ export class FileSystemOperations implements FuseOperationHandlers {
     return { attr: stat, timeout: 1.0 };
   };
 
-  readdir: ReaddirHandler = async (ino, offset, context, fi, options) => {
+  // Overrides may return either result format
+  readdir: AnyReaddirHandler = async (ino, offset, context, fi, options) => {
     if (this._overrides.readdir) {
       return this._overrides.readdir(ino, offset, context, fi, options);
     }
+    return this.readdirEntries(ino, offset, context, fi, options);
+  };
+
+  // Default listing with object entries; overrides can build on it
+  readdirEntries: ReaddirHandler = async (ino, offset, context, fi, options) => {
     logFuseOp('readdir', 'default', { ino: ino.toString(), offset: offset.toString(), size: options?.size });
     const dir = this._fs.getInode(ino);
     if (!dir || dir.type !== 'directory' || !(dir.data instanceof Map)) {
@@ -360,6 +369,14 @@ export class FileSystemOperations implements FuseOperationHandlers {
     };
   };
 
+  // In-memory inodes outlive kernel references; nothing to free by default
+  forget: ForgetHandler = async (inos) => {
+    if (this._overrides.forget) {
+      return this._overrides.forget(inos);
+    }
+    logFuseOp('forget', 'default', { count: inos.length });
+  };
+
   // Placeholder implementations for other operations
   // These can be expanded as needed for tests
 
@@ -436,6 +453,9 @@ export class FileSystemOperations implements FuseOperationHandlers {
     const buffer = this._overrides.read
       ? await this._overrides.read(ino, context, options)
       : await this.performRead(ino, options);
+    if (NativeIo.isDescriptor(buffer)) {
+      return buffer;
+    }
 
     const arrayBuffer = this.toArrayBuffer(buffer);
     return {
@@ -45,6 +45,79 @@ describe('FUSE Getattr Bridge Integration', () => {
     fuse?.shutdownDispatcher(0);
   });
 
+  describe('Native Attribute Cache', () => {
+    test('should answer repeated getattr from the native cache', async () => {
+      const defaultOperations = new FileSystemOperations(filesystem, {});
+      let getattrCalls = 0;
+
+      // Kernel timeout 0: every stat reaches the bridge
+      const countingGetattr: GetattrHandler = async (ino, context, fi, options) => {
+        getattrCalls++;
+        const result = await defaultOperations.getattr(ino, context, fi, options);
+        return { attr: result.attr, timeout: 0 as Timeout };
+      };
+
+      filesystemOperations.overrideOperationsWith({ getattr: countingGetattr });
+      await fuse!.configureAttrCache({ ttl: 60, maxEntries: 1024 });
+      await fuse!.clearAttrCache();
+
+      try {
+        const first = (await fs.stat(mountPoint, { bigint: true })) as BigIntStats;
+        const callsAfterFirst = getattrCalls;
+        const second = (await fs.stat(mountPoint, { bigint: true })) as BigIntStats;
+
+        expect(second.ino).toBe(first.ino);
+        expect(second.mtimeNs).toBe(first.mtimeNs);
+        expect(getattrCalls).toBe(callsAfterFirst);
+
+        const stats = await fuse!.getAttrCacheStats();
+        expect(stats.hits).toBeGreaterThanOrEqual(1n);
+        expect(stats.hitRate).toBeGreaterThan(0);
+
+        expect(await fuse!.invalidateAttrCache(first.ino as Ino)).toBe(true);
+        await fs.stat(mountPoint, { bigint: true });
+        expect(getattrCalls).toBeGreaterThan(callsAfterFirst);
+      } finally {
+        filesystemOperations.overrideOperationsWith({});
+        await fuse!.configureAttrCache({ ttl: 0 });
+      }
+    });
+  });
+
+  describe('Kernel Cache Invalidation', () => {
+    test('should drop cached attributes via notifyInvalInode', async () => {
+      const defaultOperations = new FileSystemOperations(filesystem, {});
+      let getattrCalls = 0;
+
+      // Lange Kernel-Timeouts: ohne Notify käme kein weiterer getattr an
+      const countingGetattr: GetattrHandler = async (ino, context, fi, options) => {
+        getattrCalls++;
+        const result = await defaultOperations.getattr(ino, context, fi, options);
+        return { attr: result.attr, timeout: 60 as Timeout };
+      };
+
+      filesystemOperations.overrideOperationsWith({ getattr: countingGetattr });
+      try {
+        const first = (await fs.stat(mountPoint, { bigint: true })) as BigIntStats;
+        await fs.stat(mountPoint, { bigint: true });
+        const callsBefore = getattrCalls;
+
+        await session!.notifyInvalInode(first.ino as Ino);
+        await fs.stat(mountPoint, { bigint: true });
+        expect(getattrCalls).toBeGreaterThan(callsBefore);
+
+        const results = await session!.notifyBatch([
+          { op: 'invalInode', ino: first.ino as Ino },
+          { op: 'invalEntry', parent: first.ino as Ino, name: 'does-not-exist' },
+        ]);
+        expect(results).toEqual([0, 0]);
+      } finally {
+        filesystemOperations.overrideOperationsWith({});
+        await session!.notifyInvalInode(1n as Ino);
+      }
+    });
+  });
+
   describe('Complete Parameter Round-trip Testing', () => {
     test('should read seeded root attributes through getattr', async () => {
       try {
@@ -1,7 +1,7 @@
 import { afterAll, beforeAll, describe, expect, test } from '@jest/globals';
 import fs from 'fs/promises';
 import path from 'path';
-import { FuseNative, type FuseSession } from '../../index.ts';
+import { FuseNative, type FuseSession, type Timeout } from '../../index.ts';
 import { fuseIntegrationSessionSetup } from './integration-setup.ts';
 import { FileSystemOperations } from './file-system-operations.ts';
 import { FileSystem } from './filesystem.ts';
@@ -40,4 +40,24 @@ describe('FUSE Link Bridge Integration', () => {
     expect(originalStats.nlink).toBe(2);
     expect(linkStats.nlink).toBe(2);
   });
+
+  test('should not serve a cached link count after unlinking a hard link', async () => {
+    const originalPath = path.join(mountPoint, 'test-file');
+    const linkPath = path.join(mountPoint, 'test-file-cached-link');
+    await fuse!.configureAttrCache({ ttl: 60, maxEntries: 1024 });
+    await fuse!.configureDentryCache({ entryTtl: 60 as Timeout });
+
+    try {
+      const before = (await fs.stat(originalPath)).nlink;
+      await fs.link(originalPath, linkPath);
+      expect((await fs.stat(originalPath)).nlink).toBe(before + 1);
+
+      // Das Kind wird über den Dentry-Cache gefunden und seine Attribute verworfen
+      await fs.unlink(linkPath);
+      expect((await fs.stat(originalPath)).nlink).toBe(before);
+    } finally {
+      await fuse!.configureAttrCache({ ttl: 0 });
+      await fuse!.configureDentryCache({});
+    }
+  });
 });
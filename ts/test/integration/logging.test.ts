@@ -0,0 +1,71 @@
+/**
+ * @file ts/test/integration/logging.test.ts
+ * @brief Integration test for the asynchronous native logger
+ */
+
+import { afterAll, beforeAll, describe, expect, test } from '@jest/globals';
+import fs from 'fs/promises';
+import { FuseNative, type FuseSession } from '../../index.ts';
+import { fuseIntegrationSessionSetup } from './integration-setup.ts';
+import { FileSystemOperations } from './file-system-operations.ts';
+import { FileSystem, DEFAULT_FILESYSTEM_SEED } from './filesystem.ts';
+
+describe('Native logging Integration', () => {
+  const filesystem = new FileSystem({
+    ...DEFAULT_FILESYSTEM_SEED,
+    '/logged': { type: 'file', mode: 0o644, content: 'log me' },
+  });
+  let fuse: FuseNative | undefined;
+  let session: FuseSession | undefined;
+  let mountPoint = '';
+  let initialLevel: string | undefined;
+
+  beforeAll(async () => {
+    const sessionWrap = await fuseIntegrationSessionSetup(new FileSystemOperations(filesystem, {}), {});
+    fuse = sessionWrap.fuseNative;
+    session = sessionWrap.session;
+    await session.mount();
+    mountPoint = sessionWrap.mountPoint;
+    initialLevel = fuse.getLoggingStats().level;
+  });
+
+  afterAll(async () => {
+    await fuse?.configureLogging({ level: (initialLevel ?? 'info') as never, async: true });
+    fuse?.flushLogs();
+    await session?.unmount();
+    await fuse?.shutdownDispatcher(750);
+    await session?.destroy();
+  });
+
+  test('should queue debug lines from FUSE threads without blocking them', async () => {
+    await fuse!.configureLogging({ level: 'debug', async: true, ringBytes: 64 * 1024 });
+    const before = fuse!.getLoggingStats();
+    expect(before.async).toBe(true);
+    expect(before.ringBytes).toBe(64 * 1024);
+
+    for (let i = 0; i < 20; i++) {
+      expect(await fs.readFile(`${mountPoint}/logged`, 'utf8')).toBe('log me');
+    }
+    fuse!.flushLogs();
+
+    const stats = fuse!.getLoggingStats();
+    expect(stats.level).toBe('debug');
+    // Einzelne Zeilen können bei vollen Ringen verworfen werden, gezählt werden sie immer
+    expect(stats.records + stats.dropped).toBeGreaterThan(before.records + before.dropped);
+    expect(stats.bytesWritten).toBeGreaterThan(before.bytesWritten);
+    expect(stats.threads).toBeGreaterThanOrEqual(1);
+  });
+
+  test('should switch to synchronous output and back', async () => {
+    await fuse!.configureLogging({ async: false, level: 'info' });
+    expect(fuse!.getLoggingStats().async).toBe(false);
+    await fuse!.configureLogging({ async: true });
+    expect(fuse!.getLoggingStats()).toMatchObject({ async: true, level: 'info' });
+  });
+
+  test('should reject invalid options', async () => {
+    await expect(fuse!.configureLogging({ level: 'verbose' as never })).rejects.toBeInstanceOf(TypeError);
+    await expect(fuse!.configureLogging({ async: 'yes' as never })).rejects.toBeInstanceOf(TypeError);
+    await expect(fuse!.configureLogging({ ringBytes: 0 })).rejects.toBeInstanceOf(TypeError);
+  });
+});
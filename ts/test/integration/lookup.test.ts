@@ -45,6 +45,108 @@ describe('FUSE Lookup Bridge Integration', () => {
     fuse?.shutdownDispatcher(0);
   });
 
+  describe('Native Dentry Cache', () => {
+    test('should answer repeated negative lookups from the native cache', async () => {
+      const defaultOperations = new FileSystemOperations(filesystem, {});
+      let lookupCalls = 0;
+
+      const countingLookup: LookupHandler = async (parent, name, context, options) => {
+        lookupCalls++;
+        return defaultOperations.lookup(parent, name, context, options);
+      };
+
+      filesystemOperations.overrideOperationsWith({ lookup: countingLookup });
+      await fuse!.configureDentryCache({ entryTtl: 60, negativeTtl: 60, maxEntries: 1024 });
+      await fuse!.clearDentryCache();
+
+      try {
+        const missing = path.join(mountPoint, 'does-not-exist');
+        await expect(fs.stat(missing)).rejects.toMatchObject({ code: 'ENOENT' });
+        const callsAfterFirst = lookupCalls;
+        await expect(fs.stat(missing)).rejects.toMatchObject({ code: 'ENOENT' });
+
+        expect(lookupCalls).toBe(callsAfterFirst);
+        const stats = await fuse!.getDentryCacheStats();
+        expect(stats.negativeHits).toBeGreaterThanOrEqual(1n);
+
+        const root = filesystem.getRoot().id;
+        expect(await fuse!.invalidateDentryCache(root, 'does-not-exist')).toBe(1);
+        await expect(fs.stat(missing)).rejects.toMatchObject({ code: 'ENOENT' });
+        expect(lookupCalls).toBeGreaterThan(callsAfterFirst);
+      } finally {
+        filesystemOperations.overrideOperationsWith({});
+        await fuse!.configureDentryCache({});
+      }
+    });
+  });
+
+  describe('Native Dentry Cache without attributes', () => {
+    test('should forward cached names without fresh attributes to the handler', async () => {
+      const defaultOperations = new FileSystemOperations(filesystem, {});
+      let lookupCalls = 0;
+      let size = 1234n;
+
+      const resizingLookup: LookupHandler = async (parent, name, context, options) => {
+        lookupCalls++;
+        const result = await defaultOperations.lookup(parent, name, context, options);
+        return { ...result, attr: { ...result.attr, size } } as typeof result;
+      };
+
+      filesystemOperations.overrideOperationsWith({ lookup: resizingLookup });
+      await fuse!.configureDentryCache({ entryTtl: 60, maxEntries: 1024 });
+      await fuse!.clearDentryCache();
+
+      try {
+        const filePath = path.join(mountPoint, 'test-file');
+        const root = filesystem.getRoot().id;
+        await session!.notifyInvalEntry(root, 'test-file');
+        expect((await fs.stat(filePath, { bigint: true })).size).toBe(1234n);
+        const callsAfterFirst = lookupCalls;
+
+        // Der Dentry-Cache kennt den Namen, der Attr-Cache ist aus: kein Antworten mit alten Attributen
+        size = 4321n;
+        await session!.notifyInvalEntry(root, 'test-file');
+        expect((await fs.stat(filePath, { bigint: true })).size).toBe(4321n);
+        expect(lookupCalls).toBeGreaterThan(callsAfterFirst);
+      } finally {
+        filesystemOperations.overrideOperationsWith({});
+        await fuse!.configureDentryCache({});
+      }
+    });
+  });
+
+  describe('Native Inode Table', () => {
+    test('should track lookup counts and deliver released inodes in batches', async () => {
+      const released = defer<bigint[]>();
+      filesystemOperations.overrideOperationsWith({
+        forget: async (inos) => {
+          released.resolve(Array.from(inos));
+        },
+      });
+      await fuse!.configureInodeTable({ batchSize: 64, flushIntervalMs: 10 });
+
+      try {
+        const fileInode = filesystem.resolvePath('/test-file');
+        await fs.stat(path.join(mountPoint, 'test-file'));
+        expect(await fuse!.getInodeLookupCount(fileInode.id)).toBeGreaterThanOrEqual(1n);
+
+        // Dentry verwerfen: der Kernel gibt das Inode frei und schickt forget
+        await session!.notifyInvalEntry(filesystem.getRoot().id, 'test-file');
+        const inos = await released.promise;
+        expect(inos).toContain(fileInode.id);
+        expect(await fuse!.getInodeLookupCount(fileInode.id)).toBe(0n);
+
+        const stats = await fuse!.getInodeTableStats();
+        expect(stats.tracking).toBe(true);
+        expect(stats.released).toBeGreaterThanOrEqual(1n);
+        expect(stats.batches).toBeGreaterThanOrEqual(1n);
+      } finally {
+        filesystemOperations.overrideOperationsWith({});
+        await fuse!.configureInodeTable({ batchSize: 1024, flushIntervalMs: 50 });
+      }
+    });
+  });
+
   describe('Complete Parameter Round-trip Testing', () => {
     test('should read seeded file attributes through lookup', async () => {
 
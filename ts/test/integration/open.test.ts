@@ -4,7 +4,9 @@
  */
 
 import { afterAll, beforeAll, describe, expect, test } from '@jest/globals';
-import fs from 'fs/promises';
+import fs, { type FileHandle } from 'fs/promises';
+import os from 'os';
+import path from 'path';
 import {
   FuseNative,
   type FuseSession,
@@ -12,6 +14,7 @@ import {
   type RequestContext,
   type FileInfo,
   type OpenOptions,
+  type ReadOptions,
 } from '../../index.ts';
 import { O_RDONLY } from '../../constants.ts';
 import { defer, fuseIntegrationSessionSetup } from './integration-setup.ts';
@@ -81,4 +84,120 @@ describe('FUSE open Bridge Integration', () => {
     // Reset overrides
     filesystemOperations.overrideOperationsWith({});
   });
+
+  test('should apply keep_cache and noflush returned by open', async () => {
+    const fileName = `/test-open-cache-${Math.random().toString(36).substring(7)}`;
+    const fileContent = 'cached across opens';
+    filesystem.addFile(fileName, fileContent);
+    const defaults = new FileSystemOperations(filesystem, {});
+
+    let keepCache = false;
+    let readCalls = 0;
+    let flushCalls = 0;
+    filesystemOperations.overrideOperationsWith({
+      open: async (ino: Ino, context: RequestContext, options?: OpenOptions): Promise<FileInfo> => ({
+        ...(await defaults.open(ino, context, options)),
+        keep_cache: keepCache,
+        noflush: true,
+      }),
+      read: async (ino: Ino, context: RequestContext, options: ReadOptions) => {
+        readCalls++;
+        return defaults.read(ino, context, options);
+      },
+      flush: async (ino, fi, context, options) => {
+        flushCalls++;
+        return defaults.flush(ino, fi, context, options);
+      },
+    });
+
+    try {
+      const testFile = `${mountPoint}${fileName}`;
+      expect((await fs.readFile(testFile)).toString()).toBe(fileContent);
+      expect(readCalls).toBeGreaterThan(0);
+
+      // Ohne keep_cache verwirft der Kernel die Seiten beim nächsten open
+      readCalls = 0;
+      keepCache = true;
+      expect((await fs.readFile(testFile)).toString()).toBe(fileContent);
+      expect(readCalls).toBeGreaterThan(0);
+
+      readCalls = 0;
+      expect((await fs.readFile(testFile)).toString()).toBe(fileContent);
+      expect(readCalls).toBe(0);
+
+      // noflush: close schickt kein flush
+      expect(flushCalls).toBe(0);
+    } finally {
+      filesystemOperations.overrideOperationsWith({});
+    }
+  });
+});
+
+describe('FUSE open passthrough Integration', () => {
+  const filesystem = new FileSystem();
+  let session: FuseSession | undefined;
+  let fuse: FuseNative | undefined;
+  const filesystemOperations = new FileSystemOperations(filesystem, {});
+  let mountPoint = '';
+  let backingDir = '';
+
+  beforeAll(async () => {
+    backingDir = await fs.mkdtemp(path.join(os.tmpdir(), 'fuse-backing-'));
+    const sessionWrap = await fuseIntegrationSessionSetup(filesystemOperations, { passthrough: true });
+    fuse = sessionWrap.fuseNative;
+    await sessionWrap.session.mount();
+    mountPoint = sessionWrap.mountPoint;
+    session = sessionWrap.session;
+  });
+
+  afterAll(async () => {
+    await session?.unmount();
+    await fuse?.shutdownDispatcher(750);
+    await session?.destroy();
+    await fs.rm(backingDir, { recursive: true, force: true });
+  });
+
+  test('should serve a backing fd from the kernel or fall back to read', async () => {
+    if (!fuse) {
+      throw new Error('fuse not initialised');
+    }
+    const content = Buffer.alloc(1234);
+    for (let i = 0; i < content.length; i++) {
+      content[i] = i % 251;
+    }
+    const backingPath = path.join(backingDir, 'test-file');
+    await fs.writeFile(backingPath, content);
+
+    let readCalls = 0;
+    const backingHandles: FileHandle[] = [];
+    const backingOpen = async (ino: Ino, context: RequestContext, options?: OpenOptions): Promise<FileInfo> => {
+      const fi = await new FileSystemOperations(filesystem, {}).open(ino, context, options);
+      const backing = await fs.open(backingPath, 'r');
+      backingHandles.push(backing);
+      return { ...fi, backingFd: backing.fd };
+    };
+    const fallbackRead = async (_ino: Ino, _context: RequestContext, options: ReadOptions): Promise<Buffer> => {
+      readCalls++;
+      const start = Number(options.offset);
+      return content.subarray(start, Math.min(content.length, start + options.size));
+    };
+    filesystemOperations.overrideOperationsWith({ open: backingOpen, read: fallbackRead });
+
+    const before = await fuse.getPassthroughStats();
+    const data = await fs.readFile(`${mountPoint}/test-file`);
+    const after = await fuse.getPassthroughStats();
+    // Der Kernel hält eine eigene Referenz auf die Backing-Datei
+    await Promise.all(backingHandles.map((handle) => handle.close()));
+
+    expect(Buffer.compare(data, content)).toBe(0);
+    expect(after.opened + after.fallbacks).toBe(before.opened + before.fallbacks + 1);
+    if (after.active && after.opened > before.opened) {
+      // read/write laufen im Kernel, der Handler sieht sie nie
+      expect(readCalls).toBe(0);
+    } else {
+      expect(readCalls).toBeGreaterThan(0);
+    }
+
+    filesystemOperations.overrideOperationsWith({});
+  });
 });
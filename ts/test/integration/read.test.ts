@@ -5,6 +5,8 @@
 
 import { afterAll, beforeAll, describe, expect, test } from '@jest/globals';
 import fs from 'fs/promises';
+import os from 'os';
+import path from 'path';
 import {
   FuseNative,
   type FuseSession,
@@ -12,6 +14,8 @@ import {
   type RequestContext,
   type FileInfo,
   type ReadOptions,
+  type NativeReadDescriptor,
+  NativeIo,
 } from '../../index.ts';
 import { O_RDONLY } from '../../constants.ts';
 import { defer, fuseIntegrationSessionSetup } from './integration-setup.ts';
@@ -62,7 +66,7 @@ describe('FUSE read Bridge Integration', () => {
     let recordedContext: RequestContext = {} as RequestContext;
     let recordedOptions: ReadOptions | undefined;
 
-    const recordingRead = async (ino: Ino, context: RequestContext, options: ReadOptions): Promise<Buffer> => {
+    const recordingRead = async (ino: Ino, context: RequestContext, options: ReadOptions): Promise<Buffer | NativeReadDescriptor> => {
       // We are interested in the first read at offset 0
       if (options.offset === 0n) {
         recordedIno = ino;
@@ -109,7 +113,7 @@ describe('FUSE read Bridge Integration', () => {
     let recordedIno: Ino = 0n as Ino;
     let recordedOptions: ReadOptions | undefined;
 
-    const recordingRead = async (ino: Ino, context: RequestContext, options: ReadOptions): Promise<Buffer> => {
+    const recordingRead = async (ino: Ino, context: RequestContext, options: ReadOptions): Promise<Buffer | NativeReadDescriptor> => {
       const start = Number(options.offset);
       const end   = start + options.size;
       const wantStart = offset;
@@ -166,7 +170,7 @@ describe('FUSE read Bridge Integration', () => {
     const testFile = `${mountPoint}${fileName}`;
     const recordedReads: { offset: bigint; size: number }[] = [];
 
-    const recordingRead = async (ino: Ino, context: RequestContext, options: ReadOptions): Promise<Buffer> => {
+    const recordingRead = async (ino: Ino, context: RequestContext, options: ReadOptions): Promise<Buffer | NativeReadDescriptor> => {
       recordedReads.push({ offset: options.offset, size: options.size });
       return new FileSystemOperations(filesystem, {}).read(ino, context, options);
     };
@@ -191,4 +195,53 @@ describe('FUSE read Bridge Integration', () => {
     // Reset overrides
     filesystemOperations.overrideOperationsWith({});
   });
+
+  test('should serve reads from a pread descriptor on the native I/O pool', async () => {
+    const fileContent = 'native pread '.repeat(1024);
+    const fileName = `/test-native-pread-${Math.random().toString(36).substring(7)}`;
+    filesystem.addFile(fileName, fileContent);
+
+    // Backing-Datei mit identischem Inhalt – der Handler liefert nur fd + offset
+    const backingDir = await fs.mkdtemp(path.join(os.tmpdir(), 'fuse-native-pread-'));
+    const backingPath = path.join(backingDir, 'backing');
+    await fs.writeFile(backingPath, fileContent);
+    const backing = await fs.open(backingPath, 'r');
+
+    const before = await fuse!.getNativeIoStats();
+    const descriptorRead = async (_ino: Ino, _context: RequestContext, options: ReadOptions): Promise<Buffer | NativeReadDescriptor> =>
+      NativeIo.pread(backing.fd, options.offset);
+
+    filesystemOperations.overrideOperationsWith({ read: descriptorRead });
+    try {
+      const buffer = await fs.readFile(`${mountPoint}${fileName}`);
+      expect(buffer.toString()).toBe(fileContent);
+
+      const after = await fuse!.getNativeIoStats();
+      expect(after.bytesRead - before.bytesRead).toBeGreaterThanOrEqual(BigInt(fileContent.length));
+      expect(after.completed).toBeGreaterThan(before.completed);
+      expect(after.errors).toBe(before.errors);
+    } finally {
+      filesystemOperations.overrideOperationsWith({});
+      await backing.close();
+      await fs.rm(backingDir, { recursive: true, force: true });
+    }
+  });
+
+  test('should push and retrieve page-cache data via notify_store/notify_retrieve', async () => {
+    const testFile = `${mountPoint}/test-file-read-2`;
+    const { ino } = await fs.stat(testFile, { bigint: true });
+    await fs.readFile(testFile);
+
+    // Kernel antwortet mit dem zusammenhängend gecachten Bereich ab offset
+    const retrieved = await session!.notifyRetrieve(ino as Ino, 0n, 4096);
+    expect(retrieved.ino).toBe(ino);
+    expect(retrieved.offset).toBe(0n);
+    expect(Buffer.isBuffer(retrieved.data)).toBe(true);
+    expect(fileContent2.startsWith(retrieved.data.toString())).toBe(true);
+
+    await session!.notifyStore(ino as Ino, 0n, Buffer.from(fileContent2));
+    await expect(
+      session!.notifyStore(0xfffffffen as Ino, 0n, Buffer.from('x'))
+    ).rejects.toMatchObject({ code: 'ENOENT' });
+  });
 });
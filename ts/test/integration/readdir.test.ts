@@ -4,15 +4,22 @@
  */
 
 import { afterAll, beforeAll, describe, expect, test } from '@jest/globals';
+import { execFile } from 'child_process';
 import fs from 'fs/promises';
+import { promisify } from 'util';
 import {
+  DirentUtils,
   FuseNative,
   type FuseSession,
+  type ColumnarReaddirHandler,
   type ReaddirHandler,
   type ReaddirResult,
   type Ino,
   type RequestContext,
   type FileInfo,
+  DirentType,
+  type DirentEntry,
+  type OpendirHandler,
 } from '../../index.ts';
 import { defer, fuseIntegrationSessionSetup } from './integration-setup.ts';
 import { FileSystemOperations } from './file-system-operations.ts';
@@ -36,6 +43,166 @@ describe('FUSE Readdir Bridge Integration', () => {
   afterAll(async () => {
   });
 
+  describe('Columnar Result Format', () => {
+    test('should pack columnar readdir results natively', async () => {
+      const defaultOperations = new FileSystemOperations(filesystem, {});
+      let columnarCalls = 0;
+
+      const columnarReaddir: ColumnarReaddirHandler = async (ino, offset, context, fi, options) => {
+        const result = await defaultOperations.readdirEntries(ino, offset, context, fi, options);
+        columnarCalls++;
+        return DirentUtils.toColumnarResult(result.entries, result.hasMore, result.nextOffset);
+      };
+
+      filesystemOperations.overrideOperationsWith({ readdir: columnarReaddir });
+
+      try {
+        const names = await fs.readdir(mountPoint);
+        expect(new Set(names)).toEqual(new Set(['test-file', 'notes']));
+        expect(columnarCalls).toBeGreaterThanOrEqual(1);
+      } finally {
+        filesystemOperations.overrideOperationsWith({});
+      }
+    });
+  });
+
+  describe('Directory Snapshots', () => {
+    // Große synthetische Liste, damit der Kernel mehrere readdir-Aufrufe braucht
+    const makeListing = (count: number, offsetOf: (i: number) => bigint): DirentEntry[] =>
+      Array.from({ length: count }, (_, i) => ({
+        name: `entry-${String(i).padStart(4, '0')}`,
+        ino: BigInt(5000 + i) as Ino,
+        type: DirentType.RegularFile,
+        nextOffset: offsetOf(i),
+      }));
+    const expectedNames = (listing: DirentEntry[]) => listing.map((entry) => entry.name).sort();
+    let nextDirHandle = 9000;
+
+    const snapshotOpendir = (listing: DirentEntry[]): OpendirHandler => async () => ({
+      fh: nextDirHandle++,
+      flags: 0,
+      snapshot: DirentUtils.toColumnarResult(listing, false),
+    }) as never;
+
+    beforeAll(async () => {
+      await fuse!.configureDirSnapshotCache({ maxBytes: 4 * 1024 * 1024 });
+    });
+
+    afterAll(async () => {
+      filesystemOperations.overrideOperationsWith({});
+      await fuse!.configureDirSnapshotCache({ maxBytes: 0 });
+      await fuse!.clearDirSnapshotCache();
+    });
+
+    test('should answer every continuation from the opendir snapshot', async () => {
+      const listing = makeListing(400, (i) => BigInt(i + 1));
+      let jsCalls = 0;
+      filesystemOperations.overrideOperationsWith({
+        opendir: snapshotOpendir(listing),
+        readdir: async () => {
+          jsCalls++;
+          return { entries: [], hasMore: false };
+        },
+      });
+      await fuse!.clearDirSnapshotCache();
+
+      const names = await fs.readdir(mountPoint);
+      expect(names.sort()).toEqual(expectedNames(listing));
+      expect(jsCalls).toBe(0);
+      const stats = await fuse!.getDirSnapshotCacheStats();
+      expect(stats.inserts).toBe(1n);
+      expect(stats.hits).toBeGreaterThan(1n);
+      expect(stats.releases).toBe(1n);
+    });
+
+    test('should fall back to JS for offsets unknown to a non-monotonic snapshot', async () => {
+      // Offsets absteigend: Fortsetzung per Suche, nicht per Binärsuche
+      const listing = makeListing(50, (i) => BigInt(1000 - i * 7));
+      const seenOffsets: bigint[] = [];
+      filesystemOperations.overrideOperationsWith({
+        opendir: snapshotOpendir(listing),
+        readdir: async (_ino, offset) => {
+          seenOffsets.push(offset);
+          return {
+            entries: [{ name: 'from-js', ino: 4999n as Ino, type: DirentType.RegularFile, nextOffset: offset + 1n }],
+            hasMore: false,
+          };
+        },
+      });
+
+      expect((await fs.readdir(mountPoint)).sort()).toEqual(expectedNames(listing));
+      expect(seenOffsets).toEqual([]);
+
+      // seekdir auf einen Offset, den das Listing nicht kennt (früher: stilles EOF)
+      const script = 'opendir(my $d, $ARGV[0]) or die; seekdir($d, 424242); print join("\\n", readdir($d));';
+      const { stdout } = await promisify(execFile)('perl', ['-e', script, mountPoint]);
+      expect(stdout.split('\n')).toContain('from-js');
+      expect(seenOffsets).toContain(424242n);
+    });
+
+    test('should serve evicted handles from the JS readdir handler', async () => {
+      const listing = makeListing(200, (i) => BigInt(i + 1));
+      let jsCalls = 0;
+      filesystemOperations.overrideOperationsWith({
+        opendir: snapshotOpendir(listing),
+        readdir: async (_ino, offset) => {
+          jsCalls++;
+          const start = Number(offset);
+          return { entries: listing.slice(start, start + 32), hasMore: start + 32 < listing.length };
+        },
+      });
+      await fuse!.clearDirSnapshotCache();
+
+      const first = await fs.opendir(mountPoint, { bufferSize: 1 });
+      let second: Awaited<ReturnType<typeof fs.opendir>> | undefined;
+      try {
+        const firstEntry = await first.read();
+        expect(firstEntry).not.toBeNull();
+
+        // Budget für genau einen Snapshot: das zweite opendir verdrängt das erste
+        const { bytes } = await fuse!.getDirSnapshotCacheStats();
+        await fuse!.configureDirSnapshotCache({ maxBytes: bytes + 1024 });
+        second = await fs.opendir(mountPoint, { bufferSize: 1 });
+        const secondNames: string[] = [];
+        for await (const entry of second) secondNames.push(entry.name);
+        expect(secondNames.sort()).toEqual(expectedNames(listing));
+
+        const firstNames = [firstEntry!.name];
+        for await (const entry of first) firstNames.push(entry.name);
+        expect(firstNames.sort()).toEqual(expectedNames(listing));
+      } finally {
+        await fuse!.configureDirSnapshotCache({ maxBytes: 4 * 1024 * 1024 });
+      }
+      expect((await fuse!.getDirSnapshotCacheStats()).evictions).toBeGreaterThanOrEqual(1n);
+      expect(jsCalls).toBeGreaterThan(0);
+    });
+
+    test('should not keep snapshots for handles shared by several opens', async () => {
+      const listing = makeListing(100, (i) => BigInt(i + 1));
+      filesystemOperations.overrideOperationsWith({
+        opendir: async () => ({ fh: 0, flags: 0, snapshot: DirentUtils.toColumnarResult(listing, false) }) as never,
+        readdir: async (_ino, offset) => {
+          const start = Number(offset);
+          return { entries: listing.slice(start, start + 32), hasMore: start + 32 < listing.length };
+        },
+      });
+      await fuse!.clearDirSnapshotCache();
+
+      const first = await fs.opendir(mountPoint, { bufferSize: 1 });
+      const second = await fs.opendir(mountPoint, { bufferSize: 1 });
+      try {
+        for (const dir of [first, second]) {
+          const names: string[] = [];
+          for await (const entry of dir) names.push(entry.name);
+          expect(names.sort()).toEqual(expectedNames(listing));
+        }
+      } finally {
+        filesystemOperations.overrideOperationsWith({});
+      }
+      expect((await fuse!.getDirSnapshotCacheStats()).shared).toBeGreaterThanOrEqual(1n);
+    });
+  });
+
   describe('Complete Parameter Round-trip Testing', () => {
     test('should stream seeded directory entries through readdir', async () => {
       const readdirDone = defer<void>();
@@ -52,7 +219,7 @@ describe('FUSE Readdir Bridge Integration', () => {
       const defaultOperations = new FileSystemOperations(filesystem, {});
 
       const recordingReaddir: ReaddirHandler = async (ino, offset, context, fi, options) => {
-        const result = await defaultOperations.readdir(ino, offset, context, fi, options);
+        const result = await defaultOperations.readdirEntries(ino, offset, context, fi, options);
         recordedCalls.push({
           ino,
           offset,
@@ -0,0 +1,104 @@
+/**
+ * @file ts/test/integration/session-handoff.test.ts
+ * @brief Integration test for passing a mounted session to a successor
+ *
+ * Both ends run in this process: the successor session adopts on a socket
+ * while the first one hands off, and a file opened before the switch must
+ * stay readable through it.
+ */
+
+import { afterAll, beforeAll, describe, expect, test } from '@jest/globals';
+import fs from 'fs/promises';
+import os from 'os';
+import path from 'path';
+import { FuseNative, type FuseSession } from '../../index.ts';
+import { fuseIntegrationSessionSetup } from './integration-setup.ts';
+import { FileSystemOperations } from './file-system-operations.ts';
+import { FileSystem, DEFAULT_FILESYSTEM_SEED } from './filesystem.ts';
+
+describe('Session handoff Integration', () => {
+  const filesystem = new FileSystem({
+    ...DEFAULT_FILESYSTEM_SEED,
+    '/handed': { type: 'file', mode: 0o644, content: 'survives the restart' },
+  });
+  const operations = new FileSystemOperations(filesystem, {});
+  let fuse: FuseNative | undefined;
+  let first: FuseSession | undefined;
+  let successor: FuseSession | undefined;
+  let mountPoint = '';
+  let socketDir = '';
+
+  beforeAll(async () => {
+    const sessionWrap = await fuseIntegrationSessionSetup(operations, {});
+    fuse = sessionWrap.fuseNative;
+    first = sessionWrap.session;
+    mountPoint = sessionWrap.mountPoint;
+    await first.mount();
+    socketDir = await fs.mkdtemp(path.join(os.tmpdir(), 'fuse-handoff-'));
+  });
+
+  afterAll(async () => {
+    await successor?.unmount();
+    await first?.unmount();
+    await fuse?.shutdownDispatcher(750);
+    await successor?.destroy();
+    await first?.destroy();
+    await fs.rm(socketDir, { recursive: true, force: true });
+  });
+
+  test('should keep serving when nobody adopts the session', async () => {
+    const socketPath = path.join(socketDir, 'nobody.sock');
+    await expect(first!.handoff({ socketPath, timeoutMs: 200 })).rejects.toMatchObject({ code: 'ETIMEDOUT' });
+    expect(first!.mounted).toBe(true);
+    expect(await fs.readFile(`${mountPoint}/handed`, 'utf8')).toBe('survives the restart');
+  });
+
+  test('should hand the mount to a successor without closing open files', async () => {
+    const socketPath = path.join(socketDir, 'handoff.sock');
+    const handle = await fs.open(`${mountPoint}/handed`, 'r');
+    const ino = filesystem.resolvePath('/handed').id;
+    const lookups = await fuse!.getInodeLookupCount(ino);
+    let initCalls = 0;
+    operations.overrideOperationsWith({
+      init: async () => {
+        initCalls++;
+        return { connectionInfo: {}, config: {} };
+      },
+    });
+    try {
+      successor = await fuse!.createSession(mountPoint, operations, {
+        debug: true,
+        singleThreaded: true,
+        autoUnmount: false,
+        allowOther: false,
+      });
+      const adopted = successor.adopt({ socketPath, timeoutMs: 5000 });
+      await first!.handoff({ socketPath, state: Buffer.from('inode-map'), timeoutMs: 5000 });
+
+      const state = await adopted;
+      expect(state?.toString()).toBe('inode-map');
+      expect(successor.mounted).toBe(true);
+      // init lief schon beim ersten Mount; Lookup-Zähler werden übernommen, nicht addiert
+      expect(initCalls).toBe(0);
+      expect(lookups).toBeGreaterThan(0n);
+      expect(await fuse!.getInodeLookupCount(ino)).toBe(lookups);
+      first = undefined;
+
+      // Derselbe Kernel-Dateideskriptor, jetzt vom Nachfolger bedient
+      const { bytesRead, buffer } = await handle.read(Buffer.alloc(64), 0, 64, 0);
+      expect(buffer.subarray(0, bytesRead).toString()).toBe('survives the restart');
+      expect(await fs.readdir(mountPoint)).toContain('handed');
+    } finally {
+      operations.overrideOperationsWith({});
+      await handle.close();
+    }
+  });
+
+  test('should refuse autoUnmount sessions', async () => {
+    const session = await fuse!.createSession(`${mountPoint}-unused`, {}, { autoUnmount: true });
+    await expect(session.setShutdownHandoff({ socketPath: path.join(socketDir, 'x.sock') })).rejects.toMatchObject({
+      code: 'EINVAL',
+    });
+    await session.destroy();
+  });
+});
@@ -5,12 +5,19 @@
 
 import { afterAll, beforeAll, describe, expect, test } from '@jest/globals';
 import fs from 'fs/promises';
+import os from 'os';
+import path from 'path';
 import {
+  FuseErrno,
   FuseNative,
   type FuseSession,
   type Ino,
   type RequestContext,
   type WriteOptions,
+  type NativeWriteDescriptor,
+  NativeIo,
+  createFd,
+  createFlags,
 } from '../../index.ts';
 import { defer, fuseIntegrationSessionSetup } from './integration-setup.ts';
 import { FileSystemOperations } from './file-system-operations.ts';
@@ -61,7 +68,7 @@ describe('FUSE write Bridge Integration', () => {
     let recordedData: ArrayBuffer = new ArrayBuffer(0);
     let recordedOptions: WriteOptions | undefined;
 
-    const recordingWrite = async (ino: Ino, data: ArrayBuffer, context: RequestContext, options: WriteOptions): Promise<number> => {
+    const recordingWrite = async (ino: Ino, data: ArrayBuffer, context: RequestContext, options: WriteOptions): Promise<number | NativeWriteDescriptor> => {
       recordedIno = ino;
       recordedData = data;
       recordedOptions = options;
@@ -106,4 +113,225 @@ describe('FUSE write Bridge Integration', () => {
     // Reset overrides
     filesystemOperations.overrideOperationsWith({});
   });
+
+  test('should route kernel writes through the per-handle queue when coalescing is enabled', async () => {
+    const mergedCounts: number[] = [];
+    filesystemOperations.overrideOperationsWith({
+      write: async (ino: Ino, data: ArrayBuffer, context: RequestContext, options: WriteOptions): Promise<number | NativeWriteDescriptor> => {
+        mergedCounts.push(options.coalesced ?? 0);
+        return defaultOperations.write(ino, data, context, options);
+      },
+    });
+    await fuse!.configureWriteCoalescing({ enabled: true, maxExtentBytes: 64 * 1024 });
+    const before = await fuse!.getWriteCoalescingStats();
+
+    try {
+      const fileName = 'coalesced-log.txt';
+      const lines = Array.from({ length: 16 }, (_, i) => `log line ${i}\n`);
+
+      const fileHandle = await fs.open(`${mountPoint}/${fileName}`, 'w');
+      for (const line of lines) {
+        await fileHandle.write(line);
+      }
+      // fsync wartet, bis die Queue des Handles leer ist
+      await fileHandle.sync();
+      await fileHandle.close();
+
+      const stats = await fuse!.getWriteCoalescingStats();
+      const batches = stats.batches - before.batches;
+      expect(stats.enabled).toBe(true);
+      expect(stats.queuedWrites - before.queuedWrites).toBe(BigInt(lines.length));
+      expect(stats.completedWrites - before.completedWrites).toBe(BigInt(lines.length));
+      expect(stats.failedWrites - before.failedWrites).toBe(0n);
+      expect(batches + (stats.mergedWrites - before.mergedWrites)).toBe(BigInt(lines.length));
+      expect(stats.pending).toBe(0n);
+      expect(BigInt(mergedCounts.length)).toBe(batches);
+      expect(mergedCounts.every((count) => count >= 1)).toBe(true);
+
+      const inode = filesystem.resolvePath(`/${fileName}`);
+      if (!(inode.data instanceof Buffer)) {
+        throw new Error('Expected written inode data to be a Buffer instance');
+      }
+      expect(inode.data.toString()).toBe(lines.join(''));
+    } finally {
+      await fuse!.configureWriteCoalescing({ enabled: false });
+      filesystemOperations.overrideOperationsWith({});
+    }
+  });
+
+  test('should acknowledge buffered writes with write-behind and report failures on fsync', async () => {
+    const gate = defer<void>();
+    filesystemOperations.overrideOperationsWith({
+      write: async (ino: Ino, data: ArrayBuffer, context: RequestContext, options: WriteOptions): Promise<number | NativeWriteDescriptor> => {
+        await gate.promise;
+        return defaultOperations.write(ino, data, context, options);
+      },
+    });
+    await fuse!.configureWriteBehind({ enabled: true });
+    const before = await fuse!.getWriteBehindStats();
+
+    try {
+      const fileName = 'write-behind.txt';
+      const fileContent = 'buffered';
+      const fileHandle = await fs.open(`${mountPoint}/${fileName}`, 'w');
+
+      // Antwort kommt, obwohl der Handler noch blockiert
+      await fileHandle.write(fileContent);
+      const dirty = await fuse!.getWriteBehindStats();
+      expect(dirty.dirtyBytes).toBe(fileContent.length);
+      expect(dirty.acknowledgedWrites - before.acknowledgedWrites).toBe(1n);
+
+      gate.resolve();
+      await fileHandle.sync();
+
+      const flushed = await fuse!.getWriteBehindStats();
+      expect(flushed.dirtyBytes).toBe(0);
+      expect(flushed.flushes - before.flushes).toBe(1n);
+      expect(flushed.flushedBytes - before.flushedBytes).toBe(BigInt(fileContent.length));
+      const inode = filesystem.resolvePath(`/${fileName}`);
+      if (!(inode.data instanceof Buffer)) {
+        throw new Error('Expected written inode data to be a Buffer instance');
+      }
+      expect(inode.data.toString()).toBe(fileContent);
+
+      // Fehler eines bestätigten Writes erscheint beim nächsten fsync
+      filesystemOperations.overrideOperationsWith({
+        write: async (): Promise<number> => {
+          throw new FuseErrno('ENOSPC');
+        },
+      });
+      await fileHandle.write('lost', fileContent.length);
+      await expect(fileHandle.sync()).rejects.toMatchObject({ code: 'ENOSPC' });
+      await fileHandle.close();
+
+      const failed = await fuse!.getWriteBehindStats();
+      expect(failed.failedWrites - before.failedWrites).toBe(1n);
+    } finally {
+      gate.resolve();
+      await fuse!.configureWriteBehind({ enabled: false });
+      filesystemOperations.overrideOperationsWith({});
+    }
+  });
+
+  test('should order stat and truncate after acknowledged writes of the inode', async () => {
+    const fileName = 'write-behind-stat.txt';
+    const gate = defer<void>();
+    filesystemOperations.overrideOperationsWith({
+      write: async (ino: Ino, data: ArrayBuffer, context: RequestContext, options: WriteOptions): Promise<number | NativeWriteDescriptor> => {
+        await gate.promise;
+        return defaultOperations.write(ino, data, context, options);
+      },
+    });
+    await fuse!.configureWriteBehind({ enabled: true });
+
+    try {
+      const fileHandle = await fs.open(`${mountPoint}/${fileName}`, 'w');
+      await fileHandle.write('0123456789');
+
+      // Beide warten auf den bestätigten Write; der truncate darf ihn nicht überholen
+      const stat = fs.stat(`${mountPoint}/${fileName}`);
+      const truncated = fs.truncate(`${mountPoint}/${fileName}`, 4);
+      gate.resolve();
+      expect((await stat).size).toBeGreaterThanOrEqual(4);
+      await truncated;
+      await fileHandle.close();
+
+      const inode = filesystem.resolvePath(`/${fileName}`);
+      if (!(inode.data instanceof Buffer)) {
+        throw new Error('Expected written inode data to be a Buffer instance');
+      }
+      expect(inode.data.toString()).toBe('0123');
+      expect((await fs.stat(`${mountPoint}/${fileName}`)).size).toBe(4);
+    } finally {
+      gate.resolve();
+      await fuse!.configureWriteBehind({ enabled: false });
+      filesystemOperations.overrideOperationsWith({});
+    }
+  });
+
+  test('should keep the write-behind queue of a shared file handle until its last release', async () => {
+    const fileName = 'shared-handle.txt';
+    await fs.writeFile(`${mountPoint}/${fileName}`, '');
+    const gate = defer<void>();
+    let released = defer<void>();
+    filesystemOperations.overrideOperationsWith({
+      // Jedes Open bekommt denselben Handle
+      open: async (_ino, _context, options) => ({ fh: createFd(4242n), flags: options?.flags ?? createFlags(0) }),
+      write: async (ino: Ino, data: ArrayBuffer, context: RequestContext, options: WriteOptions): Promise<number | NativeWriteDescriptor> => {
+        await gate.promise;
+        return defaultOperations.write(ino, data, context, options);
+      },
+      release: async (_ino, fi) => {
+        if (fi.fh === createFd(4242n)) {
+          released.resolve();
+        }
+      },
+    });
+    await fuse!.configureWriteBehind({ enabled: true });
+    const before = await fuse!.getWriteCoalescingStats();
+
+    try {
+      const first = await fs.open(`${mountPoint}/${fileName}`, 'r+');
+      const second = await fs.open(`${mountPoint}/${fileName}`, 'r+');
+      await first.write('first', 0);
+
+      // Das zweite Open schließen, während der Write des ersten noch aussteht
+      const closing = second.close();
+      gate.resolve();
+      await closing;
+      await released.promise;
+
+      const shared = await fuse!.getWriteCoalescingStats();
+      expect(shared.openHandles).toBe(before.openHandles + 1);
+
+      await first.write('-more', 5);
+      await first.sync();
+      released = defer<void>();
+      await first.close();
+      await released.promise;
+
+      const inode = filesystem.resolvePath(`/${fileName}`);
+      if (!(inode.data instanceof Buffer)) {
+        throw new Error('Expected written inode data to be a Buffer instance');
+      }
+      expect(inode.data.toString()).toBe('first-more');
+      expect((await fuse!.getWriteBehindStats()).dirtyBytes).toBe(0);
+      expect((await fuse!.getWriteCoalescingStats()).openHandles).toBe(before.openHandles);
+    } finally {
+      gate.resolve();
+      await fuse!.configureWriteBehind({ enabled: false });
+      filesystemOperations.overrideOperationsWith({});
+    }
+  });
+
+  test('should execute pwrite descriptors natively with the request data', async () => {
+    const backingDir = await fs.mkdtemp(path.join(os.tmpdir(), 'fuse-native-pwrite-'));
+    const backingPath = path.join(backingDir, 'backing');
+    const backing = await fs.open(backingPath, 'w+');
+
+    filesystemOperations.overrideOperationsWith({
+      write: async (_ino: Ino, _data: ArrayBuffer, _context: RequestContext, options: WriteOptions): Promise<number | NativeWriteDescriptor> =>
+        NativeIo.pwrite(backing.fd, options.offset),
+    });
+    const before = await fuse!.getNativeIoStats();
+
+    try {
+      const fileContent = 'pwrite from the native pool\n'.repeat(512);
+      const fileHandle = await fs.open(`${mountPoint}/native-pwrite.txt`, 'w');
+      const { bytesWritten } = await fileHandle.write(fileContent);
+      await fileHandle.close();
+
+      // Das Ergebnis meldet die tatsächlich geschriebenen Bytes an den Kernel
+      expect(bytesWritten).toBe(Buffer.byteLength(fileContent));
+      expect((await fs.readFile(backingPath)).toString()).toBe(fileContent);
+
+      const after = await fuse!.getNativeIoStats();
+      expect(after.bytesWritten - before.bytesWritten).toBe(BigInt(Buffer.byteLength(fileContent)));
+      expect(after.errors).toBe(before.errors);
+    } finally {
+      filesystemOperations.overrideOperationsWith({});
+      await backing.close();
+      await fs.rm(backingDir, { recursive: true, force: true });
+    }
+  });
 });
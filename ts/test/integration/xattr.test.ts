@@ -0,0 +1,268 @@
+/**
+ * @file ts/test/integration/xattr.test.ts
+ * @brief Integration test for the asynchronous and batched xattr API
+ */
+
+import { afterAll, beforeAll, describe, expect, test } from '@jest/globals';
+import fs from 'fs/promises';
+import os from 'os';
+import path from 'path';
+import {
+  createIno,
+  FuseErrno,
+  FuseNative,
+  type FuseSession,
+  type GetxattrHandler,
+  type ListxattrHandler,
+} from '../../index.ts';
+import { fuseIntegrationSessionSetup } from './integration-setup.ts';
+import { FileSystemOperations } from './file-system-operations.ts';
+import { FileSystem } from './filesystem.ts';
+
+describe('xattr worker Integration', () => {
+  let fuse: FuseNative | undefined;
+  let session: FuseSession | undefined;
+  let workDir = '';
+  let filePath = '';
+  let otherPath = '';
+  let supported = true;
+
+  beforeAll(async () => {
+    const sessionWrap = await fuseIntegrationSessionSetup(new FileSystemOperations(new FileSystem(), {}), {});
+    fuse = sessionWrap.fuseNative;
+    session = sessionWrap.session;
+    workDir = await fs.mkdtemp(path.join(os.tmpdir(), 'fuse-native-xattr-'));
+    filePath = path.join(workDir, 'file');
+    otherPath = path.join(workDir, 'other');
+    await fs.writeFile(filePath, 'data');
+    await fs.writeFile(otherPath, 'data');
+
+    // tmpfs kennt user.* erst ab Linux 6.6
+    try {
+      await fuse.setxattr(filePath, 'user.probe', Buffer.from('1'));
+      await fuse.removexattr(filePath, 'user.probe');
+    } catch (error) {
+      if (error instanceof FuseErrno && (error.code === 'ENOTSUP' || error.code === 'EOPNOTSUPP')) {
+        supported = false;
+      } else {
+        throw error;
+      }
+    }
+  });
+
+  afterAll(async () => {
+    await fuse?.configureXattrFdCache({ capacity: 0 });
+    await fs.rm(workDir, { recursive: true, force: true });
+    await fuse?.shutdownDispatcher(750);
+    await session?.destroy();
+  });
+
+  test('should set, read, list and remove attributes off the JS thread', async () => {
+    if (!supported) {
+      return;
+    }
+    const large = Buffer.alloc(16 * 1024, 0x78);
+    await fuse!.setxattr(filePath, 'user.small', Buffer.from('hello'));
+    await fuse!.setxattr(filePath, 'user.large', large);
+
+    // Größenabfrage und Lesen mit Puffer
+    expect(await fuse!.getxattr(filePath, 'user.small')).toEqual({ size: 5n });
+    const small = await fuse!.getxattr(filePath, 'user.small', 64n);
+    expect(small.data!.toString()).toBe('hello');
+
+    // Größer als der Stack-Puffer: ERANGE-Pfad im Worker
+    const big = await fuse!.getxattr(filePath, 'user.large', BigInt(large.length));
+    expect(big.data!.equals(large)).toBe(true);
+    await expect(fuse!.getxattr(filePath, 'user.large', 16n)).rejects.toMatchObject({ code: 'ERANGE' });
+
+    const listed = await fuse!.listxattr(filePath, 4096n);
+    expect(listed.names).toEqual(expect.arrayContaining(['user.small', 'user.large']));
+
+    await fuse!.removexattr(filePath, 'user.large');
+    await expect(fuse!.getxattr(filePath, 'user.large', 64n)).rejects.toBeInstanceOf(FuseErrno);
+  });
+
+  test('should read a batch with per-item errors in request order', async () => {
+    if (!supported) {
+      return;
+    }
+    await fuse!.setxattr(filePath, 'user.a', Buffer.from('A'));
+    await fuse!.setxattr(filePath, 'user.b', Buffer.from('B'));
+    await fuse!.setxattr(otherPath, 'user.c', Buffer.from('C'));
+
+    const results = await fuse!.getxattrBatch([
+      { path: filePath, name: 'user.a' },
+      { path: filePath, name: 'user.missing' },
+      { path: otherPath },
+      { path: path.join(workDir, 'nope'), name: 'user.a' },
+      { path: filePath, name: 'user.b' },
+    ]);
+
+    expect(results).toHaveLength(5);
+    expect(results[0]!.value!.toString()).toBe('A');
+    expect(results[1]!.error).toBe('ENODATA');
+    expect(results[2]!.values!['user.c']!.toString()).toBe('C');
+    expect(results[3]!.error).toBe('ENOENT');
+    expect(results[4]!.value!.toString()).toBe('B');
+  });
+
+  test('should address attributes through an open fd', async () => {
+    if (!supported) {
+      return;
+    }
+    const handle = await fs.open(otherPath, 'r');
+    try {
+      await fuse!.fsetxattr(handle.fd, 'user.fd', Buffer.from('via-fd'));
+      const value = await fuse!.fgetxattr(handle.fd, 'user.fd', 64n);
+      expect(value.data!.toString()).toBe('via-fd');
+      expect((await fuse!.flistxattr(handle.fd, 4096n)).names).toContain('user.fd');
+
+      const [batched] = await fuse!.getxattrBatch([{ fd: handle.fd, name: 'user.fd' }]);
+      expect(batched!.fd).toBe(handle.fd);
+      expect(batched!.value!.toString()).toBe('via-fd');
+
+      await fuse!.fremovexattr(handle.fd, 'user.fd');
+      await expect(fuse!.fgetxattr(handle.fd, 'user.fd', 64n)).rejects.toBeInstanceOf(FuseErrno);
+    } finally {
+      await handle.close();
+    }
+  });
+
+  test('should reuse cached inode handles with LRU bounds', async () => {
+    if (!supported) {
+      return;
+    }
+    await fuse!.configureXattrFdCache({ capacity: 1 });
+    const cachedPath = path.join(workDir, 'cached');
+    await fs.writeFile(cachedPath, 'data');
+    await fuse!.setxattr(cachedPath, 'user.label', Buffer.from('system_u:object_r'));
+    const ino = createIno((await fs.stat(cachedPath, { bigint: true })).ino);
+    const before = await fuse!.getXattrFdCacheStats();
+
+    for (let i = 0; i < 3; i++) {
+      const label = await fuse!.getxattr(cachedPath, 'user.label', 64n, { ino });
+      expect(label.data!.toString()).toBe('system_u:object_r');
+    }
+    let stats = await fuse!.getXattrFdCacheStats();
+    expect(stats.misses - before.misses).toBe(1n);
+    expect(stats.hits - before.hits).toBe(2n);
+    expect(stats.entries).toBe(1);
+
+    // Das Handle hängt am Inode, nicht am Pfad
+    const movedPath = path.join(workDir, 'moved');
+    await fs.rename(cachedPath, movedPath);
+    const moved = await fuse!.getxattr(cachedPath, 'user.label', 64n, { ino });
+    expect(moved.data!.toString()).toBe('system_u:object_r');
+
+    // Zweites Inode verdrängt das erste
+    const otherIno = createIno((await fs.stat(otherPath, { bigint: true })).ino);
+    await fuse!.listxattr(otherPath, 4096n, { ino: otherIno });
+    stats = await fuse!.getXattrFdCacheStats();
+    expect(stats.evictions - before.evictions).toBe(1n);
+    expect(stats.entries).toBe(1);
+
+    expect(await fuse!.invalidateXattrFdCache(otherIno)).toBe(1);
+    await expect(fuse!.getxattr(cachedPath, 'user.label', 64n, { ino })).rejects.toMatchObject({ code: 'ENOENT' });
+  });
+});
+
+describe('Native xattr cache Integration', () => {
+  const filesystemOperations = new FileSystemOperations(new FileSystem(), {});
+  let fuse: FuseNative | undefined;
+  let session: FuseSession | undefined;
+  let mountPoint = '';
+
+  beforeAll(async () => {
+    const sessionWrap = await fuseIntegrationSessionSetup(filesystemOperations, {});
+    fuse = sessionWrap.fuseNative;
+    session = sessionWrap.session;
+    await session.mount();
+    mountPoint = sessionWrap.mountPoint;
+  });
+
+  afterAll(async () => {
+    await fuse?.configureXattrCache({});
+    await session?.unmount();
+    await fuse?.shutdownDispatcher(750);
+    await session?.destroy();
+  });
+
+  test('should answer repeated getxattr/listxattr natively until set/remove invalidates', async () => {
+    const values = new Map<string, Buffer>();
+    let getCalls = 0;
+    let listCalls = 0;
+    const getxattr: GetxattrHandler = async (_ino, name) => {
+      // Kernel-Proben (security.capability) bei open/write nicht mitzählen
+      if (name.startsWith('user.')) {
+        getCalls++;
+      }
+      const data = values.get(name);
+      if (!data) {
+        throw new FuseErrno('ENODATA');
+      }
+      return { data, size: BigInt(data.length) };
+    };
+    const listxattr: ListxattrHandler = async () => {
+      listCalls++;
+      const names = [...values.keys()];
+      return { names, size: BigInt(names.reduce((sum, name) => sum + name.length + 1, 0)) };
+    };
+    filesystemOperations.overrideOperationsWith({
+      getxattr,
+      listxattr,
+      setxattr: async (_ino, name, value) => {
+        values.set(name, Buffer.from(value));
+      },
+      removexattr: async (_ino, name) => {
+        if (!values.delete(name)) {
+          throw new FuseErrno('ENODATA');
+        }
+      },
+    });
+    await fuse!.configureXattrCache({ ttl: 60, negativeTtl: 60, maxEntries: 1024 });
+    await fuse!.clearXattrCache();
+
+    try {
+      const file = `${mountPoint}/labelled`;
+      await (await fs.open(file, 'w')).close();
+
+      // Negativ-Einträge: die typische Capability-Probe
+      for (let i = 0; i < 3; i++) {
+        await expect(fuse!.getxattr(file, 'user.missing', 64n)).rejects.toMatchObject({ code: 'ENODATA' });
+      }
+      expect(getCalls).toBe(1);
+
+      await fuse!.setxattr(file, 'user.tag', Buffer.from('blue'));
+      for (let i = 0; i < 3; i++) {
+        expect((await fuse!.getxattr(file, 'user.tag', 64n)).data!.toString()).toBe('blue');
+      }
+      expect(getCalls).toBe(2);
+
+      expect((await fuse!.listxattr(file, 1024n)).names).toEqual(['user.tag']);
+      expect((await fuse!.listxattr(file, 1024n)).names).toEqual(['user.tag']);
+      expect(listCalls).toBe(1);
+
+      // removexattr über die Bridge verwirft Name und Liste
+      await fuse!.removexattr(file, 'user.tag');
+      await expect(fuse!.getxattr(file, 'user.tag', 64n)).rejects.toMatchObject({ code: 'ENODATA' });
+      expect(getCalls).toBe(3);
+      expect((await fuse!.listxattr(file, 1024n)).names ?? []).toEqual([]);
+      expect(listCalls).toBe(2);
+
+      // Externe Änderung: explizit invalidieren
+      values.set('user.missing', Buffer.from('now'));
+      const ino = createIno((await fs.stat(file, { bigint: true })).ino);
+      expect(await fuse!.invalidateXattrCache(ino, 'user.missing')).toBeGreaterThanOrEqual(1);
+      expect((await fuse!.getxattr(file, 'user.missing', 64n)).data!.toString()).toBe('now');
+
+      const stats = await fuse!.getXattrCacheStats();
+      expect(stats.negativeHits).toBeGreaterThanOrEqual(2n);
+      expect(stats.hits).toBeGreaterThanOrEqual(2n);
+      expect(stats.listHits).toBeGreaterThanOrEqual(1n);
+      expect(stats.hitRate).toBeGreaterThan(0);
+    } finally {
+      filesystemOperations.overrideOperationsWith({});
+      await fuse!.configureXattrCache({});
+    }
+  });
+});
@@ -7,6 +7,8 @@
  * and complete FUSE operation interfaces.
  */
 
+import type { AbortOptions } from './abort.ts';
+
 // =============================================================================
 // Branded Types for Type Safety
 // =============================================================================
@@ -239,8 +241,46 @@ export interface ReaddirResult {
   hasMore: boolean;
   /** Suggested offset for subsequent requests */
   nextOffset?: bigint | undefined;
+  /**
+   * `entries` is the complete listing; the bridge keeps it per open handle
+   * and serves later offsets natively (see configureDirSnapshotCache)
+   */
+  snapshot?: boolean | undefined;
 }
 
+/**
+ * Columnar directory listing result.
+ *
+ * Packed natively in a single loop instead of walking one object per entry.
+ * Column `i` across all arrays describes entry `i`; `inos.length` is the
+ * entry count. `names` is either a string array or packed UTF-8: with
+ * `nameLengths` the names are concatenated, without it each name is
+ * NUL-terminated.
+ */
+export interface ColumnarReaddirResult {
+  /** Entry names (string[] or packed UTF-8 bytes) */
+  names: readonly string[] | Uint8Array;
+  /** Byte length of each name when `names` is packed without terminators */
+  nameLengths?: Uint32Array | undefined;
+  /** Inode numbers */
+  inos: BigUint64Array;
+  /** Offsets to resume iteration; defaults to `offset + i + 1` */
+  offsets?: BigUint64Array | undefined;
+  /** Entry types (DirentType values); defaults to Unknown */
+  types?: Uint8Array | undefined;
+  /** Whether additional entries remain after this batch */
+  hasMore: boolean;
+  /** Suggested offset for subsequent requests */
+  nextOffset?: bigint | undefined;
+  /** The columns hold the complete listing (see ReaddirResult.snapshot) */
+  snapshot?: boolean | undefined;
+}
+
+/** Complete directory listing handed to the native snapshot cache */
+export type DirSnapshotListing =
+  | Pick<ReaddirResult, 'entries'>
+  | Omit<ColumnarReaddirResult, 'hasMore' | 'nextOffset' | 'snapshot'>;
+
 // =============================================================================
 // File Info and Context Types
 // =============================================================================
@@ -251,18 +291,33 @@ export interface FileInfo {
   fh: Fd;
   /** Open flags */
   flags: Flags;
-  /** Direct I/O flag */
+  /** FOPEN_DIRECT_IO: bypass the page cache for this handle (open/create) */
   direct_io?: boolean;
-  /** Keep cache flag */
+  /**
+   * FOPEN_KEEP_CACHE: keep cached pages of the inode on open (open/create).
+   * Without it the kernel drops the page cache on every open.
+   */
   keep_cache?: boolean;
   /** Flush flag */
   flush?: boolean;
-  /** Nonseekable flag */
+  /** FOPEN_NONSEEKABLE: the handle is a stream (open/create) */
   nonseekable?: boolean;
-  /** Cache readdir flag */
+  /** FOPEN_CACHE_DIR: let the kernel cache readdir results (opendir only) */
   cache_readdir?: boolean;
-  /** Parallel direct writes flag */
+  /**
+   * FOPEN_PARALLEL_DIRECT_WRITES: allow concurrent direct writes on the
+   * inode instead of serializing them (open/create; direct_io or O_DIRECT)
+   */
   parallel_direct_writes?: boolean;
+  /** FOPEN_NOFLUSH: do not send flush when this handle is closed (open/create) */
+  noflush?: boolean;
+  /**
+   * Backing file for FUSE passthrough (open/create only). When the mount
+   * negotiated passthrough the kernel serves read/write on this handle from
+   * the fd directly; otherwise it is ignored and the regular handlers run.
+   * The fd stays owned by the caller and may be closed once open returned.
+   */
+  backingFd?: number;
 }
 
 /** Poll handle for kernel polling operations */
@@ -307,8 +362,8 @@ export interface FuseBuf {
   size: number;
   /** Buffer flags */
   flags: FuseBufFlags;
-  /** Memory pointer (if not IS_FD) */
-  mem?: ArrayBuffer;
+  /** Memory pointer (if not IS_FD); views of `mapFile()` mappings are sent without copying */
+  mem?: ArrayBuffer | ArrayBufferView;
   /** File descriptor (if IS_FD) */
   fd?: number;
   /** Position in file (if IS_FD) */
@@ -409,6 +464,13 @@ export interface WriteOptions extends BaseOperationOptions {
   fi?: FileInfo;
   /** Write flags */
   flags?: number;
+  /** Number of kernel writes merged into this call (write coalescing only) */
+  coalesced?: number;
+  /**
+   * Digest of the payload, computed natively before the handler is called
+   * (see `configureWriteDigest()`); absent for coalesced writes
+   */
+  digest?: ContentDigest;
 }
 
 /** Options for access operations */
@@ -487,12 +549,33 @@ export type SetattrHandler = (
   options?: SetattrOptions
 ) => Promise<{ attr: StatResult; timeout: Timeout }>;
 
+/**
+ * Read descriptor: the bridge preads `size` bytes (default: the requested
+ * size) from `fd` at `offset` on its native I/O pool and replies directly
+ */
+export interface NativeReadDescriptor {
+  op: 'pread';
+  fd: number;
+  offset: bigint;
+  size?: number;
+}
+
+/**
+ * Write descriptor: the bridge pwrites the request data to `fd` at `offset`
+ * on its native I/O pool and replies with the number of bytes written
+ */
+export interface NativeWriteDescriptor {
+  op: 'pwrite';
+  fd: number;
+  offset: bigint;
+}
+
 /** Read operation handler */
 export type ReadHandler = (
   ino: Ino,
   context: RequestContext,
   options: ReadOptions
-) => Promise<Buffer>;
+) => Promise<Buffer | NativeReadDescriptor>;
 
 /** Write operation handler */
 export type WriteHandler = (
@@ -500,7 +583,7 @@ export type WriteHandler = (
   data: ArrayBuffer,
   context: RequestContext,
   options: WriteOptions
-) => Promise<number>;
+) => Promise<number | NativeWriteDescriptor>;
 
 /** Write buffer vector operation handler */
 export type WriteBufHandler = (
@@ -508,14 +591,14 @@ export type WriteBufHandler = (
   bufvec: FuseBufvec,
   context: RequestContext,
   options: WriteOptions
-) => Promise<number>;
+) => Promise<number | NativeWriteDescriptor>;
 
 /** Read buffer vector operation handler */
 export type ReadBufHandler = (
   ino: Ino,
   context: RequestContext,
   options: ReadOptions
-) => Promise<FuseBufvec>;
+) => Promise<FuseBufvec | NativeReadDescriptor>;
 
 /** Open operation handler */
 export type OpenHandler = (
@@ -524,6 +607,19 @@ export type OpenHandler = (
   options?: OpenOptions
 ) => Promise<FileInfo>;
 
+/** Opendir operation result */
+export interface OpendirResult extends FileInfo {
+  /** Full listing served natively until releasedir (requires a unique fh) */
+  snapshot?: DirSnapshotListing | undefined;
+}
+
+/** Opendir operation handler */
+export type OpendirHandler = (
+  ino: Ino,
+  context: RequestContext,
+  options?: OpenOptions
+) => Promise<FileInfo | OpendirResult>;
+
 /** Release operation handler */
 export type AccessHandler = (
   ino: Ino,
@@ -580,6 +676,24 @@ export type ReaddirHandler = (
   options?: ReaddirOptions
 ) => Promise<ReaddirResult>;
 
+/** Readdir operation handler returning the columnar format */
+export type ColumnarReaddirHandler = (
+  ino: Ino,
+  offset: bigint,
+  context: RequestContext,
+  fi?: FileInfo,
+  options?: ReaddirOptions
+) => Promise<ColumnarReaddirResult>;
+
+/** Any readdir handler the bridge accepts (ReaddirHandler or ColumnarReaddirHandler) */
+export type AnyReaddirHandler = (
+  ino: Ino,
+  offset: bigint,
+  context: RequestContext,
+  fi?: FileInfo,
+  options?: ReaddirOptions
+) => Promise<ReaddirResult | ColumnarReaddirResult>;
+
 /** Directory entry for readdirplus */
 export interface DirentplusEntry extends DirentEntry {
   /** Stat result for the entry */
@@ -691,6 +805,15 @@ export type RenameHandler = (
   options?: BaseOperationOptions
 ) => Promise<void>;
 
+/**
+ * Forget handler: receives inodes the kernel no longer references
+ *
+ * Called with batches of inodes whose lookup count dropped to zero; the
+ * native inode table tracks the counts. The kernel expects no reply, so a
+ * rejection is only logged.
+ */
+export type ForgetHandler = (inos: BigUint64Array) => Promise<void> | void;
+
 /** Statfs operation handler */
 export type StatfsHandler = (
   ino: Ino,
@@ -870,6 +993,8 @@ export interface FuseOperationHandlers {
   destroy?: () => Promise<void>;
   /** Lookup a directory entry */
   lookup?: LookupHandler;
+  /** Inodes released by the kernel (batched, see ForgetHandler) */
+  forget?: ForgetHandler;
   /** Get file attributes */
   getattr?: GetattrHandler;
   /** Get symlink target */
@@ -887,8 +1012,8 @@ export interface FuseOperationHandlers {
   open?: OpenHandler;
   /** Release a file */
   release?: ReleaseHandler;
-  /** Read directory contents */
-  readdir?: ReaddirHandler;
+  /** Read directory contents (object entries or columnar) */
+  readdir?: AnyReaddirHandler;
   /** Read directory contents with attributes */
   readdirplus?: ReaddirplusHandler;
   /** Create a directory */
@@ -940,7 +1065,7 @@ export interface FuseOperationHandlers {
   ) => Promise<void>;
 
   /** Open a directory */
-  opendir?: OpenHandler;
+  opendir?: OpendirHandler;
   /** Release a directory */
   releasedir?: ReleaseHandler;
   /** Synchronize directory contents */
@@ -1061,6 +1186,8 @@ export interface FuseSessionOptions {
   maxWrite?: number;
   /** Connection timeout */
   timeout?: number;
+  /** Negotiate FUSE passthrough so open/create may return `backingFd` (disables writeback cache) */
+  passthrough?: boolean;
 }
 
 /** Mount options */
@@ -1079,6 +1206,47 @@ export interface UnmountOptions extends BaseOperationOptions {
   lazy?: boolean;
 }
 
+/** Kernel cache notification (see FuseSession.notifyBatch) */
+export type NotifyOperation =
+  | {
+      op: 'invalInode';
+      ino: Ino;
+      /** Start of the data range to drop from the page cache */
+      offset?: bigint | undefined;
+      /** 0 = attributes only, negative = to end of file */
+      length?: bigint | undefined;
+    }
+  | { op: 'invalEntry'; parent: Ino; name: string }
+  | { op: 'expireEntry'; parent: Ino; name: string }
+  | { op: 'delete'; parent: Ino; child: Ino; name: string };
+
+/** Pages returned by FuseSession.notifyRetrieve */
+export interface RetrievedPages {
+  ino: Ino;
+  /** Offset the kernel answered for */
+  offset: bigint;
+  /** Cached data; shorter than requested where the cache has a gap or the file ends */
+  data: Buffer;
+}
+
+/** Options for handing a mounted session to a successor process (FuseSession.handoff) */
+export interface HandoffOptions {
+  /** Unix socket the successor listens on; a leading '@' selects the abstract namespace */
+  socketPath: string;
+  /** Opaque application state passed to the successor */
+  state?: Uint8Array;
+  /** Time for answering in-flight requests and the transfer (default 10000) */
+  timeoutMs?: number;
+}
+
+/** Options for taking over a session from a previous process (FuseSession.adopt) */
+export interface AdoptOptions {
+  /** Unix socket to listen on; a leading '@' selects the abstract namespace */
+  socketPath: string;
+  /** How long to wait for the previous process (default 10000) */
+  timeoutMs?: number;
+}
+
 /** FUSE session interface */
 export interface FuseSession {
   /** Mount point path */
@@ -1094,6 +1262,31 @@ export interface FuseSession {
   unmount(options?: UnmountOptions): Promise<void>;
   /** Destroy the session and cleanup resources */
   destroy(): Promise<void>;
+
+  /**
+   * Serve a mount handed over by a previous process instead of mounting;
+   * resolves to the state it sent
+   */
+  adopt(options: AdoptOptions): Promise<Buffer | undefined>;
+  /** Pass the mounted connection to a successor and destroy this session without unmounting */
+  handoff(options: HandoffOptions): Promise<void>;
+  /** Hand this session off during graceful shutdown instead of unmounting (null restores unmounting) */
+  setShutdownHandoff(options: HandoffOptions | null): Promise<void>;
+
+  /** Invalidate cached attributes and optionally a data range of an inode */
+  notifyInvalInode(ino: Ino, offset?: bigint, length?: bigint): Promise<void>;
+  /** Invalidate a cached directory entry */
+  notifyInvalEntry(parent: Ino, name: string): Promise<void>;
+  /** Mark a directory entry as expired without dropping it if it is in use */
+  notifyExpireEntry(parent: Ino, name: string): Promise<void>;
+  /** Tell the kernel that an entry was deleted */
+  notifyDelete(parent: Ino, child: Ino, name: string): Promise<void>;
+  /** Send several notifications in order; resolves to 0 or a negative errno per entry */
+  notifyBatch(notifications: readonly NotifyOperation[]): Promise<number[]>;
+  /** Push data into the kernel page cache of an inode */
+  notifyStore(ino: Ino, offset: bigint, data: Uint8Array): Promise<void>;
+  /** Read back pages the kernel holds in its page cache */
+  notifyRetrieve(ino: Ino, offset: bigint, size: number): Promise<RetrievedPages>;
 }
 
 // =============================================================================
@@ -1194,6 +1387,71 @@ export interface FDWriteQueueConfig {
   fdMaxQueueSize?: Record<string, number>;
 }
 
+/** Write coalescing configuration for kernel writes */
+export interface WriteCoalescingConfig {
+  /** Queue kernel writes per file handle and merge contiguous ones (default false) */
+  enabled?: boolean | undefined;
+  /** Upper bound for one merged write in bytes (default 1 MiB) */
+  maxExtentBytes?: number | undefined;
+  /** Upper bound for kernel writes merged into one call (default 256) */
+  maxBatchWrites?: number | undefined;
+}
+
+/** Write coalescing statistics */
+export interface WriteCoalescingStats {
+  enabled: boolean;
+  maxExtentBytes: number;
+  maxBatchWrites: number;
+  /** Kernel writes that went through a queue */
+  queuedWrites: bigint;
+  /** Kernel writes answered successfully */
+  completedWrites: bigint;
+  /** Kernel writes answered with an error */
+  failedWrites: bigint;
+  bytesWritten: bigint;
+  /** JS write calls issued for queued writes */
+  batches: bigint;
+  /** Kernel writes that shared a call with a predecessor */
+  mergedWrites: bigint;
+  /** Kernel writes waiting for the current call to finish */
+  pending: bigint;
+  /** File handles with a live queue */
+  openHandles: number;
+}
+
+/** Write-behind configuration for kernel writes */
+export interface WriteBehindConfig {
+  /** Acknowledge writes once buffered (default false) */
+  enabled?: boolean | undefined;
+  /** Dirty bytes allowed per file handle, 0 = unlimited (default 8 MiB) */
+  maxDirtyBytesPerHandle?: number | undefined;
+  /** Dirty bytes allowed across all handles, 0 = unlimited (default 64 MiB) */
+  maxDirtyBytes?: number | undefined;
+}
+
+/** Write-behind statistics */
+export interface WriteBehindStats {
+  enabled: boolean;
+  maxDirtyBytesPerHandle: number;
+  maxDirtyBytes: number;
+  /** Bytes acknowledged but not yet written by the handler */
+  dirtyBytes: number;
+  peakDirtyBytes: number;
+  /** Writes acknowledged before the handler ran */
+  acknowledgedWrites: bigint;
+  /** Writes over a dirty cap, acknowledged after the handler ran */
+  throttledWrites: bigint;
+  /** Acknowledged bytes the handler wrote successfully */
+  flushedBytes: bigint;
+  /** Acknowledged writes the handler failed (reported on flush/fsync) */
+  failedWrites: bigint;
+  /** Acknowledged writes the handler has finished */
+  flushes: bigint;
+  /** Time from acknowledgement to completion */
+  avgFlushLatencyMs: number;
+  maxFlushLatencyMs: number;
+}
+
 /** Write operation completion callback */
 export type WriteCompletionCallback = (result: number) => void;
 
@@ -1201,7 +1459,7 @@ export type WriteCompletionCallback = (result: number) => void;
 // =============================================================================
 
 /** Shutdown state enumeration */
-export type ShutdownState = 'RUNNING' | 'DRAINING' | 'UNMOUNTING' | 'CLOSED';
+export type ShutdownState = 'RUNNING' | 'DRAINING' | 'UNMOUNTING' | 'CLOSED' | 'HANDING_OFF';
 
 /** Shutdown phase duration information */
 export interface ShutdownPhaseDuration {
@@ -1211,6 +1469,34 @@ export interface ShutdownPhaseDuration {
   durationMs: number;
 }
 
+/** Timing of one task that ran in parallel within a shutdown phase */
+export interface ShutdownTaskMetrics {
+  /** Task name, e.g. 'write-queues', 'dispatcher', 'fuse-requests' */
+  name: string;
+  /** Duration in microseconds (time until the phase gave up if it timed out) */
+  durationUs: number;
+  /** Whether the task finished its work */
+  success: boolean;
+  /** Whether the task was still running at the phase deadline */
+  timedOut: boolean;
+}
+
+/** Metrics of one executed shutdown phase */
+export interface ShutdownPhaseMetrics {
+  /** Shutdown state/phase */
+  state: ShutdownState;
+  /** Phase description */
+  description: string;
+  /** Duration in microseconds */
+  durationUs: number;
+  /** Whether the phase completed */
+  success: boolean;
+  /** Whether the phase hit its timeout */
+  timedOut: boolean;
+  /** Parallel tasks of the phase */
+  tasks: ShutdownTaskMetrics[];
+}
+
 /** Shutdown statistics */
 export interface ShutdownStats {
   /** Final shutdown state reached */
@@ -1221,8 +1507,12 @@ export interface ShutdownStats {
   failureReason: string;
   /** Duration of each shutdown phase */
   phaseDurations: ShutdownPhaseDuration[];
+  /** Per-phase metrics including the parallel tasks of each phase */
+  phases: ShutdownPhaseMetrics[];
   /** Total shutdown duration in milliseconds (if completed) */
   totalDurationMs?: number;
+  /** Total shutdown duration in microseconds (if completed) */
+  totalDurationUs?: number;
 }
 
 /** Shutdown timeout configuration */
@@ -1231,6 +1521,8 @@ export interface ShutdownTimeouts {
   draining?: number;
   /** Unmounting phase timeout in milliseconds */
   unmounting?: number;
+  /** Handoff phase timeout in milliseconds (replaces unmounting when a handoff is configured) */
+  handoff?: number;
 }
 
 /** Shutdown callback interface */
@@ -1364,3 +1656,447 @@ export type WaitForShutdownCompletion = (timeout?: number) => Promise<boolean>;
 export type ConfigureShutdownTimeouts = (
   timeouts: ShutdownTimeouts
 ) => Promise<boolean>;
+
+// =============================================================================
+// Native Cache Types
+// =============================================================================
+
+/** Directory snapshot cache configuration */
+export interface DirSnapshotCacheConfig {
+  /** Byte budget for all snapshots; 0 disables the cache */
+  maxBytes: number;
+}
+
+/** Directory snapshot cache statistics */
+export interface DirSnapshotCacheStats {
+  /** readdir calls answered from a snapshot */
+  hits: bigint;
+  /** readdir calls on handles without a snapshot */
+  misses: bigint;
+  /** Snapshots stored */
+  inserts: bigint;
+  /** Snapshots dropped to honour the byte budget */
+  evictions: bigint;
+  /** Snapshots larger than the whole budget */
+  rejected: bigint;
+  /** Snapshots dropped by releasedir */
+  releases: bigint;
+  /** Snapshots not kept because several opens share the handle */
+  shared: bigint;
+  /** Currently cached handles */
+  entries: number;
+  /** Currently cached bytes */
+  bytes: number;
+  /** Configured byte budget */
+  maxBytes: number;
+}
+
+/** Attribute cache configuration */
+export interface AttrCacheConfig {
+  /** Lifetime of a cached entry in seconds (independent of the kernel attr timeout); 0 disables the cache */
+  ttl: Timeout;
+  /** Capacity across all shards; 0 or omitted means unbounded */
+  maxEntries?: number | undefined;
+}
+
+/** Attribute cache statistics */
+export interface AttrCacheStats {
+  /** getattr requests answered natively */
+  hits: bigint;
+  /** getattr requests forwarded to the handler */
+  misses: bigint;
+  /** Attributes stored or refreshed */
+  inserts: bigint;
+  /** Entries dropped by mutating operations, forget or invalidateAttrCache() */
+  invalidations: bigint;
+  /** Entries found past their TTL */
+  expirations: bigint;
+  /** Entries dropped to honour maxEntries */
+  evictions: bigint;
+  /** hits / (hits + misses), 0 without lookups */
+  hitRate: number;
+  /** Currently cached inodes */
+  entries: number;
+  /** Configured capacity (0 = unbounded) */
+  maxEntries: number;
+  /** Configured TTL in seconds */
+  ttl: number;
+  /** Number of independently locked shards */
+  shards: number;
+}
+
+/** Dentry (lookup) cache configuration */
+export interface DentryCacheConfig {
+  /** Lifetime of positive entries in seconds; 0 or omitted disables them */
+  entryTtl?: Timeout | undefined;
+  /** Lifetime of negative (ENOENT) entries in seconds; 0 or omitted disables them */
+  negativeTtl?: Timeout | undefined;
+  /** Capacity across all shards; 0 or omitted means unbounded */
+  maxEntries?: number | undefined;
+}
+
+/** xattr cache configuration */
+export interface XattrCacheConfig {
+  /** Lifetime of cached values and name lists in seconds; 0 or omitted disables them */
+  ttl?: Timeout | undefined;
+  /** Lifetime of ENODATA entries in seconds; 0 or omitted disables them */
+  negativeTtl?: Timeout | undefined;
+  /** Capacity across all shards (values, negative entries and name lists); 0 or omitted means unbounded */
+  maxEntries?: number | undefined;
+}
+
+/** xattr cache statistics */
+export interface XattrCacheStats {
+  /** getxattr answered natively with a value */
+  hits: bigint;
+  /** getxattr answered natively with ENODATA */
+  negativeHits: bigint;
+  /** listxattr answered natively */
+  listHits: bigint;
+  /** Requests forwarded to the handler */
+  misses: bigint;
+  inserts: bigint;
+  negativeInserts: bigint;
+  invalidations: bigint;
+  expirations: bigint;
+  evictions: bigint;
+  /** Share of requests answered natively */
+  hitRate: number;
+  entries: number;
+  negativeEntries: number;
+  maxEntries: number;
+  ttl: number;
+  negativeTtl: number;
+}
+
+/** Dentry cache statistics */
+export interface DentryCacheStats {
+  /** Lookups answered natively with an entry */
+  hits: bigint;
+  /** Lookups answered natively with ENOENT */
+  negativeHits: bigint;
+  /** Lookups forwarded to the handler */
+  misses: bigint;
+  /** Positive entries stored */
+  inserts: bigint;
+  /** Negative entries stored */
+  negativeInserts: bigint;
+  /** Entries dropped by namespace operations or invalidateDentryCache() */
+  invalidations: bigint;
+  /** Entries found past their TTL */
+  expirations: bigint;
+  /** Entries dropped to honour maxEntries */
+  evictions: bigint;
+  /** (hits + negativeHits) / all lookups, 0 without lookups */
+  hitRate: number;
+  /** Currently cached names (positive and negative) */
+  entries: number;
+  /** Currently cached negative names */
+  negativeEntries: number;
+  /** Configured capacity (0 = unbounded) */
+  maxEntries: number;
+  /** Configured positive TTL in seconds */
+  entryTtl: number;
+  /** Configured negative TTL in seconds */
+  negativeTtl: number;
+}
+
+/** Forget batching configuration */
+export interface InodeTableConfig {
+  /** Deliver as soon as this many inodes are released (default 1024) */
+  batchSize?: number | undefined;
+  /** Deliver released inodes at least this often in ms (default 50) */
+  flushIntervalMs?: number | undefined;
+}
+
+/** Inode table statistics */
+export interface InodeTableStats {
+  /** True while a forget handler is registered */
+  tracking: boolean;
+  /** Kernel references handed out by entry replies */
+  lookups: bigint;
+  /** Kernel references returned by forget */
+  forgets: bigint;
+  /** Inodes whose count reached zero */
+  released: bigint;
+  /** Forgets for inodes looked up before tracking started */
+  unknownForgets: bigint;
+  /** Batches handed to the forget handler */
+  batches: bigint;
+  /** Released inodes that could not be dispatched */
+  dropped: bigint;
+  /** Inodes currently referenced by the kernel */
+  liveInodes: number;
+  /** Released inodes waiting for the next batch */
+  pending: number;
+  batchSize: number;
+  flushIntervalMs: number;
+}
+
+/** Options for `copyFileRange()` */
+export interface CopyFileRangeOptions extends AbortOptions {
+  /**
+   * Called with the bytes copied so far after each chunk. Calls are
+   * coalesced when the JS thread is busy; the last one may lag the result.
+   */
+  onProgress?: (bytesCopied: bigint) => void;
+}
+
+/** copy_file_range statistics */
+export interface CopyStats {
+  totalOperations: bigint;
+  totalBytesCopied: bigint;
+  /** Copies that ran on a worker thread */
+  asyncOperations: bigint;
+  /** Copies stopped by their AbortSignal or timeout */
+  cancelledOperations: bigint;
+  /** Copies currently running on worker threads */
+  activeCopies: number;
+  /** How often each strategy moved data; one copy may use several */
+  strategies: CopyStrategyStats;
+  /** Source hole bytes punched or skipped instead of written */
+  holeBytes: bigint;
+  kernelCopySupported: boolean;
+}
+
+/** Per-strategy counters of the copy engine */
+export interface CopyStrategyStats {
+  /** Ranges cloned with FICLONERANGE */
+  reflink: bigint;
+  /** Ranges copied by copy_file_range(2) */
+  copyFileRange: bigint;
+  /** Data extents moved with splice through a pipe */
+  splice: bigint;
+  /** Data extents moved with sendfile */
+  sendfile: bigint;
+  /** Data extents copied through a userspace buffer */
+  buffered: bigint;
+  /** Fallback copies that walked SEEK_DATA/SEEK_HOLE and found holes */
+  sparse: bigint;
+}
+
+/** One entry of a getxattrBatch request */
+export interface XattrBatchItem {
+  /** Path of the target; required unless `fd` is given */
+  path?: string;
+  /** Open file descriptor to read with f*xattr instead of `path` */
+  fd?: number;
+  /** Inode of `path`; resolves through the xattr fd cache when enabled */
+  ino?: Ino;
+  /** Attribute name; omitted = every attribute of the target */
+  name?: string;
+}
+
+/** Result of one getxattrBatch entry, in request order */
+export interface XattrBatchResult {
+  path?: string;
+  fd?: number;
+  ino?: Ino;
+  name?: string;
+  /** Value of `name` */
+  value?: Buffer;
+  /** All attributes of `path` when no name was requested */
+  values?: Record<string, Buffer>;
+  /** Errno code (e.g. 'ENODATA') if the entry failed */
+  error?: string;
+}
+
+/** Options of the path-based FuseNative xattr calls */
+export interface XattrCallOptions extends AbortOptions {
+  /**
+   * Inode of the path. With the xattr fd cache enabled the call goes through
+   * the cached O_PATH handle of this inode; the path is only resolved on a miss.
+   */
+  ino?: Ino;
+}
+
+/** xattr fd cache configuration */
+export interface XattrFdCacheConfig {
+  /** Maximum number of cached inode handles (LRU); 0 disables the cache */
+  capacity: number;
+}
+
+/** xattr fd cache statistics */
+export interface XattrFdCacheStats {
+  hits: bigint;
+  /** Handles opened */
+  misses: bigint;
+  /** Opens that failed; the call fell back to the path */
+  openErrors: bigint;
+  evictions: bigint;
+  invalidations: bigint;
+  hitRate: number;
+  entries: number;
+  capacity: number;
+}
+
+/** Native I/O executor configuration */
+export interface NativeIoConfig {
+  /** Worker threads for descriptor I/O (1-64, default 4) */
+  threads?: number | undefined;
+}
+
+/** Native I/O executor statistics */
+export interface NativeIoStats {
+  /** Descriptors and fd read_buf replies handed to the pool */
+  submitted: number;
+  completed: number;
+  /** Descriptors that failed with an errno */
+  errors: number;
+  bytesRead: bigint;
+  bytesWritten: bigint;
+  /** Tasks waiting for a worker */
+  queued: number;
+  peakQueued: number;
+  threads: number;
+}
+
+/** Managed buffer pool configuration */
+export interface BufferPoolConfig {
+  /** false frees every block when its buffer is collected; defaults to true */
+  enabled?: boolean | undefined;
+  /** Cap for free blocks across all size classes in bytes; defaults to 64 MiB */
+  maxCachedBytes?: number | undefined;
+  /** Advise blocks of 2 MiB and more with MADV_HUGEPAGE; defaults to false */
+  hugePages?: boolean | undefined;
+}
+
+/** Statistics of one buffer pool size class */
+export interface BufferPoolClassStats {
+  blockSize: number;
+  /** Free blocks held by the pool */
+  cached: number;
+  /** Blocks referenced by live ArrayBuffers */
+  outstanding: number;
+  /** Buffers served from the free list */
+  hits: bigint;
+  /** Buffers that needed a new block */
+  misses: bigint;
+  /** Blocks returned to the free list by finalizers */
+  releases: bigint;
+  /** Blocks freed because the cap was reached or the pool is disabled */
+  dropped: bigint;
+}
+
+/** Managed buffer pool statistics */
+export interface BufferPoolStats {
+  enabled: boolean;
+  hugePages: boolean;
+  maxCachedBytes: number;
+  /** Bytes in free blocks */
+  cachedBytes: number;
+  /** Block bytes of buffers not yet finalized by the GC */
+  gcDeferredBytes: number;
+  gcDeferredBuffers: number;
+  peakGcDeferredBytes: number;
+  hugePageAllocations: bigint;
+  /** Buffers above the largest size class (mapped and unmapped individually) */
+  oversizeAllocations: bigint;
+  /** Share of pooled buffers served from a free list */
+  hitRate: number;
+  classes: BufferPoolClassStats[];
+}
+
+/** madvise() advice for file views */
+export type FileMappingAdvice = 'normal' | 'sequential' | 'random' | 'willneed' | 'dontneed';
+
+/** Options of `mapFile()` */
+export interface FileMappingOptions {
+  /** Start of the range in the file; need not be page aligned */
+  offset?: bigint | number | undefined;
+  /** Length of the range; omitted or 0 maps up to the end of the file (always clamped to it) */
+  length?: bigint | number | undefined;
+  /**
+   * MAP_SHARED instead of MAP_PRIVATE. Shared views are read-only unless
+   * `writable` is set; writing to a read-only view faults the process
+   */
+  shared?: boolean | undefined;
+  /** Shared views only: map with PROT_WRITE (path targets are opened O_RDWR) */
+  writable?: boolean | undefined;
+  /** MAP_POPULATE: prefault the whole range while mapping */
+  populate?: boolean | undefined;
+  /** Initial madvise() advice for the range */
+  advice?: FileMappingAdvice | undefined;
+}
+
+/** File mapping statistics */
+export interface FileMappingStats {
+  /** Mappings not yet unmapped */
+  active: number;
+  mappedBytes: number;
+  peakMappedBytes: number;
+  created: bigint;
+  unmapped: bigint;
+  /** read/read_buf replies sent straight from a view */
+  zeroCopyReplies: bigint;
+  zeroCopyBytes: bigint;
+}
+
+/** Content hash algorithms */
+export type HashAlgorithm = 'crc32c' | 'xxh3' | 'blake3';
+
+/** Digest of one algorithm: number (crc32c), bigint (xxh3) or 32-byte Buffer (blake3) */
+export type HashDigest<A extends HashAlgorithm> = A extends 'crc32c' ? number : A extends 'xxh3' ? bigint : Buffer;
+
+/** Any content digest */
+export type ContentDigest = HashDigest<HashAlgorithm>;
+
+/** Options of `configureWriteDigest()` */
+export interface WriteDigestConfig {
+  /** Algorithm for write payload digests; omitted disables them */
+  algorithm?: HashAlgorithm | undefined;
+}
+
+/** Hash kernels selected for this CPU */
+export interface HashImplementations {
+  /** 'sse4.2', 'armv8-crc' or 'slicing-by-8' */
+  crc32c: string;
+  /** 'sse2' or 'scalar' */
+  xxh3: string;
+  blake3: string;
+  /** Write payload bytes hashed by the bridge */
+  writeDigestBytes: bigint;
+}
+
+/** Native log levels, from quiet to verbose */
+export type NativeLogLevel = 'off' | 'error' | 'warn' | 'info' | 'debug' | 'trace';
+
+/** Options of `configureLogging()`; omitted fields keep their value */
+export interface LoggingConfig {
+  /** Runtime level; levels above the compiled-in maximum stay silent */
+  level?: NativeLogLevel | undefined;
+  /** Queue lines in per-thread rings for a writer thread (default) instead of writing synchronously */
+  async?: boolean | undefined;
+  /** Ring capacity per logging thread, rounded up to a power of two (16 KiB .. 16 MiB) */
+  ringBytes?: number | undefined;
+}
+
+/** Native logger statistics */
+export interface LoggingStats {
+  level: NativeLogLevel;
+  async: boolean;
+  ringBytes: number;
+  /** Threads with a live ring */
+  threads: number;
+  /** Records queued (async) or written (sync) */
+  records: bigint;
+  /** Records lost because a thread's ring was full */
+  dropped: bigint;
+  bytesWritten: bigint;
+}
+
+/** Passthrough statistics */
+export interface PassthroughStats {
+  /** Native binding was built against a libfuse with passthrough support */
+  supported: boolean;
+  /** Passthrough was negotiated for the current mount */
+  active: boolean;
+  /** Handles served from a backing file by the kernel */
+  opened: number;
+  /** Handles that returned backingFd but use the regular read/write path */
+  fallbacks: number;
+  /** Backing ids closed on release */
+  closed: number;
+  /** Backing ids currently registered */
+  live: number;
+}